@@ -23,11 +23,15 @@ SOURCES += \
     oc/operation/device_statistics.c \
     oc/operation/drive_info.c \
     oc/operation/dst.c \
+    oc/operation/erase_estimate.c \
     oc/operation/firmware_download.c \
     oc/operation/format.c \
     oc/operation/generic_tests.c \
+    oc/operation/health_snapshot.c \
     oc/operation/host_erase.c \
     oc/operation/logs.c \
+    oc/operation/nv_cache_pinning.c \
+    oc/operation/nvme_namespaces.c \
     oc/operation/nvme_operations.c \
     oc/operation/operations.c \
     oc/operation/power_control.c \
@@ -38,6 +42,9 @@ SOURCES += \
     oc/operation/sector_repair.c \
     oc/operation/set_max_lba.c \
     oc/operation/smart.c \
+    oc/operation/statistics_recorder.c \
+    oc/operation/streaming_workload.c \
+    oc/operation/test_checkpoint.c \
     oc/operation/trim_unmap.c \
     oc/operation/writesame.c \
     oc/operation/zoned_operations.c \
@@ -50,8 +57,10 @@ SOURCES += \
     oc/transport/csmi_helper.c \
     oc/transport/csmi_legacy_pt_cdb_helper.c \
     oc/transport/cypress_legacy_helper.c \
+    oc/transport/device_pool.c \
     oc/transport/intel_rst_helper.c \
     oc/transport/jmicron_nvme_helper.c \
+    oc/transport/ncq_queue.c \
     oc/transport/nec_legacy_helper.c \
     oc/transport/nvme_cmds.c \
     oc/transport/nvme_helper.c \
@@ -81,11 +90,15 @@ HEADERS += \
     oc/include/operation/device_statistics.h \
     oc/include/operation/drive_info.h \
     oc/include/operation/dst.h \
+    oc/include/operation/erase_estimate.h \
     oc/include/operation/firmware_download.h \
     oc/include/operation/format.h \
     oc/include/operation/generic_tests.h \
+    oc/include/operation/health_snapshot.h \
     oc/include/operation/host_erase.h \
     oc/include/operation/logs.h \
+    oc/include/operation/nv_cache_pinning.h \
+    oc/include/operation/nvme_namespaces.h \
     oc/include/operation/nvme_operations.h \
     oc/include/operation/opensea_common_version.h \
     oc/include/operation/opensea_operation_version.h \
@@ -99,6 +112,9 @@ HEADERS += \
     oc/include/operation/sector_repair.h \
     oc/include/operation/set_max_lba.h \
     oc/include/operation/smart.h \
+    oc/include/operation/statistics_recorder.h \
+    oc/include/operation/streaming_workload.h \
+    oc/include/operation/test_checkpoint.h \
     oc/include/operation/trim_unmap.h \
     oc/include/operation/writesame.h \
     oc/include/operation/zoned_operations.h \
@@ -118,10 +134,12 @@ HEADERS += \
     oc/include/transport/csmi_legacy_pt_cdb_helper.h \
     oc/include/transport/csmisas.h \
     oc/include/transport/cypress_legacy_helper.h \
+    oc/include/transport/device_pool.h \
     oc/include/transport/dirent.h \
     oc/include/transport/intel_rst_defs.h \
     oc/include/transport/intel_rst_helper.h \
     oc/include/transport/jmicron_nvme_helper.h \
+    oc/include/transport/ncq_queue.h \
     oc/include/transport/nec_legacy_helper.h \
     oc/include/transport/nvme_helper.h \
     oc/include/transport/nvme_helper_func.h \
@@ -25,6 +25,23 @@
 #include <stdlib.h>//aligned allocation functions come from here
 #include <math.h>
 
+//Vector instructions for filling and comparing pattern buffers. These are only used when the compiler is already targeting them, otherwise the generic code is used.
+#if !defined (UEFI_C_SOURCE) && defined (__AVX2__)
+    #include <immintrin.h>
+    #define SEA_SIMD_AVX2
+#endif
+#if !defined (UEFI_C_SOURCE) && (defined (__SSE2__) || defined (_M_X64) || defined (_M_AMD64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SEA_SIMD_SSE2
+#endif
+#if !defined (UEFI_C_SOURCE) && (defined (__SSE4_2__) || (defined (_MSC_VER) && defined (__AVX__)))
+    #include <nmmintrin.h>
+    #define SEA_CRC32C_SSE42
+#elif !defined (UEFI_C_SOURCE) && defined (__ARM_FEATURE_CRC32)
+    #include <arm_acle.h>
+    #define SEA_CRC32C_ARM
+#endif
+
 void delay_Milliseconds(uint32_t milliseconds)
 {
 #if defined(_WIN32) && !defined (UEFI_C_SOURCE)
@@ -272,6 +289,264 @@ void *realloc_page_aligned(void *alignedPtr, size_t originalSize, size_t size)
     }
 }
 
+typedef struct _alignedBufferClass
+{
+    size_t bufferSize;
+    uint32_t maxFree;//buffers kept in the free list. More than this are freed when returned.
+    uint32_t numberFree;
+    void **freeList;
+}alignedBufferClass;
+
+typedef struct _pooledPinnedBuffer
+{
+    pinnedIOBuffer ioBuffer;
+    bool inUse;
+}pooledPinnedBuffer;
+
+struct _alignedBufferPool
+{
+    seaMutex mutex;
+    alignedBufferClass classes[ALIGNED_BUFFER_POOL_SIZE_CLASSES];
+    pooledPinnedBuffer pinned[ALIGNED_BUFFER_POOL_MAX_PINNED];//buffers larger than the biggest class. Slots with a buffer that is not in use are free for reuse. Slots with no buffer are empty only when not in use, since inUse with no buffer means a thread has reserved the slot and is allocating.
+};
+
+int create_Aligned_Buffer_Pool(alignedBufferPool *pool)
+{
+    //512B pages for logs and sense data, 4KiB for larger log pages, 64KiB and 1MiB for data transfers
+    static const size_t classSizes[ALIGNED_BUFFER_POOL_SIZE_CLASSES] = { 512, 4096, 65536, ALIGNED_BUFFER_POOL_MAX_CLASS_SIZE };
+    static const uint32_t classMaxFree[ALIGNED_BUFFER_POOL_SIZE_CLASSES] = { 16, 16, 4, 2 };
+    uint8_t classIter = 0;
+    if (!pool)
+    {
+        return BAD_PARAMETER;
+    }
+    *pool = C_CAST(alignedBufferPool, calloc(1, sizeof(struct _alignedBufferPool)));
+    if (!*pool)
+    {
+        return MEMORY_FAILURE;
+    }
+    for (classIter = 0; classIter < ALIGNED_BUFFER_POOL_SIZE_CLASSES; ++classIter)
+    {
+        (*pool)->classes[classIter].bufferSize = classSizes[classIter];
+        (*pool)->classes[classIter].maxFree = classMaxFree[classIter];
+        (*pool)->classes[classIter].freeList = C_CAST(void**, calloc(classMaxFree[classIter], sizeof(void*)));
+        if (!(*pool)->classes[classIter].freeList)
+        {
+            destroy_Aligned_Buffer_Pool(pool);
+            return MEMORY_FAILURE;
+        }
+    }
+    if (SUCCESS != create_Mutex(&(*pool)->mutex))
+    {
+        destroy_Aligned_Buffer_Pool(pool);
+        return MEMORY_FAILURE;
+    }
+    return SUCCESS;
+}
+
+static alignedBufferClass* get_Aligned_Buffer_Class(alignedBufferPool pool, size_t size)
+{
+    uint8_t classIter = 0;
+    for (classIter = 0; classIter < ALIGNED_BUFFER_POOL_SIZE_CLASSES; ++classIter)
+    {
+        if (size <= pool->classes[classIter].bufferSize)
+        {
+            return &pool->classes[classIter];
+        }
+    }
+    return NULL;
+}
+
+static void *get_Pooled_Pinned_Buffer(alignedBufferPool pool, size_t size)
+{
+    pooledPinnedBuffer *best = NULL;
+    pooledPinnedBuffer *emptySlot = NULL;
+    uint8_t pinnedIter = 0;
+    void *buffer = NULL;
+    lock_Mutex(pool->mutex);
+    for (pinnedIter = 0; pinnedIter < ALIGNED_BUFFER_POOL_MAX_PINNED; ++pinnedIter)
+    {
+        pooledPinnedBuffer *current = &pool->pinned[pinnedIter];
+        if (current->inUse)
+        {
+            //either handed out, or reserved by another thread that is still allocating its buffer
+            continue;
+        }
+        if (!current->ioBuffer.buffer)
+        {
+            if (!emptySlot)
+            {
+                emptySlot = current;
+            }
+        }
+        else if (current->ioBuffer.size >= size && (!best || current->ioBuffer.size < best->ioBuffer.size))
+        {
+            best = current;
+        }
+    }
+    if (best)
+    {
+        best->inUse = true;
+        buffer = best->ioBuffer.buffer;
+    }
+    else if (emptySlot)
+    {
+        //reserve the slot so that the allocation can happen without holding the mutex
+        emptySlot->inUse = true;
+    }
+    unlock_Mutex(pool->mutex);
+    if (buffer)
+    {
+        memset(buffer, 0, size);
+        return buffer;
+    }
+    if (emptySlot)
+    {
+        pinnedIOBuffer ioBuffer;
+        if (SUCCESS == allocate_Pinned_IO_Buffer(size, &ioBuffer))
+        {
+            lock_Mutex(pool->mutex);
+            memcpy(&emptySlot->ioBuffer, &ioBuffer, sizeof(pinnedIOBuffer));
+            unlock_Mutex(pool->mutex);
+            return ioBuffer.buffer;
+        }
+        lock_Mutex(pool->mutex);
+        emptySlot->inUse = false;
+        unlock_Mutex(pool->mutex);
+    }
+    //no free slot or no pinned memory available on this system
+    return calloc_page_aligned(size, sizeof(uint8_t));
+}
+
+static void return_Pooled_Pinned_Buffer(alignedBufferPool pool, void *buffer)
+{
+    pinnedIOBuffer toFree;
+    uint8_t pinnedIter = 0;
+    uint8_t idleBuffers = 0;
+    bool found = false;
+    memset(&toFree, 0, sizeof(pinnedIOBuffer));
+    lock_Mutex(pool->mutex);
+    for (pinnedIter = 0; pinnedIter < ALIGNED_BUFFER_POOL_MAX_PINNED; ++pinnedIter)
+    {
+        if (pool->pinned[pinnedIter].ioBuffer.buffer && !pool->pinned[pinnedIter].inUse)
+        {
+            ++idleBuffers;
+        }
+    }
+    for (pinnedIter = 0; pinnedIter < ALIGNED_BUFFER_POOL_MAX_PINNED; ++pinnedIter)
+    {
+        if (pool->pinned[pinnedIter].inUse && C_CAST(void*, pool->pinned[pinnedIter].ioBuffer.buffer) == buffer)
+        {
+            found = true;
+            pool->pinned[pinnedIter].inUse = false;
+            if (idleBuffers >= ALIGNED_BUFFER_POOL_MAX_IDLE_PINNED)
+            {
+                memcpy(&toFree, &pool->pinned[pinnedIter].ioBuffer, sizeof(pinnedIOBuffer));
+                memset(&pool->pinned[pinnedIter].ioBuffer, 0, sizeof(pinnedIOBuffer));
+            }
+            break;
+        }
+    }
+    unlock_Mutex(pool->mutex);
+    if (found)
+    {
+        free_Pinned_IO_Buffer(&toFree);
+    }
+    else
+    {
+        //came from the calloc_page_aligned fallback
+        free_page_aligned(buffer);
+    }
+}
+
+void *get_Pooled_Buffer(alignedBufferPool pool, size_t size)
+{
+    void *buffer = NULL;
+    alignedBufferClass *sizeClass = NULL;
+    if (!pool || size == 0)
+    {
+        return NULL;
+    }
+    sizeClass = get_Aligned_Buffer_Class(pool, size);
+    if (!sizeClass)
+    {
+        return get_Pooled_Pinned_Buffer(pool, size);
+    }
+    lock_Mutex(pool->mutex);
+    if (sizeClass->numberFree > 0)
+    {
+        --sizeClass->numberFree;
+        buffer = sizeClass->freeList[sizeClass->numberFree];
+        sizeClass->freeList[sizeClass->numberFree] = NULL;
+    }
+    unlock_Mutex(pool->mutex);
+    if (buffer)
+    {
+        //only the part the caller asked for needs clearing. The rest of the buffer is never handed out.
+        memset(buffer, 0, size);
+    }
+    else
+    {
+        buffer = calloc_page_aligned(sizeClass->bufferSize, sizeof(uint8_t));
+    }
+    return buffer;
+}
+
+void return_Pooled_Buffer(alignedBufferPool pool, void *buffer, size_t size)
+{
+    alignedBufferClass *sizeClass = NULL;
+    if (!pool || !buffer)
+    {
+        return;
+    }
+    sizeClass = get_Aligned_Buffer_Class(pool, size);
+    if (!sizeClass)
+    {
+        return_Pooled_Pinned_Buffer(pool, buffer);
+        return;
+    }
+    lock_Mutex(pool->mutex);
+    if (sizeClass->numberFree < sizeClass->maxFree)
+    {
+        sizeClass->freeList[sizeClass->numberFree] = buffer;
+        ++sizeClass->numberFree;
+        buffer = NULL;
+    }
+    unlock_Mutex(pool->mutex);
+    safe_Free_page_aligned(buffer)
+}
+
+void destroy_Aligned_Buffer_Pool(alignedBufferPool *pool)
+{
+    uint8_t classIter = 0;
+    uint8_t pinnedIter = 0;
+    if (!pool || !*pool)
+    {
+        return;
+    }
+    for (classIter = 0; classIter < ALIGNED_BUFFER_POOL_SIZE_CLASSES; ++classIter)
+    {
+        if ((*pool)->classes[classIter].freeList)
+        {
+            while ((*pool)->classes[classIter].numberFree > 0)
+            {
+                --(*pool)->classes[classIter].numberFree;
+                safe_Free_page_aligned((*pool)->classes[classIter].freeList[(*pool)->classes[classIter].numberFree])
+            }
+            safe_Free((*pool)->classes[classIter].freeList)
+        }
+    }
+    for (pinnedIter = 0; pinnedIter < ALIGNED_BUFFER_POOL_MAX_PINNED; ++pinnedIter)
+    {
+        free_Pinned_IO_Buffer(&(*pool)->pinned[pinnedIter].ioBuffer);
+    }
+    if ((*pool)->mutex)
+    {
+        destroy_Mutex(&(*pool)->mutex);
+    }
+    safe_Free(*pool)
+}
+
 void nibble_Swap(uint8_t *byteToSwap)
 {
     *byteToSwap = C_CAST(uint8_t, ((*byteToSwap & 0x0F) << 4)) | C_CAST(uint8_t, ((*byteToSwap & 0xF0) >> 4));
@@ -1069,51 +1344,117 @@ uint64_t random_Range_64(uint64_t rangeMin, uint64_t rangeMax)
     }
 }
 
+//Copies the first patternLength bytes of ptrData over the rest of the buffer, doubling the amount copied each time.
+//This keeps each memcpy large so the C library's vectorized copy does the work instead of a byte or pattern sized loop.
+static void replicate_Pattern_In_Buffer(uint8_t *ptrData, size_t patternLength, size_t dataLength)
+{
+    size_t filled = patternLength;
+    while (filled < dataLength)
+    {
+        size_t copyLength = M_Min(filled, dataLength - filled);
+        memcpy(&ptrData[filled], ptrData, copyLength);
+        filled += copyLength;
+    }
+}
+
+//Fills the buffer with a pattern whose length evenly divides the vector register size using full width vector stores.
+//Returns false if the pattern length cannot be handled this way so the caller can fall back to replicating the pattern.
+static bool fill_Vector_Pattern(const uint8_t *pattern, size_t patternLength, uint8_t *ptrData, size_t dataLength)
+{
+#if defined (SEA_SIMD_AVX2)
+    #define SIMD_FILL_WIDTH 32
+#elif defined (SEA_SIMD_SSE2)
+    #define SIMD_FILL_WIDTH 16
+#else
+    #define SIMD_FILL_WIDTH 8
+#endif
+    uint8_t block[SIMD_FILL_WIDTH] = { 0 };
+    size_t offset = 0;
+    if (patternLength == 0 || patternLength > SIMD_FILL_WIDTH || SIMD_FILL_WIDTH % patternLength != 0)
+    {
+        return false;
+    }
+    for (size_t iter = 0; iter < SIMD_FILL_WIDTH; iter += patternLength)
+    {
+        memcpy(&block[iter], pattern, patternLength);
+    }
+#if defined (SEA_SIMD_AVX2)
+    {
+        __m256i vector = _mm256_loadu_si256(C_CAST(const __m256i*, block));
+        for (; offset + SIMD_FILL_WIDTH <= dataLength; offset += SIMD_FILL_WIDTH)
+        {
+            _mm256_storeu_si256(C_CAST(__m256i*, &ptrData[offset]), vector);
+        }
+    }
+#elif defined (SEA_SIMD_SSE2)
+    {
+        __m128i vector = _mm_loadu_si128(C_CAST(const __m128i*, block));
+        for (; offset + SIMD_FILL_WIDTH <= dataLength; offset += SIMD_FILL_WIDTH)
+        {
+            _mm_storeu_si128(C_CAST(__m128i*, &ptrData[offset]), vector);
+        }
+    }
+#else
+    {
+        uint64_t value = 0;
+        memcpy(&value, block, sizeof(uint64_t));
+        for (; offset + SIMD_FILL_WIDTH <= dataLength; offset += SIMD_FILL_WIDTH)
+        {
+            memcpy(&ptrData[offset], &value, sizeof(uint64_t));
+        }
+    }
+#endif
+    if (offset < dataLength)
+    {
+        memcpy(&ptrData[offset], block, dataLength - offset);
+    }
+    return true;
+#undef SIMD_FILL_WIDTH
+}
+
 int fill_Random_Pattern_In_Buffer(uint8_t *ptrData, uint32_t dataLength)
 {
-    size_t localPtrDataLen = ((dataLength + sizeof(uint32_t)) - 1) / sizeof(uint32_t);//round up to nearest uint32 amount
-    uint32_t* localPtr = C_CAST(uint32_t*, calloc(localPtrDataLen, sizeof(uint32_t)));
-    if (!localPtr)
+    uint32_t iter = 0;
+    if (!ptrData)
     {
-        return MEMORY_FAILURE;
+        return BAD_PARAMETER;
     }
     seed_32(C_CAST(uint32_t, time(NULL)));
-    for (uint32_t iter = 0; iter < (dataLength / sizeof(uint32_t)); ++iter)
+    for (; iter + sizeof(uint32_t) <= dataLength; iter += sizeof(uint32_t))
     {
-        localPtr[iter] = xorshiftplus32();
+        uint32_t randomValue = xorshiftplus32();
+        memcpy(&ptrData[iter], &randomValue, sizeof(uint32_t));
+    }
+    if (iter < dataLength)
+    {
+        uint32_t randomValue = xorshiftplus32();
+        memcpy(&ptrData[iter], &randomValue, dataLength - iter);
     }
-    memcpy(ptrData, localPtr, dataLength);//copy only the length of the original pointer since we may have overallocated and rounded up earlier.
-    safe_Free(localPtr)
     return SUCCESS;
 }
 
 int fill_Hex_Pattern_In_Buffer(uint32_t hexPattern, uint8_t *ptrData, uint32_t dataLength)
 {
-    size_t localPtrDataLen = ((dataLength + sizeof(uint32_t)) - 1) / sizeof(uint32_t);//round up to nearest uint32 amount
-    uint32_t *localPtr = C_CAST(uint32_t*, calloc(localPtrDataLen, sizeof(uint32_t)));
-    if (!localPtr)
-    {
-        return MEMORY_FAILURE;
-    }
-    for (uint32_t iter = 0; iter < (dataLength / sizeof(uint32_t)); ++iter)
+    if (!ptrData)
     {
-        localPtr[iter] = hexPattern;
+        return BAD_PARAMETER;
     }
-    memcpy(ptrData, localPtr, dataLength);//copy only the length of the original pointer since we may have overallocated and rounded up earlier.
-    safe_Free(localPtr)
+    fill_Vector_Pattern(C_CAST(const uint8_t*, &hexPattern), sizeof(uint32_t), ptrData, dataLength);
     return SUCCESS;
 }
 
 int fill_Incrementing_Pattern_In_Buffer(uint8_t incrementStartValue, uint8_t *ptrData, uint32_t dataLength)
 {
+    uint32_t firstPeriod = M_Min(dataLength, UINT32_C(256));//the pattern repeats every 256 bytes, so only generate it once
     if (!ptrData)
     {
         return BAD_PARAMETER;
     }
-    for (uint32_t iter = 0; iter < dataLength; ++iter)
+    for (uint32_t iter = 0; iter < firstPeriod; ++iter)
     {
         ptrData[iter] = incrementStartValue++;
     }
+    replicate_Pattern_In_Buffer(ptrData, firstPeriod, dataLength);
     return SUCCESS;
 }
 
@@ -1136,13 +1477,191 @@ int fill_Pattern_Buffer_Into_Another_Buffer(uint8_t *inPattern, uint32_t inpatte
     {
         return BAD_PARAMETER;
     }
-    for (uint32_t iter = 0; iter < dataLength; iter += inpatternLength)
+    if (!fill_Vector_Pattern(inPattern, inpatternLength, ptrData, dataLength))
     {
-        memcpy(&ptrData[iter], inPattern, M_Min(inpatternLength, dataLength - iter));
+        memcpy(ptrData, inPattern, M_Min(inpatternLength, dataLength));
+        replicate_Pattern_In_Buffer(ptrData, inpatternLength, dataLength);
     }
     return SUCCESS;
 }
 
+static uint8_t count_Set_Bits_64(uint64_t value)
+{
+#if defined (__GNUC__) || defined (__clang__)
+    return C_CAST(uint8_t, __builtin_popcountll(value));
+#else
+    value = value - ((value >> 1) & UINT64_C(0x5555555555555555));
+    value = (value & UINT64_C(0x3333333333333333)) + ((value >> 2) & UINT64_C(0x3333333333333333));
+    value = (value + (value >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+    return C_CAST(uint8_t, (value * UINT64_C(0x0101010101010101)) >> 56);
+#endif
+}
+
+//Skips over bytes that match using the widest compare available. Returns the offset of the first byte that is different, or length if everything matches.
+static size_t find_First_Difference(const uint8_t *bufferA, const uint8_t *bufferB, size_t length)
+{
+    size_t offset = 0;
+#if defined (SEA_SIMD_AVX2)
+    for (; offset + 32 <= length; offset += 32)
+    {
+        __m256i a = _mm256_loadu_si256(C_CAST(const __m256i*, &bufferA[offset]));
+        __m256i b = _mm256_loadu_si256(C_CAST(const __m256i*, &bufferB[offset]));
+        if (C_CAST(uint32_t, _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b))) != UINT32_MAX)
+        {
+            break;
+        }
+    }
+#endif
+#if defined (SEA_SIMD_SSE2)
+    for (; offset + 16 <= length; offset += 16)
+    {
+        __m128i a = _mm_loadu_si128(C_CAST(const __m128i*, &bufferA[offset]));
+        __m128i b = _mm_loadu_si128(C_CAST(const __m128i*, &bufferB[offset]));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF)
+        {
+            break;
+        }
+    }
+#endif
+    for (; offset + sizeof(uint64_t) <= length; offset += sizeof(uint64_t))
+    {
+        uint64_t a = 0, b = 0;
+        memcpy(&a, &bufferA[offset], sizeof(uint64_t));
+        memcpy(&b, &bufferB[offset], sizeof(uint64_t));
+        if (a != b)
+        {
+            break;
+        }
+    }
+    for (; offset < length; ++offset)
+    {
+        if (bufferA[offset] != bufferB[offset])
+        {
+            break;
+        }
+    }
+    return offset;
+}
+
+bool compare_Buffers(const uint8_t *expected, const uint8_t *actual, size_t length, ptrBufferCompareResult result)
+{
+    size_t firstDifference = 0;
+    if (result)
+    {
+        memset(result, 0, sizeof(bufferCompareResult));
+    }
+    if (!expected || !actual)
+    {
+        return false;
+    }
+    firstDifference = find_First_Difference(expected, actual, length);
+    if (firstDifference == length)
+    {
+        return true;
+    }
+    if (result)
+    {
+        size_t offset = firstDifference;
+        result->miscompare = true;
+        result->firstMiscompareOffset = firstDifference;
+        for (; offset + sizeof(uint64_t) <= length; offset += sizeof(uint64_t))
+        {
+            uint64_t a = 0, b = 0;
+            memcpy(&a, &expected[offset], sizeof(uint64_t));
+            memcpy(&b, &actual[offset], sizeof(uint64_t));
+            result->miscomparedBits += count_Set_Bits_64(a ^ b);
+        }
+        for (; offset < length; ++offset)
+        {
+            result->miscomparedBits += count_Set_Bits_64(C_CAST(uint64_t, expected[offset] ^ actual[offset]));
+        }
+    }
+    return false;
+}
+
+//CRC32C (Castagnoli) uses the hardware instruction on SSE4.2 or ARMv8 CRC when the compiler targets them, otherwise this table is used a byte at a time
+static const uint32_t crc32cTable[256] = {
+    UINT32_C(0x00000000), UINT32_C(0xF26B8303), UINT32_C(0xE13B70F7), UINT32_C(0x1350F3F4), UINT32_C(0xC79A971F), UINT32_C(0x35F1141C), UINT32_C(0x26A1E7E8), UINT32_C(0xD4CA64EB),
+    UINT32_C(0x8AD958CF), UINT32_C(0x78B2DBCC), UINT32_C(0x6BE22838), UINT32_C(0x9989AB3B), UINT32_C(0x4D43CFD0), UINT32_C(0xBF284CD3), UINT32_C(0xAC78BF27), UINT32_C(0x5E133C24),
+    UINT32_C(0x105EC76F), UINT32_C(0xE235446C), UINT32_C(0xF165B798), UINT32_C(0x030E349B), UINT32_C(0xD7C45070), UINT32_C(0x25AFD373), UINT32_C(0x36FF2087), UINT32_C(0xC494A384),
+    UINT32_C(0x9A879FA0), UINT32_C(0x68EC1CA3), UINT32_C(0x7BBCEF57), UINT32_C(0x89D76C54), UINT32_C(0x5D1D08BF), UINT32_C(0xAF768BBC), UINT32_C(0xBC267848), UINT32_C(0x4E4DFB4B),
+    UINT32_C(0x20BD8EDE), UINT32_C(0xD2D60DDD), UINT32_C(0xC186FE29), UINT32_C(0x33ED7D2A), UINT32_C(0xE72719C1), UINT32_C(0x154C9AC2), UINT32_C(0x061C6936), UINT32_C(0xF477EA35),
+    UINT32_C(0xAA64D611), UINT32_C(0x580F5512), UINT32_C(0x4B5FA6E6), UINT32_C(0xB93425E5), UINT32_C(0x6DFE410E), UINT32_C(0x9F95C20D), UINT32_C(0x8CC531F9), UINT32_C(0x7EAEB2FA),
+    UINT32_C(0x30E349B1), UINT32_C(0xC288CAB2), UINT32_C(0xD1D83946), UINT32_C(0x23B3BA45), UINT32_C(0xF779DEAE), UINT32_C(0x05125DAD), UINT32_C(0x1642AE59), UINT32_C(0xE4292D5A),
+    UINT32_C(0xBA3A117E), UINT32_C(0x4851927D), UINT32_C(0x5B016189), UINT32_C(0xA96AE28A), UINT32_C(0x7DA08661), UINT32_C(0x8FCB0562), UINT32_C(0x9C9BF696), UINT32_C(0x6EF07595),
+    UINT32_C(0x417B1DBC), UINT32_C(0xB3109EBF), UINT32_C(0xA0406D4B), UINT32_C(0x522BEE48), UINT32_C(0x86E18AA3), UINT32_C(0x748A09A0), UINT32_C(0x67DAFA54), UINT32_C(0x95B17957),
+    UINT32_C(0xCBA24573), UINT32_C(0x39C9C670), UINT32_C(0x2A993584), UINT32_C(0xD8F2B687), UINT32_C(0x0C38D26C), UINT32_C(0xFE53516F), UINT32_C(0xED03A29B), UINT32_C(0x1F682198),
+    UINT32_C(0x5125DAD3), UINT32_C(0xA34E59D0), UINT32_C(0xB01EAA24), UINT32_C(0x42752927), UINT32_C(0x96BF4DCC), UINT32_C(0x64D4CECF), UINT32_C(0x77843D3B), UINT32_C(0x85EFBE38),
+    UINT32_C(0xDBFC821C), UINT32_C(0x2997011F), UINT32_C(0x3AC7F2EB), UINT32_C(0xC8AC71E8), UINT32_C(0x1C661503), UINT32_C(0xEE0D9600), UINT32_C(0xFD5D65F4), UINT32_C(0x0F36E6F7),
+    UINT32_C(0x61C69362), UINT32_C(0x93AD1061), UINT32_C(0x80FDE395), UINT32_C(0x72966096), UINT32_C(0xA65C047D), UINT32_C(0x5437877E), UINT32_C(0x4767748A), UINT32_C(0xB50CF789),
+    UINT32_C(0xEB1FCBAD), UINT32_C(0x197448AE), UINT32_C(0x0A24BB5A), UINT32_C(0xF84F3859), UINT32_C(0x2C855CB2), UINT32_C(0xDEEEDFB1), UINT32_C(0xCDBE2C45), UINT32_C(0x3FD5AF46),
+    UINT32_C(0x7198540D), UINT32_C(0x83F3D70E), UINT32_C(0x90A324FA), UINT32_C(0x62C8A7F9), UINT32_C(0xB602C312), UINT32_C(0x44694011), UINT32_C(0x5739B3E5), UINT32_C(0xA55230E6),
+    UINT32_C(0xFB410CC2), UINT32_C(0x092A8FC1), UINT32_C(0x1A7A7C35), UINT32_C(0xE811FF36), UINT32_C(0x3CDB9BDD), UINT32_C(0xCEB018DE), UINT32_C(0xDDE0EB2A), UINT32_C(0x2F8B6829),
+    UINT32_C(0x82F63B78), UINT32_C(0x709DB87B), UINT32_C(0x63CD4B8F), UINT32_C(0x91A6C88C), UINT32_C(0x456CAC67), UINT32_C(0xB7072F64), UINT32_C(0xA457DC90), UINT32_C(0x563C5F93),
+    UINT32_C(0x082F63B7), UINT32_C(0xFA44E0B4), UINT32_C(0xE9141340), UINT32_C(0x1B7F9043), UINT32_C(0xCFB5F4A8), UINT32_C(0x3DDE77AB), UINT32_C(0x2E8E845F), UINT32_C(0xDCE5075C),
+    UINT32_C(0x92A8FC17), UINT32_C(0x60C37F14), UINT32_C(0x73938CE0), UINT32_C(0x81F80FE3), UINT32_C(0x55326B08), UINT32_C(0xA759E80B), UINT32_C(0xB4091BFF), UINT32_C(0x466298FC),
+    UINT32_C(0x1871A4D8), UINT32_C(0xEA1A27DB), UINT32_C(0xF94AD42F), UINT32_C(0x0B21572C), UINT32_C(0xDFEB33C7), UINT32_C(0x2D80B0C4), UINT32_C(0x3ED04330), UINT32_C(0xCCBBC033),
+    UINT32_C(0xA24BB5A6), UINT32_C(0x502036A5), UINT32_C(0x4370C551), UINT32_C(0xB11B4652), UINT32_C(0x65D122B9), UINT32_C(0x97BAA1BA), UINT32_C(0x84EA524E), UINT32_C(0x7681D14D),
+    UINT32_C(0x2892ED69), UINT32_C(0xDAF96E6A), UINT32_C(0xC9A99D9E), UINT32_C(0x3BC21E9D), UINT32_C(0xEF087A76), UINT32_C(0x1D63F975), UINT32_C(0x0E330A81), UINT32_C(0xFC588982),
+    UINT32_C(0xB21572C9), UINT32_C(0x407EF1CA), UINT32_C(0x532E023E), UINT32_C(0xA145813D), UINT32_C(0x758FE5D6), UINT32_C(0x87E466D5), UINT32_C(0x94B49521), UINT32_C(0x66DF1622),
+    UINT32_C(0x38CC2A06), UINT32_C(0xCAA7A905), UINT32_C(0xD9F75AF1), UINT32_C(0x2B9CD9F2), UINT32_C(0xFF56BD19), UINT32_C(0x0D3D3E1A), UINT32_C(0x1E6DCDEE), UINT32_C(0xEC064EED),
+    UINT32_C(0xC38D26C4), UINT32_C(0x31E6A5C7), UINT32_C(0x22B65633), UINT32_C(0xD0DDD530), UINT32_C(0x0417B1DB), UINT32_C(0xF67C32D8), UINT32_C(0xE52CC12C), UINT32_C(0x1747422F),
+    UINT32_C(0x49547E0B), UINT32_C(0xBB3FFD08), UINT32_C(0xA86F0EFC), UINT32_C(0x5A048DFF), UINT32_C(0x8ECEE914), UINT32_C(0x7CA56A17), UINT32_C(0x6FF599E3), UINT32_C(0x9D9E1AE0),
+    UINT32_C(0xD3D3E1AB), UINT32_C(0x21B862A8), UINT32_C(0x32E8915C), UINT32_C(0xC083125F), UINT32_C(0x144976B4), UINT32_C(0xE622F5B7), UINT32_C(0xF5720643), UINT32_C(0x07198540),
+    UINT32_C(0x590AB964), UINT32_C(0xAB613A67), UINT32_C(0xB831C993), UINT32_C(0x4A5A4A90), UINT32_C(0x9E902E7B), UINT32_C(0x6CFBAD78), UINT32_C(0x7FAB5E8C), UINT32_C(0x8DC0DD8F),
+    UINT32_C(0xE330A81A), UINT32_C(0x115B2B19), UINT32_C(0x020BD8ED), UINT32_C(0xF0605BEE), UINT32_C(0x24AA3F05), UINT32_C(0xD6C1BC06), UINT32_C(0xC5914FF2), UINT32_C(0x37FACCF1),
+    UINT32_C(0x69E9F0D5), UINT32_C(0x9B8273D6), UINT32_C(0x88D28022), UINT32_C(0x7AB90321), UINT32_C(0xAE7367CA), UINT32_C(0x5C18E4C9), UINT32_C(0x4F48173D), UINT32_C(0xBD23943E),
+    UINT32_C(0xF36E6F75), UINT32_C(0x0105EC76), UINT32_C(0x12551F82), UINT32_C(0xE03E9C81), UINT32_C(0x34F4F86A), UINT32_C(0xC69F7B69), UINT32_C(0xD5CF889D), UINT32_C(0x27A40B9E),
+    UINT32_C(0x79B737BA), UINT32_C(0x8BDCB4B9), UINT32_C(0x988C474D), UINT32_C(0x6AE7C44E), UINT32_C(0xBE2DA0A5), UINT32_C(0x4C4623A6), UINT32_C(0x5F16D052), UINT32_C(0xAD7D5351)
+};
+
+uint32_t crc32c(uint32_t crc, const uint8_t *data, size_t length)
+{
+    size_t offset = 0;
+    crc = ~crc;
+    if (!data)
+    {
+        return ~crc;
+    }
+#if defined (SEA_CRC32C_SSE42)
+    #if defined (_M_X64) || defined (_M_AMD64) || defined (__x86_64__)
+    for (; offset + sizeof(uint64_t) <= length; offset += sizeof(uint64_t))
+    {
+        uint64_t word = 0;
+        memcpy(&word, &data[offset], sizeof(uint64_t));
+        crc = C_CAST(uint32_t, _mm_crc32_u64(crc, word));
+    }
+    #endif
+    for (; offset + sizeof(uint32_t) <= length; offset += sizeof(uint32_t))
+    {
+        uint32_t word = 0;
+        memcpy(&word, &data[offset], sizeof(uint32_t));
+        crc = _mm_crc32_u32(crc, word);
+    }
+    for (; offset < length; ++offset)
+    {
+        crc = _mm_crc32_u8(crc, data[offset]);
+    }
+#elif defined (SEA_CRC32C_ARM)
+    for (; offset + sizeof(uint64_t) <= length; offset += sizeof(uint64_t))
+    {
+        uint64_t word = 0;
+        memcpy(&word, &data[offset], sizeof(uint64_t));
+        crc = __crc32cd(crc, word);
+    }
+    for (; offset < length; ++offset)
+    {
+        crc = __crc32cb(crc, data[offset]);
+    }
+#else
+    for (; offset < length; ++offset)
+    {
+        crc = crc32cTable[(crc ^ data[offset]) & 0xFF] ^ (crc >> 8);
+    }
+#endif
+    return ~crc;
+}
+
 double convert_128bit_to_double(uint8_t * pData)
 {
     double result = 0;
@@ -1812,3 +2331,468 @@ char* common_String_Concat_Len(char* destination, size_t destinationSizeBytes, c
     }
     return NULL;
 }
+
+int init_Structured_Writer(ptrStructuredWriter writer, eOutputFormat format, FILE *output)
+{
+    if (!writer || !output)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(writer, 0, sizeof(structuredWriter));
+    writer->format = format;
+    writer->output = output;
+    switch (format)
+    {
+    case SEAC_OUTPUT_TEXT:
+        break;
+    case SEAC_OUTPUT_JSON:
+        fprintf(output, "{");
+        break;
+    case SEAC_OUTPUT_CSV:
+        fprintf(output, "Field,Value\n");
+        break;
+    case SEAC_OUTPUT_XML:
+        fprintf(output, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<openSeaChest>\n");
+        break;
+    case SEAC_OUTPUT_RAW:
+    default:
+        return NOT_SUPPORTED;
+    }
+    return SUCCESS;
+}
+
+static bool structured_In_Array(ptrStructuredWriter writer)
+{
+    return writer->depth > 0 && writer->isArray[writer->depth - 1];
+}
+
+static uint32_t* structured_Item_Count(ptrStructuredWriter writer)
+{
+    return writer->depth > 0 ? &writer->itemCount[writer->depth - 1] : &writer->rootItemCount;
+}
+
+static void structured_Indent(ptrStructuredWriter writer, uint8_t depth)
+{
+    uint8_t indentIter = 0;
+    for (indentIter = 0; indentIter < depth; ++indentIter)
+    {
+        fprintf(writer->output, "    ");
+    }
+}
+
+static void write_JSON_Escaped_String(FILE *output, const char *string)
+{
+    fputc('"', output);
+    for (; string && *string; ++string)
+    {
+        unsigned char character = C_CAST(unsigned char, *string);
+        switch (character)
+        {
+        case '"':
+            fprintf(output, "\\\"");
+            break;
+        case '\\':
+            fprintf(output, "\\\\");
+            break;
+        case '\n':
+            fprintf(output, "\\n");
+            break;
+        case '\r':
+            fprintf(output, "\\r");
+            break;
+        case '\t':
+            fprintf(output, "\\t");
+            break;
+        default:
+            if (character < 0x20)
+            {
+                fprintf(output, "\\u%04X", character);
+            }
+            else
+            {
+                fputc(character, output);
+            }
+            break;
+        }
+    }
+    fputc('"', output);
+}
+
+static void write_CSV_Field(FILE *output, const char *string)
+{
+    if (string && strpbrk(string, ",\"\r\n"))
+    {
+        fputc('"', output);
+        for (; *string; ++string)
+        {
+            if (*string == '"')
+            {
+                fputc('"', output);
+            }
+            fputc(*string, output);
+        }
+        fputc('"', output);
+    }
+    else if (string)
+    {
+        fprintf(output, "%s", string);
+    }
+}
+
+static void write_XML_Escaped_String(FILE *output, const char *string)
+{
+    for (; string && *string; ++string)
+    {
+        switch (*string)
+        {
+        case '<':
+            fprintf(output, "&lt;");
+            break;
+        case '>':
+            fprintf(output, "&gt;");
+            break;
+        case '&':
+            fprintf(output, "&amp;");
+            break;
+        case '"':
+            fprintf(output, "&quot;");
+            break;
+        default:
+            fputc(*string, output);
+            break;
+        }
+    }
+}
+
+static void write_XML_Element_Name(FILE *output, const char *name)
+{
+    if (!name || !*name)
+    {
+        fprintf(output, "item");
+        return;
+    }
+    if (!isalpha(C_CAST(unsigned char, *name)) && *name != '_')
+    {
+        fputc('_', output);
+    }
+    for (; *name; ++name)
+    {
+        if (isalnum(C_CAST(unsigned char, *name)) || *name == '_' || *name == '-' || *name == '.')
+        {
+            fputc(*name, output);
+        }
+        else
+        {
+            fputc('_', output);
+        }
+    }
+}
+
+//CSV field names are the path of every open object/array. Items in arrays use their index.
+static void write_CSV_Path(ptrStructuredWriter writer, const char *name)
+{
+    char indexString[11] = { 0 };
+    size_t buildLength = 0;
+    uint8_t depthIter = 0;
+    char *path = NULL;
+    for (depthIter = 0; depthIter < writer->depth; ++depthIter)
+    {
+        buildLength += (writer->names[depthIter] ? strlen(writer->names[depthIter]) : 10) + 1;
+    }
+    buildLength += (name ? strlen(name) : 10) + 1;
+    path = C_CAST(char*, calloc(buildLength, sizeof(char)));
+    if (!path)
+    {
+        return;
+    }
+    for (depthIter = 0; depthIter <= writer->depth; ++depthIter)
+    {
+        const char *part = depthIter < writer->depth ? writer->names[depthIter] : name;
+        bool parentIsArray = depthIter > 0 && writer->isArray[depthIter - 1];
+        if (parentIsArray)
+        {
+            //the item's name is its position in the array. Items that are objects have already been counted.
+            uint32_t index = writer->itemCount[depthIter - 1];
+            if (depthIter < writer->depth && index > 0)
+            {
+                --index;
+            }
+            snprintf(indexString, sizeof(indexString), "%" PRIu32, index);
+            part = indexString;
+        }
+        if (depthIter > 0)
+        {
+            common_String_Concat(path, buildLength, ".");
+        }
+        common_String_Concat(path, buildLength, part ? part : "");
+    }
+    write_CSV_Field(writer->output, path);
+    safe_Free(path)
+}
+
+//Writes what comes before a name in the current format and counts the item
+static void begin_Structured_Item(ptrStructuredWriter writer, const char *name)
+{
+    uint32_t *itemCount = structured_Item_Count(writer);
+    bool inArray = structured_In_Array(writer);
+    switch (writer->format)
+    {
+    case SEAC_OUTPUT_TEXT:
+        structured_Indent(writer, writer->depth);
+        if (inArray)
+        {
+            fprintf(writer->output, "[%" PRIu32 "]: ", *itemCount);
+        }
+        else
+        {
+            fprintf(writer->output, "%s: ", name ? name : "");
+        }
+        break;
+    case SEAC_OUTPUT_JSON:
+        if (*itemCount > 0)
+        {
+            fputc(',', writer->output);
+        }
+        fputc('\n', writer->output);
+        structured_Indent(writer, writer->depth + 1);
+        if (!inArray)
+        {
+            write_JSON_Escaped_String(writer->output, name);
+            fprintf(writer->output, ": ");
+        }
+        break;
+    case SEAC_OUTPUT_XML:
+        structured_Indent(writer, writer->depth + 1);
+        fputc('<', writer->output);
+        write_XML_Element_Name(writer->output, inArray ? NULL : name);
+        fputc('>', writer->output);
+        break;
+    default:
+        break;
+    }
+}
+
+static void end_Structured_Value(ptrStructuredWriter writer, const char *name)
+{
+    bool inArray = structured_In_Array(writer);
+    switch (writer->format)
+    {
+    case SEAC_OUTPUT_TEXT:
+    case SEAC_OUTPUT_CSV:
+        fputc('\n', writer->output);
+        break;
+    case SEAC_OUTPUT_XML:
+        fprintf(writer->output, "</");
+        write_XML_Element_Name(writer->output, inArray ? NULL : name);
+        fprintf(writer->output, ">\n");
+        break;
+    default:
+        break;
+    }
+    ++(*structured_Item_Count(writer));
+}
+
+static void begin_Structured_Container(ptrStructuredWriter writer, const char *name, bool isArray)
+{
+    if (!writer || writer->overflow)
+    {
+        return;
+    }
+    if (writer->depth >= STRUCTURED_WRITER_MAX_DEPTH)
+    {
+        writer->overflow = true;
+        return;
+    }
+    if (writer->format != SEAC_OUTPUT_CSV)
+    {
+        begin_Structured_Item(writer, name);
+    }
+    switch (writer->format)
+    {
+    case SEAC_OUTPUT_TEXT:
+        fputc('\n', writer->output);
+        break;
+    case SEAC_OUTPUT_JSON:
+        fputc(isArray ? '[' : '{', writer->output);
+        break;
+    case SEAC_OUTPUT_XML:
+        fputc('\n', writer->output);
+        break;
+    default:
+        break;
+    }
+    ++(*structured_Item_Count(writer));
+    writer->names[writer->depth] = structured_In_Array(writer) ? NULL : name;
+    writer->isArray[writer->depth] = isArray;
+    writer->itemCount[writer->depth] = 0;
+    ++(writer->depth);
+}
+
+static void end_Structured_Container(ptrStructuredWriter writer)
+{
+    if (!writer || writer->overflow || writer->depth == 0)
+    {
+        return;
+    }
+    --(writer->depth);
+    switch (writer->format)
+    {
+    case SEAC_OUTPUT_JSON:
+        if (writer->itemCount[writer->depth] > 0)
+        {
+            fputc('\n', writer->output);
+            structured_Indent(writer, writer->depth + 1);
+        }
+        fputc(writer->isArray[writer->depth] ? ']' : '}', writer->output);
+        break;
+    case SEAC_OUTPUT_XML:
+        structured_Indent(writer, writer->depth + 1);
+        fprintf(writer->output, "</");
+        write_XML_Element_Name(writer->output, writer->names[writer->depth]);
+        fprintf(writer->output, ">\n");
+        break;
+    default:
+        break;
+    }
+}
+
+void begin_Structured_Object(ptrStructuredWriter writer, const char *name)
+{
+    begin_Structured_Container(writer, name, false);
+}
+
+void end_Structured_Object(ptrStructuredWriter writer)
+{
+    end_Structured_Container(writer);
+}
+
+void begin_Structured_Array(ptrStructuredWriter writer, const char *name)
+{
+    begin_Structured_Container(writer, name, true);
+}
+
+void end_Structured_Array(ptrStructuredWriter writer)
+{
+    end_Structured_Container(writer);
+}
+
+//Numbers and bools are written the same way in every format. Only strings need quoting/escaping.
+static void write_Structured_Plain_Value(ptrStructuredWriter writer, const char *name, const char *value)
+{
+    if (!writer || writer->overflow)
+    {
+        return;
+    }
+    if (writer->format == SEAC_OUTPUT_CSV)
+    {
+        write_CSV_Path(writer, name);
+        fputc(',', writer->output);
+    }
+    else
+    {
+        begin_Structured_Item(writer, name);
+    }
+    fprintf(writer->output, "%s", value);
+    end_Structured_Value(writer, name);
+}
+
+void write_Structured_String(ptrStructuredWriter writer, const char *name, const char *value)
+{
+    if (!writer || writer->overflow)
+    {
+        return;
+    }
+    if (writer->format == SEAC_OUTPUT_CSV)
+    {
+        write_CSV_Path(writer, name);
+        fputc(',', writer->output);
+        write_CSV_Field(writer->output, value);
+    }
+    else
+    {
+        begin_Structured_Item(writer, name);
+        switch (writer->format)
+        {
+        case SEAC_OUTPUT_JSON:
+            if (value)
+            {
+                write_JSON_Escaped_String(writer->output, value);
+            }
+            else
+            {
+                fprintf(writer->output, "null");
+            }
+            break;
+        case SEAC_OUTPUT_XML:
+            write_XML_Escaped_String(writer->output, value);
+            break;
+        case SEAC_OUTPUT_TEXT:
+        default:
+            fprintf(writer->output, "%s", value ? value : "");
+            break;
+        }
+    }
+    end_Structured_Value(writer, name);
+}
+
+void write_Structured_Unsigned(ptrStructuredWriter writer, const char *name, uint64_t value)
+{
+    char valueString[21] = { 0 };
+    snprintf(valueString, sizeof(valueString), "%" PRIu64, value);
+    write_Structured_Plain_Value(writer, name, valueString);
+}
+
+void write_Structured_Signed(ptrStructuredWriter writer, const char *name, int64_t value)
+{
+    char valueString[21] = { 0 };
+    snprintf(valueString, sizeof(valueString), "%" PRId64, value);
+    write_Structured_Plain_Value(writer, name, valueString);
+}
+
+void write_Structured_Double(ptrStructuredWriter writer, const char *name, double value)
+{
+    char valueString[32] = { 0 };
+    if (writer && writer->format == SEAC_OUTPUT_JSON && !isfinite(value))
+    {
+        //JSON has no nan or inf, so write these the same as a value that is not available
+        write_Structured_Plain_Value(writer, name, "null");
+        return;
+    }
+    snprintf(valueString, sizeof(valueString), "%.6g", value);
+    write_Structured_Plain_Value(writer, name, valueString);
+}
+
+void write_Structured_Bool(ptrStructuredWriter writer, const char *name, bool value)
+{
+    write_Structured_Plain_Value(writer, name, value ? "true" : "false");
+}
+
+int finish_Structured_Writer(ptrStructuredWriter writer)
+{
+    if (!writer || !writer->output)
+    {
+        return BAD_PARAMETER;
+    }
+    writer->overflow = false;
+    while (writer->depth > 0)
+    {
+        end_Structured_Container(writer);
+    }
+    switch (writer->format)
+    {
+    case SEAC_OUTPUT_JSON:
+        fprintf(writer->output, "%s}\n", writer->rootItemCount > 0 ? "\n" : "");
+        break;
+    case SEAC_OUTPUT_XML:
+        fprintf(writer->output, "</openSeaChest>\n");
+        break;
+    default:
+        break;
+    }
+    fflush(writer->output);
+    if (ferror(writer->output))
+    {
+        return ERROR_WRITING_FILE;
+    }
+    return SUCCESS;
+}
@@ -33,6 +33,9 @@
 #include <dirent.h>//for scan dir in linux to get os name. We can move ifdef this if it doesn't work for other OS's
 #include <pwd.h>
 #include <grp.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 
 //freeBSD doesn't have the 64 versions of these functions...so I'm defining things this way to make it work. - TJE
 #if defined(__FreeBSD__)
@@ -1003,3 +1006,284 @@ int get_Current_User_Name(char **userName)
     return ret;
 }
 
+
+struct _seaThread
+{
+    pthread_t thread;
+    seaThreadRoutine routine;
+    void *context;
+};
+
+static void* sea_Thread_Start(void *param)
+{
+    seaThread thread = C_CAST(seaThread, param);
+    thread->routine(thread->context);
+    return NULL;
+}
+
+int create_Thread(seaThread *thread, seaThreadRoutine routine, void *context)
+{
+    if (!thread || !routine)
+    {
+        return BAD_PARAMETER;
+    }
+    *thread = C_CAST(seaThread, calloc(1, sizeof(struct _seaThread)));
+    if (!*thread)
+    {
+        return MEMORY_FAILURE;
+    }
+    (*thread)->routine = routine;
+    (*thread)->context = context;
+    if (0 != pthread_create(&(*thread)->thread, NULL, sea_Thread_Start, *thread))
+    {
+        safe_Free(*thread)
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+int join_Thread(seaThread *thread)
+{
+    int ret = SUCCESS;
+    if (!thread || !*thread)
+    {
+        return BAD_PARAMETER;
+    }
+    if (0 != pthread_join((*thread)->thread, NULL))
+    {
+        ret = FAILURE;
+    }
+    safe_Free(*thread)
+    return ret;
+}
+
+struct _seaMutex
+{
+    pthread_mutex_t mutex;
+};
+
+int create_Mutex(seaMutex *mutex)
+{
+    if (!mutex)
+    {
+        return BAD_PARAMETER;
+    }
+    *mutex = C_CAST(seaMutex, calloc(1, sizeof(struct _seaMutex)));
+    if (!*mutex)
+    {
+        return MEMORY_FAILURE;
+    }
+    if (0 != pthread_mutex_init(&(*mutex)->mutex, NULL))
+    {
+        safe_Free(*mutex)
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+void lock_Mutex(seaMutex mutex)
+{
+    if (mutex)
+    {
+        pthread_mutex_lock(&mutex->mutex);
+    }
+}
+
+void unlock_Mutex(seaMutex mutex)
+{
+    if (mutex)
+    {
+        pthread_mutex_unlock(&mutex->mutex);
+    }
+}
+
+void destroy_Mutex(seaMutex *mutex)
+{
+    if (mutex && *mutex)
+    {
+        pthread_mutex_destroy(&(*mutex)->mutex);
+        safe_Free(*mutex)
+    }
+}
+
+//A mutex and condition variable rather than sem_t since macOS does not support unnamed POSIX semaphores
+struct _seaSemaphore
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t condition;
+    uint32_t count;
+};
+
+int create_Semaphore(seaSemaphore *semaphore, uint32_t initialCount)
+{
+    if (!semaphore)
+    {
+        return BAD_PARAMETER;
+    }
+    *semaphore = C_CAST(seaSemaphore, calloc(1, sizeof(struct _seaSemaphore)));
+    if (!*semaphore)
+    {
+        return MEMORY_FAILURE;
+    }
+    if (0 != pthread_mutex_init(&(*semaphore)->mutex, NULL))
+    {
+        safe_Free(*semaphore)
+        return FAILURE;
+    }
+    if (0 != pthread_cond_init(&(*semaphore)->condition, NULL))
+    {
+        pthread_mutex_destroy(&(*semaphore)->mutex);
+        safe_Free(*semaphore)
+        return FAILURE;
+    }
+    (*semaphore)->count = initialCount;
+    return SUCCESS;
+}
+
+void wait_Semaphore(seaSemaphore semaphore)
+{
+    if (semaphore)
+    {
+        pthread_mutex_lock(&semaphore->mutex);
+        while (semaphore->count == 0)
+        {
+            pthread_cond_wait(&semaphore->condition, &semaphore->mutex);
+        }
+        --semaphore->count;
+        pthread_mutex_unlock(&semaphore->mutex);
+    }
+}
+
+void post_Semaphore(seaSemaphore semaphore)
+{
+    if (semaphore)
+    {
+        pthread_mutex_lock(&semaphore->mutex);
+        ++semaphore->count;
+        pthread_cond_signal(&semaphore->condition);
+        pthread_mutex_unlock(&semaphore->mutex);
+    }
+}
+
+void destroy_Semaphore(seaSemaphore *semaphore)
+{
+    if (semaphore && *semaphore)
+    {
+        pthread_cond_destroy(&(*semaphore)->condition);
+        pthread_mutex_destroy(&(*semaphore)->mutex);
+        safe_Free(*semaphore)
+    }
+}
+
+int map_File_Read_Only(const char *fileName, ptrReadOnlyFileMapping mapping)
+{
+    int fd = -1;
+    struct stat st;
+    void *data = NULL;
+    if (!fileName || !mapping)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(mapping, 0, sizeof(readOnlyFileMapping));
+    memset(&st, 0, sizeof(struct stat));
+    fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+        return FILE_OPEN_ERROR;
+    }
+    if (0 != fstat(fd, &st) || st.st_size <= 0)
+    {
+        close(fd);
+        return INVALID_LENGTH;
+    }
+    data = mmap(NULL, C_CAST(size_t, st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);//the mapping holds its own reference to the file
+    if (data == MAP_FAILED)
+    {
+        return FAILURE;
+    }
+    mapping->data = C_CAST(const uint8_t*, data);
+    mapping->length = C_CAST(size_t, st.st_size);
+    return SUCCESS;
+}
+
+void unmap_File(ptrReadOnlyFileMapping mapping)
+{
+    if (mapping && mapping->data)
+    {
+        munmap(C_CAST(void*, C_CAST(uintptr_t, mapping->data)), mapping->length);
+        memset(mapping, 0, sizeof(readOnlyFileMapping));
+    }
+}
+
+#if !defined (MAP_ANONYMOUS) && defined (MAP_ANON)
+    #define MAP_ANONYMOUS MAP_ANON
+#endif
+
+int allocate_Pinned_IO_Buffer(size_t size, ptrPinnedIOBuffer ioBuffer)
+{
+    void *data = MAP_FAILED;
+    size_t hugeSize = 0;
+    if (!ioBuffer || size == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(ioBuffer, 0, sizeof(pinnedIOBuffer));
+    hugeSize = ((size + PINNED_IO_BUFFER_HUGE_PAGE_SIZE - 1) / PINNED_IO_BUFFER_HUGE_PAGE_SIZE) * PINNED_IO_BUFFER_HUGE_PAGE_SIZE;
+    #if defined (MAP_HUGETLB)
+    //only works when hugepages have been reserved (vm.nr_hugepages), so this is expected to fail on most systems
+    data = mmap(NULL, hugeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (data != MAP_FAILED)
+    {
+        ioBuffer->hugePages = true;
+    }
+    #endif
+    if (data == MAP_FAILED)
+    {
+        //Map one extra hugepage, then trim both ends so that what is left starts on a hugepage boundary. Transparent hugepages can only
+        //back whole aligned 2MiB ranges.
+        uint8_t *mapped = C_CAST(uint8_t*, mmap(NULL, hugeSize + PINNED_IO_BUFFER_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        size_t leading = 0;
+        if (C_CAST(void*, mapped) == MAP_FAILED)
+        {
+            return MEMORY_FAILURE;
+        }
+        leading = (PINNED_IO_BUFFER_HUGE_PAGE_SIZE - (C_CAST(uintptr_t, mapped) % PINNED_IO_BUFFER_HUGE_PAGE_SIZE)) % PINNED_IO_BUFFER_HUGE_PAGE_SIZE;
+        if (leading > 0)
+        {
+            munmap(mapped, leading);
+        }
+        if (leading < PINNED_IO_BUFFER_HUGE_PAGE_SIZE)
+        {
+            munmap(mapped + leading + hugeSize, PINNED_IO_BUFFER_HUGE_PAGE_SIZE - leading);
+        }
+        data = mapped + leading;
+        #if defined (MADV_HUGEPAGE)
+        if (0 == madvise(data, hugeSize, MADV_HUGEPAGE))
+        {
+            ioBuffer->hugePages = true;
+        }
+        #endif
+    }
+    //locking also faults in every page now instead of during the first command
+    if (0 == mlock(data, hugeSize))
+    {
+        ioBuffer->locked = true;
+    }
+    ioBuffer->buffer = C_CAST(uint8_t*, data);
+    ioBuffer->size = hugeSize;
+    return SUCCESS;
+}
+
+void free_Pinned_IO_Buffer(ptrPinnedIOBuffer ioBuffer)
+{
+    if (ioBuffer && ioBuffer->buffer)
+    {
+        if (ioBuffer->locked)
+        {
+            munlock(ioBuffer->buffer, ioBuffer->size);
+        }
+        munmap(ioBuffer->buffer, ioBuffer->size);
+        memset(ioBuffer, 0, sizeof(pinnedIOBuffer));
+    }
+}
@@ -699,3 +699,108 @@ int get_Current_User_Name(char **userName)
     }
     return ret;
 }
+
+//UEFI applications are single threaded, so threads and semaphores are not available and the mutex functions do nothing.
+int create_Thread(seaThread *thread, M_ATTR_UNUSED seaThreadRoutine routine, M_ATTR_UNUSED void *context)
+{
+    if (thread)
+    {
+        *thread = NULL;
+    }
+    return NOT_SUPPORTED;
+}
+
+int join_Thread(M_ATTR_UNUSED seaThread *thread)
+{
+    return BAD_PARAMETER;
+}
+
+int create_Mutex(seaMutex *mutex)
+{
+    if (!mutex)
+    {
+        return BAD_PARAMETER;
+    }
+    *mutex = NULL;
+    return SUCCESS;
+}
+
+void lock_Mutex(M_ATTR_UNUSED seaMutex mutex)
+{
+    return;
+}
+
+void unlock_Mutex(M_ATTR_UNUSED seaMutex mutex)
+{
+    return;
+}
+
+void destroy_Mutex(seaMutex *mutex)
+{
+    if (mutex)
+    {
+        *mutex = NULL;
+    }
+}
+
+int create_Semaphore(seaSemaphore *semaphore, M_ATTR_UNUSED uint32_t initialCount)
+{
+    if (!semaphore)
+    {
+        return BAD_PARAMETER;
+    }
+    *semaphore = NULL;
+    return NOT_SUPPORTED;
+}
+
+void wait_Semaphore(M_ATTR_UNUSED seaSemaphore semaphore)
+{
+    return;
+}
+
+void post_Semaphore(M_ATTR_UNUSED seaSemaphore semaphore)
+{
+    return;
+}
+
+void destroy_Semaphore(seaSemaphore *semaphore)
+{
+    if (semaphore)
+    {
+        *semaphore = NULL;
+    }
+}
+
+int map_File_Read_Only(M_ATTR_UNUSED const char *fileName, ptrReadOnlyFileMapping mapping)
+{
+    if (mapping)
+    {
+        memset(mapping, 0, sizeof(readOnlyFileMapping));
+    }
+    return NOT_SUPPORTED;
+}
+
+void unmap_File(ptrReadOnlyFileMapping mapping)
+{
+    if (mapping)
+    {
+        memset(mapping, 0, sizeof(readOnlyFileMapping));
+    }
+}
+
+int allocate_Pinned_IO_Buffer(M_ATTR_UNUSED size_t size, ptrPinnedIOBuffer ioBuffer)
+{
+    if (ioBuffer)
+    {
+        memset(ioBuffer, 0, sizeof(pinnedIOBuffer));
+    }
+    return NOT_SUPPORTED;
+}
+
+void free_Pinned_IO_Buffer(ptrPinnedIOBuffer ioBuffer)
+{
+    if (ioBuffer)
+    {
+        memset(ioBuffer, 0, sizeof(pinnedIOBuffer));
+    }
+}
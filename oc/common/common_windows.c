@@ -1193,3 +1193,255 @@ int get_Current_User_Name(char **userName)
     }
     return ret;
 }
+
+struct _seaThread
+{
+    HANDLE thread;
+    seaThreadRoutine routine;
+    void *context;
+};
+
+static DWORD WINAPI sea_Thread_Start(LPVOID param)
+{
+    seaThread thread = C_CAST(seaThread, param);
+    thread->routine(thread->context);
+    return 0;
+}
+
+int create_Thread(seaThread *thread, seaThreadRoutine routine, void *context)
+{
+    if (!thread || !routine)
+    {
+        return BAD_PARAMETER;
+    }
+    *thread = C_CAST(seaThread, calloc(1, sizeof(struct _seaThread)));
+    if (!*thread)
+    {
+        return MEMORY_FAILURE;
+    }
+    (*thread)->routine = routine;
+    (*thread)->context = context;
+    (*thread)->thread = CreateThread(NULL, 0, sea_Thread_Start, *thread, 0, NULL);
+    if (!(*thread)->thread)
+    {
+        safe_Free(*thread)
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+int join_Thread(seaThread *thread)
+{
+    int ret = SUCCESS;
+    if (!thread || !*thread)
+    {
+        return BAD_PARAMETER;
+    }
+    if (WAIT_OBJECT_0 != WaitForSingleObject((*thread)->thread, INFINITE))
+    {
+        ret = FAILURE;
+    }
+    CloseHandle((*thread)->thread);
+    safe_Free(*thread)
+    return ret;
+}
+
+struct _seaMutex
+{
+    CRITICAL_SECTION criticalSection;
+};
+
+int create_Mutex(seaMutex *mutex)
+{
+    if (!mutex)
+    {
+        return BAD_PARAMETER;
+    }
+    *mutex = C_CAST(seaMutex, calloc(1, sizeof(struct _seaMutex)));
+    if (!*mutex)
+    {
+        return MEMORY_FAILURE;
+    }
+    InitializeCriticalSection(&(*mutex)->criticalSection);
+    return SUCCESS;
+}
+
+void lock_Mutex(seaMutex mutex)
+{
+    if (mutex)
+    {
+        EnterCriticalSection(&mutex->criticalSection);
+    }
+}
+
+void unlock_Mutex(seaMutex mutex)
+{
+    if (mutex)
+    {
+        LeaveCriticalSection(&mutex->criticalSection);
+    }
+}
+
+void destroy_Mutex(seaMutex *mutex)
+{
+    if (mutex && *mutex)
+    {
+        DeleteCriticalSection(&(*mutex)->criticalSection);
+        safe_Free(*mutex)
+    }
+}
+
+struct _seaSemaphore
+{
+    HANDLE semaphore;
+};
+
+int create_Semaphore(seaSemaphore *semaphore, uint32_t initialCount)
+{
+    if (!semaphore || initialCount > MAXLONG)
+    {
+        return BAD_PARAMETER;
+    }
+    *semaphore = C_CAST(seaSemaphore, calloc(1, sizeof(struct _seaSemaphore)));
+    if (!*semaphore)
+    {
+        return MEMORY_FAILURE;
+    }
+    (*semaphore)->semaphore = CreateSemaphore(NULL, C_CAST(LONG, initialCount), MAXLONG, NULL);
+    if (!(*semaphore)->semaphore)
+    {
+        safe_Free(*semaphore)
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
+void wait_Semaphore(seaSemaphore semaphore)
+{
+    if (semaphore)
+    {
+        WaitForSingleObject(semaphore->semaphore, INFINITE);
+    }
+}
+
+void post_Semaphore(seaSemaphore semaphore)
+{
+    if (semaphore)
+    {
+        ReleaseSemaphore(semaphore->semaphore, 1, NULL);
+    }
+}
+
+void destroy_Semaphore(seaSemaphore *semaphore)
+{
+    if (semaphore && *semaphore)
+    {
+        CloseHandle((*semaphore)->semaphore);
+        safe_Free(*semaphore)
+    }
+}
+
+int map_File_Read_Only(const char *fileName, ptrReadOnlyFileMapping mapping)
+{
+    HANDLE fileHandle = INVALID_HANDLE_VALUE;
+    HANDLE mappingHandle = NULL;
+    LARGE_INTEGER fileSize;
+    void *data = NULL;
+    if (!fileName || !mapping)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(mapping, 0, sizeof(readOnlyFileMapping));
+    fileSize.QuadPart = 0;
+    fileHandle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return FILE_OPEN_ERROR;
+    }
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0 || C_CAST(uint64_t, fileSize.QuadPart) > SIZE_MAX)
+    {
+        CloseHandle(fileHandle);
+        return INVALID_LENGTH;
+    }
+    mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(fileHandle);//the mapping holds its own reference to the file
+    if (!mappingHandle)
+    {
+        return FAILURE;
+    }
+    data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        CloseHandle(mappingHandle);
+        return FAILURE;
+    }
+    mapping->data = C_CAST(const uint8_t*, data);
+    mapping->length = C_CAST(size_t, fileSize.QuadPart);
+    mapping->platformHandle = mappingHandle;
+    return SUCCESS;
+}
+
+void unmap_File(ptrReadOnlyFileMapping mapping)
+{
+    if (mapping && mapping->data)
+    {
+        UnmapViewOfFile(mapping->data);
+        CloseHandle(C_CAST(HANDLE, mapping->platformHandle));
+        memset(mapping, 0, sizeof(readOnlyFileMapping));
+    }
+}
+
+int allocate_Pinned_IO_Buffer(size_t size, ptrPinnedIOBuffer ioBuffer)
+{
+    SIZE_T largePageSize = GetLargePageMinimum();
+    void *data = NULL;
+    SYSTEM_INFO system;
+    if (!ioBuffer || size == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(ioBuffer, 0, sizeof(pinnedIOBuffer));
+    if (largePageSize > 0)
+    {
+        //large pages need SeLockMemoryPrivilege. They are always locked in memory.
+        size_t largeSize = ((size + largePageSize - 1) / largePageSize) * largePageSize;
+        data = VirtualAlloc(NULL, largeSize, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (data)
+        {
+            ioBuffer->buffer = C_CAST(uint8_t*, data);
+            ioBuffer->size = largeSize;
+            ioBuffer->hugePages = true;
+            ioBuffer->locked = true;
+            return SUCCESS;
+        }
+    }
+    memset(&system, 0, sizeof(SYSTEM_INFO));
+    GetSystemInfo(&system);
+    size = ((size + system.dwPageSize - 1) / system.dwPageSize) * system.dwPageSize;
+    data = VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (!data)
+    {
+        return MEMORY_FAILURE;
+    }
+    //this is limited by the working set size, so it can fail for large buffers
+    if (VirtualLock(data, size))
+    {
+        ioBuffer->locked = true;
+    }
+    ioBuffer->buffer = C_CAST(uint8_t*, data);
+    ioBuffer->size = size;
+    return SUCCESS;
+}
+
+void free_Pinned_IO_Buffer(ptrPinnedIOBuffer ioBuffer)
+{
+    if (ioBuffer && ioBuffer->buffer)
+    {
+        if (ioBuffer->locked && !ioBuffer->hugePages)
+        {
+            VirtualUnlock(ioBuffer->buffer, ioBuffer->size);
+        }
+        VirtualFree(ioBuffer->buffer, 0, MEM_RELEASE);
+        memset(ioBuffer, 0, sizeof(pinnedIOBuffer));
+    }
+}
@@ -522,8 +522,8 @@ extern "C"
         SEAC_OUTPUT_RAW,  //This will output the data as raw binary glob
         SEAC_OUTPUT_JSON,
         //TODO: add other output formats as we want to support them
-        SEAC_OUTPUT_CSV, //just an idea...isn't implemented now
-        SEAC_OUTPUT_XML, //just an idea...isn't implemented now
+        SEAC_OUTPUT_CSV, //field,value rows. See structuredWriter
+        SEAC_OUTPUT_XML, //See structuredWriter
     }eOutputFormat;
 
 
@@ -1263,6 +1263,49 @@ extern "C"
     //-----------------------------------------------------------------------------
     int fill_Pattern_Buffer_Into_Another_Buffer(uint8_t *inPattern, uint32_t inpatternLength, uint8_t *ptrData, uint32_t dataLength);
 
+    typedef struct _bufferCompareResult
+    {
+        bool miscompare;//true when any byte in the buffers did not match
+        size_t firstMiscompareOffset;//byte offset of the first byte that did not match. Only valid when miscompare is true
+        uint64_t miscomparedBits;//total number of bits that are different between the two buffers
+    }bufferCompareResult, *ptrBufferCompareResult;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  compare_Buffers(const uint8_t *expected, const uint8_t *actual, size_t length, ptrBufferCompareResult result)
+    //
+    //! \brief   Description:  Compares two buffers like memcmp, but can also report where the first miscompare is and how many bits are different.
+    //!                        Uses SSE2/AVX2 when the compiler targets them, otherwise compares 8 bytes at a time.
+    //
+    //  Entry:
+    //!   \param[in] expected = pointer to the data that was expected (ex: what was written)
+    //!   \param[in] actual = pointer to the data to check (ex: what was read back)
+    //!   \param[in] length = number of bytes to compare
+    //!   \param[out] result = optional pointer to hold miscompare details. If NULL, the compare stops at the first difference.
+    //!
+    //  Exit:
+    //!   \return true = buffers match, false = buffers are different (or a NULL buffer was passed in)
+    //
+    //-----------------------------------------------------------------------------
+    bool compare_Buffers(const uint8_t *expected, const uint8_t *actual, size_t length, ptrBufferCompareResult result);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  crc32c(uint32_t crc, const uint8_t *data, size_t length)
+    //
+    //! \brief   Description:  Calculates a CRC32C (Castagnoli) over a buffer. Uses the SSE4.2/ARMv8 CRC instructions when the compiler targets them.
+    //
+    //  Entry:
+    //!   \param[in] crc = CRC to continue from. Pass 0 to start a new CRC
+    //!   \param[in] data = pointer to the data to calculate the CRC on
+    //!   \param[in] length = number of bytes to include in the CRC
+    //!
+    //  Exit:
+    //!   \return the CRC32C value
+    //
+    //-----------------------------------------------------------------------------
+    uint32_t crc32c(uint32_t crc, const uint8_t *data, size_t length);
+
     double convert_128bit_to_double(uint8_t * pData);
 
     //meant to replace calling gmtime() function as this handles all the cross-platform weirdness calling the safest possible version
@@ -1591,6 +1634,76 @@ extern "C"
     //-----------------------------------------------------------------------------
     void *realloc_page_aligned(void *alignedPtr, size_t originalSize, size_t size);
 
+    //Pool of page aligned buffers that are kept for reuse instead of being freed, so that code sending many small commands does not allocate and free
+    //a buffer for every command. Requests are rounded up to the size classes below. Larger requests get pinned hugepage buffers (allocate_Pinned_IO_Buffer)
+    //that stay locked in memory while the pool keeps them, and a returned one is reused for any later request that fits in it.
+    #define ALIGNED_BUFFER_POOL_SIZE_CLASSES 4
+    #define ALIGNED_BUFFER_POOL_MAX_CLASS_SIZE (1024 * 1024)
+    #define ALIGNED_BUFFER_POOL_MAX_PINNED 8 //pinned buffers in use or kept at once. Past this, large requests are allocated and freed each time.
+    #define ALIGNED_BUFFER_POOL_MAX_IDLE_PINNED 2 //pinned buffers kept when not in use
+    typedef struct _alignedBufferPool *alignedBufferPool;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  create_Aligned_Buffer_Pool(alignedBufferPool *pool)
+    //
+    //! \brief   Description:  Creates an empty buffer pool. Buffers are allocated the first time each size is requested. The pool can be used from any thread.
+    //
+    //  Entry:
+    //!   \param[out] pool = pointer to hold the new pool. Free it with destroy_Aligned_Buffer_Pool.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    int create_Aligned_Buffer_Pool(alignedBufferPool *pool);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Pooled_Buffer(alignedBufferPool pool, size_t size)
+    //
+    //! \brief   Description:  Gets a zeroed, page aligned buffer from the pool, allocating one if none of that size class are free.
+    //
+    //  Entry:
+    //!   \param[in] pool = pool from create_Aligned_Buffer_Pool
+    //!   \param[in] size = size in bytes the caller needs
+    //!
+    //  Exit:
+    //!   \return pointer to the buffer, or NULL if memory could not be allocated. Give it back with return_Pooled_Buffer and the same size.
+    //
+    //-----------------------------------------------------------------------------
+    void *get_Pooled_Buffer(alignedBufferPool pool, size_t size);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  return_Pooled_Buffer(alignedBufferPool pool, void *buffer, size_t size)
+    //
+    //! \brief   Description:  Gives a buffer back to the pool. It is freed instead if its size class already has enough free buffers.
+    //
+    //  Entry:
+    //!   \param[in] pool = pool the buffer came from
+    //!   \param[in] buffer = buffer from get_Pooled_Buffer. NULL is ignored.
+    //!   \param[in] size = same size that was passed to get_Pooled_Buffer
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    void return_Pooled_Buffer(alignedBufferPool pool, void *buffer, size_t size);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  destroy_Aligned_Buffer_Pool(alignedBufferPool *pool)
+    //
+    //! \brief   Description:  Frees every free buffer in the pool and the pool itself. All buffers must be returned first.
+    //
+    //  Entry:
+    //!   \param[in,out] pool = pool to destroy. Set to NULL on return.
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    void destroy_Aligned_Buffer_Pool(alignedBufferPool *pool);
+
     //-----------------------------------------------------------------------------
     //
     //  is_Empty(void *ptrData, size_t lengthBytes)
@@ -1642,6 +1755,96 @@ extern "C"
 
     char* common_String_Concat_Len(char* destination, size_t destinationSizeBytes, const char* source, int sourceLength);
 
+    #define STRUCTURED_WRITER_MAX_DEPTH 16
+
+    //Streaming writer for structured output. Each call writes directly to the output, so nothing is held in memory other than the names of the
+    //objects/arrays that are currently open. Use the same calls for every format:
+    //  SEAC_OUTPUT_TEXT = indented "name: value" lines
+    //  SEAC_OUTPUT_JSON = one JSON object holding everything that was written
+    //  SEAC_OUTPUT_CSV = "field,value" rows where field is the full dotted path to the value (ex: DST Log.Entries.0.Status)
+    //  SEAC_OUTPUT_XML = elements named after each field. Characters that are not allowed in element names are changed to underscores.
+    typedef struct _structuredWriter
+    {
+        eOutputFormat format;
+        FILE *output;
+        uint8_t depth;//number of objects/arrays currently open
+        bool overflow;//set when more than STRUCTURED_WRITER_MAX_DEPTH levels were opened. Output stops being written when this happens.
+        const char *names[STRUCTURED_WRITER_MAX_DEPTH];//names of the open objects/arrays. The caller's strings must stay valid until the matching end call.
+        bool isArray[STRUCTURED_WRITER_MAX_DEPTH];
+        uint32_t itemCount[STRUCTURED_WRITER_MAX_DEPTH];//number of items written in each open object/array
+        uint32_t rootItemCount;
+    }structuredWriter, *ptrStructuredWriter;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  init_Structured_Writer()
+    //
+    //! \brief   Description:  Sets up a streaming structured writer and writes anything the format needs at the start (JSON opening brace, XML declaration, CSV header)
+    //
+    //  Entry:
+    //!   \param[out] writer = pointer to the writer to setup
+    //!   \param[in] format = output format. SEAC_OUTPUT_RAW is not supported.
+    //!   \param[in] output = where to write. Usually stdout or a file.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED = format cannot be used for structured output
+    //
+    //-----------------------------------------------------------------------------
+    int init_Structured_Writer(ptrStructuredWriter writer, eOutputFormat format, FILE *output);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  finish_Structured_Writer()
+    //
+    //! \brief   Description:  Closes anything still open, writes the end of the output, and flushes it.
+    //
+    //  Entry:
+    //!   \param[in] writer = pointer to the writer
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, ERROR_WRITING_FILE = the output reported an error
+    //
+    //-----------------------------------------------------------------------------
+    int finish_Structured_Writer(ptrStructuredWriter writer);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  begin_Structured_Object() / end_Structured_Object() / begin_Structured_Array() / end_Structured_Array()
+    //
+    //! \brief   Description:  Open and close a named group of fields (object) or a list of unnamed items (array).
+    //
+    //  Entry:
+    //!   \param[in] writer = pointer to the writer
+    //!   \param[in] name = name of the object or array. Ignored for items inside an array, so NULL can be used there.
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    void begin_Structured_Object(ptrStructuredWriter writer, const char *name);
+    void end_Structured_Object(ptrStructuredWriter writer);
+    void begin_Structured_Array(ptrStructuredWriter writer, const char *name);
+    void end_Structured_Array(ptrStructuredWriter writer);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  write_Structured_String() / _Unsigned() / _Signed() / _Double() / _Bool()
+    //
+    //! \brief   Description:  Write one named value in the current object. Inside an array, the name is ignored.
+    //
+    //  Entry:
+    //!   \param[in] writer = pointer to the writer
+    //!   \param[in] name = name of the value
+    //!   \param[in] value = value to write. A NULL string is written as null (JSON) or empty. In JSON, a double that is nan or inf is written as null.
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    void write_Structured_String(ptrStructuredWriter writer, const char *name, const char *value);
+    void write_Structured_Unsigned(ptrStructuredWriter writer, const char *name, uint64_t value);
+    void write_Structured_Signed(ptrStructuredWriter writer, const char *name, int64_t value);
+    void write_Structured_Double(ptrStructuredWriter writer, const char *name, double value);
+    void write_Structured_Bool(ptrStructuredWriter writer, const char *name, bool value);
+
 #if defined (__cplusplus)
 } //extern "C"
 #endif
@@ -568,6 +568,166 @@ extern "C"
     //-----------------------------------------------------------------------------
     int get_Current_User_Name(char **userName);
 
+    //Minimal threading support for operations that run on many devices at once. Each device should only be used by one thread at a time.
+    typedef void (*seaThreadRoutine)(void *context);
+    typedef struct _seaThread *seaThread;
+    typedef struct _seaMutex *seaMutex;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  create_Thread
+    //
+    //! \brief   Description:  Starts a new thread running the routine with the context pointer. The thread must be cleaned up with join_Thread.
+    //
+    //  Entry:
+    //!   \param[out] thread - pointer to hold the new thread handle
+    //!   \param[in] routine - function for the thread to run
+    //!   \param[in] context - pointer passed to the routine
+    //!
+    //  Exit:
+    //!   \return SUCCESS = thread started, BAD_PARAMETER, MEMORY_FAILURE, FAILURE = OS could not start the thread, NOT_SUPPORTED = no threads on this platform
+    //
+    //-----------------------------------------------------------------------------
+    int create_Thread(seaThread *thread, seaThreadRoutine routine, void *context);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  join_Thread
+    //
+    //! \brief   Description:  Waits for a thread to finish its routine, then frees the thread handle.
+    //
+    //  Entry:
+    //!   \param[in] thread - thread handle from create_Thread. Set to NULL on return.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = thread finished, BAD_PARAMETER, FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    int join_Thread(seaThread *thread);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  create_Mutex / lock_Mutex / unlock_Mutex / destroy_Mutex
+    //
+    //! \brief   Description:  Simple non-recursive mutex. On platforms without threads, these do nothing.
+    //
+    //  Entry:
+    //!   \param[in,out] mutex - mutex handle. destroy_Mutex sets it to NULL.
+    //!
+    //  Exit:
+    //!   \return (create_Mutex) SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    int create_Mutex(seaMutex *mutex);
+    void lock_Mutex(seaMutex mutex);
+    void unlock_Mutex(seaMutex mutex);
+    void destroy_Mutex(seaMutex *mutex);
+
+    typedef struct _seaSemaphore *seaSemaphore;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  create_Semaphore / wait_Semaphore / post_Semaphore / destroy_Semaphore
+    //
+    //! \brief   Description:  Counting semaphore so that a thread can sleep until another one has work for it or has finished something.
+    //!                        wait_Semaphore blocks until the count is above zero, then decrements it. post_Semaphore increments it.
+    //!                        Not available on platforms without threads, since nothing could ever post while the only thread waits.
+    //
+    //  Entry:
+    //!   \param[in,out] semaphore - semaphore handle. destroy_Semaphore sets it to NULL.
+    //!   \param[in] initialCount - (create_Semaphore) starting count
+    //!
+    //  Exit:
+    //!   \return (create_Semaphore) SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, FAILURE, NOT_SUPPORTED = no threads on this platform
+    //
+    //-----------------------------------------------------------------------------
+    int create_Semaphore(seaSemaphore *semaphore, uint32_t initialCount);
+    void wait_Semaphore(seaSemaphore semaphore);
+    void post_Semaphore(seaSemaphore semaphore);
+    void destroy_Semaphore(seaSemaphore *semaphore);
+
+    typedef struct _readOnlyFileMapping
+    {
+        const uint8_t *data;//pointer to the file contents. Do not write to this.
+        size_t length;//length of the file in bytes
+        void *platformHandle;//OS specific handle to the mapping. Do not use this directly.
+    }readOnlyFileMapping, *ptrReadOnlyFileMapping;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  map_File_Read_Only
+    //
+    //! \brief   Description:  Maps a whole file into memory as read only so that one copy can be shared (ex: a firmware image sent to many devices).
+    //!                        The mapping is page aligned. Free it with unmap_File.
+    //
+    //  Entry:
+    //!   \param[in] fileName - path to the file to map
+    //!   \param[out] mapping - pointer to the structure to hold the mapping
+    //!
+    //  Exit:
+    //!   \return SUCCESS = mapped, BAD_PARAMETER, FILE_OPEN_ERROR, INVALID_LENGTH = empty file, FAILURE = could not map, NOT_SUPPORTED
+    //
+    //-----------------------------------------------------------------------------
+    int map_File_Read_Only(const char *fileName, ptrReadOnlyFileMapping mapping);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  unmap_File
+    //
+    //! \brief   Description:  Releases a mapping from map_File_Read_Only.
+    //
+    //  Entry:
+    //!   \param[in,out] mapping - pointer to the mapping. Will be cleared on return.
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    void unmap_File(ptrReadOnlyFileMapping mapping);
+
+    #define PINNED_IO_BUFFER_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+    typedef struct _pinnedIOBuffer
+    {
+        uint8_t *buffer;//page aligned and zeroed when allocated
+        size_t size;//bytes allocated. Rounded up from the requested size to a whole number of (huge) pages.
+        bool hugePages;//backed by hugepages/large pages, or asked the OS for transparent hugepages
+        bool locked;//locked in memory so it is never paged out. Locking can fail when the process is limited in how much memory it may lock.
+    }pinnedIOBuffer, *ptrPinnedIOBuffer;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  allocate_Pinned_IO_Buffer
+    //
+    //! \brief   Description:  Allocates a buffer for large data transfers using hugepages when possible and locks it in memory. Fewer, larger pages mean
+    //!                        less work for the OS to pin the buffer for each command and shorter scatter-gather lists. Meant to be allocated once and
+    //!                        used for many commands since allocating it costs more than a normal allocation.
+    //!                        Linux: explicit hugepages (MAP_HUGETLB), then transparent hugepages on a 2MiB aligned mapping. Windows: large pages when
+    //!                        the process holds the lock memory privilege, otherwise normal pages.
+    //
+    //  Entry:
+    //!   \param[in] size - number of bytes needed
+    //!   \param[out] ioBuffer - pointer to the structure to hold the buffer. Free it with free_Pinned_IO_Buffer.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = allocated (check hugePages and locked for what was possible), BAD_PARAMETER, MEMORY_FAILURE, NOT_SUPPORTED
+    //
+    //-----------------------------------------------------------------------------
+    int allocate_Pinned_IO_Buffer(size_t size, ptrPinnedIOBuffer ioBuffer);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  free_Pinned_IO_Buffer
+    //
+    //! \brief   Description:  Unlocks and frees a buffer from allocate_Pinned_IO_Buffer.
+    //
+    //  Entry:
+    //!   \param[in,out] ioBuffer - pointer to the buffer. Will be cleared on return.
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    void free_Pinned_IO_Buffer(ptrPinnedIOBuffer ioBuffer);
+
 #if defined (__cplusplus)
 } //extern "C"
 #endif
@@ -38,6 +38,8 @@ extern "C"
         uint32_t totalCommandCRCErrors;//how many commands return a CRC error
         uint32_t totalBufferComparisons;//how many write-read buffer, then compare the two have been done in the test;
         uint32_t totalBufferMiscompares;//how many times did the buffer miscompare.
+        uint32_t firstMiscompareOffset;//byte offset of the first miscompare seen in this test. Only valid when totalBufferMiscompares is non-zero
+        uint64_t totalMiscomparedBits;//how many bits were different across all miscompares
     }patternTestResults, *ptrPatternTestResults;
 
     typedef struct _cableTestResults
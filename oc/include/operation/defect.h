@@ -174,6 +174,7 @@ extern "C" {
     //  is_Read_Long_Write_Long_Supported(tDevice *device)
     //
     //! \brief   Description:  Checks if a drive supports using read long and write long commands to create errors on a drive. (This is obsolete on new drives)
+    //!          The result is cached in device->drive_info.capabilities until invalidate_Capability_Cache() is called.
     //
     //  Entry:
     //!   \param[in] device = file descriptor
@@ -307,6 +307,9 @@ extern "C"
 
     OPENSEA_OPERATIONS_API int print_DeviceStatistics(tDevice *device, ptrDeviceStatistics deviceStats);
 
+    //Writes the same statistics as print_DeviceStatistics to a structured writer. Values are written raw (not formatted as dates, times, etc).
+    OPENSEA_OPERATIONS_API int write_DeviceStatistics(tDevice *device, ptrDeviceStatistics deviceStats, ptrStructuredWriter writer);
+
 #if defined (__cplusplus)
 }
 #endif
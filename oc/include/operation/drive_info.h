@@ -419,6 +419,23 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_OPERATIONS_API int print_Drive_Information(tDevice *device, bool showChildInformation);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  write_Drive_Information()
+    //
+    //! \brief   Description:  Gathers the same information as print_Drive_Information and writes it to a structured writer (JSON, CSV, XML, or text).
+    //!                        Values are written as numbers (bytes, LBAs, degrees C) instead of the scaled units shown on screen.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] writer = structured writer setup with init_Structured_Writer
+    //!
+    //  Exit:
+    //!   \return SUCCESS = pass, BAD_PARAMETER, MEMORY_FAILURE, !SUCCESS = failed to get the information
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int write_Drive_Information(tDevice *device, ptrStructuredWriter writer);
+
     //-----------------------------------------------------------------------------
     //
     //  get_SAS_Interface_Speeds()
@@ -275,6 +275,49 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_OPERATIONS_API int run_DST_And_Clean(tDevice *device, uint16_t errorLimit, custom_Update updateFunction, void *updateData, ptrDSTAndCleanErrorList externalErrorList, bool *repaired);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  run_DST_And_Clean_Checkpoint()
+    //
+    //! \brief   Description:  Same as run_DST_And_Clean, but saves the list of repaired LBAs to a checkpoint file before each DST is started.
+    //!                        If interrupted, resume_DST_And_Clean continues with the errors already found still counting against the error limit.
+    //!                        The checkpoint file is removed when DST and clean finishes.
+    //
+    //  Entry:
+    //!   \param[in] device - pointer to the device structure
+    //!   \param[in] errorLimit - value representing number of errors to fix. This must be 1 or higher.
+    //!   \param[in] updateFunction - 
+    //!   \param[in] updateData - 
+    //!   \param[in] externalErrorList - optional. See run_DST_And_Clean
+    //!   \param[in] repaired - flag for Tattoo log for when the drive has been repaired.
+    //!   \param[in] checkpointFile - path of the checkpoint file to write
+    //!
+    //  Exit:
+    //!   \return SUCCESS = completed DST and clean successfully, !SUCCESS = error limit reached, or unrepairable DST condition
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int run_DST_And_Clean_Checkpoint(tDevice *device, uint16_t errorLimit, custom_Update updateFunction, void *updateData, ptrDSTAndCleanErrorList externalErrorList, bool *repaired, const char *checkpointFile);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  resume_DST_And_Clean()
+    //
+    //! \brief   Description:  Continues a DST and clean started with run_DST_And_Clean_Checkpoint. The error limit and repaired LBAs come from the checkpoint.
+    //
+    //  Entry:
+    //!   \param[in] device - pointer to the device structure
+    //!   \param[in] checkpointFile - path of the checkpoint file. It is updated as DST and clean continues and removed when it finishes.
+    //!   \param[in] updateFunction - 
+    //!   \param[in] updateData - 
+    //!   \param[in] externalErrorList - optional. See run_DST_And_Clean. Must hold at least as many entries as the error limit in the checkpoint.
+    //!   \param[in] repaired - flag for Tattoo log for when the drive has been repaired.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = completed DST and clean successfully, BAD_PARAMETER = checkpoint is not for this device, !SUCCESS = error limit reached, or unrepairable DST condition
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int resume_DST_And_Clean(tDevice *device, const char *checkpointFile, custom_Update updateFunction, void *updateData, ptrDSTAndCleanErrorList externalErrorList, bool *repaired);
+
     typedef struct _dstDescriptor
     {
         bool descriptorValid;
@@ -341,6 +384,22 @@ extern "C"
 
     OPENSEA_OPERATIONS_API int print_DST_Log_Entries(ptrDstLogEntries entries);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  write_DST_Log_Entries()
+    //
+    //! \brief   Description:  Writes the DST log entries to a structured writer (JSON, CSV, XML, or text) instead of printing a table
+    //
+    //  Entry:
+    //!   \param[in] entries = pointer to the DST log entries read with get_DST_Log_Entries
+    //!   \param[in] writer = structured writer setup with init_Structured_Writer
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int write_DST_Log_Entries(ptrDstLogEntries entries, ptrStructuredWriter writer);
+
     OPENSEA_OPERATIONS_API bool is_Self_Test_Supported(tDevice *device);
 
     OPENSEA_OPERATIONS_API bool is_Conveyence_Self_Test_Supported(tDevice *device);
@@ -0,0 +1,127 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file erase_estimate.h
+// \brief This file defines the functions for estimating erase times from a measured transfer rate instead of the times the drive reports
+
+#pragma once
+
+#include "operations_Common.h"
+#include "operations.h"
+#include "generic_tests.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define ERASE_RATE_CACHE_MAX_ENTRIES 32
+
+    //Erase times returned for methods that do not depend on the transfer rate (crypto erase, block erase, TCG revert) when the drive does not report a time.
+    #define ERASE_ESTIMATE_NOT_AVAILABLE UINT64_MAX
+
+    typedef struct _eraseRateCacheEntry
+    {
+        char modelNumber[MODEL_NUM_LEN + 1];
+        char firmwareRevision[FW_REV_LEN + 1];
+        uint64_t maxLBA;
+        uint32_t logicalBlockSize;
+        uint64_t measuredTime;//seconds since the epoch
+        diameterThroughput throughput;
+    }eraseRateCacheEntry;
+
+    //Measured rates saved by model, firmware, and capacity so that the rest of a fleet of the same drive does not need to be sampled.
+    //This is owned by the caller and is not thread safe. Use save_Erase_Rate_Cache/load_Erase_Rate_Cache to keep it between runs.
+    typedef struct _eraseRateCache
+    {
+        uint32_t numberOfEntries;
+        eraseRateCacheEntry entries[ERASE_RATE_CACHE_MAX_ENTRIES];
+    }eraseRateCache, *ptrEraseRateCache;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  measure_Erase_Rate()
+    //
+    //! \brief   Description:  Gets the transfer rate at the outer, middle, and inner diameter for a drive. If the cache already has a rate for the same model,
+    //!                        firmware, and capacity, that is returned without accessing the drive. Otherwise the drive is sampled with measure_Diameter_Throughput
+    //!                        and the result is added to the cache (replacing the oldest entry when it is full).
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in,out] cache = optional cache to look in and add to
+    //!   \param[in] allowWriteSamples = true to sample with writes. This overwrites the sampled LBAs, but is the only accurate way to measure SMR drives.
+    //!                                  When false, reads are sampled instead.
+    //!   \param[in] secondsPerDiameter = how long to sample each diameter
+    //!   \param[out] throughput = measured or cached rates
+    //!   \param[in] hideLBACounter = set to true to hide the LBA counter being printed to stdout
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, FAILURE = an error occured while sampling
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int measure_Erase_Rate(tDevice *device, ptrEraseRateCache cache, bool allowWriteSamples, uint64_t secondsPerDiameter, ptrDiameterThroughput throughput, bool hideLBACounter);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Measured_Erase_Time_Estimates()
+    //
+    //! \brief   Description:  Estimates how long each erase method in a list from get_Supported_Erase_Methods will take.
+    //!                        Methods that overwrite the media (overwrite, write same, sanitize overwrite, format unit) use the measured rates, assuming the
+    //!                        rate changes in a straight line between the sampled diameters. ATA security erase uses the drive's reported time when it has one.
+    //!                        Crypto erase, block erase, and TCG revert are set to ERASE_ESTIMATE_NOT_AVAILABLE since they do not depend on the transfer rate.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] throughput = rates from measure_Erase_Rate
+    //!   \param[in] eraseMethodList = list from get_Supported_Erase_Methods
+    //!   \param[out] estimateSeconds = estimated time for each entry in eraseMethodList. Entries that are not used in eraseMethodList are set to ERASE_ESTIMATE_NOT_AVAILABLE.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER = a measured rate is zero
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int get_Measured_Erase_Time_Estimates(tDevice *device, ptrDiameterThroughput throughput, eraseMethod const eraseMethodList[MAX_SUPPORTED_ERASE_METHODS], uint64_t estimateSeconds[MAX_SUPPORTED_ERASE_METHODS]);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  save_Erase_Rate_Cache()
+    //
+    //! \brief   Description:  Writes a rate cache to a text file with one tab separated line per entry.
+    //
+    //  Entry:
+    //!   \param[in] cacheFile = path to the file to write
+    //!   \param[in] cache = cache to save
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, FILE_OPEN_ERROR, ERROR_WRITING_FILE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int save_Erase_Rate_Cache(const char *cacheFile, ptrEraseRateCache cache);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  load_Erase_Rate_Cache()
+    //
+    //! \brief   Description:  Reads a rate cache saved with save_Erase_Rate_Cache. Lines that cannot be read are skipped.
+    //
+    //  Entry:
+    //!   \param[in] cacheFile = path to the file to read
+    //!   \param[out] cache = cache to fill in
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, FILE_OPEN_ERROR
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int load_Erase_Rate_Cache(const char *cacheFile, ptrEraseRateCache cache);
+
+#if defined (__cplusplus)
+}
+#endif
@@ -144,6 +144,72 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_OPERATIONS_API void show_Supported_FWDL_Modes(tDevice *device, ptrSupportedDLModes supportedModes);
 
+    #define FIRMWARE_FLEET_UPDATE_VERSION 1
+
+    typedef struct _firmwareFleetDevice
+    {
+        tDevice *device;//device to update. Each device must only be listed once.
+        uint32_t controllerID;//set by the caller. Devices with the same value share a controller/HBA and are limited by maxDevicesPerController
+        uint8_t firmwareSlot;//NVMe firmware slot to download and activate in. 0 lets the controller pick.
+        //results. These are filled in by the functions below.
+        int downloadResult;//SUCCESS, or the error from reading the supported modes or downloading. NOT_SUPPORTED if the device cannot do the requested download mode.
+        int activateResult;//SUCCESS, or the error from activating. ABORTED if activation was skipped because an earlier wave failed.
+        eDownloadMode modeUsed;
+        uint16_t segmentSizeUsed;//in 512B blocks
+        uint64_t downloadTimeNanoSeconds;//time for the whole download. Includes the activation when the mode used activates with the last segment.
+        uint64_t activateTimeNanoSeconds;
+    }firmwareFleetDevice, *ptrFirmwareFleetDevice;
+
+    typedef struct _firmwareFleetUpdate
+    {
+        size_t size;//set to sizeof(firmwareFleetUpdate)
+        uint32_t version;//set to FIRMWARE_FLEET_UPDATE_VERSION
+        const uint8_t *firmwareImage;//one copy of the image shared by all devices. map_File_Read_Only is the recommended way to get this. It is never written to.
+        uint32_t firmwareImageLength;
+        uint32_t maxDevicesTotal;//maximum number of devices downloading at the same time. 0 = no limit
+        uint32_t maxDevicesPerController;//maximum number of devices downloading at the same time on one controllerID. 0 = no limit
+        bool stagedActivation;//true = download with deferred mode to all devices, then activate with activate_Firmware_On_Devices. false = each device activates when its own download completes (segmented or full)
+        uint32_t activationWaveSize;//number of devices to activate at the same time. 0 = all devices in one wave
+        uint32_t activationWaveDelaySeconds;//time to wait between waves so that devices can come back before the next wave is started
+        bool stopActivationOnFailure;//do not start any more waves after a device fails to activate
+        uint32_t numberOfDevices;
+        ptrFirmwareFleetDevice devices;
+    }firmwareFleetUpdate, *ptrFirmwareFleetUpdate;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  firmware_Download_To_Devices()
+    //
+    //! \brief   Description:  Downloads the same firmware image to many devices at the same time. Each device uses the largest segment size it reports
+    //!                        (limited by the image size and the OS transfer limits), and downloads are limited per controller so that one HBA is not overloaded.
+    //!                        When stagedActivation is set, the new code is not activated until activate_Firmware_On_Devices is called.
+    //!                        On platforms without threads, the devices are updated one at a time.
+    //
+    //  Entry:
+    //!   \param[in,out] fleetUpdate = pointer to the options and device list. Results are set for each device.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = all devices were updated, FAILURE = one or more devices failed (check each device's downloadResult), BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int firmware_Download_To_Devices(ptrFirmwareFleetUpdate fleetUpdate);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  activate_Firmware_On_Devices()
+    //
+    //! \brief   Description:  Activates firmware on each device that successfully completed a deferred download in firmware_Download_To_Devices.
+    //!                        Devices are activated in waves of activationWaveSize with activationWaveDelaySeconds between each wave.
+    //
+    //  Entry:
+    //!   \param[in,out] fleetUpdate = pointer to the options and device list used for the download. activateResult is set for each device.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = all devices activated, FAILURE = one or more devices failed or were skipped, BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int activate_Firmware_On_Devices(ptrFirmwareFleetUpdate fleetUpdate);
+
 #if defined(__cplusplus)
 }
 #endif
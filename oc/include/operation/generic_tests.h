@@ -371,6 +371,9 @@ extern "C"
     //
     //-----------------------------------------------------------------------------
     OPENSEA_OPERATIONS_API int long_Generic_Test(tDevice *device, eRWVCommandType rwvCommand, uint16_t errorLimit, bool stopOnError, bool repairOnTheFly, bool repairAtEnd, custom_Update updateFunction, void *updateData, bool hideLBACounter);
+
+    //same as long_Generic_Test, but saves progress to checkpointFile so it can be continued with resume_User_Sequential_Test. See user_Sequential_Test_Checkpoint
+    OPENSEA_OPERATIONS_API int long_Generic_Test_Checkpoint(tDevice *device, eRWVCommandType rwvCommand, uint16_t errorLimit, bool stopOnError, bool repairOnTheFly, bool repairAtEnd, const char *checkpointFile, custom_Update updateFunction, void *updateData, bool hideLBACounter);
     
     //-----------------------------------------------------------------------------
     //
@@ -469,6 +472,52 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_OPERATIONS_API int user_Sequential_Test(tDevice *device, eRWVCommandType rwvCommand, uint64_t startingLBA, uint64_t range, uint16_t errorLimit, bool stopOnError, bool repairOnTheFly, bool repairAtEnd, custom_Update updateFunction, void *updateData, bool hideLBACounter);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  user_Sequential_Test_Checkpoint()
+    //
+    //! \brief   Description:  Same as user_Sequential_Test, but saves its position, error list and elapsed time to a checkpoint file about every TEST_CHECKPOINT_INTERVAL_SECONDS.
+    //!                        If the test is interrupted, resume_User_Sequential_Test can continue it from the last checkpoint. The checkpoint file is removed when the test finishes.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] rwvCommand = enum value specifying which command type to issue
+    //!   \param[in] startingLBA = LBA to start the test at
+    //!   \param[in] range = the range of LBAs from the starting LBA to test
+    //!   \param[in] errorLimit = the maximum number of errors to tolerate before stopping the test
+    //!   \param[in] stopOnError = set to true to stop on the first error (will ignore the error limit)
+    //!   \param[in] repairOnTheFly = set to true to repair LBAs as they are found to be bad
+    //!   \param[in] repairAtEnd = set to true to repair LBAs at the end of the test
+    //!   \param[in] checkpointFile = path of the checkpoint file to write. May be NULL to not checkpoint (same as user_Sequential_Test).
+    //!   \param[in] updateFunction = callback function to update UI
+    //!   \param[in] updateData = hidden data to pass to the callback function
+    //!   \param[in] hideLBACounter = set to true to hide the LBA counter being printed to stdout
+    //!
+    //  Exit:
+    //!   \return SUCCESS on successful completion, FAILURE = fail
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int user_Sequential_Test_Checkpoint(tDevice *device, eRWVCommandType rwvCommand, uint64_t startingLBA, uint64_t range, uint16_t errorLimit, bool stopOnError, bool repairOnTheFly, bool repairAtEnd, const char *checkpointFile, custom_Update updateFunction, void *updateData, bool hideLBACounter);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  resume_User_Sequential_Test()
+    //
+    //! \brief   Description:  Continues a sequential test (user_Sequential_Test_Checkpoint or long_Generic_Test_Checkpoint) from its last checkpoint. The test options come from the checkpoint.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] checkpointFile = path of the checkpoint file. It is updated as the test continues and removed when it finishes.
+    //!   \param[in] updateFunction = callback function to update UI
+    //!   \param[in] updateData = hidden data to pass to the callback function
+    //!   \param[in] hideLBACounter = set to true to hide the LBA counter being printed to stdout
+    //!
+    //  Exit:
+    //!   \return SUCCESS on successful completion, FAILURE = fail, BAD_PARAMETER = checkpoint is not for this device or test. See load_Test_Checkpoint for other errors.
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int resume_User_Sequential_Test(tDevice *device, const char *checkpointFile, custom_Update updateFunction, void *updateData, bool hideLBACounter);
+
     //-----------------------------------------------------------------------------
     //
     //  butterfly_Read_Test()
@@ -630,8 +679,327 @@ extern "C"
 
     OPENSEA_OPERATIONS_API int diameter_Test_Time(tDevice *device, eRWVCommandType testMode, bool outer, bool middle, bool inner, uint64_t timeInSecondsPerDiameter, uint16_t errorLimit, bool stopOnError, bool repairOnTheFly, bool repairAtEnd, bool hideLBACounter);
 
+    typedef struct _diameterThroughput
+    {
+        eRWVCommandType testMode;
+        uint64_t outerLBA;//LBA each sample started at
+        uint64_t middleLBA;
+        uint64_t innerLBA;
+        double outerMBPerSecond;
+        double middleMBPerSecond;
+        double innerMBPerSecond;
+    }diameterThroughput, *ptrDiameterThroughput;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  measure_Diameter_Throughput()
+    //
+    //! \brief   Description:  Runs the same outer, middle, and inner diameter passes as diameter_Test_Time, but times each one and reports the rate that was achieved
+    //!                        instead of looking for bad LBAs. Stops at the first error.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] testMode = read, write, or verify. Write overwrites the LBAs that are sampled!
+    //!   \param[in] timeInSecondsPerDiameter = how long to run at each diameter
+    //!   \param[out] throughput = rate measured at each diameter in MB/s (1000000 bytes)
+    //!   \param[in] hideLBACounter = set to true to hide the LBA counter being printed to stdout
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, FAILURE = an error was found during a pass
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int measure_Diameter_Throughput(tDevice *device, eRWVCommandType testMode, uint64_t timeInSecondsPerDiameter, ptrDiameterThroughput throughput, bool hideLBACounter);
+
     OPENSEA_OPERATIONS_API int user_Timed_Test(tDevice *device, eRWVCommandType rwvCommand, uint64_t startingLBA, uint64_t timeInSeconds, uint16_t errorLimit, bool stopOnError, bool repairOnTheFly, bool repairAtEnd, custom_Update updateFunction, void *updateData, bool hideLBACounter);
 
+    typedef struct _dataIntegrityResults
+    {
+        uint64_t blocksWritten;//total number of logical blocks written across all passes
+        uint64_t blocksChecked;//total number of logical blocks read back and checked across all passes
+        uint64_t commandFailures;//number of read or write commands that failed. The blocks in these transfers are not checked, including on the read back after a failed write.
+        uint64_t checksumFailures;//block read back did not match its own CRC32C. Data was corrupted or never written by this test.
+        uint64_t misdirectedBlocks;//block had a valid signature, but for a different LBA. A write landed in the wrong place (or a read came from the wrong place)
+        uint64_t staleBlocks;//block had a valid signature for this LBA, but from an earlier pass or run. A write was lost.
+        uint64_t firstFailingLBA;//first LBA that failed any check. UINT64_MAX when no failures were found
+    }dataIntegrityResults, *ptrDataIntegrityResults;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  data_Integrity_Test()
+    //
+    //! \brief   Description:  Writes every logical block in a range with a signature (magic, run ID, pass number, LBA, filler, CRC32C), then reads the whole range back and checks each block.
+    //!                        The whole range is written before any of it is read back so that a misdirected write that lands on another block in the range is caught.
+    //!                        Each pass uses a new pass number so a lost write shows up as stale data from the previous pass. THIS OVERWRITES ALL DATA IN THE RANGE.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] startingLBA = LBA to start the test at
+    //!   \param[in] range = number of LBAs to test. Will be reduced to fit on the device.
+    //!   \param[in] passes = number of write/read-back passes to perform. Must be at least 1.
+    //!   \param[out] results = pointer to a structure that will hold the counts of what was found. Must not be NULL.
+    //!   \param[in] updateFunction = optional callback function to update UI. Called with a progress message each time another percent of a pass's write or check is done.
+    //!   \param[in] updateData = hidden data to pass to the callback function
+    //!   \param[in] hideLBACounter = set to true to hide the LBA counter being printed to stdout
+    //!
+    //  Exit:
+    //!   \return SUCCESS = all blocks verified, FAILURE = one or more blocks failed a check or a command failed, BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int data_Integrity_Test(tDevice *device, uint64_t startingLBA, uint64_t range, uint32_t passes, ptrDataIntegrityResults results, custom_Update updateFunction, void *updateData, bool hideLBACounter);
+
+    OPENSEA_OPERATIONS_API void print_Data_Integrity_Results(ptrDataIntegrityResults results);
+
+    #define ACTUATOR_PARALLEL_MAX_RANGES 15 //matches the maximum number of concurrent positioning ranges
+
+    typedef struct _actuatorRangeResult
+    {
+        uint8_t rangeNumber;
+        uint64_t startingLBA;
+        uint64_t numberOfLBAs;
+        int result;//SUCCESS, FAILURE = errors found, or the error that stopped this range
+        uint64_t lbasAccessed;
+        uint16_t errorCount;
+        uint64_t firstFailingLBA;//UINT64_MAX when no errors were found
+        uint64_t elapsedNanoSeconds;
+        double megaBytesPerSecond;
+    }actuatorRangeResult;
+
+    typedef struct _actuatorParallelResults
+    {
+        uint8_t numberOfRanges;
+        bool rangesRanInParallel;//false if threads were not available and each range ran one after another
+        uint64_t totalElapsedNanoSeconds;
+        actuatorRangeResult range[ACTUATOR_PARALLEL_MAX_RANGES];
+    }actuatorParallelResults, *ptrActuatorParallelResults;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  actuator_Parallel_RWV_Test()
+    //
+    //! \brief   Description:  Reads, writes (erases), or verifies the whole drive by splitting the work on the concurrent positioning ranges the drive reports
+    //!                        and running each range at the same time so every actuator stays busy. Each range keeps its own error count and throughput.
+    //!                        Drives that report one or no ranges are tested as a single range.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] rwvCommand = read, write, or verify
+    //!   \param[in] errorLimitPerRange = number of errors in a range before that range stops. 0 means no limit.
+    //!   \param[in] stopOnError = set to true to stop a range at its first error
+    //!   \param[out] results = pointer to a structure to hold the per range results. Must not be NULL.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = no errors, FAILURE = one or more ranges had errors, BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int actuator_Parallel_RWV_Test(tDevice *device, eRWVCommandType rwvCommand, uint16_t errorLimitPerRange, bool stopOnError, ptrActuatorParallelResults results);
+
+    OPENSEA_OPERATIONS_API void print_Actuator_Parallel_Results(ptrActuatorParallelResults results);
+
+    #define ZONED_TRANSFER_RATE_MAX_BINS 256
+    #define ZONED_TRANSFER_RATE_DEFAULT_MB_PER_BIN 64
+    #define ZONED_TRANSFER_RATE_DEFAULT_ANOMALY_PERCENT 20.0
+    #define ZONED_TRANSFER_RATE_PIPELINE_DEPTH 2 //transfers kept outstanding at once so the drive is not idle between commands
+
+    typedef struct _transferRateBin
+    {
+        uint64_t startingLBA;
+        uint64_t lbasAccessed;
+        int result;//SUCCESS or the error that stopped sampling this bin
+        double megaBytesPerSecond;
+        bool anomaly;//rate is well below the bins on either side of it
+    }transferRateBin;
+
+    typedef struct _zonedTransferRateProfile
+    {
+        eRWVCommandType rwvCommand;
+        uint32_t numberOfBins;
+        uint32_t numberOfAnomalies;
+        bool pipelined;//false if threads were not available and one transfer was sent at a time
+        double minimumMBPerSecond;
+        double maximumMBPerSecond;
+        double averageMBPerSecond;
+        transferRateBin bin[ZONED_TRANSFER_RATE_MAX_BINS];
+    }zonedTransferRateProfile, *ptrZonedTransferRateProfile;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  zoned_Transfer_Rate_Test()
+    //
+    //! \brief   Description:  Splits the LBA space into bins and measures the sustained transfer rate at the start of each one, giving a curve of throughput
+    //!                        across the drive. Each bin is sampled with the largest transfers the library uses, with ZONED_TRANSFER_RATE_PIPELINE_DEPTH of them
+    //!                        outstanding at once. A bin is marked as an anomaly when its rate is more than anomalyThresholdPercent below the average of its neighbours,
+    //!                        which points to a weak head or zone. Drives slow down gradually from OD to ID, so that alone does not cause anomalies.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] rwvCommand = read or write. Write overwrites the sampled LBAs with zeroes!
+    //!   \param[in] numberOfBins = number of bins to split the drive into. 0 or more than ZONED_TRANSFER_RATE_MAX_BINS uses ZONED_TRANSFER_RATE_MAX_BINS
+    //!   \param[in] megabytesPerBin = amount to transfer in each bin. 0 uses ZONED_TRANSFER_RATE_DEFAULT_MB_PER_BIN
+    //!   \param[in] anomalyThresholdPercent = how far below its neighbours a bin must be to be marked. 0 uses ZONED_TRANSFER_RATE_DEFAULT_ANOMALY_PERCENT
+    //!   \param[out] profile = rate of each bin
+    //!   \param[in] hideLBACounter = set to true to hide the LBA counter being printed to stdout
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, FAILURE = a transfer failed in one or more bins
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int zoned_Transfer_Rate_Test(tDevice *device, eRWVCommandType rwvCommand, uint32_t numberOfBins, uint64_t megabytesPerBin, double anomalyThresholdPercent, ptrZonedTransferRateProfile profile, bool hideLBACounter);
+
+    OPENSEA_OPERATIONS_API void print_Zoned_Transfer_Rate_Profile(ptrZonedTransferRateProfile profile);
+
+    #define SEEK_PROFILE_MAX_SAMPLES 4096 //per seek class in each range. Percentiles are from the samples kept; later samples still count toward min/avg/max
+    #define SEEK_PROFILE_DISTANCE_BUCKETS 65 //bucket 0 is a seek distance of 0, bucket N is a distance of 2^(N-1) to 2^N - 1 LBAs
+    #define SEEK_PROFILE_TRACK_TO_TRACK_BYTES (2 * 1048576) //about one track on a current HDD. Tracks are not reported by the drive, so this is an estimate.
+
+    typedef enum _eSeekClass
+    {
+        SEEK_CLASS_TRACK_TO_TRACK,
+        SEEK_CLASS_THIRD_STROKE,
+        SEEK_CLASS_FULL_STROKE,
+        SEEK_CLASS_COUNT
+    }eSeekClass;
+
+    typedef struct _seekLatencyStatistics
+    {
+        uint64_t numberOfCommands;
+        uint64_t minimumNanoSeconds;
+        uint64_t averageNanoSeconds;
+        uint64_t maximumNanoSeconds;
+        uint64_t p50NanoSeconds;
+        uint64_t p90NanoSeconds;
+        uint64_t p99NanoSeconds;
+    }seekLatencyStatistics;
+
+    typedef struct _seekDistanceBucket
+    {
+        uint64_t numberOfCommands;
+        uint64_t totalNanoSeconds;
+        uint64_t maximumNanoSeconds;
+    }seekDistanceBucket;
+
+    typedef struct _seekRangeProfile
+    {
+        uint8_t rangeNumber;
+        uint64_t startingLBA;
+        uint64_t numberOfLBAs;
+        seekLatencyStatistics seekClass[SEEK_CLASS_COUNT];
+        seekDistanceBucket distance[SEEK_PROFILE_DISTANCE_BUCKETS];//every command, including the ones that only position for a classified seek
+    }seekRangeProfile;
+
+    typedef struct _seekLatencyProfile
+    {
+        eRWVCommandType rwvCommand;
+        uint8_t numberOfRanges;//one per actuator when the drive reports concurrent positioning ranges, otherwise 1
+        uint64_t failingLBA;//UINT64_MAX when every command completed
+        seekRangeProfile range[ACTUATOR_PARALLEL_MAX_RANGES];
+    }seekLatencyProfile, *ptrSeekLatencyProfile;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  seek_Latency_Profile_Test()
+    //
+    //! \brief   Description:  Profiles positioning performance the way butterfly_Test and random_Test move the heads, but times every command.
+    //!                        Each seek class (track to track, third stroke, full stroke) is measured by positioning at a random LBA, then timing a one
+    //!                        sector command at the class distance from it. Every command's latency is also kept against its seek distance.
+    //!                        On drives with concurrent positioning ranges, each range (actuator) is profiled separately, inside its own LBAs.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] rwvCommand = read, write, or verify. Write overwrites the LBAs that are accessed!
+    //!   \param[in] timeLimitSeconds = total time to run, split evenly between ranges
+    //!   \param[out] profile = latency distributions
+    //!   \param[in] hideLBACounter = set to true to hide the LBA counter being printed to stdout
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, FAILURE = a command failed (see profile->failingLBA)
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int seek_Latency_Profile_Test(tDevice *device, eRWVCommandType rwvCommand, time_t timeLimitSeconds, ptrSeekLatencyProfile profile, bool hideLBACounter);
+
+    OPENSEA_OPERATIONS_API void print_Seek_Latency_Profile(ptrSeekLatencyProfile profile);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  write_Seek_Latency_Profile()
+    //
+    //! \brief   Description:  Writes a seek profile with a structured writer (JSON, CSV, XML) for other tools to read.
+    //
+    //  Entry:
+    //!   \param[in] profile = profile from seek_Latency_Profile_Test
+    //!   \param[in] writer = writer from init_Structured_Writer
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API void write_Seek_Latency_Profile(ptrSeekLatencyProfile profile, ptrStructuredWriter writer);
+
+    #define QUEUE_DEPTH_SWEEP_MAX_DEPTH 256
+    #define QUEUE_DEPTH_SWEEP_DEFAULT_MAX_DEPTH 32 //SATA NCQ limit
+    #define QUEUE_DEPTH_SWEEP_MAX_TRANSFER_SIZES 8
+    #define QUEUE_DEPTH_SWEEP_MAX_POINTS (9 * QUEUE_DEPTH_SWEEP_MAX_TRANSFER_SIZES) //queue depths 1, 2, 4...256 for each transfer size
+    #define QUEUE_DEPTH_SWEEP_LATENCY_SAMPLES 65536 //latencies kept per point for percentiles, split between the outstanding commands
+
+    typedef struct _queueDepthSweepOptions
+    {
+        uint16_t maxQueueDepth;//queue depths 1, 2, 4... up to this are measured. 0 uses QUEUE_DEPTH_SWEEP_DEFAULT_MAX_DEPTH
+        uint8_t numberOfTransferSizes;//0 measures 4096 bytes only
+        uint32_t transferSizeBytes[QUEUE_DEPTH_SWEEP_MAX_TRANSFER_SIZES];//rounded up to a whole number of logical sectors
+        uint8_t readPercent;//percent of commands that are reads. WARNING: anything below 100 writes over user data at random LBAs in the range!
+        uint32_t secondsPerPoint;//0 uses 10 seconds
+        uint64_t startingLBA;
+        uint64_t range;//0 uses the rest of the drive after startingLBA
+    }queueDepthSweepOptions, *ptrQueueDepthSweepOptions;
+
+    typedef struct _queueDepthSweepPoint
+    {
+        uint16_t queueDepth;
+        uint16_t queueDepthAchieved;//lower than queueDepth if not enough threads could be started or a SATA drive supports fewer NCQ tags
+        uint32_t transferSizeBytes;
+        uint64_t commands;
+        uint64_t failures;
+        double iops;
+        double megaBytesPerSecond;
+        uint64_t averageNanoSeconds;
+        uint64_t p50NanoSeconds;
+        uint64_t p90NanoSeconds;
+        uint64_t p99NanoSeconds;
+        uint64_t p999NanoSeconds;
+        uint64_t maximumNanoSeconds;
+    }queueDepthSweepPoint;
+
+    typedef struct _queueDepthSweepResults
+    {
+        uint8_t readPercent;
+        bool commandsQueued;//false for SATA drives that cannot use NCQ. These only take one command at a time, so only queue depth 1 is measured.
+        uint32_t numberOfPoints;
+        queueDepthSweepPoint point[QUEUE_DEPTH_SWEEP_MAX_POINTS];
+    }queueDepthSweepResults, *ptrQueueDepthSweepResults;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  queue_Depth_Sweep_Test()
+    //
+    //! \brief   Description:  Measures random IOPS, bandwidth, and latency at each queue depth and transfer size through the library's own command path.
+    //!                        On SAS, each outstanding command is a thread sending commands one after another on its own copy of the device, so
+    //!                        the OS and drive see that many commands at once. NVMe is the same, except on Linux where the commands are kept in flight
+    //!                        from one thread through the device's io_uring (see submit_NVMe_IO_Uring_Command) when the kernel supports it. On SATA, reads and writes are sent as FPDMA queued commands through an NCQ
+    //!                        queue (see open_NCQ_Queue) since the regular read and write commands cannot be queued. SATA drives without NCQ are only
+    //!                        measured at queue depth 1.
+    //!                        WARNING: when readPercent is below 100, writes go to random LBAs in the range and destroy the data there!
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] options = what to measure
+    //!   \param[out] results = one point for each queue depth and transfer size
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, FAILURE = some commands failed (counted in each point)
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int queue_Depth_Sweep_Test(tDevice *device, ptrQueueDepthSweepOptions options, ptrQueueDepthSweepResults results);
+
+    OPENSEA_OPERATIONS_API void print_Queue_Depth_Sweep_Results(ptrQueueDepthSweepResults results);
+
 #if defined (__cplusplus)
 }
 #endif
@@ -0,0 +1,187 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file health_snapshot.h
+// \brief This file defines the functions for reading a device's health information in one pass, reading each log/VPD page only once
+
+#pragma once
+
+#include "operations_Common.h"
+#include "drive_info.h"
+#include "smart.h"
+#include "device_statistics.h"
+#include "dst.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define HEALTH_SNAPSHOT_VERSION 1
+
+    //views that can be requested in a snapshot. OR these together in requestedViews
+    #define HEALTH_SNAPSHOT_DRIVE_INFO          BIT0 //get_ATA_Drive_Information, get_SCSI_Drive_Information, or get_NVMe_Drive_Information
+    #define HEALTH_SNAPSHOT_SMART_ATTRIBUTES    BIT1 //get_SMART_Attributes
+    #define HEALTH_SNAPSHOT_DEVICE_STATISTICS   BIT2 //get_DeviceStatistics
+    #define HEALTH_SNAPSHOT_DST_LOG             BIT3 //get_DST_Log_Entries
+    #define HEALTH_SNAPSHOT_DEFECT_COUNTS       BIT4 //get_Pending_List_Count and get_Grown_List_Count
+    #define HEALTH_SNAPSHOT_ALL_VIEWS           (HEALTH_SNAPSHOT_DRIVE_INFO | HEALTH_SNAPSHOT_SMART_ATTRIBUTES | HEALTH_SNAPSHOT_DEVICE_STATISTICS | HEALTH_SNAPSHOT_DST_LOG | HEALTH_SNAPSHOT_DEFECT_COUNTS)
+
+    typedef struct _healthSnapshot
+    {
+        size_t size;//set to sizeof(healthSnapshot)
+        uint32_t version;//set to HEALTH_SNAPSHOT_VERSION
+        uint32_t requestedViews;//set to the HEALTH_SNAPSHOT_ views to read
+        uint32_t validViews;//set to the views that were read successfully
+        //results from each view. Only look at the data when the bit for it is set in validViews
+        driveInformation driveInfo;
+        smartLogData smartData;
+        deviceStatistics deviceStats;
+        dstLogEntries dstEntries;
+        uint32_t pendingCount;
+        bool pendingCountValid;
+        uint32_t grownCount;
+        bool grownCountValid;
+        //how well the page cache did. pageCacheHits is the number of pages that did not need to be read from the device again.
+        uint32_t pageCacheHits;
+        uint32_t pageCacheMisses;
+    }healthSnapshot, *ptrHealthSnapshot;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Health_Snapshot()
+    //
+    //! \brief   Description:  Reads all the requested health views from a device at once. A page cache is attached to the device for the duration,
+    //!                        logs that several views need are read up front in as few commands as possible, and every view is decoded from the cache
+    //!                        so that Identify/VPD/log pages shared between views are only read from the device once.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in,out] snapshot = pointer to a snapshot with size, version, and requestedViews set. The rest is filled in.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = all requested views read, FAILURE = some views could not be read (see validViews), BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int get_Health_Snapshot(tDevice *device, ptrHealthSnapshot snapshot);
+
+    #define HEALTH_POLL_STATE_VERSION 1
+    #define HEALTH_POLL_MAX_PAGES 32 //most raw pages kept between polls for one device
+    #define HEALTH_POLL_MAX_SCSI_LOG_PAGES 16
+
+    typedef enum _eHealthCounterSource
+    {
+        HEALTH_COUNTER_ATA_SMART_ATTRIBUTE,//id = attribute number for the raw value, attribute number + 256 for the nominal value
+        HEALTH_COUNTER_ATA_DEVICE_STATISTIC,//id = (log page << 16) | byte offset of the statistic
+        HEALTH_COUNTER_SCSI_LOG_PARAMETER,//id = (page << 24) | (subpage << 16) | parameter code
+        HEALTH_COUNTER_NVME_SMART_LOG,//id = byte offset of the field in the SMART/health log
+    }eHealthCounterSource;
+
+    typedef struct _healthCounterChange
+    {
+        eHealthCounterSource source;
+        uint32_t id;
+        uint64_t previousValue;
+        uint64_t currentValue;
+        int64_t delta;//currentValue - previousValue. Can be negative for things like temperature.
+        double ratePerSecond;//delta over the time since the previous poll
+    }healthCounterChange, *ptrHealthCounterChange;
+
+    typedef struct _healthPollPage
+    {
+        eHealthCounterSource source;
+        uint32_t pageID;//0 for SMART data, log page number for device statistics, (page << 8) | subpage for SCSI, 0 for NVMe
+        uint32_t fingerprint;//CRC32C of the page. Pages with the same fingerprint as last time are not decoded.
+        uint32_t length;
+        uint8_t *data;
+    }healthPollPage;
+
+    //Keep one of these per device between polls. Start with it zeroed and size/version set, and free it with free_Health_Poll_State.
+    typedef struct _healthPollState
+    {
+        size_t size;//set to sizeof(healthPollState)
+        uint32_t version;//set to HEALTH_POLL_STATE_VERSION
+        bool baselineTaken;
+        seatimer_t intervalTimer;
+        double lastIntervalSeconds;
+        uint16_t ataDeviceStatisticsPages;//from the log directory on the first poll
+        uint8_t numberOfSCSILogPages;//counter pages the device supports, from the first poll
+        uint8_t scsiLogPages[HEALTH_POLL_MAX_SCSI_LOG_PAGES];
+        uint32_t pagesUnchanged;//pages that had the same fingerprint on the last poll
+        uint32_t pagesChanged;//pages that were decoded on the last poll
+        uint32_t numberOfPages;
+        healthPollPage pages[HEALTH_POLL_MAX_PAGES];
+    }healthPollState, *ptrHealthPollState;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  poll_Health_Counters()
+    //
+    //! \brief   Description:  Reads the raw SMART data, device statistics log, SCSI counter log pages, or NVMe SMART/health log, and reports only the counters
+    //!                        that changed since the previous poll, along with their rate of change. Each raw page is fingerprinted and pages that have not
+    //!                        changed are not decoded at all. The first poll of a state only records a baseline and reports no changes.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in,out] state = per device state kept between polls
+    //!   \param[out] changes = array to fill with the counters that changed. May be NULL if maxChanges is 0.
+    //!   \param[in] maxChanges = number of entries in changes
+    //!   \param[out] numberOfChanges = total number of counters that changed. If this is larger than maxChanges, only the first maxChanges were saved.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = polled, NOT_SUPPORTED = nothing to poll on this device, BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int poll_Health_Counters(tDevice *device, ptrHealthPollState state, ptrHealthCounterChange changes, uint32_t maxChanges, uint32_t *numberOfChanges);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  free_Health_Poll_State()
+    //
+    //! \brief   Description:  Frees the pages saved in a poll state and resets it so it can be used again for a new baseline.
+    //
+    //  Entry:
+    //!   \param[in,out] state = state to free
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API void free_Health_Poll_State(ptrHealthPollState state);
+
+    typedef struct _healthCounterValueEntry
+    {
+        eHealthCounterSource source;
+        uint32_t id;//same as healthCounterChange
+        uint64_t value;
+    }healthCounterValueEntry, *ptrHealthCounterValueEntry;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Health_Counter_Values()
+    //
+    //! \brief   Description:  Gets the current value of every counter saved in a poll state, not only the ones that changed. This is decoded from
+    //!                        the pages saved by the last poll_Health_Counters call so no commands are sent to the device.
+    //
+    //  Entry:
+    //!   \param[in] state = state that has been polled at least once
+    //!   \param[out] values = array to fill with the counter values. May be NULL if maxValues is 0.
+    //!   \param[in] maxValues = number of entries in values
+    //!   \param[out] numberOfValues = total number of counters. If this is larger than maxValues, only the first maxValues were saved.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int get_Health_Counter_Values(ptrHealthPollState state, ptrHealthCounterValueEntry values, uint32_t maxValues, uint32_t *numberOfValues);
+
+#if defined (__cplusplus)
+}
+#endif
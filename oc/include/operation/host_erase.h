@@ -41,6 +41,45 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_OPERATIONS_API int erase_Range(tDevice *device, uint64_t eraseRangeStart, uint64_t eraseRangeEnd, uint8_t *pattern, uint32_t patternLength, bool hideLBACounter);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  erase_Range_Checkpoint( tDevice * device )
+    //
+    //! \brief   Same as erase_Range, but saves the position (and pattern) to a checkpoint file about every TEST_CHECKPOINT_INTERVAL_SECONDS
+    //!          so an interrupted erase can be continued with resume_Erase_Range. The checkpoint file is removed when the erase completes.
+    //
+    //  Entry:
+    //!   \param device - file descriptor
+    //!   \param eraseRangeStart - the LBA to start the erase at
+    //!   \param eraseRangeEnd - the end LBA
+    //!   \param pattern - pointer to a buffer with a pattern to use.
+    //!   \param patternLength - length of the buffer pointed to by the pattern parameter. This must be at least 1 logical sector in size
+    //!   \param[in] hideLBACounter = set to true to hide the LBA counter being printed to stdout
+    //!   \param[in] checkpointFile = path of the checkpoint file to write
+    //!
+    //  Exit:
+    //!   \return SUCCESS = good, !SUCCESS something went wrong see error codes
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int erase_Range_Checkpoint(tDevice *device, uint64_t eraseRangeStart, uint64_t eraseRangeEnd, uint8_t *pattern, uint32_t patternLength, bool hideLBACounter, const char *checkpointFile);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  resume_Erase_Range( tDevice * device )
+    //
+    //! \brief   Continues an erase started with erase_Range_Checkpoint from its last checkpoint.
+    //
+    //  Entry:
+    //!   \param device - file descriptor
+    //!   \param[in] checkpointFile = path of the checkpoint file. It is updated as the erase continues and removed when it completes.
+    //!   \param[in] hideLBACounter = set to true to hide the LBA counter being printed to stdout
+    //!
+    //  Exit:
+    //!   \return SUCCESS = good, BAD_PARAMETER = checkpoint is not for this device, !SUCCESS something went wrong see error codes
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int resume_Erase_Range(tDevice *device, const char *checkpointFile, bool hideLBACounter);
+
     //-----------------------------------------------------------------------------
     //
     //  erase_Time( tDevice * device )
@@ -61,6 +100,70 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_OPERATIONS_API int erase_Time(tDevice *device, uint64_t eraseStartLBA, time_t eraseTime, uint8_t *pattern, uint32_t patternLength, bool hideLBACounter);
 
+    #define ERASE_RANGE_PIPELINE_DEPTH 2 //host writes kept outstanding at once by erase_Range_Offloaded so the drive is not idle between commands
+
+    typedef enum _eOffloadEraseCommand
+    {
+        OFFLOAD_ERASE_NONE,
+        OFFLOAD_ERASE_HOST_WRITES,//write commands with a host filled buffer
+        OFFLOAD_ERASE_SCSI_WRITE_SAME,
+        OFFLOAD_ERASE_ATA_SCT_WRITE_SAME,//runs in the background on the drive and is polled for completion
+        OFFLOAD_ERASE_ATA_ZEROS_EXT,
+        OFFLOAD_ERASE_NVME_WRITE_ZEROES,
+        OFFLOAD_ERASE_TRIM_UNMAP,//only when the device guarantees zeroes are read back from deallocated LBAs
+    }eOffloadEraseCommand;
+
+    //Filled in by erase_Range_Offloaded to show what was done and how fast it went.
+    typedef struct _eraseOffloadResult
+    {
+        eOffloadEraseCommand deviceCommand;//command chosen for the range. OFFLOAD_ERASE_NONE if everything was written by the host
+        uint64_t lbasErasedByDevice;
+        uint64_t lbasErasedByHost;//LBAs the device command could not handle (unsupported pattern or a command that failed) that were written by the host instead
+        uint64_t deviceNanoseconds;
+        uint64_t hostNanoseconds;
+        double megabytesPerSecond;//for the whole range
+    }eraseOffloadResult, *ptrEraseOffloadResult;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  erase_Range_Offloaded( tDevice * device )
+    //
+    //! \brief   Erase a range of LBAs, letting the drive do the writing when it can. The fastest command the drive supports for the pattern is chosen from
+    //!          NVMe Write Zeroes, ATA Zeros Ext, trim/unmap (only when deallocation is allowed and the drive reads zeroes back), SCSI write same, and ATA SCT write same.
+    //!          Patterns that do not fit in one logical sector, drives without any of these commands, and any part of the range where the command fails are
+    //!          written by the host with ERASE_RANGE_PIPELINE_DEPTH writes in flight from copies of the device (see clone_Device_For_Thread).
+    //!          If the copies cannot be made, the host writes one transfer at a time the same as erase_Range.
+    //
+    //  Entry:
+    //!   \param device - file descriptor
+    //!   \param eraseRangeStart - the LBA to start the erase at
+    //!   \param eraseRangeEnd - the end LBA (not erased, same as erase_Range). MAX64, or anything past the max LBA, erases to the end of the drive.
+    //!   \param pattern - pointer to a buffer with a pattern to use. NULL for zeroes.
+    //!   \param patternLength - length of the buffer pointed to by the pattern parameter
+    //!   \param[in] allowDeallocate = set to true to allow the drive to deallocate the range instead of writing it, as long as reads will return zeroes
+    //!   \param[in] hideLBACounter = set to true to hide the LBA counter being printed to stdout
+    //!   \param[out] result = optional. What was used to erase the range and the rate that was achieved.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = good, !SUCCESS something went wrong see error codes
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int erase_Range_Offloaded(tDevice *device, uint64_t eraseRangeStart, uint64_t eraseRangeEnd, uint8_t *pattern, uint32_t patternLength, bool allowDeallocate, bool hideLBACounter, ptrEraseOffloadResult result);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  print_Erase_Offload_Result( eraseOffloadResult result )
+    //
+    //! \brief   Prints which method erase_Range_Offloaded used and the rate it achieved.
+    //
+    //  Entry:
+    //!   \param[in] result - result from erase_Range_Offloaded
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API void print_Erase_Offload_Result(ptrEraseOffloadResult result);
+
 #if defined (__cplusplus)
 }
 #endif
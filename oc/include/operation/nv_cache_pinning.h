@@ -0,0 +1,168 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file nv_cache_pinning.h
+// \brief This file defines the functions for tracking how often LBAs are accessed and pinning the most accessed ones in the NV cache of a hybrid drive
+
+#pragma once
+
+#include "operations_Common.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define NV_CACHE_HEAT_MAP_DEFAULT_EXTENT_SIZE 2048 //logical blocks tracked as one unit. 1MiB on 512B sector drives.
+    #define NV_CACHE_HEAT_MAP_DEFAULT_MAX_EXTENTS 65536 //extents tracked before the map is decayed to make room
+    #define NV_CACHE_HEAT_MAP_DEFAULT_HYSTERESIS 25 //percent hotter an extent must be to replace one that is already pinned
+
+    typedef struct _nvCacheExtent
+    {
+        uint64_t extent;//starting LBA / extent size
+        uint32_t heat;//accesses, halved each time the map decays
+        bool pinned;
+        bool used;//hash table slot is in use
+    }nvCacheExtent;
+
+    //Accesses are counted per extent in a hash table that only holds extents that have been accessed. When it fills, every count is halved and
+    //extents that drop to zero are removed, so older accesses count less than recent ones.
+    typedef struct _nvCacheHeatMap
+    {
+        uint16_t extentSize;//logical blocks. Limited to what one NV cache LBA range entry can hold.
+        uint64_t maxLBA;
+        uint64_t pinnedCapacity;//logical blocks that can be pinned. From identify words 215-216 unless the caller sets a smaller value.
+        uint64_t pinnedBlocks;//logical blocks currently pinned by extents in this map
+        uint32_t maxExtents;
+        uint32_t numberOfExtents;
+        uint32_t tableSize;//power of 2, at least twice maxExtents
+        nvCacheExtent *table;
+        uint32_t decays;
+        uint8_t hysteresisPercent;
+    }nvCacheHeatMap, *ptrNVCacheHeatMap;
+
+    typedef struct _nvCachePinningResult
+    {
+        uint32_t extentsPinned;//added to the pinned set in this update
+        uint32_t extentsUnpinned;//removed from the pinned set in this update
+        uint32_t extentsKept;//were already pinned and still hot enough
+        uint64_t pinnedBlocks;//total after the update
+    }nvCachePinningResult, *ptrNVCachePinningResult;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  create_NV_Cache_Heat_Map()
+    //
+    //! \brief   Description:  Sets up an empty heat map for a hybrid drive and reads the drive's current pinned set into it,
+    //!                        so that LBAs pinned in an earlier run are tracked and can be unpinned once they go cold. These start with the lowest heat
+    //!                        that keeps them pinned, so they stay until hotter extents need the room or they decay to zero without being accessed.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] extentSize = logical blocks per extent. 0 uses NV_CACHE_HEAT_MAP_DEFAULT_EXTENT_SIZE.
+    //!   \param[in] maxExtents = extents to track. 0 uses NV_CACHE_HEAT_MAP_DEFAULT_MAX_EXTENTS.
+    //!   \param[out] heatMap = map to setup. Free it with free_NV_Cache_Heat_Map.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED = not an ATA drive or the drive does not have an NV cache, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int create_NV_Cache_Heat_Map(tDevice *device, uint16_t extentSize, uint32_t maxExtents, ptrNVCacheHeatMap heatMap);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  record_NV_Cache_Access()
+    //
+    //! \brief   Description:  Adds one access to every extent a range of LBAs touches.
+    //
+    //  Entry:
+    //!   \param[in] heatMap = map from create_NV_Cache_Heat_Map
+    //!   \param[in] lba = first LBA accessed
+    //!   \param[in] count = number of LBAs accessed
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int record_NV_Cache_Access(ptrNVCacheHeatMap heatMap, uint64_t lba, uint64_t count);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  read_NV_Cache_Access_Trace()
+    //
+    //! \brief   Description:  Records every access in a text trace file. Each line is a starting LBA and a count separated by whitespace.
+    //!                        Lines that do not start with a number, such as comments, are skipped.
+    //
+    //  Entry:
+    //!   \param[in] heatMap = map from create_NV_Cache_Heat_Map
+    //!   \param[in] traceFile = path to the trace file
+    //!   \param[out] accessesRead = optional count of accesses recorded
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, FILE_OPEN_ERROR
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int read_NV_Cache_Access_Trace(ptrNVCacheHeatMap heatMap, const char *traceFile, uint64_t *accessesRead);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  record_NV_Cache_Misses()
+    //
+    //! \brief   Description:  Reads the LBA ranges the drive most recently missed in its NV cache (Query NV Cache Misses) and records each as an access.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] heatMap = map from create_NV_Cache_Heat_Map
+    //!   \param[out] rangesRead = optional count of miss ranges recorded
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, or the error from the command
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int record_NV_Cache_Misses(tDevice *device, ptrNVCacheHeatMap heatMap, uint32_t *rangesRead);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  update_NV_Cache_Pinned_Set()
+    //
+    //! \brief   Description:  Picks the hottest extents that fit in the pinned capacity and changes the drive's pinned set to match. Only the difference
+    //!                        from the last update is sent: extents that went cold are removed, then newly hot extents are added. Extents that are already
+    //!                        pinned are treated as hysteresisPercent hotter so that extents with similar heat do not keep trading places.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] heatMap = map from create_NV_Cache_Heat_Map
+    //!   \param[in] populateImmediately = have the drive copy newly pinned LBAs into the NV cache now instead of on their next access
+    //!   \param[out] result = optional count of changes made
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, or the error from the command. The map reflects whatever was changed before an error.
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int update_NV_Cache_Pinned_Set(tDevice *device, ptrNVCacheHeatMap heatMap, bool populateImmediately, ptrNVCachePinningResult result);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  free_NV_Cache_Heat_Map()
+    //
+    //! \brief   Description:  Frees the memory of a heat map. The drive's pinned set is not changed.
+    //
+    //  Entry:
+    //!   \param[in] heatMap = map from create_NV_Cache_Heat_Map
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API void free_NV_Cache_Heat_Map(ptrNVCacheHeatMap heatMap);
+
+#if defined (__cplusplus)
+}
+#endif
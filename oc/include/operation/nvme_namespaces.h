@@ -0,0 +1,183 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file nvme_namespaces.h
+// \brief This file defines the functions for running the same operation on every namespace of an NVMe controller at the same time
+
+#pragma once
+
+#if !defined(DISABLE_NVME_PASSTHROUGH)
+#include "operations_Common.h"
+#include "format.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define NVME_MAX_NAMESPACE_LIST 1024 //namespace IDs returned by one identify active namespace list command
+    #define NVME_NAMESPACE_DEFAULT_THREADS 16 //namespaces worked on at the same time when the caller does not set a limit
+
+    typedef struct _nvmeNamespaceList
+    {
+        uint32_t numberOfNamespaces;
+        uint32_t namespaceIDs[NVME_MAX_NAMESPACE_LIST];//in increasing order
+    }nvmeNamespaceList, *ptrNVMeNamespaceList;
+
+    //Runs the work for one namespace. namespaceDevice is private to this call and its namespaceID and namespace identify data are for the namespace.
+    //namespaceIndex is the namespace's index in the list, so that each call can use its own part of an array in the context. Routines run on
+    //different threads at the same time, so anything else in the context they change must be protected.
+    typedef int (*nvmeNamespaceRoutine)(tDevice *namespaceDevice, uint32_t namespaceIndex, void *context);
+
+    typedef struct _nvmeNamespaceResult
+    {
+        uint32_t namespaceID;
+        int result;//SUCCESS, or the error from the routine or from opening the namespace
+        uint64_t timeNanoSeconds;
+    }nvmeNamespaceResult;
+
+    typedef struct _nvmeNamespaceResults
+    {
+        uint32_t numberOfNamespaces;
+        uint32_t namespacesPassed;
+        uint32_t namespacesNotSupported;
+        uint32_t namespacesFailed;//any result other than SUCCESS or NOT_SUPPORTED
+        bool ranInParallel;//false when threads were not available and namespaces were done one at a time
+        uint64_t totalTimeNanoSeconds;//time for all namespaces together
+        nvmeNamespaceResult namespaces[NVME_MAX_NAMESPACE_LIST];//same order as the namespace list
+    }nvmeNamespaceResults, *ptrNVMeNamespaceResults;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_NVMe_Active_Namespace_List()
+    //
+    //! \brief   Description:  Reads the IDs of every active namespace on the controller with one identify active namespace list command (CNS 02h).
+    //!                        Only the first NVME_MAX_NAMESPACE_LIST namespaces are listed on controllers with more than that. Controllers older than
+    //!                        NVMe 1.1, or that reject the command as an invalid field, do not have the list, so namespaces 1 through NN are listed instead.
+    //
+    //  Entry:
+    //!   \param[in] device = any handle on the NVMe controller
+    //!   \param[out] namespaces = list to fill in
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED = not an NVMe device, MEMORY_FAILURE, or the error from the identify command
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int get_NVMe_Active_Namespace_List(tDevice *device, ptrNVMeNamespaceList namespaces);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  run_On_NVMe_Namespaces()
+    //
+    //! \brief   Description:  Runs a routine for each namespace in a list, on up to maxThreads namespaces at the same time, and collects the results.
+    //!                        For admin commands, each routine gets a copy of the device (see clone_Device_For_Thread) with the namespace ID and
+    //!                        namespace identify data changed. IO commands are only accepted on a handle opened for the namespace on some OSes, so
+    //!                        when ioCommands is set, each other namespace's own handle is opened instead. This is only done on Linux today; on other
+    //!                        OSes, namespaces other than the device's own are reported as NOT_SUPPORTED when ioCommands is set.
+    //
+    //  Entry:
+    //!   \param[in] device = any handle on the NVMe controller. It must not be used by anything else until this returns.
+    //!   \param[in] namespaces = namespaces to run on. NULL reads the active namespace list from the controller.
+    //!   \param[in] routine = work to do on each namespace
+    //!   \param[in] context = passed to each call of the routine
+    //!   \param[in] ioCommands = set when the routine sends NVM (IO) commands such as reads or deallocate. Admin only routines leave this false.
+    //!   \param[in] maxThreads = namespaces worked on at the same time. 0 uses NVME_NAMESPACE_DEFAULT_THREADS.
+    //!   \param[out] results = result for each namespace and totals for the controller
+    //!
+    //  Exit:
+    //!   \return SUCCESS = routine passed on every namespace, FAILURE = one or more namespaces did not pass (check results), BAD_PARAMETER,
+    //!           NOT_SUPPORTED = not an NVMe device, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int run_On_NVMe_Namespaces(tDevice *device, ptrNVMeNamespaceList namespaces, nvmeNamespaceRoutine routine, void *context, bool ioCommands, uint32_t maxThreads, ptrNVMeNamespaceResults results);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  run_NVMe_Format_On_Namespaces()
+    //
+    //! \brief   Description:  Formats each namespace separately and at the same time with run_NVMe_Format. The format number, if given, must be valid
+    //!                        on every namespace. Controllers that can only format (or secure erase) all namespaces together must use run_NVMe_Format with
+    //!                        currentNamespace cleared instead. If the device's own namespace is formatted, its identify data, block size and max LBA are read again.
+    //
+    //  Entry:
+    //!   \param[in] device = any handle on the NVMe controller
+    //!   \param[in] namespaces = namespaces to format. NULL formats every active namespace.
+    //!   \param[in] nvmParams = format settings. currentNamespace is ignored.
+    //!   \param[in] maxThreads = namespaces formatted at the same time. 0 uses NVME_NAMESPACE_DEFAULT_THREADS.
+    //!   \param[out] results = result for each namespace
+    //!
+    //  Exit:
+    //!   \return SUCCESS, FAILURE = one or more namespaces failed, BAD_PARAMETER, NOT_SUPPORTED = the controller does not format namespaces separately
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int run_NVMe_Format_On_Namespaces(tDevice *device, ptrNVMeNamespaceList namespaces, runNVMFormatParameters nvmParams, uint32_t maxThreads, ptrNVMeNamespaceResults results);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_NVMe_SMART_Log_For_Namespaces()
+    //
+    //! \brief   Description:  Reads the SMART / health log of each namespace at the same time.
+    //
+    //  Entry:
+    //!   \param[in] device = any handle on the NVMe controller
+    //!   \param[in] namespaces = namespaces to read. NULL reads every active namespace.
+    //!   \param[out] smartLogs = array with an entry for each namespace, in the same order as the namespace list
+    //!   \param[in] numberOfSmartLogs = number of entries in smartLogs. Must be at least the number of namespaces.
+    //!   \param[in] maxThreads = namespaces read at the same time. 0 uses NVME_NAMESPACE_DEFAULT_THREADS.
+    //!   \param[out] results = result for each namespace
+    //!
+    //  Exit:
+    //!   \return SUCCESS, FAILURE = one or more namespaces failed, BAD_PARAMETER, NOT_SUPPORTED = the controller only reports the log for all namespaces together
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int get_NVMe_SMART_Log_For_Namespaces(tDevice *device, ptrNVMeNamespaceList namespaces, nvmeSmartLog *smartLogs, uint32_t numberOfSmartLogs, uint32_t maxThreads, ptrNVMeNamespaceResults results);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  nvme_Deallocate_Namespaces()
+    //
+    //! \brief   Description:  Deallocates every LBA of each namespace at the same time with nvme_Deallocate_Range.
+    //
+    //  Entry:
+    //!   \param[in] device = any handle on the NVMe controller
+    //!   \param[in] namespaces = namespaces to deallocate. NULL deallocates every active namespace.
+    //!   \param[in] maxThreads = namespaces deallocated at the same time. 0 uses NVME_NAMESPACE_DEFAULT_THREADS.
+    //!   \param[out] results = result for each namespace
+    //!
+    //  Exit:
+    //!   \return SUCCESS, FAILURE = one or more namespaces failed, BAD_PARAMETER, NOT_SUPPORTED
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int nvme_Deallocate_Namespaces(tDevice *device, ptrNVMeNamespaceList namespaces, uint32_t maxThreads, ptrNVMeNamespaceResults results);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  short_Generic_Read_Test_On_Namespaces()
+    //
+    //! \brief   Description:  Runs short_Generic_Read_Test on each namespace at the same time. The LBA counter is not shown since the namespaces run together.
+    //
+    //  Entry:
+    //!   \param[in] device = any handle on the NVMe controller
+    //!   \param[in] namespaces = namespaces to test. NULL tests every active namespace.
+    //!   \param[in] maxThreads = namespaces tested at the same time. 0 uses NVME_NAMESPACE_DEFAULT_THREADS.
+    //!   \param[out] results = result for each namespace
+    //!
+    //  Exit:
+    //!   \return SUCCESS, FAILURE = one or more namespaces failed, BAD_PARAMETER, NOT_SUPPORTED
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int short_Generic_Read_Test_On_Namespaces(tDevice *device, ptrNVMeNamespaceList namespaces, uint32_t maxThreads, ptrNVMeNamespaceResults results);
+
+#if defined (__cplusplus)
+}
+#endif
+
+#endif //DISABLE_NVME_PASSTHROUGH
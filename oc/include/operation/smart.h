@@ -80,6 +80,22 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_OPERATIONS_API int print_SMART_Attributes(tDevice *device, eSMARTAttrOutMode outputMode);
 
+    //-----------------------------------------------------------------------------
+    //
+    // write_SMART_Attributes( tDevice * device, ptrStructuredWriter writer )
+    //
+    //! \brief   Pulls the SMART attributes and writes them to a structured writer (JSON, CSV, XML, or text). Raw values are written as numbers.
+    //
+    //  Entry:
+    //!   \param[in]  device file descriptor
+    //!   \param[in] writer - structured writer setup with init_Structured_Writer
+    //
+    //  Exit:
+    //!   \return SUCCESS = good, !SUCCESS something went wrong see error codes
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int write_SMART_Attributes(tDevice *device, ptrStructuredWriter writer);
+
     typedef enum _eSMARTTripInfoType
     {
         SMART_TRIP_INFO_TYPE_UNKNOWN,
@@ -193,6 +209,7 @@ extern "C"
     //  is_SMART_Enabled(tDevice *device)
     //
     //! \brief   Description:  Function to check if SMART is enabled on a device
+    //!          The result is cached in device->drive_info.capabilities until invalidate_Capability_Cache() is called.
     //
     //  Entry:
     //!   \param device - pointer to the device structure
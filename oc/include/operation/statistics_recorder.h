@@ -0,0 +1,213 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file statistics_recorder.h
+// \brief This file defines the functions for recording device counters over time into a compact binary file and reading them back by time range
+
+#pragma once
+
+#include "operations_Common.h"
+#include "health_snapshot.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define STATISTICS_RECORDING_VERSION 1
+
+    //default number of samples kept in memory before they are encoded and appended to the file as one block. At one sample a minute, this is one block per day.
+    #define STATISTICS_RECORDER_DEFAULT_SAMPLES_PER_BLOCK 1440
+
+    //Column keys used by record_Health_Counters. Other callers can use any 64bit key they want as long as it is used consistently in one file.
+    #define STATISTICS_RECORDER_HEALTH_COUNTER_KEY(source, id) ((C_CAST(uint64_t, source) << 32) | C_CAST(uint64_t, id))
+
+    //Samples are held in memory in columns (one per counter) and written out in blocks. In each block, every column is stored as its first value followed by
+    //the change from the previous sample, and runs of samples where the counter did not change are stored as a single count. Counters that rarely change
+    //take a few bytes per block no matter how many samples are in it.
+    typedef struct _statisticsRecorder
+    {
+        FILE *file;
+        uint32_t samplesPerBlock;
+        uint32_t numberOfSamples;//samples waiting to be written
+        uint32_t numberOfColumns;
+        uint32_t columnsAllocated;
+        uint64_t *columnKeys;//sorted
+        uint64_t *currentValues;//last value seen for each column. Columns left out of a sample keep this value.
+        uint64_t *timestamps;//samplesPerBlock entries
+        uint64_t *values;//column major: values[column * samplesPerBlock + sample]
+        uint64_t lastTimestamp;
+        uint32_t blocksWritten;
+    }statisticsRecorder, *ptrStatisticsRecorder;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  open_Statistics_Recorder()
+    //
+    //! \brief   Description:  Opens a recording file to add samples to. A new file is created if it does not exist. An existing file must have been
+    //!                        made for the same device (serial number).
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor. The serial and model numbers are saved in the file.
+    //!   \param[in] recordingFile = path to the recording file. Use one file per device.
+    //!   \param[in] samplesPerBlock = samples to keep in memory before writing. 0 uses STATISTICS_RECORDER_DEFAULT_SAMPLES_PER_BLOCK.
+    //!   \param[out] recorder = recorder to setup
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER = file was recorded for a different device, FILE_OPEN_ERROR, ERROR_WRITING_FILE, NOT_SUPPORTED = unknown file version, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int open_Statistics_Recorder(tDevice *device, const char *recordingFile, uint32_t samplesPerBlock, ptrStatisticsRecorder recorder);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  record_Statistics_Sample()
+    //
+    //! \brief   Description:  Adds one sample. Columns that are not in this sample keep their last value. When enough samples are saved, or a column that has
+    //!                        not been seen before is added, the saved samples are written to the file.
+    //
+    //  Entry:
+    //!   \param[in] recorder = recorder from open_Statistics_Recorder
+    //!   \param[in] timestamp = time of this sample. Must not be earlier than the previous sample. Units are up to the caller (seconds since the epoch is suggested).
+    //!   \param[in] numberOfValues = number of entries in columnKeys and values
+    //!   \param[in] columnKeys = key for each value
+    //!   \param[in] values = value of each column
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER = timestamp went backwards, MEMORY_FAILURE, ERROR_WRITING_FILE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int record_Statistics_Sample(ptrStatisticsRecorder recorder, uint64_t timestamp, uint32_t numberOfValues, const uint64_t *columnKeys, const uint64_t *values);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  record_Health_Counters()
+    //
+    //! \brief   Description:  Polls a device with poll_Health_Counters and records every counter it reports (SMART attributes, device statistics,
+    //!                        SCSI counter log pages, or the NVMe SMART/health log) as one sample. Column keys are made with STATISTICS_RECORDER_HEALTH_COUNTER_KEY.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in,out] state = poll state for this device. See poll_Health_Counters.
+    //!   \param[in] recorder = recorder from open_Statistics_Recorder
+    //!   \param[in] timestamp = time of this sample
+    //!
+    //  Exit:
+    //!   \return SUCCESS, or an error from poll_Health_Counters or record_Statistics_Sample
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int record_Health_Counters(tDevice *device, ptrHealthPollState state, ptrStatisticsRecorder recorder, uint64_t timestamp);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  flush_Statistics_Recorder()
+    //
+    //! \brief   Description:  Writes any samples still in memory to the file now.
+    //
+    //  Entry:
+    //!   \param[in] recorder = recorder from open_Statistics_Recorder
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, ERROR_WRITING_FILE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int flush_Statistics_Recorder(ptrStatisticsRecorder recorder);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  close_Statistics_Recorder()
+    //
+    //! \brief   Description:  Writes any samples still in memory, closes the file, and frees the recorder's memory.
+    //
+    //  Entry:
+    //!   \param[in] recorder = recorder from open_Statistics_Recorder
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, ERROR_WRITING_FILE = the last samples could not be written
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int close_Statistics_Recorder(ptrStatisticsRecorder recorder);
+
+    typedef struct _statisticsRecordingBlock
+    {
+        size_t offset;//offset of the block's payload in the file
+        uint32_t payloadLength;
+        uint32_t numberOfSamples;
+        uint32_t numberOfColumns;
+        uint64_t firstTimestamp;
+        uint64_t lastTimestamp;
+    }statisticsRecordingBlock;
+
+    typedef struct _statisticsRecording
+    {
+        readOnlyFileMapping mapping;
+        char serialNumber[SERIAL_NUM_LEN + 1];
+        char modelNumber[MODEL_NUM_LEN + 1];
+        uint32_t numberOfBlocks;
+        statisticsRecordingBlock *blocks;//index of every block in the file, in time order
+        uint32_t corruptBlocksSkipped;//blocks that failed their CRC check, usually from being interrupted while writing
+    }statisticsRecording, *ptrStatisticsRecording;
+
+    //Called for each sample read by scan_Statistics_Recording. The arrays are only valid during the call. Return true to stop the scan.
+    typedef bool (*statisticsSampleCallback)(void *callbackData, uint64_t timestamp, uint32_t numberOfColumns, const uint64_t *columnKeys, const uint64_t *values);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  open_Statistics_Recording()
+    //
+    //! \brief   Description:  Maps a recording file into memory and builds an index of its blocks so that time ranges can be found without decoding the file.
+    //
+    //  Entry:
+    //!   \param[in] recordingFile = path to the recording file
+    //!   \param[out] recording = recording to setup. Free it with close_Statistics_Recording.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, FILE_OPEN_ERROR, INVALID_LENGTH = not a recording, WARN_INVALID_CHECKSUM = file header is corrupt, NOT_SUPPORTED = unknown version or file mapping not supported, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int open_Statistics_Recording(const char *recordingFile, ptrStatisticsRecording recording);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  scan_Statistics_Recording()
+    //
+    //! \brief   Description:  Calls a function for every sample recorded between two times. Only the blocks that overlap the range are decoded.
+    //
+    //  Entry:
+    //!   \param[in] recording = recording from open_Statistics_Recording
+    //!   \param[in] startTime = first time to include
+    //!   \param[in] endTime = last time to include
+    //!   \param[in] callback = function to call for each sample
+    //!   \param[in] callbackData = passed to the callback
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, ABORTED = callback stopped the scan, WARN_INVALID_CHECKSUM = a block could not be decoded
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int scan_Statistics_Recording(ptrStatisticsRecording recording, uint64_t startTime, uint64_t endTime, statisticsSampleCallback callback, void *callbackData);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  close_Statistics_Recording()
+    //
+    //! \brief   Description:  Unmaps a recording file and frees its index.
+    //
+    //  Entry:
+    //!   \param[in] recording = recording from open_Statistics_Recording
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API void close_Statistics_Recording(ptrStatisticsRecording recording);
+
+#if defined (__cplusplus)
+}
+#endif
@@ -0,0 +1,107 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file streaming_workload.h
+// \brief This file defines the functions for running a multi-stream recording workload with the ATA streaming feature set and measuring deadline misses
+
+#pragma once
+
+#include "operations_Common.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define STREAMING_WORKLOAD_MAX_STREAMS 8 //stream IDs are 3 bits
+    #define STREAMING_WORKLOAD_DEFAULT_TRANSFER_SIZE 524288 //bytes per write stream command
+    #define STREAMING_WORKLOAD_LATENCY_SAMPLES 65536 //latencies kept per stream for percentiles
+
+    typedef struct _streamingWorkloadOptions
+    {
+        uint8_t numberOfStreams;//1 to STREAMING_WORKLOAD_MAX_STREAMS
+        uint32_t kilobitsPerSecond;//target bitrate of each stream
+        uint32_t deadlineMicroseconds;//command completion time limit (CCTL) for each write. 0 = no limit is sent to the drive, and misses are counted against the time each command can take for every stream to keep up.
+        uint32_t transferSizeBytes;//bytes per command. Rounded down to a whole number of logical sectors. 0 = STREAMING_WORKLOAD_DEFAULT_TRANSFER_SIZE
+        uint32_t durationSeconds;
+        uint64_t startingLBA;
+        uint64_t range;//LBAs to use, split evenly between the streams. 0 = to the end of the drive
+        bool writeContinuous;//the drive completes each command by its deadline even if it could not write all the data, and logs what it missed in the write stream error log
+    }streamingWorkloadOptions, *ptrStreamingWorkloadOptions;
+
+    typedef struct _streamStatistics
+    {
+        uint8_t streamID;
+        uint64_t startingLBA;
+        uint64_t numberOfLBAs;
+        uint64_t commands;
+        uint64_t bytesWritten;
+        uint64_t deadlineMisses;//host measured completion time was over the deadline
+        uint64_t completionTimeouts;//drive reported it could not complete in the CCTL (error register bit 0)
+        uint64_t streamErrorsReported;//write continuous commands the drive completed with the stream error bit set
+        uint64_t failures;//any other error
+        uint64_t lateStarts;//commands sent more than a deadline after they were due because earlier commands had not finished
+        uint64_t minimumNanoSeconds;
+        uint64_t averageNanoSeconds;
+        uint64_t p99NanoSeconds;
+        uint64_t maximumNanoSeconds;
+        double achievedKilobitsPerSecond;
+    }streamStatistics;
+
+    typedef struct _streamingWorkloadResults
+    {
+        uint8_t numberOfStreams;
+        uint32_t transferSizeBytes;
+        uint32_t kilobitsPerSecond;
+        uint32_t deadlineMicroseconds;//deadline used to count misses
+        uint32_t granularityMicroseconds;//stream performance granularity from identify words 98-99
+        uint8_t commandCCTL;//CCTL sent with each command. 0 = none
+        streamStatistics stream[STREAMING_WORKLOAD_MAX_STREAMS];
+    }streamingWorkloadResults, *ptrStreamingWorkloadResults;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  streaming_Workload_Test()
+    //
+    //! \brief   Description:  Runs a multi-stream recording workload like surveillance video ingest. Each stream is configured on the drive with Configure Stream,
+    //!                        then given its own part of the range to write sequentially, wrapping at the end. Writes are scheduled at the target bitrate of each
+    //!                        stream and interleaved in the order they come due. Each write stream command is timed and compared against the deadline.
+    //!                        Stream commands cannot be queued, so the commands are sent one at a time. The streams are removed from the drive when done.
+    //!                        WARNING: This overwrites the data in the range!
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] options = streams, bitrate, deadline, and range to use
+    //!   \param[out] results = statistics for each stream
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED = not an ATA drive or the streaming feature set is not supported, MEMORY_FAILURE, FAILURE = a stream could not be configured
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int streaming_Workload_Test(tDevice *device, ptrStreamingWorkloadOptions options, ptrStreamingWorkloadResults results);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  print_Streaming_Workload_Results()
+    //
+    //! \brief   Description:  Prints a table of the statistics for each stream from streaming_Workload_Test
+    //
+    //  Entry:
+    //!   \param[in] results = results to print
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API void print_Streaming_Workload_Results(ptrStreamingWorkloadResults results);
+
+#if defined (__cplusplus)
+}
+#endif
@@ -0,0 +1,157 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file test_checkpoint.h
+// \brief This file defines the functions for saving and loading checkpoints so that long running tests can be resumed after being interrupted
+
+#pragma once
+
+#include "operations_Common.h"
+#include "sector_repair.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define TEST_CHECKPOINT_VERSION 1
+
+    //how often the long running tests save their progress
+    #define TEST_CHECKPOINT_INTERVAL_SECONDS 60
+
+    typedef enum _eCheckpointTestType
+    {
+        CHECKPOINT_TEST_UNKNOWN,
+        CHECKPOINT_TEST_SEQUENTIAL_RWV,//user_Sequential_Test and long_Generic_Test. testMode holds the eRWVCommandType
+        CHECKPOINT_TEST_ERASE_RANGE,//erase_Range. pattern holds the pattern being written, if any
+        CHECKPOINT_TEST_DST_AND_CLEAN,//run_DST_And_Clean. errorList holds everything repaired so far
+    }eCheckpointTestType;
+
+    typedef struct _testCheckpoint
+    {
+        eCheckpointTestType testType;
+        uint32_t testMode;//test specific value. See eCheckpointTestType
+        char serialNumber[SERIAL_NUM_LEN + 1];//serial number of the device this checkpoint was made on. Used to refuse resuming on a different device.
+        uint64_t deviceMaxLba;//also used to refuse resuming on a different device or after the capacity changed.
+        uint64_t startingLBA;//where the test was originally started
+        uint64_t endingLBA;//where the test stops. This LBA is not accessed.
+        uint64_t currentLBA;//the next LBA to access when resuming
+        uint64_t elapsedSeconds;//how long the test has run across all previous runs
+        uint16_t errorLimit;
+        bool stopOnError;
+        bool repairOnTheFly;
+        bool repairAtEnd;
+        uint64_t errorCount;//number of entries in errorList
+        ptrErrorLBA errorList;//when loading, this is allocated and must be freed with free_Test_Checkpoint. It is allocated to hold errorLimit + 1 entries (at least errorCount) so it can be used directly to resume.
+        uint32_t patternLength;
+        uint8_t *pattern;//when loading, this is allocated and must be freed with free_Test_Checkpoint
+    }testCheckpoint, *ptrTestCheckpoint;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  init_Test_Checkpoint()
+    //
+    //! \brief   Description:  Sets up a checkpoint structure for a new test on a device. The serial number and max LBA are filled in from the device.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[out] checkpoint = pointer to the checkpoint to setup
+    //!   \param[in] testType = which test is being checkpointed
+    //!   \param[in] startingLBA = first LBA of the test
+    //!   \param[in] endingLBA = LBA the test stops at (not accessed)
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API void init_Test_Checkpoint(tDevice *device, ptrTestCheckpoint checkpoint, eCheckpointTestType testType, uint64_t startingLBA, uint64_t endingLBA);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  save_Test_Checkpoint()
+    //
+    //! \brief   Description:  Saves a checkpoint to a file. The file is written to a temporary file first, flushed to disk, then renamed over the
+    //!                        old checkpoint so that an interruption while saving always leaves either the old or the new checkpoint behind.
+    //
+    //  Entry:
+    //!   \param[in] checkpointFile = path to the checkpoint file
+    //!   \param[in] checkpoint = pointer to the checkpoint to save
+    //!
+    //  Exit:
+    //!   \return SUCCESS = saved, BAD_PARAMETER, MEMORY_FAILURE, FILE_OPEN_ERROR, ERROR_WRITING_FILE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int save_Test_Checkpoint(const char *checkpointFile, ptrTestCheckpoint checkpoint);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  load_Test_Checkpoint()
+    //
+    //! \brief   Description:  Loads a checkpoint from a file and checks that it is not corrupt.
+    //
+    //  Entry:
+    //!   \param[in] checkpointFile = path to the checkpoint file
+    //!   \param[out] checkpoint = pointer to the checkpoint to fill in. Free it with free_Test_Checkpoint when done.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = loaded, NOT_SUPPORTED = unknown checkpoint version, FILE_OPEN_ERROR, INVALID_LENGTH = file is truncated, WARN_INVALID_CHECKSUM = file is corrupt, BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int load_Test_Checkpoint(const char *checkpointFile, ptrTestCheckpoint checkpoint);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  free_Test_Checkpoint()
+    //
+    //! \brief   Description:  Frees memory allocated by load_Test_Checkpoint
+    //
+    //  Entry:
+    //!   \param[in] checkpoint = pointer to the checkpoint
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API void free_Test_Checkpoint(ptrTestCheckpoint checkpoint);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  is_Checkpoint_For_Device()
+    //
+    //! \brief   Description:  Checks that a loaded checkpoint was made for this device, with the same capacity, and for the expected test.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] checkpoint = pointer to the loaded checkpoint
+    //!   \param[in] testType = which test is about to be resumed
+    //!
+    //  Exit:
+    //!   \return true = checkpoint can be used to resume on this device, false = it cannot
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API bool is_Checkpoint_For_Device(tDevice *device, ptrTestCheckpoint checkpoint, eCheckpointTestType testType);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  remove_Test_Checkpoint()
+    //
+    //! \brief   Description:  Deletes a checkpoint file. Tests call this when they complete so that a later resume does not repeat them.
+    //
+    //  Entry:
+    //!   \param[in] checkpointFile = path to the checkpoint file
+    //!
+    //  Exit:
+    //!   \return SUCCESS = removed or did not exist, FAILURE = could not be removed
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_OPERATIONS_API int remove_Test_Checkpoint(const char *checkpointFile);
+
+#if defined (__cplusplus)
+}
+#endif
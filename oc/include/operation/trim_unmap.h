@@ -26,6 +26,7 @@ extern "C"
     //  is_Trim_Or_Unmap_Supported( tDevice * device )
     //
     //! \brief   Get whether a device supports TRIM (ATA) or UNMAP (SCSI) commands. Can also tell you how many descriptors can be specified in the command.
+    //!          The result is cached in device->drive_info.capabilities until invalidate_Capability_Cache() is called.
     //
     //  Entry:
     //!   \param device - file descriptor
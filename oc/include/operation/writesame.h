@@ -26,6 +26,8 @@ extern "C"
     // is_Write_Same_Supported
     //
     //! \brief   This function checks if the device supports write same. On SCSI, it returns the max number of logical blocks per command, which is reported in an inquiry page. On ATA, this will return MaxLBA - startLBA and whether SCT write same is supported or not
+    //!          What the device reports is cached in device->drive_info.capabilities until invalidate_Capability_Cache() is called. The requested range is
+    //!          checked against the cached block limits on every call, so false is returned when it is longer than the device accepts in one command.
     //
     //  Entry:
     //!   \param[in] device = file descriptor
@@ -34,7 +36,7 @@ extern "C"
     //!   \param[out] maxNumberOfLogicalBlocksPerCommand = this is the range the device supports in a single write same command (0 means that there is no limit)
     //!
     //  Exit:
-    //!   \return SUCCESS = good, !SUCCESS something went wrong see error codes
+    //!   \return true = write same is supported for the requested range, false = not supported
     //
     //-----------------------------------------------------------------------------
     OPENSEA_OPERATIONS_API bool is_Write_Same_Supported(tDevice *device, uint64_t startingLBA, uint64_t requesedNumberOfLogicalBlocks, uint64_t *maxNumberOfLogicalBlocksPerCommand);
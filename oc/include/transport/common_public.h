@@ -878,6 +878,64 @@ extern "C"
         //TODO: Add more hacks and padd this structure
     }passthroughHacks;
 
+    //This caches capabilities that can only be learned by sending a command (VPD pages, mode pages, report supported op codes, etc).
+    //Each capability is read the first time it is asked for, then reused. The "Valid" bool must be true for the remaining fields of that capability to be used.
+    //Call invalidate_Capability_Cache() after anything that can change these (format, sanitize, firmware update, mode select) so they are read again.
+    typedef struct _capabilityCache
+    {
+        bool writePsuedoUncorrectableValid;
+        bool writePsuedoUncorrectableSupported;
+        bool readWriteLongValid;
+        bool readWriteLongSupported;
+        bool writeSameValid;
+        bool writeSameSupported;
+        bool trimUnmapValid;
+        bool trimUnmapSupported;
+        bool smartEnabledValid;
+        bool smartEnabled;
+        bool selfTestValid;
+        bool selfTestSupported;
+        bool writeSameBlockLimitsReported;//writeSameMaxLBAsPerCommand came from the block limits VPD page and each requested range is checked against it
+        bool writeSameNonZero;//WSNZ bit from the block limits VPD page
+        uint8_t padd[2];//padd to 8 byte boundary
+        uint64_t writeSameMaxLBAsPerCommand;//0 means no limit
+        uint32_t trimUnmapMaxBlockDescriptors;
+        uint32_t trimUnmapMaxLBACount;
+    }capabilityCache;
+
+    //Sources of data that can be held in a page cache. Each is a read-only command that returns the same data while nothing changes on the device.
+    typedef enum _ePageCacheSource
+    {
+        PAGE_CACHE_ATA_GPL_LOG,//one entry per 512B page
+        PAGE_CACHE_ATA_SMART_LOG,
+        PAGE_CACHE_ATA_SMART_DATA,
+        PAGE_CACHE_ATA_SMART_THRESHOLDS,
+        PAGE_CACHE_SCSI_INQUIRY,
+        PAGE_CACHE_SCSI_LOG_SENSE,
+        PAGE_CACHE_NVME_LOG_PAGE,
+    }ePageCacheSource;
+
+    typedef struct _pageCacheEntry
+    {
+        ePageCacheSource source;
+        uint32_t address;//log address, VPD page, log page code, or NVMe log identifier
+        uint32_t page;//log page number, EVPD bit, subpage code, or NVMe namespace ID
+        uint64_t qualifier;//anything else that changes the returned data (feature register, page control and parameter pointer, log offset)
+        uint32_t length;
+        uint8_t *data;
+    }pageCacheEntry, *ptrPageCacheEntry;
+
+    //A page cache holds the data from read-only commands so that a group of operations (ex: a health snapshot) reads each page once.
+    //It is only attached to a device for the duration of that group of operations, so it never needs invalidating. Only successful reads are cached.
+    typedef struct _pageCache
+    {
+        uint32_t numberOfEntries;
+        uint32_t entriesAllocated;
+        uint32_t hits;//requests answered from the cache
+        uint32_t misses;//requests that had to be sent to the device
+        ptrPageCacheEntry entries;
+    }pageCache, *ptrPageCache;
+
     typedef struct _driveInfo {
         eMediaType     media_type;
         eDriveType     drive_type;
@@ -942,6 +1000,8 @@ extern "C"
         };
         //9304 bytes to make divisible by 8
         passthroughHacks passThroughHacks;
+        capabilityCache capabilities;//Lazily filled capabilities. Use invalidate_Capability_Cache() to clear it.
+        ptrPageCache pageCache;//NULL unless attach_Page_Cache() was called. Read-only commands check this before going to the device.
     }driveInfo;
 
 #if defined(UEFI_C_SOURCE)
@@ -1066,6 +1126,7 @@ extern "C"
         #if defined(VMK_CROSS_COMP)
         uint8_t paddSG[35];//TODO: need to change this based on size of NVMe handle for VMWare.
         #else
+        struct _nvmeUringContext *nvmeUring;//io_uring used to send NVMe IO commands. Created on the first command and never shared with clones since a ring is not thread safe.
         uint8_t paddSG[35];
         #endif
         #elif defined (_WIN32)
@@ -1142,7 +1203,7 @@ extern "C"
 
     typedef int (*issue_io_func)( void * );
 
-    #define DEVICE_BLOCK_VERSION    (6)
+    #define DEVICE_BLOCK_VERSION    (10)
 
     // verification for compatibility checking
     typedef struct _versionBlock
@@ -1162,6 +1223,7 @@ extern "C"
         issue_io_func       issue_nvme_io;//nvme IO function pointer for raid or other driver/custom interface to send commands
         eDiscoveryOptions   dFlags;
         eVerbosityLevels    deviceVerbosity;
+        alignedBufferPool   bufferPool;//NULL unless enable_Device_Buffer_Pool was called. Shared by clones of this device.
     }tDevice;
 
      //Common enum for getting/setting power states.
@@ -1479,6 +1541,157 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API int close_Device(tDevice *device);
 
+    //Results of one command. These are the fields of tDevice that every command overwrites, copied out so that they can be kept with the request
+    //that produced them instead of being read back from a device that another request may have used since.
+    typedef struct _commandResults
+    {
+        ataReturnTFRs rtfrs;
+        bool ataSenseDataValid;
+        uint8_t ataSenseKey;
+        uint8_t ataAdditionalSenseCode;
+        uint8_t ataAdditionalSenseCodeQualifier;
+        uint8_t senseData[SPC3_SENSE_LEN];
+        uint32_t nvmeCommandSpecific;
+        uint32_t nvmeStatus;
+        uint64_t commandTimeNanoSeconds;
+        unsigned int osLastError;
+    }commandResults, *ptrCommandResults;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  clone_Device_For_Thread()
+    //
+    //! \brief   Description:  Makes a copy of a device that can be used to send commands on another thread at the same time as the original.
+    //!                        The OS handle and everything found during discovery are shared. The results of the last command (RTFRs, sense data,
+    //!                        NVMe completion, command time, and OS error) are private to each copy, so each thread reads back its own.
+    //!                        The copy does not use the original's page cache, since the cache is not thread safe.
+    //!                        The original must stay open until every clone is freed, and clones must not be closed with close_Device.
+    //
+    //  Entry:
+    //!   \param[in] device = device from get_Device
+    //!
+    //  Exit:
+    //!   \return copy of the device, or NULL if memory could not be allocated. Free it with free_Device_Clone.
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API tDevice* clone_Device_For_Thread(tDevice *device);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  free_Device_Clone()
+    //
+    //! \brief   Description:  Frees a copy from clone_Device_For_Thread without closing the OS handle it shares.
+    //
+    //  Entry:
+    //!   \param[in,out] clone = copy to free. Set to NULL on return.
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void free_Device_Clone(tDevice **clone);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Last_Command_Results()
+    //
+    //! \brief   Description:  Copies the results of the last command sent with a device into a commandResults structure.
+    //
+    //  Entry:
+    //!   \param[in] device = device (or clone) the command was sent with
+    //!   \param[out] results = results of the last command
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int get_Last_Command_Results(tDevice *device, ptrCommandResults results);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  enable_Device_Buffer_Pool()
+    //
+    //! \brief   Description:  Gives a device its own pool of data and sense buffers so that get_Device_Buffer reuses buffers instead of allocating them.
+    //!                        Useful for devices that stay open and are polled often. Call this before any buffers are taken from the device.
+    //!                        get_Device does not do this since most callers open a device, send a few commands and close it, and the pool would only
+    //!                        keep memory allocated. Without a pool, get_Device_Buffer allocates and frees each buffer as before.
+    //
+    //  Entry:
+    //!   \param[in] device = device from get_Device
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int enable_Device_Buffer_Pool(tDevice *device);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  disable_Device_Buffer_Pool()
+    //
+    //! \brief   Description:  Frees a device's buffer pool. All buffers taken from the device must be released first. close_Device calls this.
+    //
+    //  Entry:
+    //!   \param[in] device = device from get_Device
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void disable_Device_Buffer_Pool(tDevice *device);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Device_Buffer()
+    //
+    //! \brief   Description:  Gets a zeroed buffer that meets the device's alignment requirement. It comes from the device's buffer pool when it has one,
+    //!                        otherwise it is allocated with calloc_aligned.
+    //
+    //  Entry:
+    //!   \param[in] device = device the buffer will be used with
+    //!   \param[in] size = size in bytes
+    //!
+    //  Exit:
+    //!   \return pointer to the buffer, or NULL. Release it with safe_Release_Device_Buffer and the same size.
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void* get_Device_Buffer(tDevice *device, size_t size);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  release_Device_Buffer()
+    //
+    //! \brief   Description:  Gives a buffer from get_Device_Buffer back to the device's pool, or frees it when the device has no pool.
+    //
+    //  Entry:
+    //!   \param[in] device = device the buffer was taken from
+    //!   \param[in] buffer = buffer to release
+    //!   \param[in] size = same size that was passed to get_Device_Buffer
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void release_Device_Buffer(tDevice *device, void *buffer, size_t size);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  safe_Release_Device_Buffer()
+    //
+    //! \brief   Description:  Gives a buffer from get_Device_Buffer back to the device's pool (or frees it) and sets it to NULL.
+    //
+    //  Entry:
+    //!   \param[in] device - device the buffer was taken from
+    //!   \param[in] mem - buffer to release
+    //!   \param[in] size - same size that was passed to get_Device_Buffer
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    #define safe_Release_Device_Buffer(device, mem, size)  \
+    if(mem)                                             \
+    {                                                   \
+        release_Device_Buffer(device, mem, size);       \
+        mem = NULL;                                     \
+    }                                                   \
+
     //-----------------------------------------------------------------------------
     //
     //  scan_And_Print_Devs()
@@ -1836,6 +2049,92 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API uint64_t align_LBA(tDevice *device, uint64_t LBA);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  invalidate_Capability_Cache()
+    //
+    //! \brief   Description:  Clears all cached capabilities in device->drive_info.capabilities so they are read from the device again the next time they are needed.
+    //!                        This should be called after any operation that can change the device's capabilities such as format, sanitize, firmware download, or changing mode pages.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void invalidate_Capability_Cache(tDevice *device);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  attach_Page_Cache()
+    //
+    //! \brief   Description:  Attaches an empty page cache to the device. Until detach_Page_Cache is called, log, SMART data, and VPD reads are answered from
+    //!                        the cache when the same data was already read. Do not attach a cache while changing anything on the device.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!
+    //  Exit:
+    //!   \return SUCCESS = attached, BAD_PARAMETER = already attached, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int attach_Page_Cache(tDevice *device);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  detach_Page_Cache()
+    //
+    //! \brief   Description:  Removes and frees the page cache attached to the device.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void detach_Page_Cache(tDevice *device);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  read_Page_Cache()
+    //
+    //! \brief   Description:  Copies cached data for a command into ptrData, if it is in the cache. Used by the command functions.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] source = which command the data comes from
+    //!   \param[in] address = see pageCacheEntry
+    //!   \param[in] page = see pageCacheEntry
+    //!   \param[in] qualifier = see pageCacheEntry
+    //!   \param[out] ptrData = buffer to copy the data into
+    //!   \param[in] dataSize = number of bytes requested. The cached entry must be at least this long.
+    //!
+    //  Exit:
+    //!   \return true = data was copied from the cache, false = not cached (or no cache attached) and the command must be sent
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API bool read_Page_Cache(tDevice *device, ePageCacheSource source, uint32_t address, uint32_t page, uint64_t qualifier, uint8_t *ptrData, uint32_t dataSize);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  write_Page_Cache()
+    //
+    //! \brief   Description:  Saves data read by a command in the attached cache. Does nothing if there is no cache attached.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] source = which command the data came from
+    //!   \param[in] address = see pageCacheEntry
+    //!   \param[in] page = see pageCacheEntry
+    //!   \param[in] qualifier = see pageCacheEntry
+    //!   \param[in] ptrData = data returned by the command
+    //!   \param[in] dataSize = number of bytes returned
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void write_Page_Cache(tDevice *device, ePageCacheSource source, uint32_t address, uint32_t page, uint64_t qualifier, const uint8_t *ptrData, uint32_t dataSize);
+
     OPENSEA_TRANSPORT_API void print_Command_Time(uint64_t timeInNanoSeconds);
 
     OPENSEA_TRANSPORT_API void print_Time(uint64_t timeInNanoSeconds);
@@ -0,0 +1,161 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file device_pool.h
+// \brief Keeps devices open with their discovered information so that callers can lease them instead of calling get_Device and close_Device for every operation
+
+#pragma once
+
+#include "common.h"
+#include "common_public.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define DEVICE_POOL_MAX_DEVICES 256
+    #define DEVICE_POOL_DEFAULT_REVALIDATE_SECONDS 60
+
+    typedef enum _eDeviceLeaseType
+    {
+        DEVICE_LEASE_SHARED,//any number of shared leases at a time. Each gets its own copy of the device structure using the same OS handle.
+        DEVICE_LEASE_EXCLUSIVE,//no other leases at the same time. Gets the pooled device itself, so changes made to it are kept.
+    }eDeviceLeaseType;
+
+    typedef struct _devicePoolEntry
+    {
+        char handle[OS_HANDLE_NAME_MAX_LENGTH];//handle the caller asked for. This can be a block device on Linux; the device remembers what it was mapped to.
+        tDevice *device;//NULL when the device could not be opened the last time it was tried
+        uint32_t sharedLeases;
+        bool exclusiveLease;//also set while the entry is being revalidated
+        bool needsRevalidation;//set when a lease is released after an error that can mean the device went away
+        time_t lastValidated;
+        uint32_t generation;//incremented each time a different device is found at this handle
+        uint64_t worldWideName;//identity of the device last seen at this handle, kept while it is missing so that it can be recognized if it comes back
+        char serialNumber[SERIAL_NUM_LEN + 1];
+        char modelNumber[MODEL_NUM_LEN + 1];
+        uint32_t reopens;
+    }devicePoolEntry;
+
+    //One pool can be used from any number of threads. Only leases are handed between threads, never the pool's devices directly.
+    typedef struct _devicePool
+    {
+        seaMutex mutex;
+        uint64_t discoveryFlags;//set in dFlags before each get_Device
+        eVerbosityLevels verbosity;
+        uint32_t revalidateSeconds;//0 = only revalidate after errors
+        uint32_t numberOfEntries;
+        devicePoolEntry entries[DEVICE_POOL_MAX_DEVICES];
+    }devicePool, *ptrDevicePool;
+
+    typedef struct _deviceLease
+    {
+        ptrDevicePool pool;
+        uint32_t entryIndex;
+        eDeviceLeaseType type;
+        uint32_t generation;//generation of the entry when the lease was made
+        tDevice *device;//device to send commands with. Valid until the lease is released.
+    }deviceLease, *ptrDeviceLease;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  create_Device_Pool()
+    //
+    //! \brief   Description:  Sets up an empty pool. Devices are opened the first time they are leased.
+    //
+    //  Entry:
+    //!   \param[out] pool = pool to setup
+    //!   \param[in] discoveryFlags = flags to put in dFlags before get_Device (same as the flags for get_Device_List)
+    //!   \param[in] verbosity = verbosity to set in each device
+    //!   \param[in] revalidateSeconds = how often to check that an idle handle is still the same device. 0 = only after an error.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int create_Device_Pool(ptrDevicePool pool, uint64_t discoveryFlags, eVerbosityLevels verbosity, uint32_t revalidateSeconds);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  get_Device_Lease()
+    //
+    //! \brief   Description:  Leases a device from the pool, opening it the first time. Before the lease is made, the device is checked when it is due
+    //!                        (see revalidate_Device_Pool_Entry).
+    //
+    //  Entry:
+    //!   \param[in] pool = pool from create_Device_Pool
+    //!   \param[in] handle = device handle, same as for get_Device
+    //!   \param[in] type = shared or exclusive
+    //!   \param[in] timeoutMilliseconds = how long to wait for conflicting leases to be released. 0 = do not wait.
+    //!   \param[out] lease = lease to use. Release it with release_Device_Lease.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, MEMORY_FAILURE, IN_PROGRESS = conflicting leases were not released in time, FAILURE = pool is full,
+    //!           or the error from get_Device when the device could not be opened
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int get_Device_Lease(ptrDevicePool pool, const char *handle, eDeviceLeaseType type, uint32_t timeoutMilliseconds, ptrDeviceLease lease);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  release_Device_Lease()
+    //
+    //! \brief   Description:  Returns a lease to the pool. If the last result is an error that can mean the device was removed, the device is checked
+    //!                        before its next lease.
+    //
+    //  Entry:
+    //!   \param[in] lease = lease from get_Device_Lease
+    //!   \param[in] lastResult = result of the last thing done with the lease, or SUCCESS
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void release_Device_Lease(ptrDeviceLease lease, int lastResult);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  revalidate_Device_Pool_Entry()
+    //
+    //! \brief   Description:  Opens the handle again and compares the world wide name, serial number, and model number with the pooled device.
+    //!                        If they match and the pooled device had no errors, the pooled device is kept. Otherwise the pooled device is closed and replaced
+    //!                        with the new one. If a different device is found, the entry's generation is incremented. Entries with leases out are skipped.
+    //
+    //  Entry:
+    //!   \param[in] pool = pool from create_Device_Pool
+    //!   \param[in] handle = device handle to check
+    //!   \param[out] replaced = optional. Set to true when a different device is now at this handle.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED = handle is not in the pool, IN_PROGRESS = entry has leases out, MEMORY_FAILURE,
+    //!           or the error from get_Device when the device is gone
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int revalidate_Device_Pool_Entry(ptrDevicePool pool, const char *handle, bool *replaced);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  close_Device_Pool()
+    //
+    //! \brief   Description:  Closes every device in the pool. All leases must be released first.
+    //
+    //  Entry:
+    //!   \param[in] pool = pool from create_Device_Pool
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, IN_PROGRESS = leases are still out
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int close_Device_Pool(ptrDevicePool pool);
+
+#if defined (__cplusplus)
+}
+#endif
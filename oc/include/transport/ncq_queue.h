@@ -0,0 +1,152 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file ncq_queue.h
+// \brief Keeps track of NCQ tags so that more than one FPDMA queued command can be outstanding to a SATA drive at a time
+
+#pragma once
+
+#include "common.h"
+#include "ata_helper.h"
+
+#if defined (__cplusplus)
+extern "C"
+{
+#endif
+
+    #define NCQ_MAX_QUEUE_DEPTH 32
+
+    //Called once for each command by complete_NCQ_Commands, from the thread that called it. result is the final result after any error recovery.
+    typedef void (*ncqCompletionCallback)(void *callbackData, bool writeCommand, uint64_t lba, uint16_t sectorCount, uint8_t *ptrData, int result);
+
+    struct _ncqQueue;
+
+    typedef struct _ncqCommand
+    {
+        struct _ncqQueue *queue;
+        tDevice *device;//copy of the queue's device. The OS handle is shared, but the last command results are not.
+        seaThread thread;//worker for this tag, started by open_NCQ_Queue. NULL when commands on this tag are done by the submitting thread.
+        seaSemaphore start;//posted by submit_NCQ_Command to wake the worker
+        uint8_t ncqTag;
+        bool writeCommand;
+        bool fua;
+        uint8_t prio;
+        uint64_t lba;
+        uint16_t sectorCount;
+        uint8_t *ptrData;
+        uint64_t submitOrder;
+        int result;
+        ncqCompletionCallback callback;
+        void *callbackData;
+    }ncqCommand;
+
+    //Each tag has a worker thread, started when the queue is opened, that sends the commands submitted on that tag since every passthrough interface
+    //blocks until the command completes. Whether the commands really overlap on the drive depends on the OS and HBA accepting FPDMA passthrough
+    //commands while others are outstanding. Commands must only be submitted and completed from one thread.
+    typedef struct _ncqQueue
+    {
+        tDevice *device;
+        seaMutex mutex;
+        seaSemaphore completed;//posted by a worker each time a command finishes
+        bool stopWorkers;
+        uint8_t queueDepth;
+        uint32_t tagsInUse;//bitmap: submitted and not yet reported to the callback
+        uint32_t tagsComplete;//bitmap: set by the command's thread when the drive has responded
+        uint32_t tagsFailed;//bitmap: waiting for error recovery
+        uint64_t submitCounter;
+        uint64_t commandsCompleted;
+        uint64_t commandsFailed;
+        uint64_t commandsRetried;
+        uint32_t errorRecoveries;
+        bool failingTagValid;//set when the NCQ command error log reported the failing command
+        uint8_t failingTag;//tag the drive reported. This is the tag the drive saw, which may not be the one requested if the OS assigned its own.
+        uint64_t failingLBA;
+        ncqCommand command[NCQ_MAX_QUEUE_DEPTH];
+    }ncqQueue, *ptrNCQQueue;
+
+    //-----------------------------------------------------------------------------
+    //
+    //  open_NCQ_Queue()
+    //
+    //! \brief   Description:  Sets up a queue of NCQ tags for a drive and starts a worker thread for each tag. The depth is limited to what the drive reports
+    //!                        in identify word 75. If the workers cannot be started, commands are still accepted but are done one at a time.
+    //
+    //  Entry:
+    //!   \param[in] device = file descriptor
+    //!   \param[in] queueDepth = number of commands to allow outstanding at a time. 0 uses the drive's maximum.
+    //!   \param[out] queue = queue to setup. Free it with close_NCQ_Queue.
+    //!
+    //  Exit:
+    //!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED = not an ATA drive or the drive does not support NCQ, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int open_NCQ_Queue(tDevice *device, uint8_t queueDepth, ptrNCQQueue queue);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  submit_NCQ_Command()
+    //
+    //! \brief   Description:  Starts a read or write FPDMA queued command on the next free tag. When every tag is in use, this first waits for
+    //!                        at least one command to complete (see complete_NCQ_Commands). If the queue has no workers, the command is done before returning.
+    //
+    //  Entry:
+    //!   \param[in] queue = queue from open_NCQ_Queue
+    //!   \param[in] writeCommand = true for write FPDMA queued, false for read FPDMA queued
+    //!   \param[in] fua = set the force unit access bit
+    //!   \param[in] lba = starting LBA
+    //!   \param[in] ptrData = data buffer. Must stay valid until the callback is called for this command.
+    //!   \param[in] sectorCount = number of logical sectors to transfer
+    //!   \param[in] prio = NCQ priority (bits 1:0)
+    //!   \param[in] callback = optional function to call when the command completes
+    //!   \param[in] callbackData = passed to the callback
+    //!
+    //  Exit:
+    //!   \return SUCCESS = command was started, BAD_PARAMETER
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int submit_NCQ_Command(ptrNCQQueue queue, bool writeCommand, bool fua, uint64_t lba, uint8_t *ptrData, uint16_t sectorCount, uint8_t prio, ncqCompletionCallback callback, void *callbackData);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  complete_NCQ_Commands()
+    //
+    //! \brief   Description:  Reports completed commands to their callbacks and frees their tags.
+    //!                        When a command fails, the drive aborts everything else it has queued, so this waits for all outstanding commands, then reads the
+    //!                        NCQ command error log to find the command that failed. Reading the log also lets the drive accept queued commands again.
+    //!                        That command keeps its error. Every other failed command is retried once on its own.
+    //
+    //  Entry:
+    //!   \param[in] queue = queue from open_NCQ_Queue
+    //!   \param[in] waitForAll = true to wait until every outstanding command has completed. false to wait until at least one has.
+    //!
+    //  Exit:
+    //!   \return SUCCESS = every command reported completed successfully, FAILURE = at least one command reported with an error, BAD_PARAMETER
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int complete_NCQ_Commands(ptrNCQQueue queue, bool waitForAll);
+
+    //-----------------------------------------------------------------------------
+    //
+    //  close_NCQ_Queue()
+    //
+    //! \brief   Description:  Waits for all outstanding commands, reporting them to their callbacks, then stops the workers and frees the queue.
+    //
+    //  Entry:
+    //!   \param[in] queue = queue from open_NCQ_Queue
+    //!
+    //  Exit:
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API void close_NCQ_Queue(ptrNCQQueue queue);
+
+#if defined (__cplusplus)
+}
+#endif
@@ -304,6 +304,9 @@ OPENSEA_TRANSPORT_API int nvme_Security_Send(tDevice *device, uint8_t securityPr
 
 OPENSEA_TRANSPORT_API int nvme_Write_Uncorrectable(tDevice *device, uint64_t startingLBA, uint16_t numberOfLogicalBlocks);
 
+//numberOfLogicalBlocks is 0 based. deallocate allows the controller to deallocate the range instead of writing it if reads will still return zeroes.
+OPENSEA_TRANSPORT_API int nvme_Write_Zeroes(tDevice *device, uint64_t startingLBA, uint16_t numberOfLogicalBlocks, bool deallocate);
+
 #define SANITIZE_NVM_EXIT_FAILURE_MODE 1
 #define SANITIZE_NVM_BLOCK_ERASE 2
 #define SANITIZE_NVM_OVERWRITE 3
@@ -284,6 +284,19 @@ extern "C"
         bool            fwdlLastSegment;
     } ScsiIoCtx;
 
+    //One command for scsi_Send_Cdb_Batch. The fields match the parameters of scsi_Send_Cdb.
+    typedef struct _scsiBatchCommand
+    {
+        uint8_t *cdb;
+        eCDBLen cdbLen;
+        uint8_t *pdata;
+        uint32_t dataLen;
+        eDataTransferDirection dataDirection;
+        uint8_t *senseData;//optional. SPC3_SENSE_LEN bytes for this command's sense data.
+        uint32_t timeoutSeconds;
+        int result;//set to what scsi_Send_Cdb would have returned for this command
+    }scsiBatchCommand, *ptrScsiBatchCommand;
+
 
     #define OPERATION_CODE          (0)
 
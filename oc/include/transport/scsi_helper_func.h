@@ -50,6 +50,26 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API int scsi_Send_Cdb(tDevice *device, uint8_t *cdb, eCDBLen cdbLen, uint8_t *pdata, uint32_t dataLen, eDataTransferDirection dataDirection, uint8_t *senseData, uint32_t senseDataLen, uint32_t timeoutSeconds);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  scsi_Send_Cdb_Batch()
+    //
+    //! \brief   Description:  Sends a list of CDBs to one device. Where the OS can queue several commands with one wait (Linux sg handles), they are sent
+    //!                        that way so that small commands such as log page reads or verifies are not each paid for with a full round trip. Otherwise,
+    //!                        and at command verbose output or higher, each is sent with scsi_Send_Cdb in order.
+    //!                        Commands may complete in any order, so do not put commands that depend on each other in the same batch.
+    //
+    //  Entry:
+    //!   \param device - pointer to the device structure containing a valid device handle
+    //!   \param commands - array of commands. Each command's result is set.
+    //!   \param count - number of commands
+    //!
+    //  Exit:
+    //!   \return SUCCESS = every command returned SUCCESS, FAILURE = at least one command did not (see each result), BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int scsi_Send_Cdb_Batch(tDevice *device, ptrScsiBatchCommand commands, uint32_t count);
+
     //-----------------------------------------------------------------------------
     //
     //  uint16_t calculate_Logical_Block_Guard(uint8_t *buffer, uint32_t userDataLength, uint32_t totalDataLength)
@@ -414,6 +434,29 @@ extern "C"
     //-----------------------------------------------------------------------------
     OPENSEA_TRANSPORT_API int scsi_Log_Sense_Cmd(tDevice *device, bool saveParameters, uint8_t pageControl, uint8_t pageCode, uint8_t subpageCode, uint16_t paramPointer, uint8_t *ptrData, uint16_t dataSize);
 
+    //-----------------------------------------------------------------------------
+    //
+    //  scsi_Prefetch_Log_Pages()
+    //
+    //! \brief   Description:  Reads a list of log pages with scsi_Send_Cdb_Batch and saves each one that is read in the attached page cache, so that
+    //!                        later scsi_Log_Sense_Cmd calls for them (parameter pointer 0, same or smaller size) do not go to the device.
+    //!                        Only useful while a page cache is attached (see attach_Page_Cache).
+    //
+    //  Entry:
+    //!   \param device - pointer to the device structure
+    //!   \param pageControl - page control field for every page. Only bits 1:0 are valid
+    //!   \param pageCodes - page code of each page to read
+    //!   \param subpageCodes - subpage code of each page to read
+    //!   \param numberOfPages - number of entries in pageCodes and subpageCodes
+    //!   \param dataSize - bytes to read of each page
+    //!
+    //  Exit:
+    //!   \return SUCCESS = every page was read, FAILURE = some pages could not be read (they are not cached), NOT_SUPPORTED = no page cache is
+    //!           attached, BAD_PARAMETER, MEMORY_FAILURE
+    //
+    //-----------------------------------------------------------------------------
+    OPENSEA_TRANSPORT_API int scsi_Prefetch_Log_Pages(tDevice *device, uint8_t pageControl, uint8_t *pageCodes, uint8_t *subpageCodes, uint32_t numberOfPages, uint16_t dataSize);
+
     //-----------------------------------------------------------------------------
     //
     //  scsi_log_select_cmd()
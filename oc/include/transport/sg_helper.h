@@ -223,6 +223,32 @@ extern "C"
 // \param scsiIoCtx
     int send_IO( ScsiIoCtx *scsiIoCtx );
 
+#if !defined (SG_MAX_QUEUE)
+#define SG_MAX_QUEUE 16
+#endif
+
+//-----------------------------------------------------------------------------
+//
+//  send_sg_io_Batch(ScsiIoCtx *scsiIoCtx, uint32_t count, int *results)
+//
+//! \brief   Description:  Sends many commands to one sg device with the asynchronous sg interface (write() to queue, read() to complete) instead
+//!                        of one SG_IO ioctl per command. Up to SG_MAX_QUEUE commands are queued at a time, so the device is never idle waiting for
+//!                        the next command to be sent. Commands can complete in any order. Only one batch at a time may use a handle.
+//
+//  Entry:
+//!   \param[in] scsiIoCtx = array of commands, all for the same device. Each must have its own sense buffer.
+//!   \param[in] count = number of commands
+//!   \param[out] results = array of count results, each the same as send_sg_io would have returned for that command
+//!
+//  Exit:
+//!   \return SUCCESS = every command was completed (check results), NOT_SUPPORTED = handle is not an sg handle, BAD_PARAMETER, MEMORY_FAILURE,
+//!           OS_PASSTHROUGH_FAILURE = waiting on the handle failed. No more commands are sent, and the ones already queued are still waited for
+//!           and read back before returning. Commands that had not completed are set to OS_PASSTHROUGH_FAILURE. If waiting fails a second
+//!           time, the rest are left in the sg driver, which never writes to their data or sense buffers, and the handle should be closed.
+//
+//-----------------------------------------------------------------------------
+    int send_sg_io_Batch(ScsiIoCtx *scsiIoCtx, uint32_t count, int *results);
+
 //-----------------------------------------------------------------------------
 //
 //  os_Device_Reset(tDevice *device)
@@ -295,6 +321,94 @@ int pci_Read_Bar_Reg( tDevice * device, uint8_t * pData, uint32_t dataSize );
 
 int send_NVMe_IO(nvmeCmdCtx *nvmeIoCtx);
 
+#define NVME_URING_MAX_FIXED_BUFFERS 16
+#define NVME_URING_MAX_QUEUED 256 //NVMe IO commands that can be in flight at once through submit_NVMe_IO_Uring_Command on one device
+
+//-----------------------------------------------------------------------------
+//
+//  register_NVMe_IO_Uring_Buffers()
+//
+//! \brief   Description:  Registers data buffers with the device's io_uring so that NVMe IO commands using them do not have to map
+//!                        the memory for every command. Commands with data anywhere inside a registered buffer use it automatically.
+//!                        Replaces any buffers registered before. The buffers must stay allocated until they are unregistered or the device is closed.
+//!                        When the first buffer holds at least one block, LBA 0 is read into it to check that the kernel (6.1 or later) accepts
+//!                        registered buffers in passthrough commands.
+//
+//  Entry:
+//!   \param[in] device = NVMe namespace device. Each clone of a device has its own ring, so this must be called for each clone.
+//!   \param[in] buffers = buffers to register
+//!   \param[in] bufferSizes = size of each buffer in bytes
+//!   \param[in] count = number of buffers, up to NVME_URING_MAX_FIXED_BUFFERS. 0 unregisters the current buffers, and also shows whether the
+//!                     device can use io_uring at all.
+//!
+//  Exit:
+//!   \return SUCCESS, BAD_PARAMETER = bad buffers, or commands are in flight, NOT_SUPPORTED = the kernel or device cannot send NVMe commands
+//!           through io_uring, or cannot use registered buffers with them, MEMORY_FAILURE = the buffers could not be locked in memory, FAILURE
+//
+//-----------------------------------------------------------------------------
+int register_NVMe_IO_Uring_Buffers(tDevice *device, uint8_t **buffers, uint32_t *bufferSizes, uint32_t count);
+
+//-----------------------------------------------------------------------------
+//
+//  submit_NVMe_IO_Uring_Command()
+//
+//! \brief   Description:  Starts an NVMe IO command through the device's io_uring without waiting for it, so that several commands can be
+//!                        in flight from one thread. The command is built the same way as for nvme_Cmd. Data inside a registered buffer
+//!                        (register_NVMe_IO_Uring_Buffers) uses it automatically. While any command is in flight, commands sent the normal way
+//!                        on this device use the ioctls instead of the ring.
+//
+//  Entry:
+//!   \param[in] nvmeIoCtx = command to start. The device must be set. This and its data buffer must stay valid until the command is reaped.
+//!
+//  Exit:
+//!   \return SUCCESS = the command is in flight, BAD_PARAMETER = not an IO command, metadata was given, or NVME_URING_MAX_QUEUED commands
+//!           are already in flight, NOT_SUPPORTED = the kernel or device cannot send NVMe commands through io_uring (use nvme_Cmd instead),
+//!           OS_PASSTHROUGH_FAILURE = the kernel did not take the command
+//
+//-----------------------------------------------------------------------------
+int submit_NVMe_IO_Uring_Command(nvmeCmdCtx *nvmeIoCtx);
+
+//-----------------------------------------------------------------------------
+//
+//  reap_NVMe_IO_Uring_Commands()
+//
+//! \brief   Description:  Collects commands started with submit_NVMe_IO_Uring_Command that have finished. Waits until at least
+//!                        minimumToComplete have finished (fewer if fewer are in flight), then also takes any others that are already done.
+//!                        The completion data in each command is filled in the same way as nvme_Cmd.
+//
+//  Entry:
+//!   \param[in] device = device the commands were started on
+//!   \param[in] minimumToComplete = commands to wait for. 0 only takes commands that are already done.
+//!   \param[out] completed = set to the commands that finished, in the order they finished
+//!   \param[out] results = result of each finished command, as nvme_Cmd would return it
+//!   \param[in] maxCompleted = number of entries in completed and results
+//!   \param[out] numberCompleted = number of commands that finished
+//!
+//  Exit:
+//!   \return SUCCESS, BAD_PARAMETER, NOT_SUPPORTED, OS_PASSTHROUGH_FAILURE = waiting failed. Commands still in flight can be reaped later.
+//
+//-----------------------------------------------------------------------------
+int reap_NVMe_IO_Uring_Commands(tDevice *device, uint32_t minimumToComplete, nvmeCmdCtx **completed, int *results, uint32_t maxCompleted, uint32_t *numberCompleted);
+
+//-----------------------------------------------------------------------------
+//
+//  get_NVMe_Namespace_Handle()
+//
+//! \brief   Description:  Finds the block handle of another namespace on the same NVMe controller as a device. IO commands can only be sent to
+//!                        the namespace a Linux handle was opened for, so this is needed to send them to other namespaces.
+//
+//  Entry:
+//!   \param[in] device = any handle on the controller (/dev/nvme0 or /dev/nvme0n1)
+//!   \param[in] namespaceID = namespace ID to find
+//!   \param[out] handle = set to the handle for the namespace. Ex: /dev/nvme0n2
+//!   \param[in] handleLength = size of handle in bytes
+//!
+//  Exit:
+//!   \return SUCCESS, BAD_PARAMETER (also when handle is too small for the name), NOT_SUPPORTED = no handle was found for the namespace
+//
+//-----------------------------------------------------------------------------
+int get_NVMe_Namespace_Handle(tDevice *device, uint32_t namespaceID, char *handle, size_t handleLength);
+
 //to be used with a deep scan???
 //int nvme_Namespace_Rescan(int fd);//rescans a controller for namespaces. This must be a file descriptor without a namespace. EX: /dev/nvme0 and NOT /dev/nvme0n1
 
@@ -305,6 +419,20 @@ int os_nvme_Subsystem_Reset(tDevice *device);
 
 #endif
 
+//-----------------------------------------------------------------------------
+//
+//  close_NVMe_IO_Uring()
+//
+//! \brief   Description:  Closes the io_uring a device uses for NVMe IO commands, if it has one. Called by close_Device and free_Device_Clone.
+//
+//  Entry:
+//!   \param[in] device = device to close the ring of
+//!
+//  Exit:
+//
+//-----------------------------------------------------------------------------
+void close_NVMe_IO_Uring(tDevice *device);
+
 int map_Block_To_Generic_Handle(const char *handle, char **genericHandle, char **blockHandle);
 
 int device_Reset(int fd);
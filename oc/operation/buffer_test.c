@@ -229,6 +229,22 @@ bool was_There_A_CRC_Error_On_Last_Command(tDevice *device)
     return crc;
 }
 
+//compares what was written to the buffer against what was read back and tracks where and how badly it miscompared
+static void compare_Pattern_Test_Buffers(uint8_t *patternBuffer, uint8_t *returnBuffer, uint32_t deviceBufferSize, ptrPatternTestResults testResults)
+{
+    bufferCompareResult compareResult;
+    ++(testResults->totalBufferComparisons);
+    if (!compare_Buffers(patternBuffer, returnBuffer, deviceBufferSize, &compareResult))
+    {
+        if (testResults->totalBufferMiscompares == 0)
+        {
+            testResults->firstMiscompareOffset = C_CAST(uint32_t, compareResult.firstMiscompareOffset);
+        }
+        ++(testResults->totalBufferMiscompares);
+        testResults->totalMiscomparedBits += compareResult.miscomparedBits;
+    }
+}
+
 //Function for simple byte pattern tests. take counter for number of times to try it?
 void perform_Byte_Pattern_Test(tDevice *device, uint32_t pattern, uint32_t deviceBufferSize, ptrPatternTestResults testResults)
 {
@@ -300,12 +316,7 @@ void perform_Byte_Pattern_Test(tDevice *device, uint32_t pattern, uint32_t devic
             {
                 break;
             }
-            ++(testResults->totalBufferComparisons);
-            //first check if the pattern matches or not
-            if (memcmp(patternBuffer, returnBuffer, deviceBufferSize))
-            {
-                ++(testResults->totalBufferMiscompares);
-            }
+            compare_Pattern_Test_Buffers(patternBuffer, returnBuffer, deviceBufferSize, testResults);
         }
         stop_Timer(&patternTimer);
         testResults->totalTimeNS = get_Nano_Seconds(patternTimer);
@@ -407,12 +418,7 @@ void perform_Walking_Test(tDevice *device, bool walkingZeros, uint32_t deviceBuf
             {
                 break;
             }
-            ++(testResults->totalBufferComparisons);
-            //first check if the pattern matches or not
-            if (memcmp(patternBuffer, returnBuffer, deviceBufferSize))
-            {
-                ++(testResults->totalBufferMiscompares);
-            }
+            compare_Pattern_Test_Buffers(patternBuffer, returnBuffer, deviceBufferSize, testResults);
         }
     }
     safe_Free_aligned(patternBuffer)
@@ -486,12 +492,7 @@ void perform_Random_Pattern_Test(tDevice *device, uint32_t deviceBufferSize, ptr
             {
                 break;
             }
-            ++(testResults->totalBufferComparisons);
-            //first check if the pattern matches or not
-            if (memcmp(patternBuffer, returnBuffer, deviceBufferSize))
-            {
-                ++(testResults->totalBufferMiscompares);
-            }
+            compare_Pattern_Test_Buffers(patternBuffer, returnBuffer, deviceBufferSize, testResults);
         }
     }
     safe_Free(patternBuffer)
@@ -585,6 +586,11 @@ void print_Cable_Test_Results(cableTestResults testResults)
         printf("        Number of command timeouts: %" PRIu32 "\n", testResults.zerosTest[count].totalCommandTimeouts);
         printf("        Number of buffer comparisons: %" PRIu32 "\n", testResults.zerosTest[count].totalBufferComparisons);
         printf("        Number of buffer miscompares: %" PRIu32 "\n", testResults.zerosTest[count].totalBufferMiscompares);
+        if (testResults.zerosTest[count].totalBufferMiscompares > 0)
+        {
+            printf("        First miscompare at byte offset: %" PRIu32 "\n", testResults.zerosTest[count].firstMiscompareOffset);
+            printf("        Number of miscompared bits: %" PRIu64 "\n", testResults.zerosTest[count].totalMiscomparedBits);
+        }
         printf("        Test time: ");
         print_Command_Time(testResults.zerosTest[count].totalTimeNS);
         printf("\n");
@@ -598,6 +604,11 @@ void print_Cable_Test_Results(cableTestResults testResults)
         printf("        Number of command timeouts: %" PRIu32 "\n", testResults.fTest[count].totalCommandTimeouts);
         printf("        Number of buffer comparisons: %" PRIu32 "\n", testResults.fTest[count].totalBufferComparisons);
         printf("        Number of buffer miscompares: %" PRIu32 "\n", testResults.fTest[count].totalBufferMiscompares);
+        if (testResults.fTest[count].totalBufferMiscompares > 0)
+        {
+            printf("        First miscompare at byte offset: %" PRIu32 "\n", testResults.fTest[count].firstMiscompareOffset);
+            printf("        Number of miscompared bits: %" PRIu64 "\n", testResults.fTest[count].totalMiscomparedBits);
+        }
         printf("        Test time: ");
         print_Command_Time(testResults.fTest[count].totalTimeNS);
         printf("\n");
@@ -611,6 +622,11 @@ void print_Cable_Test_Results(cableTestResults testResults)
         printf("        Number of command timeouts: %" PRIu32 "\n", testResults.fivesTest[count].totalCommandTimeouts);
         printf("        Number of buffer comparisons: %" PRIu32 "\n", testResults.fivesTest[count].totalBufferComparisons);
         printf("        Number of buffer miscompares: %" PRIu32 "\n", testResults.fivesTest[count].totalBufferMiscompares);
+        if (testResults.fivesTest[count].totalBufferMiscompares > 0)
+        {
+            printf("        First miscompare at byte offset: %" PRIu32 "\n", testResults.fivesTest[count].firstMiscompareOffset);
+            printf("        Number of miscompared bits: %" PRIu64 "\n", testResults.fivesTest[count].totalMiscomparedBits);
+        }
         printf("        Test time: ");
         print_Command_Time(testResults.fivesTest[count].totalTimeNS);
         printf("\n");
@@ -624,6 +640,11 @@ void print_Cable_Test_Results(cableTestResults testResults)
         printf("        Number of command timeouts: %" PRIu32 "\n", testResults.aTest[count].totalCommandTimeouts);
         printf("        Number of buffer comparisons: %" PRIu32 "\n", testResults.aTest[count].totalBufferComparisons);
         printf("        Number of buffer miscompares: %" PRIu32 "\n", testResults.aTest[count].totalBufferMiscompares);
+        if (testResults.aTest[count].totalBufferMiscompares > 0)
+        {
+            printf("        First miscompare at byte offset: %" PRIu32 "\n", testResults.aTest[count].firstMiscompareOffset);
+            printf("        Number of miscompared bits: %" PRIu64 "\n", testResults.aTest[count].totalMiscomparedBits);
+        }
         printf("        Test time: ");
         print_Command_Time(testResults.aTest[count].totalTimeNS);
         printf("\n");
@@ -637,6 +658,11 @@ void print_Cable_Test_Results(cableTestResults testResults)
         printf("        Number of command timeouts: %" PRIu32 "\n", testResults.zeroF5ATest[count].totalCommandTimeouts);
         printf("        Number of buffer comparisons: %" PRIu32 "\n", testResults.zeroF5ATest[count].totalBufferComparisons);
         printf("        Number of buffer miscompares: %" PRIu32 "\n", testResults.zeroF5ATest[count].totalBufferMiscompares);
+        if (testResults.zeroF5ATest[count].totalBufferMiscompares > 0)
+        {
+            printf("        First miscompare at byte offset: %" PRIu32 "\n", testResults.zeroF5ATest[count].firstMiscompareOffset);
+            printf("        Number of miscompared bits: %" PRIu64 "\n", testResults.zeroF5ATest[count].totalMiscomparedBits);
+        }
         printf("        Test time: ");
         print_Command_Time(testResults.zeroF5ATest[count].totalTimeNS);
         printf("\n");
@@ -650,6 +676,11 @@ void print_Cable_Test_Results(cableTestResults testResults)
         printf("        Number of command timeouts: %" PRIu32 "\n", testResults.walking1sTest[count].totalCommandTimeouts);
         printf("        Number of buffer comparisons: %" PRIu32 "\n", testResults.walking1sTest[count].totalBufferComparisons);
         printf("        Number of buffer miscompares: %" PRIu32 "\n", testResults.walking1sTest[count].totalBufferMiscompares);
+        if (testResults.walking1sTest[count].totalBufferMiscompares > 0)
+        {
+            printf("        First miscompare at byte offset: %" PRIu32 "\n", testResults.walking1sTest[count].firstMiscompareOffset);
+            printf("        Number of miscompared bits: %" PRIu64 "\n", testResults.walking1sTest[count].totalMiscomparedBits);
+        }
         printf("        Test time: ");
         print_Command_Time(testResults.walking1sTest[count].totalTimeNS);
         printf("\n");
@@ -663,6 +694,11 @@ void print_Cable_Test_Results(cableTestResults testResults)
         printf("        Number of command timeouts: %" PRIu32 "\n", testResults.walking0sTest[count].totalCommandTimeouts);
         printf("        Number of buffer comparisons: %" PRIu32 "\n", testResults.walking0sTest[count].totalBufferComparisons);
         printf("        Number of buffer miscompares: %" PRIu32 "\n", testResults.walking0sTest[count].totalBufferMiscompares);
+        if (testResults.walking0sTest[count].totalBufferMiscompares > 0)
+        {
+            printf("        First miscompare at byte offset: %" PRIu32 "\n", testResults.walking0sTest[count].firstMiscompareOffset);
+            printf("        Number of miscompared bits: %" PRIu64 "\n", testResults.walking0sTest[count].totalMiscomparedBits);
+        }
         printf("        Test time: ");
         print_Command_Time(testResults.walking0sTest[count].totalTimeNS);
         printf("\n");
@@ -676,6 +712,11 @@ void print_Cable_Test_Results(cableTestResults testResults)
         printf("        Number of command timeouts: %" PRIu32 "\n", testResults.randomTest[count].totalCommandTimeouts);
         printf("        Number of buffer comparisons: %" PRIu32 "\n", testResults.randomTest[count].totalBufferComparisons);
         printf("        Number of buffer miscompares: %" PRIu32 "\n", testResults.randomTest[count].totalBufferMiscompares);
+        if (testResults.randomTest[count].totalBufferMiscompares > 0)
+        {
+            printf("        First miscompare at byte offset: %" PRIu32 "\n", testResults.randomTest[count].firstMiscompareOffset);
+            printf("        Number of miscompared bits: %" PRIu64 "\n", testResults.randomTest[count].totalMiscomparedBits);
+        }
         printf("        Test time: ");
         print_Command_Time(testResults.randomTest[count].totalTimeNS);
         printf("\n");
@@ -754,6 +754,10 @@ int flag_Uncorrectables(tDevice *device, uint64_t startingLBA, uint64_t range, M
 bool is_Read_Long_Write_Long_Supported(tDevice *device)
 {
     bool supported = false;
+    if (device->drive_info.capabilities.readWriteLongValid)
+    {
+        return device->drive_info.capabilities.readWriteLongSupported;
+    }
     if (device->drive_info.drive_type == ATA_DRIVE)
     {
         if (device->drive_info.IdentifyData.ata.Word206 & BIT1)
@@ -838,6 +842,8 @@ bool is_Read_Long_Write_Long_Supported(tDevice *device)
             }
         }
     }
+    device->drive_info.capabilities.readWriteLongSupported = supported;
+    device->drive_info.capabilities.readWriteLongValid = true;
     return supported;
 }
 
@@ -42,7 +42,7 @@ int get_ATA_DeviceStatistics(tDevice *device, ptrDeviceStatistics deviceStats)
     {
         bool dsnFeatureSupported = M_ToBool(device->drive_info.IdentifyData.ata.Word119 & BIT9);
         bool dsnFeatureEnabled = M_ToBool(device->drive_info.IdentifyData.ata.Word120 & BIT9);
-        uint8_t *deviceStatsLog = C_CAST(uint8_t*, calloc_aligned(deviceStatsSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+        uint8_t *deviceStatsLog = C_CAST(uint8_t*, get_Device_Buffer(device, deviceStatsSize));
         if (!deviceStatsLog)
         {
             return MEMORY_FAILURE;
@@ -50,7 +50,7 @@ int get_ATA_DeviceStatistics(tDevice *device, ptrDeviceStatistics deviceStats)
         //this is to get the threshold stuff
         if (dsnFeatureSupported && dsnFeatureEnabled && SUCCESS == get_ATA_Log_Size(device, ATA_LOG_DEVICE_STATISTICS_NOTIFICATION, &deviceStatsNotificationsSize, true, false))
         {
-            uint8_t *devStatsNotificationsLog = C_CAST(uint8_t*, calloc_aligned(deviceStatsNotificationsSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+            uint8_t *devStatsNotificationsLog = C_CAST(uint8_t*, get_Device_Buffer(device, deviceStatsNotificationsSize));
             if (SUCCESS == get_ATA_Log(device, ATA_LOG_DEVICE_STATISTICS_NOTIFICATION, NULL, NULL, true, false, true, devStatsNotificationsLog, deviceStatsNotificationsSize, NULL, 0,0))
             {
                 //Start at page 1 since we want all the details, not just the summary from page 0
@@ -577,7 +577,7 @@ int get_ATA_DeviceStatistics(tDevice *device, ptrDeviceStatistics deviceStats)
                     }
                 }
             }
-            safe_Free_aligned(devStatsNotificationsLog)
+            safe_Release_Device_Buffer(device, devStatsNotificationsLog, deviceStatsNotificationsSize)
         }
         if (SUCCESS == get_ATA_Log(device, ATA_LOG_DEVICE_STATISTICS, NULL, NULL, true, true, true, deviceStatsLog, deviceStatsSize, NULL, 0,0))
         {
@@ -1214,7 +1214,7 @@ int get_ATA_DeviceStatistics(tDevice *device, ptrDeviceStatistics deviceStats)
                 }
             }
         }
-        safe_Free_aligned(deviceStatsLog)
+        safe_Release_Device_Buffer(device, deviceStatsLog, deviceStatsSize)
     }
     return ret;
 }
@@ -7614,3 +7614,481 @@ int print_DeviceStatistics(tDevice *device, ptrDeviceStatistics deviceStats)
     }
     return ret;
 }
+
+static void write_Statistic_Details(ptrStructuredWriter writer, statistic theStatistic)
+{
+    if (theStatistic.isThresholdValid)
+    {
+        write_Structured_Unsigned(writer, "Threshold", theStatistic.threshold);
+        switch (theStatistic.threshType)
+        {
+        case THRESHOLD_TYPE_ALWAYS_TRIGGER_ON_UPDATE:
+            write_Structured_String(writer, "Threshold Type", "Always Trigger");
+            break;
+        case THRESHOLD_TYPE_TRIGGER_WHEN_EQUAL:
+            write_Structured_String(writer, "Threshold Type", "Equal");
+            break;
+        case THRESHOLD_TYPE_TRIGGER_WHEN_NOT_EQUAL:
+            write_Structured_String(writer, "Threshold Type", "Not Equal");
+            break;
+        case THRESHOLD_TYPE_TRIGGER_WHEN_GREATER:
+            write_Structured_String(writer, "Threshold Type", "Greater");
+            break;
+        case THRESHOLD_TYPE_TRIGGER_WHEN_LESS:
+            write_Structured_String(writer, "Threshold Type", "Less");
+            break;
+        case THRESHOLD_TYPE_NO_TRIGGER:
+        default:
+            write_Structured_String(writer, "Threshold Type", "No Trigger");
+            break;
+        }
+    }
+    write_Structured_Bool(writer, "Monitored Condition Met", theStatistic.monitoredConditionMet);
+    write_Structured_Bool(writer, "Supports Notification", theStatistic.supportsNotification);
+}
+
+//Writes the statistic's value as is. The text output formats some statistics (dates, time intervals, etc), but structured output leaves that to whatever reads it.
+static void write_Statistic(ptrStructuredWriter writer, statistic theStatistic, const char *statisticName, const char *statisticUnit)
+{
+    if (theStatistic.isSupported)
+    {
+        begin_Structured_Object(writer, NULL);
+        write_Structured_String(writer, "Name", statisticName);
+        if (theStatistic.isValueValid)
+        {
+            write_Structured_Unsigned(writer, "Value", theStatistic.statisticValue);
+        }
+        else
+        {
+            write_Structured_String(writer, "Value", NULL);
+        }
+        if (statisticUnit)
+        {
+            write_Structured_String(writer, "Unit", statisticUnit);
+        }
+        write_Statistic_Details(writer, theStatistic);
+        end_Structured_Object(writer);
+    }
+}
+
+//Temperatures are signed 8 bit values
+static void write_Temperature_Statistic(ptrStructuredWriter writer, statistic theStatistic, const char *statisticName, const char *statisticUnit)
+{
+    if (theStatistic.isSupported)
+    {
+        begin_Structured_Object(writer, NULL);
+        write_Structured_String(writer, "Name", statisticName);
+        if (theStatistic.isValueValid)
+        {
+            write_Structured_Signed(writer, "Value", C_CAST(int8_t, theStatistic.statisticValue));
+        }
+        else
+        {
+            write_Structured_String(writer, "Value", NULL);
+        }
+        write_Structured_String(writer, "Unit", statisticUnit);
+        write_Statistic_Details(writer, theStatistic);
+        end_Structured_Object(writer);
+    }
+}
+
+static int write_ATA_DeviceStatistics(tDevice *device, ptrDeviceStatistics deviceStats, ptrStructuredWriter writer)
+{
+    int ret = SUCCESS;
+    if (!deviceStats)
+    {
+        return MEMORY_FAILURE;
+    }    
+    if (deviceStats->sataStatistics.generalStatisticsSupported)
+    {
+        begin_Structured_Array(writer, "General Statistics");
+        write_Statistic(writer, deviceStats->sataStatistics.lifetimePoweronResets, "LifeTime Power-On Resets", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.powerOnHours, "Power-On Hours", "hours");
+        write_Statistic(writer, deviceStats->sataStatistics.logicalSectorsWritten, "Logical Sectors Written", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.numberOfWriteCommands, "Number Of Write Commands", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.logicalSectorsRead, "Logical Sectors Read", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.numberOfReadCommands, "Number Of Read Commands", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.dateAndTimeTimestamp, "Date And Time Timestamp", "milliseconds");
+        write_Statistic(writer, deviceStats->sataStatistics.pendingErrorCount, "Pending Error Count", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.workloadUtilization, "Workload Utilization", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.utilizationUsageRate, "Utilization Usage Rate", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.resourceAvailability, "Resource Availability", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.randomWriteResourcesUsed, "Random Write Resources Used", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sataStatistics.freeFallStatisticsSupported)
+    {
+        begin_Structured_Array(writer, "Free Fall Statistics");
+        write_Statistic(writer, deviceStats->sataStatistics.numberOfFreeFallEventsDetected, "Number Of Free-Fall Events Detected", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.overlimitShockEvents, "Overlimit Shock Events", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sataStatistics.rotatingMediaStatisticsSupported)
+    {
+        begin_Structured_Array(writer, "Rotating Media Statistics");
+        write_Statistic(writer, deviceStats->sataStatistics.spindleMotorPoweronHours, "Spindle Motor Power-On Hours", "hours");
+        write_Statistic(writer, deviceStats->sataStatistics.headFlyingHours, "Head Flying Hours", "hours");
+        write_Statistic(writer, deviceStats->sataStatistics.headLoadEvents, "Head Load Events", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.numberOfReallocatedLogicalSectors, "Number Of Reallocated Logical Sectors", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.readRecoveryAttempts, "Read Recovery Attempts", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.numberOfMechanicalStartFailures, "Number Of Mechanical Start Failures", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.numberOfReallocationCandidateLogicalSectors, "Number Of Reallocation Candidate Logical Sectors", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.numberOfHighPriorityUnloadEvents, "Number Of High Priority Unload Events", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sataStatistics.generalErrorsStatisticsSupported)
+    {
+        begin_Structured_Array(writer, "General Errors Statistics");
+        write_Statistic(writer, deviceStats->sataStatistics.numberOfReportedUncorrectableErrors, "Number Of Reported Uncorrectable Errors", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.numberOfResetsBetweenCommandAcceptanceAndCommandCompletion, "Number Of Resets Between Command Acceptance and Completion", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.physicalElementStatusChanged, "Physical Element Status Changed", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sataStatistics.temperatureStatisticsSupported)
+    {
+        begin_Structured_Array(writer, "Temperature Statistics");
+        write_Temperature_Statistic(writer, deviceStats->sataStatistics.currentTemperature, "Current Temperature", "C");
+        write_Temperature_Statistic(writer, deviceStats->sataStatistics.averageShortTermTemperature, "Average Short Term Temperature", "C");
+        write_Temperature_Statistic(writer, deviceStats->sataStatistics.averageLongTermTemperature, "Average Long Term Temperature", "C");
+        write_Temperature_Statistic(writer, deviceStats->sataStatistics.highestTemperature, "Highest Temperature", "C");
+        write_Temperature_Statistic(writer, deviceStats->sataStatistics.lowestTemperature, "Lowest Temperature", "C");
+        write_Temperature_Statistic(writer, deviceStats->sataStatistics.highestAverageShortTermTemperature, "Highest Average Short Term Temperature", "C");
+        write_Temperature_Statistic(writer, deviceStats->sataStatistics.lowestAverageShortTermTemperature, "Lowest Average Short Term Temperature", "C");
+        write_Temperature_Statistic(writer, deviceStats->sataStatistics.highestAverageLongTermTemperature, "Highest Average Long Term Temperature", "C");
+        write_Temperature_Statistic(writer, deviceStats->sataStatistics.lowestAverageLongTermTemperature, "Lowest Average Long Term Temperature", "C");
+        write_Statistic(writer, deviceStats->sataStatistics.timeInOverTemperature, "Time In Over Temperature", "minutes");
+        write_Temperature_Statistic(writer, deviceStats->sataStatistics.specifiedMaximumOperatingTemperature, "Specified Maximum Operating Temperature", "C");
+        write_Statistic(writer, deviceStats->sataStatistics.timeInUnderTemperature, "Time In Under Temperature", "minutes");
+        write_Temperature_Statistic(writer, deviceStats->sataStatistics.specifiedMinimumOperatingTemperature, "Specified Minimum Operating Temperature", "C");
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sataStatistics.transportStatisticsSupported)
+    {
+        begin_Structured_Array(writer, "Transport Statistics");
+        write_Statistic(writer, deviceStats->sataStatistics.numberOfHardwareResets, "Number Of Hardware Resets", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.numberOfASREvents, "Number Of ASR Events", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.numberOfInterfaceCRCErrors, "Number Of Interface CRC Errors", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sataStatistics.ssdStatisticsSupported)
+    {
+        begin_Structured_Array(writer, "Solid State Device Statistics");
+        write_Statistic(writer, deviceStats->sataStatistics.percentageUsedIndicator, "Percent Used Indicator", "%");
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sataStatistics.zonedDeviceStatisticsSupported)
+    {
+        begin_Structured_Array(writer, "Zoned Device Statistics");
+        write_Statistic(writer, deviceStats->sataStatistics.maximumOpenZones, "Maximum Open Zones", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.maximumExplicitlyOpenZones, "Maximum Explicitly Open Zones", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.maximumImplicitlyOpenZones, "Maximum Implicitly Open Zones", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.minimumEmptyZones, "Minumum Empty Zones", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.maximumNonSequentialZones, "Maximum Non-sequential Zones", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.zonesEmptied, "Zones Emptied", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.suboptimalWriteCommands, "Suboptimal Write Commands", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.commandsExceedingOptimalLimit, "Commands Exceeding Optimal Limit", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.failedExplicitOpens, "Failed Explicit Opens", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.readRuleViolations, "Read Rule Violations", NULL);
+        write_Statistic(writer, deviceStats->sataStatistics.writeRuleViolations, "Write Rule Violations", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sataStatistics.vendorSpecificStatisticsSupported)
+    {
+        if (SEAGATE == is_Seagate_Family(device))
+        {
+            begin_Structured_Array(writer, "Seagate Specific Statistics");
+        }
+        else
+        {
+            begin_Structured_Array(writer, "Vendor Specific Statistics");
+        }
+        for (uint8_t vendorSpecificIter = 0, statisticsFound = 0; vendorSpecificIter < 64 && statisticsFound < deviceStats->sataStatistics.vendorSpecificStatisticsPopulated; ++vendorSpecificIter)
+        {
+            #define VENDOR_UNIQUE_DEVICE_STATISTIC_NAME_STRING_LENGTH 64
+            char statisticName[VENDOR_UNIQUE_DEVICE_STATISTIC_NAME_STRING_LENGTH] = { 0 };
+            if (SEAGATE == is_Seagate_Family(device))
+            {
+                switch (vendorSpecificIter + 1)
+                {
+                case 1://pressure
+                    snprintf(statisticName, VENDOR_UNIQUE_DEVICE_STATISTIC_NAME_STRING_LENGTH, "Pressure Min/Max Reached");
+                    break;
+                default:
+                    snprintf(statisticName, VENDOR_UNIQUE_DEVICE_STATISTIC_NAME_STRING_LENGTH, "Vendor Specific Statistic %" PRIu8, vendorSpecificIter + 1);
+                    break;
+                }
+            }
+            else
+            {
+                snprintf(statisticName, VENDOR_UNIQUE_DEVICE_STATISTIC_NAME_STRING_LENGTH, "Vendor Specific Statistic %" PRIu8, vendorSpecificIter + 1);
+            }
+            if (deviceStats->sataStatistics.vendorSpecificStatistics[vendorSpecificIter].isSupported)
+            {
+                write_Statistic(writer, deviceStats->sataStatistics.vendorSpecificStatistics[vendorSpecificIter], statisticName, NULL);
+                ++statisticsFound;
+            }
+        }
+        end_Structured_Array(writer);
+    }
+    return ret;
+}
+
+static int write_SCSI_DeviceStatistics(M_ATTR_UNUSED tDevice *device, ptrDeviceStatistics deviceStats, ptrStructuredWriter writer)
+{
+    int ret = SUCCESS;
+    if (!deviceStats)
+    {
+        return MEMORY_FAILURE;
+    }
+    ret = SUCCESS;
+    if (deviceStats->sasStatistics.writeErrorCountersSupported)
+    {
+        begin_Structured_Array(writer, "Write Error Counters");
+        write_Statistic(writer, deviceStats->sasStatistics.writeErrorsCorrectedWithoutSubstantialDelay, "Write Errors Corrected Without Substantial Delay", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.writeErrorsCorrectedWithPossibleDelays, "Write Errors Corrected With Possible Delay", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.writeTotalReWrites, "Write Total Rewrites", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.writeErrorsCorrected, "Write Errors Corrected", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.writeTotalTimeCorrectionAlgorithmProcessed, "Write Total Times Corrective Algorithm Processed", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.writeTotalBytesProcessed, "Write Total Bytes Processed", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.writeTotalUncorrectedErrors, "Write Total Uncorrected Errors", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.readErrorCountersSupported)
+    {
+        begin_Structured_Array(writer, "Read Error Counters");
+        write_Statistic(writer, deviceStats->sasStatistics.readErrorsCorrectedWithPossibleDelays, "Read Errors Corrected With Possible Delay", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readTotalRereads, "Read Total Rereads", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readErrorsCorrected, "Read Errors Corrected", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readTotalTimeCorrectionAlgorithmProcessed, "Read Total Times Corrective Algorithm Processed", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readTotalBytesProcessed, "Read Total Bytes Processed", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readTotalUncorrectedErrors, "Read Total Uncorrected Errors", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.readReverseErrorCountersSupported)
+    {
+        begin_Structured_Array(writer, "Read Reverse Error Counters");
+        write_Statistic(writer, deviceStats->sasStatistics.readReverseErrorsCorrectedWithoutSubstantialDelay, "Read Reverse Errors Corrected Without Substantial Delay", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readReverseErrorsCorrectedWithPossibleDelays, "Read Reverse Errors Corrected With Possible Delay", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readReverseTotalReReads, "Read Reverse Total Rereads", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readReverseErrorsCorrected, "Read Reverse Errors Corrected", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readReverseTotalTimeCorrectionAlgorithmProcessed, "Read Reverse Total Times Corrective Algorithm Processed", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readReverseTotalBytesProcessed, "Read Reverse Total Bytes Processed", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readReverseTotalUncorrectedErrors, "Read Reverse Total Uncorrected Errors", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.verifyErrorCountersSupported)
+    {
+        begin_Structured_Array(writer, "Verify Error Counters");
+        write_Statistic(writer, deviceStats->sasStatistics.verifyErrorsCorrectedWithoutSubstantialDelay, "Verify Errors Corrected Without Substantial Delay", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.verifyErrorsCorrectedWithPossibleDelays, "Verify Errors Corrected With Possible Delay", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.verifyTotalReVerifies, "Verify Total Rereads", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.verifyErrorsCorrected, "Verify Errors Corrected", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.verifyTotalTimeCorrectionAlgorithmProcessed, "Verify Total Times Corrective Algorithm Processed", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.verifyTotalBytesProcessed, "Verify Total Bytes Processed", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.verifyTotalUncorrectedErrors, "Verify Total Uncorrected Errors", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.nonMediumErrorSupported)
+    {
+        begin_Structured_Array(writer, "Non Medium Error");
+        write_Statistic(writer, deviceStats->sasStatistics.nonMediumErrorCount, "Non-Medium Error Count", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.formatStatusSupported)
+    {
+        begin_Structured_Array(writer, "Format Status");
+        write_Statistic(writer, deviceStats->sasStatistics.grownDefectsDuringCertification, "Grown Defects During Certification", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.totalBlocksReassignedDuringFormat, "Total Blocks Reassigned During Format", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.totalNewBlocksReassigned, "Total New Blocks Reassigned", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.powerOnMinutesSinceFormat, "Power On Minutes Since Last Format", "minutes");
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.logicalBlockProvisioningSupported)
+    {
+        begin_Structured_Array(writer, "Logical Block Provisioning");
+        write_Statistic(writer, deviceStats->sasStatistics.availableLBAMappingresourceCount, "Available LBA Mapping Resource Count", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.usedLBAMappingResourceCount, "Used LBA Mapping Resource Count", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.availableProvisioningResourcePercentage, "Available Provisioning Resource Percentage", "%");
+        write_Statistic(writer, deviceStats->sasStatistics.deduplicatedLBAResourceCount, "De-duplicted LBA Resource Count", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.compressedLBAResourceCount, "Compressed LBA Resource Count", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.totalEfficiencyLBAResourceCount, "Total Efficiency LBA Resource Count", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.temperatureSupported)
+    {
+        begin_Structured_Array(writer, "Temperature");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.temperature, "Temperature", "C");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.referenceTemperature, "Reference Temperature", "C");
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.environmentReportingSupported)
+    {
+        begin_Structured_Array(writer, "Environmental Reporting");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.currentTemperature, "Temperature", "C");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.lifetimeMaximumTemperature, "Lifetime Maximum Temperature", "C");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.lifetimeMinimumTemperature, "Lifetime Minimum Temperature", "C");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.maximumTemperatureSincePowerOn, "Maximum Temperature Since Power On", "C");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.minimumTemperatureSincePowerOn, "Minimum Temperature Since Power On", "C");
+        write_Statistic(writer, deviceStats->sasStatistics.currentRelativeHumidity, "Relative Humidity", "%");
+        write_Statistic(writer, deviceStats->sasStatistics.lifetimeMaximumRelativeHumidity, "Lifetime Maximum Relative Humidity", "%");
+        write_Statistic(writer, deviceStats->sasStatistics.lifetimeMinumumRelativeHumidity, "Lifetime Minimum Relative Humidity", "%");
+        write_Statistic(writer, deviceStats->sasStatistics.maximumRelativeHumiditySincePoweron, "Maximum Relative Humidity Since Power On", "%");
+        write_Statistic(writer, deviceStats->sasStatistics.minimumRelativeHumiditySincePoweron, "Minimum Relative Humidity Since Power On", "%");
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.environmentReportingSupported)
+    {
+        begin_Structured_Array(writer, "Environmental Limits");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.highCriticalTemperatureLimitTrigger, "High Critical Temperature Limit Trigger", "C");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.highCriticalTemperatureLimitReset, "High Critical Temperature Limit Reset", "C");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.lowCriticalTemperatureLimitReset, "Low Critical Temperature Limit Reset", "C");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.lowCriticalTemperatureLimitTrigger, "Low Critical Temperature Limit Trigger", "C");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.highOperatingTemperatureLimitTrigger, "High Operating Temperature Limit Trigger", "C");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.highOperatingTemperatureLimitReset, "High Operating Temperature Limit Reset", "C");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.lowOperatingTemperatureLimitReset, "Low Operating Temperature Limit Reset", "C");
+        write_Temperature_Statistic(writer, deviceStats->sasStatistics.lowOperatingTemperatureLimitTrigger, "Low Operating Temperature Limit Trigger", "C");
+        write_Statistic(writer, deviceStats->sasStatistics.highCriticalHumidityLimitTrigger, "High Critical Relative Humidity Limit Trigger", "%");
+        write_Statistic(writer, deviceStats->sasStatistics.highCriticalHumidityLimitReset, "High Critical Relative Humidity Limit Reset", "%");
+        write_Statistic(writer, deviceStats->sasStatistics.lowCriticalHumidityLimitReset, "Low Critical Relative Humidity Limit Reset", "%");
+        write_Statistic(writer, deviceStats->sasStatistics.lowCriticalHumidityLimitTrigger, "Low Critical Relative Humidity Limit Trigger", "%");
+        write_Statistic(writer, deviceStats->sasStatistics.highOperatingHumidityLimitTrigger, "High Operating Relative Humidity Limit Trigger", "%");
+        write_Statistic(writer, deviceStats->sasStatistics.highOperatingHumidityLimitReset, "High Operating Relative Humidity Limit Reset", "%");
+        write_Statistic(writer, deviceStats->sasStatistics.lowOperatingHumidityLimitReset, "Low Operating Relative Humidity Limit Reset", "%");
+        write_Statistic(writer, deviceStats->sasStatistics.lowOperatingHumidityLimitTrigger, "Low Operating Relative Humidity Limit Trigger", "%");
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.startStopCycleCounterSupported)
+    {
+        begin_Structured_Array(writer, "Start-Stop Cycle Counter");
+        write_Statistic(writer, deviceStats->sasStatistics.dateOfManufacture, "Date Of Manufacture", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.accountingDate, "Accounting Date", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.specifiedCycleCountOverDeviceLifetime, "Specified Cycle Count Over Device Lifetime", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.accumulatedStartStopCycles, "Accumulated Start-Stop Cycles", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.specifiedLoadUnloadCountOverDeviceLifetime, "Specified Load-Unload Count Over Device Lifetime", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.accumulatedLoadUnloadCycles, "Accumulated Load-Unload Cycles", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.utilizationSupported)
+    {
+        begin_Structured_Array(writer, "Utilization");
+        write_Statistic(writer, deviceStats->sasStatistics.workloadUtilization, "Workload Utilization", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.utilizationUsageRateBasedOnDateAndTime, "Utilization Usage Rate", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.solidStateMediaSupported)
+    {
+        begin_Structured_Array(writer, "Solid State Media");
+        write_Statistic(writer, deviceStats->sasStatistics.percentUsedEndurance, "Percent Used Endurance", "%");
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.backgroundScanResultsSupported)
+    {
+        begin_Structured_Array(writer, "Background Scan Results");
+        write_Statistic(writer, deviceStats->sasStatistics.accumulatedPowerOnMinutes, "Accumulated Power On Minutes", "minutes");
+        write_Statistic(writer, deviceStats->sasStatistics.numberOfBackgroundScansPerformed, "Number Of Background Scans Performed", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.numberOfBackgroundMediaScansPerformed, "Number Of Background Media Scans Performed", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.pendingDefectsSupported)
+    {
+        begin_Structured_Array(writer, "Pending Defects");
+        write_Statistic(writer, deviceStats->sasStatistics.pendingDefectCount, "Pending Defect Count", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.lpsMisalignmentSupported)
+    {
+        begin_Structured_Array(writer, "LPS Misalignment");
+        write_Statistic(writer, deviceStats->sasStatistics.lpsMisalignmentCount, "LPS Misalignment Count", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.nvCacheSupported)
+    {
+        begin_Structured_Array(writer, "Non-Volatile Cache");
+        write_Statistic(writer, deviceStats->sasStatistics.remainingNonvolatileTime, "Remaining Non-Volatile Time", "minutes");
+        write_Statistic(writer, deviceStats->sasStatistics.maximumNonvolatileTime, "Maximum Non-Volatile Time", "minutes");
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.generalStatisticsAndPerformanceSupported)
+    {
+        begin_Structured_Array(writer, "General Statistics And Performance");
+        write_Statistic(writer, deviceStats->sasStatistics.numberOfReadCommands, "Number Of Read Commands", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.numberOfWriteCommands, "Number Of Write Commands", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.numberOfLogicalBlocksReceived, "Number Of Logical Blocks Received", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.numberOfLogicalBlocksTransmitted, "Number Of Logical Blocks Transmitted", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readCommandProcessingIntervals, "Read Command Processing Intervals", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.writeCommandProcessingIntervals, "Write Command Processing Intervals", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.weightedNumberOfReadCommandsPlusWriteCommands, "Weighted Number Of Read Commands Plus Write Commands", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.weightedReadCommandProcessingPlusWriteCommandProcessing, "Weighted Number Of Read Command Processing Plus Write Command Processing", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.idleTimeIntervals, "Idle Time Intervals", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.timeIntervalDescriptor, "Time Interval Desriptor", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.numberOfReadFUACommands, "Number Of Read FUA Commands", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.numberOfWriteFUACommands, "Number Of Write FUA Commands", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.numberOfReadFUANVCommands, "Number Of Read FUA NV Commands", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.numberOfWriteFUANVCommands, "Number Of Write FUA NV Commands", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readFUACommandProcessingIntervals, "Read FUA Command Processing Intervals", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.writeFUACommandProcessingIntervals, "Write FUA Command Processing Intervals", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readFUANVCommandProcessingIntervals, "Read FUA NV Command Processing Intervals", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.writeFUANVCommandProcessingIntervals, "Write FUA NV Command Processing Intervals", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.cacheMemoryStatisticsSupported)
+    {
+        begin_Structured_Array(writer, "Cache Memory Statistics");
+        write_Statistic(writer, deviceStats->sasStatistics.readCacheMemoryHits, "Read Cache Memory Hits", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readsToCacheMemory, "Reads To Cache Memory", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.writeCacheMemoryHits, "Write Cache Memory Hits", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.writesFromCacheMemory, "Writes From Cache Memory", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.timeFromLastHardReset, "Last Hard Reset Intervals", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.cacheTimeInterval, "Cache Memory Time Interval", NULL);
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.timeStampSupported)
+    {
+        begin_Structured_Array(writer, "Timestamp");
+        write_Statistic(writer, deviceStats->sasStatistics.dateAndTimeTimestamp, "Date And Time Timestamp", "milliseconds");
+        end_Structured_Array(writer);
+    }
+    if (deviceStats->sasStatistics.zonedDeviceStatisticsSupported)
+    {
+        begin_Structured_Array(writer, "Zoned Device Statistics");
+        write_Statistic(writer, deviceStats->sasStatistics.maximumOpenZones, "Maximum Open Zones", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.maximumExplicitlyOpenZones, "Maximum Explicitly Open Zones", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.maximumImplicitlyOpenZones, "Maximum Implicitly Open Zones", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.minimumEmptyZones, "Minumum Empty Zones", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.maximumNonSequentialZones, "Maximum Non-sequential Zones", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.zonesEmptied, "Zones Emptied", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.suboptimalWriteCommands, "Suboptimal Write Commands", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.commandsExceedingOptimalLimit, "Commands Exceeding Optimal Limit", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.failedExplicitOpens, "Failed Explicit Opens", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.readRuleViolations, "Read Rule Violations", NULL);
+        write_Statistic(writer, deviceStats->sasStatistics.writeRuleViolations, "Write Rule Violations", NULL);
+        end_Structured_Array(writer);
+    }
+    return ret;
+}
+
+int write_DeviceStatistics(tDevice *device, ptrDeviceStatistics deviceStats, ptrStructuredWriter writer)
+{
+    int ret = NOT_SUPPORTED;
+    if (!deviceStats)
+    {
+        return MEMORY_FAILURE;
+    }
+    if (!writer)
+    {
+        return BAD_PARAMETER;
+    }
+    if (device->drive_info.drive_type == ATA_DRIVE)
+    {
+        begin_Structured_Object(writer, "Device Statistics");
+        ret = write_ATA_DeviceStatistics(device, deviceStats, writer);
+        end_Structured_Object(writer);
+    }
+    else if (device->drive_info.drive_type == SCSI_DRIVE)
+    {
+        begin_Structured_Object(writer, "Device Statistics");
+        ret = write_SCSI_DeviceStatistics(device, deviceStats, writer);
+        end_Structured_Object(writer);
+    }
+    return ret;
+}
@@ -377,7 +377,7 @@ int get_ATA_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA drive
             else
             {
                 //Read supported security protocol list
-                uint8_t *protocolList = C_CAST(uint8_t*, calloc_aligned(LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+                uint8_t *protocolList = C_CAST(uint8_t*, get_Device_Buffer(device, LEGACY_DRIVE_SEC_SIZE));
                 if (protocolList)
                 {
                     if (SUCCESS == ata_Trusted_Receive(device, device->drive_info.ata_Options.dmaSupported, 0, 0, protocolList, LEGACY_DRIVE_SEC_SIZE))
@@ -424,7 +424,7 @@ int get_ATA_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA drive
                             }
                         }
                     }
-                    safe_Free_aligned(protocolList)
+                    safe_Release_Device_Buffer(device, protocolList, LEGACY_DRIVE_SEC_SIZE)
                 }
             }
         }
@@ -2397,7 +2397,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
     }
 
     //VPD pages (read list of supported pages...if we don't get anything back, we'll dummy up a list of things we are interested in trying to read...this is to work around crappy USB bridges
-    uint8_t *tempBuf = C_CAST(uint8_t*, calloc_aligned(LEGACY_DRIVE_SEC_SIZE * 2, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint8_t *tempBuf = C_CAST(uint8_t*, get_Device_Buffer(device, LEGACY_DRIVE_SEC_SIZE * 2));
     if (!tempBuf)
     {
         return MEMORY_FAILURE;
@@ -2487,7 +2487,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
             case UNIT_SERIAL_NUMBER:
             {
                 uint8_t unitSerialNumberPageLength = SERIAL_NUM_LEN + 4;//adding 4 bytes extra for the header
-                uint8_t *unitSerialNumber = C_CAST(uint8_t*, calloc_aligned(unitSerialNumberPageLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+                uint8_t *unitSerialNumber = C_CAST(uint8_t*, get_Device_Buffer(device, unitSerialNumberPageLength));
                 if (!unitSerialNumber)
                 {
                     perror("Error allocating memory to read the unit serial number");
@@ -2518,7 +2518,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                         }
                     }
                 }
-                safe_Free_aligned(unitSerialNumber)
+                safe_Release_Device_Buffer(device, unitSerialNumber, unitSerialNumberPageLength)
                 break;
             }
             case DEVICE_IDENTIFICATION:
@@ -2616,7 +2616,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
             }
             case EXTENDED_INQUIRY_DATA:
             {
-                uint8_t *extendedInquiryData = C_CAST(uint8_t*, calloc_aligned(VPD_EXTENDED_INQUIRY_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+                uint8_t *extendedInquiryData = C_CAST(uint8_t*, get_Device_Buffer(device, VPD_EXTENDED_INQUIRY_LEN));
                 if (!extendedInquiryData)
                 {
                     perror("Error allocating memory to read extended inquiry VPD page");
@@ -2701,12 +2701,12 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                         break;
                     }
                 }
-                safe_Free_aligned(extendedInquiryData)
+                safe_Release_Device_Buffer(device, extendedInquiryData, VPD_EXTENDED_INQUIRY_LEN)
                 break;
             }
             case BLOCK_DEVICE_CHARACTERISTICS:
             {
-                uint8_t *blockDeviceCharacteristics = C_CAST(uint8_t*, calloc_aligned(VPD_BLOCK_DEVICE_CHARACTERISTICS_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+                uint8_t *blockDeviceCharacteristics = C_CAST(uint8_t*, get_Device_Buffer(device, VPD_BLOCK_DEVICE_CHARACTERISTICS_LEN));
                 if (!blockDeviceCharacteristics)
                 {
                     perror("Error allocating memory to read block device characteistics VPD page");
@@ -2719,7 +2719,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                     driveInfo->formFactor = M_Nibble0(blockDeviceCharacteristics[7]);
                     driveInfo->zonedDevice = (blockDeviceCharacteristics[8] & (BIT4 | BIT5)) >> 4;
                 }
-                safe_Free_aligned(blockDeviceCharacteristics)
+                safe_Release_Device_Buffer(device, blockDeviceCharacteristics, VPD_BLOCK_DEVICE_CHARACTERISTICS_LEN)
                 break;
             }
             case POWER_CONDITION:
@@ -2733,7 +2733,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                 break;
             case LOGICAL_BLOCK_PROVISIONING:
             {
-                uint8_t *logicalBlockProvisioning = C_CAST(uint8_t*, calloc_aligned(VPD_LOGICAL_BLOCK_PROVISIONING_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+                uint8_t *logicalBlockProvisioning = C_CAST(uint8_t*, get_Device_Buffer(device, VPD_LOGICAL_BLOCK_PROVISIONING_LEN));
                 if (!logicalBlockProvisioning)
                 {
                     perror("Error allocating memory to read logical block provisioning VPD page");
@@ -2747,12 +2747,12 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                         driveInfo->numberOfFeaturesSupported++;
                     }
                 }
-                safe_Free_aligned(logicalBlockProvisioning)
+                safe_Release_Device_Buffer(device, logicalBlockProvisioning, VPD_LOGICAL_BLOCK_PROVISIONING_LEN)
                 break;
             }
             case BLOCK_LIMITS:
             {
-                uint8_t *blockLimits = C_CAST(uint8_t*, calloc_aligned(VPD_BLOCK_LIMITS_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+                uint8_t *blockLimits = C_CAST(uint8_t*, get_Device_Buffer(device, VPD_BLOCK_LIMITS_LEN));
                 if (!blockLimits)
                 {
                     perror("Error allocating memory to read logical block provisioning VPD page");
@@ -2767,12 +2767,12 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                         driveInfo->numberOfFeaturesSupported++;
                     }
                 }
-                safe_Free_aligned(blockLimits)
+                safe_Release_Device_Buffer(device, blockLimits, VPD_BLOCK_LIMITS_LEN)
                 break;
             }
             case ATA_INFORMATION:
             {
-                uint8_t *ataInformation = C_CAST(uint8_t*, calloc_aligned(VPD_ATA_INFORMATION_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+                uint8_t *ataInformation = C_CAST(uint8_t*, get_Device_Buffer(device, VPD_ATA_INFORMATION_LEN));
                 if (!ataInformation)
                 {
                     perror("Error allocating memory to read ATA Information VPD page");
@@ -2786,13 +2786,13 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                     memcpy(driveInfo->satProductRevision, &ataInformation[32], 4);
                     driveInfo->numberOfFeaturesSupported++;
                 }
-                safe_Free_aligned(ataInformation)
+                safe_Release_Device_Buffer(device, ataInformation, VPD_ATA_INFORMATION_LEN)
                 break;
             }
             case CONCURRENT_POSITIONING_RANGES:
             {
                 uint32_t concurrentRangesLength = (15 * 32) + 64;//max of 15 ranges at 32 bytes each, plus 64 bytes that show ahead as a "header"
-                uint8_t *concurrentRanges = C_CAST(uint8_t*, calloc_aligned(concurrentRangesLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+                uint8_t *concurrentRanges = C_CAST(uint8_t*, get_Device_Buffer(device, concurrentRangesLength));
                 if (!concurrentRanges)
                 {
                     perror("Error allocating memory to read concurrent positioning ranges VPD page");
@@ -2803,7 +2803,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                     //calculate how many ranges are being reported by the device.
                     driveInfo->concurrentPositioningRanges = (M_BytesTo2ByteValue(concurrentRanges[2], concurrentRanges[3]) - 60) / 32;//-60 since page length doesn't include first 4 bytes and descriptors start at offset 64. Each descriptor is 32B long
                 }
-                safe_Free_aligned(concurrentRanges)
+                safe_Release_Device_Buffer(device, concurrentRanges, concurrentRangesLength)
             }
                 break;
             default:
@@ -2823,7 +2823,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
     uint8_t *readCapBuf = C_CAST(uint8_t*, calloc_aligned(READ_CAPACITY_10_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
     if (!readCapBuf)
     {
-        safe_Free_aligned(tempBuf)
+        safe_Release_Device_Buffer(device, tempBuf, LEGACY_DRIVE_SEC_SIZE * 2)
         return MEMORY_FAILURE;
     }
     switch (peripheralDeviceType)
@@ -2841,7 +2841,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                 uint8_t* temp = C_CAST(uint8_t*, realloc_aligned(readCapBuf, READ_CAPACITY_10_LEN, READ_CAPACITY_16_LEN * sizeof(uint8_t), device->os_info.minimumAlignment));
                 if (!temp)
                 {
-                    safe_Free_aligned(tempBuf)
+                    safe_Release_Device_Buffer(device, tempBuf, LEGACY_DRIVE_SEC_SIZE * 2)
                     safe_Free_aligned(readCapBuf)
                     return MEMORY_FAILURE;
                 }
@@ -2903,7 +2903,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
             uint8_t* temp = C_CAST(uint8_t*, realloc_aligned(readCapBuf, READ_CAPACITY_10_LEN, READ_CAPACITY_16_LEN * sizeof(uint8_t), device->os_info.minimumAlignment));
             if (temp == NULL)
             {
-                safe_Free_aligned(tempBuf)
+                safe_Release_Device_Buffer(device, tempBuf, LEGACY_DRIVE_SEC_SIZE * 2)
                 safe_Free_aligned(readCapBuf)
                 return MEMORY_FAILURE;
             }
@@ -3257,7 +3257,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                 {
                     //we need parameter code 5h (total bytes processed)
                     //assume we only need to read 16 bytes to get this value
-                    uint8_t *writeErrorData = C_CAST(uint8_t*, calloc_aligned(16, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    uint8_t *writeErrorData = C_CAST(uint8_t*, get_Device_Buffer(device, 16));
                     if (!writeErrorData)
                     {
                         break;
@@ -3292,7 +3292,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                             }
                         }
                     }
-                    safe_Free_aligned(writeErrorData)
+                    safe_Release_Device_Buffer(device, writeErrorData, 16)
                 }
                 break;
             case LP_READ_ERROR_COUNTERS:
@@ -3300,7 +3300,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                 {
                     //we need parameter code 5h (total bytes processed)
                     //assume we only need to read 16 bytes to get this value
-                    uint8_t *readErrorData = C_CAST(uint8_t*, calloc_aligned(16, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    uint8_t *readErrorData = C_CAST(uint8_t*, get_Device_Buffer(device, 16));
                     if (!readErrorData)
                     {
                         break;
@@ -3335,7 +3335,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                             }
                         }
                     }
-                    safe_Free_aligned(readErrorData)
+                    safe_Release_Device_Buffer(device, readErrorData, 16)
                 }
                 break;
             case LP_LOGICAL_BLOCK_PROVISIONING:
@@ -3349,7 +3349,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                 {
                 case 0://temperature
                 {
-                    uint8_t *temperatureData = C_CAST(uint8_t*, calloc_aligned(10, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    uint8_t *temperatureData = C_CAST(uint8_t*, get_Device_Buffer(device, 10));
                     if (!temperatureData)
                     {
                         break;
@@ -3359,12 +3359,12 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                         driveInfo->temperatureData.temperatureDataValid = true;
                         driveInfo->temperatureData.currentTemperature = temperatureData[9];
                     }
-                    safe_Free_aligned(temperatureData)
+                    safe_Release_Device_Buffer(device, temperatureData, 10)
                 }
                 break;
                 case 1://environmental reporting
                 {
-                    uint8_t *environmentReporting = C_CAST(uint8_t*, calloc_aligned(16, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    uint8_t *environmentReporting = C_CAST(uint8_t*, get_Device_Buffer(device, 16));
                     if (!environmentReporting)
                     {
                         break;
@@ -3389,7 +3389,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                         driveInfo->humidityData.highestValid = true;
                         driveInfo->humidityData.lowestValid = true;
                     }
-                    safe_Free_aligned(environmentReporting)
+                    safe_Release_Device_Buffer(device, environmentReporting, 16)
                 }
                 break;
                 default:
@@ -3401,7 +3401,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                 {
                 case 0x01://utilization
                 {
-                    uint8_t *utilizationData = C_CAST(uint8_t*, calloc_aligned(10, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    uint8_t *utilizationData = C_CAST(uint8_t*, get_Device_Buffer(device, 10));
                     if (!utilizationData)
                     {
                         break;
@@ -3411,7 +3411,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                         //bytes 9 & 10
                         driveInfo->deviceReportedUtilizationRate = C_CAST(double, M_BytesTo2ByteValue(utilizationData[8], utilizationData[9])) / 1000.0;
                     }
-                    safe_Free_aligned(utilizationData)
+                    safe_Release_Device_Buffer(device, utilizationData, 10)
                 }
                 break;
                 default:
@@ -3423,7 +3423,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                 {
                 case 0x00://application client
                 {
-                    uint8_t *applicationClient = C_CAST(uint8_t*, calloc_aligned(4, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    uint8_t *applicationClient = C_CAST(uint8_t*, get_Device_Buffer(device, 4));
                     if (!applicationClient)
                     {
                         break;
@@ -3434,7 +3434,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                         snprintf(driveInfo->featuresSupported[driveInfo->numberOfFeaturesSupported], MAX_FEATURE_LENGTH, "Application Client Logging");
                         driveInfo->numberOfFeaturesSupported++;
                     }
-                    safe_Free_aligned(applicationClient)
+                    safe_Release_Device_Buffer(device, applicationClient, 4)
                 }
                 break;
                 default:
@@ -3444,7 +3444,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
             case LP_SELF_TEST_RESULTS:
                 if (subpageCode == 0)
                 {
-                    uint8_t *selfTestResults = C_CAST(uint8_t*, calloc_aligned(LP_SELF_TEST_RESULTS_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    uint8_t *selfTestResults = C_CAST(uint8_t*, get_Device_Buffer(device, LP_SELF_TEST_RESULTS_LEN));
                     if (!selfTestResults)
                     {
                         break;
@@ -3461,14 +3461,14 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                         driveInfo->dstInfo.powerOnHours = M_BytesTo2ByteValue(selfTestResults[parameterOffset + 6], selfTestResults[parameterOffset + 7]);
                         driveInfo->dstInfo.errorLBA = M_BytesTo8ByteValue(selfTestResults[parameterOffset + 8], selfTestResults[parameterOffset + 9], selfTestResults[parameterOffset + 10], selfTestResults[parameterOffset + 11], selfTestResults[parameterOffset + 12], selfTestResults[parameterOffset + 13], selfTestResults[parameterOffset + 14], selfTestResults[parameterOffset + 15]);
                     }
-                    safe_Free_aligned(selfTestResults)
+                    safe_Release_Device_Buffer(device, selfTestResults, LP_SELF_TEST_RESULTS_LEN)
                 }
                 break;
             case LP_SOLID_STATE_MEDIA:
                 if (subpageCode == 0)
                 {
                     //need parameter 0001h
-                    uint8_t *ssdEnduranceData = C_CAST(uint8_t*, calloc_aligned(12, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    uint8_t *ssdEnduranceData = C_CAST(uint8_t*, get_Device_Buffer(device, 12));
                     if (!ssdEnduranceData)
                     {
                         break;
@@ -3478,14 +3478,14 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                         //bytes 7 of parameter 1 (or byte 12)
                         driveInfo->percentEnduranceUsed = C_CAST(double, ssdEnduranceData[11]);
                     }
-                    safe_Free_aligned(ssdEnduranceData)
+                    safe_Release_Device_Buffer(device, ssdEnduranceData, 12)
                 }
                 break;
             case LP_BACKGROUND_SCAN_RESULTS:
                 if (subpageCode == 0)
                 {
                     //reading power on minutes from here
-                    uint8_t *backgroundScanResults = C_CAST(uint8_t*, calloc_aligned(19, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    uint8_t *backgroundScanResults = C_CAST(uint8_t*, get_Device_Buffer(device, 19));
                     if (!backgroundScanResults)
                     {
                         break;
@@ -3495,14 +3495,14 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                         //bytes 8 to 11
                         driveInfo->powerOnMinutes = M_BytesTo4ByteValue(backgroundScanResults[8], backgroundScanResults[9], backgroundScanResults[10], backgroundScanResults[11]);
                     }
-                    safe_Free_aligned(backgroundScanResults)
+                    safe_Release_Device_Buffer(device, backgroundScanResults, 19)
                 }
                 break;
             case LP_GENERAL_STATISTICS_AND_PERFORMANCE:
                 if (subpageCode == 0)
                 {
                     //parameter code 1 is what we're interested in for this one
-                    uint8_t *generalStatsAndPerformance = C_CAST(uint8_t*, calloc_aligned(72, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    uint8_t *generalStatsAndPerformance = C_CAST(uint8_t*, get_Device_Buffer(device, 72));
                     if (!generalStatsAndPerformance)
                     {
                         break;
@@ -3518,13 +3518,13 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                         //convert to bytes written
                         driveInfo->totalBytesRead = driveInfo->totalLBAsRead * driveInfo->logicalSectorSize;
                     }
-                    safe_Free_aligned(generalStatsAndPerformance)
+                    safe_Release_Device_Buffer(device, generalStatsAndPerformance, 72)
                 }
                 break;
             case LP_INFORMATION_EXCEPTIONS:
                 if (subpageCode == 0)
                 {
-                    uint8_t *informationExceptions = C_CAST(uint8_t*, calloc_aligned(11, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    uint8_t *informationExceptions = C_CAST(uint8_t*, get_Device_Buffer(device, 11));
                     if (!informationExceptions)
                     {
                         break;
@@ -3545,13 +3545,13 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                     {
                         driveInfo->smartStatus = 2;
                     }
-                    safe_Free_aligned(informationExceptions)
+                    safe_Release_Device_Buffer(device, informationExceptions, 11)
                 }
                 break;
             case 0x3C://Vendor specific page. we're checking this page on Seagate drives for an enhanced usage indicator on SSDs (PPM value)
                 if (is_Seagate_Family(device) == SEAGATE || is_Seagate_Family(device) == SEAGATE_VENDOR_A)
                 {
-                    uint8_t *ssdUsage = C_CAST(uint8_t*, calloc_aligned(12, sizeof(uint8_t), device->os_info.minimumAlignment));
+                    uint8_t *ssdUsage = C_CAST(uint8_t*, get_Device_Buffer(device, 12));
                     if (!ssdUsage)
                     {
                         break;
@@ -3560,7 +3560,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
                     {
                         driveInfo->percentEnduranceUsed = (C_CAST(double, M_BytesTo4ByteValue(ssdUsage[8], ssdUsage[9], ssdUsage[10], ssdUsage[11])) / 1000000.00) * 100.00;
                     }
-                    safe_Free_aligned(ssdUsage)
+                    safe_Release_Device_Buffer(device, ssdUsage, 12)
                 }
                 break;
             default:
@@ -5299,7 +5299,7 @@ int get_SCSI_Drive_Information(tDevice *device, ptrDriveInformationSAS_SATA driv
         }
     }
     driveInfo->lowCurrentSpinupValid = false;
-    safe_Free_aligned(tempBuf)
+    safe_Release_Device_Buffer(device, tempBuf, LEGACY_DRIVE_SEC_SIZE * 2)
     return ret;
 }
 
@@ -5314,7 +5314,7 @@ int get_NVMe_Drive_Information(tDevice *device, ptrDriveInformationNVMe driveInf
 #if !defined(DISABLE_NVME_PASSTHROUGH)
     //changing ret to success since we have passthrough available
     ret = SUCCESS;
-    uint8_t *nvmeIdentifyData = C_CAST(uint8_t*, calloc_aligned(NVME_IDENTIFY_DATA_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint8_t *nvmeIdentifyData = C_CAST(uint8_t*, get_Device_Buffer(device, NVME_IDENTIFY_DATA_LEN));
     if (!nvmeIdentifyData)
     {
         return MEMORY_FAILURE;
@@ -5752,7 +5752,7 @@ int get_NVMe_Drive_Information(tDevice *device, ptrDriveInformationNVMe driveInf
         {
             driveInfo->smartData.smartStatus = 2;
         }
-        safe_Free_aligned(nvmeIdentifyData)
+        safe_Release_Device_Buffer(device, nvmeIdentifyData, NVME_IDENTIFY_DATA_LEN)
     }
     else
     {
@@ -7230,6 +7230,267 @@ int print_Drive_Information(tDevice *device, bool showChildInformation)
     return ret;
 }
 
+static void write_Last_DST_Information(ptrStructuredWriter writer, lastDSTInformation *dstInfo)
+{
+    if (dstInfo->informationValid)
+    {
+        begin_Structured_Object(writer, "Last DST");
+        write_Structured_Unsigned(writer, "Power On Hours", dstInfo->powerOnHours);
+        write_Structured_Unsigned(writer, "Test", dstInfo->testNumber);
+        write_Structured_Unsigned(writer, "Result", dstInfo->resultOrStatus);
+        if (dstInfo->errorLBA == UINT64_MAX)
+        {
+            write_Structured_String(writer, "Error LBA", NULL);
+        }
+        else
+        {
+            write_Structured_Unsigned(writer, "Error LBA", dstInfo->errorLBA);
+        }
+        end_Structured_Object(writer);
+    }
+}
+
+static void write_Feature_List(ptrStructuredWriter writer, const char *listName, char features[][MAX_FEATURE_LENGTH], uint16_t numberOfFeatures)
+{
+    begin_Structured_Array(writer, listName);
+    for (uint16_t featureIter = 0; featureIter < numberOfFeatures && featureIter < MAX_FEATURES; ++featureIter)
+    {
+        write_Structured_String(writer, NULL, features[featureIter]);
+    }
+    end_Structured_Array(writer);
+}
+
+static void write_SAS_SATA_Device_Information(ptrStructuredWriter writer, ptrDriveInformationSAS_SATA driveInfo)
+{
+    write_Structured_String(writer, "Vendor ID", driveInfo->vendorID);
+    write_Structured_String(writer, "Model Number", driveInfo->modelNumber);
+    write_Structured_String(writer, "Serial Number", driveInfo->serialNumber);
+    write_Structured_String(writer, "Firmware Revision", driveInfo->firmwareRevision);
+    if (driveInfo->worldWideNameSupported)
+    {
+        char wwnString[17] = { 0 };
+        snprintf(wwnString, 17, "%016" PRIX64, driveInfo->worldWideName);
+        write_Structured_String(writer, "World Wide Name", wwnString);
+    }
+    write_Structured_Unsigned(writer, "MaxLBA", driveInfo->maxLBA);
+    if (driveInfo->nativeMaxLBA != 0 && driveInfo->nativeMaxLBA != UINT64_MAX)
+    {
+        write_Structured_Unsigned(writer, "Native MaxLBA", driveInfo->nativeMaxLBA);
+    }
+    write_Structured_Unsigned(writer, "Logical Sector Size", driveInfo->logicalSectorSize);
+    write_Structured_Unsigned(writer, "Physical Sector Size", driveInfo->physicalSectorSize);
+    write_Structured_Unsigned(writer, "Sector Alignment", driveInfo->sectorAlignment);
+    write_Structured_Unsigned(writer, "Rotation Rate", driveInfo->rotationRate);
+    write_Structured_Unsigned(writer, "Form Factor", driveInfo->formFactor);
+    write_Structured_Unsigned(writer, "Cache Size", driveInfo->cacheSize);
+    if (driveInfo->hybridNANDSize > 0)
+    {
+        write_Structured_Unsigned(writer, "Hybrid NAND Size", driveInfo->hybridNANDSize);
+    }
+    if (driveInfo->temperatureData.temperatureDataValid)
+    {
+        write_Structured_Signed(writer, "Current Temperature (C)", driveInfo->temperatureData.currentTemperature);
+    }
+    if (driveInfo->temperatureData.highestValid)
+    {
+        write_Structured_Signed(writer, "Highest Temperature (C)", driveInfo->temperatureData.highestTemperature);
+    }
+    if (driveInfo->temperatureData.lowestValid)
+    {
+        write_Structured_Signed(writer, "Lowest Temperature (C)", driveInfo->temperatureData.lowestTemperature);
+    }
+    write_Structured_Unsigned(writer, "Power On Minutes", driveInfo->powerOnMinutes);
+    write_Structured_Unsigned(writer, "Total LBAs Read", driveInfo->totalLBAsRead);
+    write_Structured_Unsigned(writer, "Total LBAs Written", driveInfo->totalLBAsWritten);
+    write_Structured_Unsigned(writer, "Total Bytes Read", driveInfo->totalBytesRead);
+    write_Structured_Unsigned(writer, "Total Bytes Written", driveInfo->totalBytesWritten);
+    write_Structured_Double(writer, "Percent Endurance Used", driveInfo->percentEnduranceUsed);
+    write_Structured_Double(writer, "Device Reported Utilization Rate", driveInfo->deviceReportedUtilizationRate);
+    write_Structured_Unsigned(writer, "SMART Status", driveInfo->smartStatus);
+    write_Structured_Unsigned(writer, "Zoned Device Type", driveInfo->zonedDevice);
+    write_Last_DST_Information(writer, &driveInfo->dstInfo);
+    if (driveInfo->longDSTTimeMinutes > 0)
+    {
+        write_Structured_Unsigned(writer, "Long DST Time (minutes)", driveInfo->longDSTTimeMinutes);
+    }
+    write_Structured_Bool(writer, "Read Look Ahead Supported", driveInfo->readLookAheadSupported);
+    write_Structured_Bool(writer, "Read Look Ahead Enabled", driveInfo->readLookAheadEnabled);
+    write_Structured_Bool(writer, "Write Cache Supported", driveInfo->writeCacheSupported);
+    write_Structured_Bool(writer, "Write Cache Enabled", driveInfo->writeCacheEnabled);
+    write_Structured_Unsigned(writer, "Encryption Support", C_CAST(uint64_t, driveInfo->encryptionSupport));
+    if (driveInfo->lunCount > 0)
+    {
+        write_Structured_Unsigned(writer, "Number Of Logical Units", driveInfo->lunCount);
+    }
+    if (driveInfo->concurrentPositioningRanges > 0)
+    {
+        write_Structured_Unsigned(writer, "Concurrent Positioning Ranges", driveInfo->concurrentPositioningRanges);
+    }
+    begin_Structured_Array(writer, "Specifications Supported");
+    for (uint8_t specIter = 0; specIter < driveInfo->numberOfSpecificationsSupported && specIter < MAX_SPECS; ++specIter)
+    {
+        write_Structured_String(writer, NULL, driveInfo->specificationsSupported[specIter]);
+    }
+    end_Structured_Array(writer);
+    write_Feature_List(writer, "Features Supported", driveInfo->featuresSupported, driveInfo->numberOfFeaturesSupported);
+}
+
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+static void write_NVMe_Device_Information(ptrStructuredWriter writer, ptrDriveInformationNVMe driveInfo)
+{
+    begin_Structured_Object(writer, "Controller");
+    write_Structured_String(writer, "Model Number", driveInfo->controllerData.modelNumber);
+    write_Structured_String(writer, "Serial Number", driveInfo->controllerData.serialNumber);
+    write_Structured_String(writer, "Firmware Revision", driveInfo->controllerData.firmwareRevision);
+    write_Structured_Unsigned(writer, "IEEE OUI", driveInfo->controllerData.ieeeOUI);
+    write_Structured_Unsigned(writer, "PCI Vendor ID", driveInfo->controllerData.pciVendorID);
+    write_Structured_Unsigned(writer, "PCI Subsystem Vendor ID", driveInfo->controllerData.pciSubsystemVendorID);
+    write_Structured_Unsigned(writer, "Controller ID", driveInfo->controllerData.controllerID);
+    write_Structured_Unsigned(writer, "Major Version", driveInfo->controllerData.majorVersion);
+    write_Structured_Unsigned(writer, "Minor Version", driveInfo->controllerData.minorVersion);
+    write_Structured_Unsigned(writer, "Tertiary Version", driveInfo->controllerData.tertiaryVersion);
+    write_Structured_Double(writer, "Total NVM Capacity", driveInfo->controllerData.totalNVMCapacityD);
+    write_Structured_Double(writer, "Unallocated NVM Capacity", driveInfo->controllerData.unallocatedNVMCapacityD);
+    write_Structured_Unsigned(writer, "Maximum Number Of Namespaces", driveInfo->controllerData.maxNumberOfNamespaces);
+    write_Structured_Bool(writer, "Volatile Write Cache Supported", driveInfo->controllerData.volatileWriteCacheSupported);
+    write_Structured_Bool(writer, "Volatile Write Cache Enabled", driveInfo->controllerData.volatileWriteCacheEnabled);
+    write_Structured_Unsigned(writer, "Number Of Firmware Slots", driveInfo->controllerData.numberOfFirmwareSlots);
+    write_Structured_Unsigned(writer, "Number Of Power States", driveInfo->controllerData.numberOfPowerStatesSupported);
+    write_Structured_Unsigned(writer, "Encryption Support", C_CAST(uint64_t, driveInfo->controllerData.encryptionSupport));
+    if (driveInfo->controllerData.longDSTTimeMinutes > 0)
+    {
+        write_Structured_Unsigned(writer, "Long DST Time (minutes)", driveInfo->controllerData.longDSTTimeMinutes);
+    }
+    write_Feature_List(writer, "Features Supported", driveInfo->controllerData.controllerFeaturesSupported, driveInfo->controllerData.numberOfControllerFeatures);
+    end_Structured_Object(writer);
+    if (driveInfo->smartData.valid)
+    {
+        begin_Structured_Object(writer, "Health");
+        write_Structured_Unsigned(writer, "SMART Status", driveInfo->smartData.smartStatus);
+        write_Structured_Bool(writer, "Medium Is Read Only", driveInfo->smartData.mediumIsReadOnly);
+        write_Structured_Signed(writer, "Composite Temperature (C)", C_CAST(int64_t, driveInfo->smartData.compositeTemperatureKelvin) - 273);
+        write_Structured_Unsigned(writer, "Percentage Used", driveInfo->smartData.percentageUsed);
+        write_Structured_Unsigned(writer, "Available Spare (%)", driveInfo->smartData.availableSpacePercent);
+        write_Structured_Unsigned(writer, "Available Spare Threshold (%)", driveInfo->smartData.availableSpaceThresholdPercent);
+        write_Structured_Double(writer, "Data Units Read", driveInfo->smartData.dataUnitsReadD);
+        write_Structured_Double(writer, "Data Units Written", driveInfo->smartData.dataUnitsWrittenD);
+        write_Structured_Double(writer, "Power On Hours", driveInfo->smartData.powerOnHoursD);
+        end_Structured_Object(writer);
+    }
+    write_Last_DST_Information(writer, &driveInfo->dstInfo);
+    if (driveInfo->namespaceData.valid)
+    {
+        begin_Structured_Object(writer, "Namespace");
+        write_Structured_Unsigned(writer, "Size", driveInfo->namespaceData.namespaceSize);
+        write_Structured_Unsigned(writer, "Capacity", driveInfo->namespaceData.namespaceCapacity);
+        write_Structured_Unsigned(writer, "Utilization", driveInfo->namespaceData.namespaceUtilization);
+        write_Structured_Unsigned(writer, "Formatted LBA Size", driveInfo->namespaceData.formattedLBASizeBytes);
+        write_Structured_Unsigned(writer, "Relative Format Performance", driveInfo->namespaceData.relativeFormatPerformance);
+        write_Structured_Double(writer, "NVM Capacity", driveInfo->namespaceData.nvmCapacityD);
+        write_Structured_Unsigned(writer, "IEEE Extended Unique Identifier", driveInfo->namespaceData.ieeeExtendedUniqueIdentifier);
+        write_Feature_List(writer, "Features Supported", driveInfo->namespaceData.namespaceFeaturesSupported, driveInfo->namespaceData.numberOfNamespaceFeatures);
+        end_Structured_Object(writer);
+    }
+}
+#endif
+
+int write_Drive_Information(tDevice *device, ptrStructuredWriter writer)
+{
+    int ret = SUCCESS;
+    ptrDriveInformation ataDriveInfo = NULL, scsiDriveInfo = NULL, usbDriveInfo = NULL, nvmeDriveInfo = NULL, infoToWrite = NULL;
+    if (!writer)
+    {
+        return BAD_PARAMETER;
+    }
+    //Gathered the same way as print_Drive_Information so that both outputs always describe the same device information
+    scsiDriveInfo = C_CAST(ptrDriveInformation, calloc(1, sizeof(driveInformation)));
+    if (device->drive_info.drive_type == ATA_DRIVE)
+    {
+        ataDriveInfo = C_CAST(ptrDriveInformation, calloc(1, sizeof(driveInformation)));
+        if (ataDriveInfo)
+        {
+            ataDriveInfo->infoType = DRIVE_INFO_SAS_SATA;
+            ret = get_ATA_Drive_Information(device, &ataDriveInfo->sasSata);
+        }
+    }
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+    else if (device->drive_info.drive_type == NVME_DRIVE)
+    {
+        nvmeDriveInfo = C_CAST(ptrDriveInformation, calloc(1, sizeof(driveInformation)));
+        if (nvmeDriveInfo)
+        {
+            nvmeDriveInfo->infoType = DRIVE_INFO_NVME;
+            ret = get_NVMe_Drive_Information(device, &nvmeDriveInfo->nvme);
+        }
+    }
+#endif
+    if (scsiDriveInfo)
+    {
+        scsiDriveInfo->infoType = DRIVE_INFO_SAS_SATA;
+        ret = get_SCSI_Drive_Information(device, &scsiDriveInfo->sasSata);
+    }
+    if (ret == SUCCESS)
+    {
+        if ((device->drive_info.interface_type == USB_INTERFACE || device->drive_info.interface_type == IEEE_1394_INTERFACE) && ataDriveInfo && scsiDriveInfo && device->drive_info.drive_type == ATA_DRIVE)
+        {
+            usbDriveInfo = C_CAST(ptrDriveInformation, calloc(1, sizeof(driveInformation)));
+            if (usbDriveInfo)
+            {
+                usbDriveInfo->infoType = DRIVE_INFO_SAS_SATA;
+                generate_External_Drive_Information(&usbDriveInfo->sasSata, &scsiDriveInfo->sasSata, &ataDriveInfo->sasSata);
+                infoToWrite = usbDriveInfo;
+            }
+        }
+        else if (device->drive_info.interface_type == USB_INTERFACE && device->drive_info.drive_type == NVME_DRIVE && nvmeDriveInfo && scsiDriveInfo)
+        {
+            usbDriveInfo = C_CAST(ptrDriveInformation, calloc(1, sizeof(driveInformation)));
+            if (usbDriveInfo)
+            {
+                usbDriveInfo->infoType = DRIVE_INFO_SAS_SATA;
+                generate_External_NVMe_Drive_Information(&usbDriveInfo->sasSata, &scsiDriveInfo->sasSata, &nvmeDriveInfo->nvme);
+                infoToWrite = usbDriveInfo;
+            }
+        }
+        else if (device->drive_info.drive_type == ATA_DRIVE && ataDriveInfo)
+        {
+            infoToWrite = ataDriveInfo;
+        }
+        else if (device->drive_info.drive_type == NVME_DRIVE && nvmeDriveInfo)
+        {
+            infoToWrite = nvmeDriveInfo;
+        }
+        else
+        {
+            infoToWrite = scsiDriveInfo;
+        }
+        if (infoToWrite)
+        {
+            begin_Structured_Object(writer, "Drive Information");
+            write_Structured_String(writer, "Drive Type", print_drive_type(device));
+            if (infoToWrite->infoType == DRIVE_INFO_SAS_SATA)
+            {
+                write_SAS_SATA_Device_Information(writer, &infoToWrite->sasSata);
+            }
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+            else if (infoToWrite->infoType == DRIVE_INFO_NVME)
+            {
+                write_NVMe_Device_Information(writer, &infoToWrite->nvme);
+            }
+#endif
+            end_Structured_Object(writer);
+        }
+        else
+        {
+            ret = MEMORY_FAILURE;
+        }
+    }
+    safe_Free(ataDriveInfo)
+    safe_Free(scsiDriveInfo)
+    safe_Free(usbDriveInfo)
+    safe_Free(nvmeDriveInfo)
+    return ret;
+}
+
 char * print_drive_type(tDevice *device)
 {
     if (device != NULL)
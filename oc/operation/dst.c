@@ -20,6 +20,7 @@
 #include "cmds.h"
 #include <stdlib.h>
 #include "platform_helper.h"
+#include "test_checkpoint.h"
 
 int ata_Abort_DST(tDevice *device)
 {
@@ -391,6 +392,10 @@ int print_DST_Progress(tDevice *device)
 bool is_Self_Test_Supported(tDevice *device)
 {
     bool supported = false;
+    if (device->drive_info.capabilities.selfTestValid)
+    {
+        return device->drive_info.capabilities.selfTestSupported;
+    }
     switch (device->drive_info.drive_type)
     {
     case NVME_DRIVE:
@@ -430,6 +435,8 @@ bool is_Self_Test_Supported(tDevice *device)
     default:
         break;
     }
+    device->drive_info.capabilities.selfTestSupported = supported;
+    device->drive_info.capabilities.selfTestValid = true;
     return supported;
 }
 
@@ -1107,7 +1114,9 @@ bool get_Error_LBA_From_DST_Log(tDevice *device, uint64_t *lba)
     return isValidLBA;
 }
 
-int run_DST_And_Clean(tDevice *device, uint16_t errorLimit, custom_Update updateFunction, void *updateData, ptrDSTAndCleanErrorList externalErrorList, bool *repaired)
+//When checkpointFile is set, the list of repaired LBAs is saved before each DST is started so that resume_DST_And_Clean can continue with the same error count.
+//resumeState is only set when resuming and holds the errors from the checkpoint.
+static int run_DST_And_Clean_Internal(tDevice *device, uint16_t errorLimit, custom_Update updateFunction, void *updateData, ptrDSTAndCleanErrorList externalErrorList, bool *repaired, const char *checkpointFile, ptrTestCheckpoint resumeState)
 {
     int ret = SUCCESS;//assume this works successfully
     errorLBA *errorList = NULL;
@@ -1150,6 +1159,23 @@ int run_DST_And_Clean(tDevice *device, uint16_t errorLimit, custom_Update update
         errorIndex = externalErrorList->errorIndex;
     }
 
+    testCheckpoint checkpoint;
+    time_t runStartTime = time(NULL);
+    init_Test_Checkpoint(device, &checkpoint, CHECKPOINT_TEST_DST_AND_CLEAN, 0, device->drive_info.deviceMaxLba + 1);
+    checkpoint.errorLimit = errorLimit;
+    if (resumeState)
+    {
+        //pick up the errors that were already found and repaired so they still count against the error limit
+        uint64_t resumeIter = 0;
+        checkpoint.elapsedSeconds = resumeState->elapsedSeconds;
+        for (resumeIter = 0; resumeIter < resumeState->errorCount && resumeIter < M_Max(errorLimit, 1); ++resumeIter)
+        {
+            errorList[resumeIter] = resumeState->errorList[resumeIter];
+        }
+        *errorIndex = resumeIter;
+        totalErrors = resumeIter;
+    }
+
     bool autoReadReassign = false;
     bool autoWriteReassign = false;
     if (SUCCESS != get_Automatic_Reallocation_Support(device, &autoWriteReassign, &autoReadReassign))
@@ -1159,6 +1185,18 @@ int run_DST_And_Clean(tDevice *device, uint16_t errorLimit, custom_Update update
     //this is escentially a loop over the sequential read function
     while (totalErrors <= errorLimit)
     {
+        if (checkpointFile)
+        {
+            //each DST can take a while, so save everything repaired so far before starting another one
+            checkpoint.errorCount = M_Min(*errorIndex, C_CAST(uint64_t, M_Max(errorLimit, 1)));
+            checkpoint.errorList = errorList;
+            checkpoint.elapsedSeconds += C_CAST(uint64_t, difftime(time(NULL), runStartTime));
+            runStartTime = time(NULL);
+            if (SUCCESS != save_Test_Checkpoint(checkpointFile, &checkpoint) && device->deviceVerbosity > VERBOSITY_QUIET)
+            {
+                printf("Warning: Unable to save checkpoint to %s\n", checkpointFile);
+            }
+        }
         //start DST
         if (device->deviceVerbosity >= VERBOSITY_DEFAULT)
         {
@@ -1358,6 +1396,11 @@ int run_DST_And_Clean(tDevice *device, uint16_t errorLimit, custom_Update update
     {
         ret = FAILURE;
     }
+    if (checkpointFile)
+    {
+        //DST and clean ran to its end, so there is nothing left to resume
+        remove_Test_Checkpoint(checkpointFile);
+    }
     if (device->deviceVerbosity > VERBOSITY_QUIET && localErrorList)
     {
         if (errorList[0].errorAddress != UINT64_MAX)
@@ -1380,6 +1423,48 @@ int run_DST_And_Clean(tDevice *device, uint16_t errorLimit, custom_Update update
     }
     return ret;
 }
+
+int run_DST_And_Clean(tDevice *device, uint16_t errorLimit, custom_Update updateFunction, void *updateData, ptrDSTAndCleanErrorList externalErrorList, bool *repaired)
+{
+    return run_DST_And_Clean_Internal(device, errorLimit, updateFunction, updateData, externalErrorList, repaired, NULL, NULL);
+}
+
+int run_DST_And_Clean_Checkpoint(tDevice *device, uint16_t errorLimit, custom_Update updateFunction, void *updateData, ptrDSTAndCleanErrorList externalErrorList, bool *repaired, const char *checkpointFile)
+{
+    return run_DST_And_Clean_Internal(device, errorLimit, updateFunction, updateData, externalErrorList, repaired, checkpointFile, NULL);
+}
+
+int resume_DST_And_Clean(tDevice *device, const char *checkpointFile, custom_Update updateFunction, void *updateData, ptrDSTAndCleanErrorList externalErrorList, bool *repaired)
+{
+    int ret = SUCCESS;
+    testCheckpoint state;
+    if (!checkpointFile)
+    {
+        return BAD_PARAMETER;
+    }
+    ret = load_Test_Checkpoint(checkpointFile, &state);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    if (!is_Checkpoint_For_Device(device, &state, CHECKPOINT_TEST_DST_AND_CLEAN))
+    {
+        if (device->deviceVerbosity > VERBOSITY_QUIET)
+        {
+            printf("Checkpoint %s is not for DST and clean on this device.\n", checkpointFile);
+        }
+        free_Test_Checkpoint(&state);
+        return BAD_PARAMETER;
+    }
+    if (device->deviceVerbosity > VERBOSITY_QUIET)
+    {
+        printf("Resuming DST and clean with %" PRIu64 " errors already repaired.\n", state.errorCount);
+    }
+    ret = run_DST_And_Clean_Internal(device, state.errorLimit, updateFunction, updateData, externalErrorList, repaired, checkpointFile, &state);
+    free_Test_Checkpoint(&state);
+    return ret;
+}
+
 #define ENABLE_DST_LOG_DEBUG 0 //set to non zero to enable this debug.
 //TODO: This should grab the entries in order from most recent to oldest...current sort via timestamp won't fix getting the most recent one first.
 int get_ATA_DST_Log_Entries(tDevice *device, ptrDstLogEntries entries)
@@ -1793,6 +1878,192 @@ int get_DST_Log_Entries(tDevice *device, ptrDstLogEntries entries)
     }
 }
 
+static void get_DST_Test_Run_String(dstLogType logType, ptrDescriptor entry, char *string, size_t stringLength)
+{
+    if (logType == DST_LOG_TYPE_ATA)
+    {
+        switch (entry->selfTestRun)
+        {
+        case 0:
+            snprintf(string, stringLength,  "Offline Data Collect");
+            break;
+        case 1://short
+            snprintf(string, stringLength,  "Short (offline)");
+            break;
+        case 2://extended
+            snprintf(string, stringLength,  "Extended (offline)");
+            break;
+        case 3://conveyance
+            snprintf(string, stringLength,  "Conveyance (offline)");
+            break;
+        case 4://selective
+            snprintf(string, stringLength,  "Selective (offline)");
+            break;
+        case 0x81://short
+            snprintf(string, stringLength,  "Short (captive)");
+            break;
+        case 0x82://extended
+            snprintf(string, stringLength,  "Extended (captive)");
+            break;
+        case 0x83://conveyance
+            snprintf(string, stringLength,  "Conveyance (captive)");
+            break;
+        case 0x84://selective
+            snprintf(string, stringLength,  "Selective (captive)");
+            break;
+        default:
+            if ((entry->selfTestRun >= 0x40 && entry->selfTestRun <= 0x7E) || (entry->selfTestRun >= 0x90 /*&& entry->selfTestRun <= 0xFF*/))
+            {
+                snprintf(string, stringLength,  "Vendor Specific - %"PRIX8"h", entry->selfTestRun);
+            }
+            else
+            {
+                snprintf(string, stringLength,  "Unknown - %"PRIX8"h", entry->selfTestRun);
+            }
+            break;
+        }
+    }
+    else if (logType == DST_LOG_TYPE_SCSI)
+    {
+        switch (entry->selfTestRun)
+        {
+        case 0:
+            snprintf(string, stringLength,  "Unknown (Not in spec)");
+            break;
+        case 1://short
+            snprintf(string, stringLength,  "Short (background)");
+            break;
+        case 2://extended
+            snprintf(string, stringLength,  "Extended (background)");
+            break;
+        case 5://short
+            snprintf(string, stringLength,  "Short (foreground)");
+            break;
+        case 6://extended
+            snprintf(string, stringLength,  "Extended (foreground)");
+            break;
+        default:
+            snprintf(string, stringLength,  "Unknown - %"PRIX8"h", entry->selfTestRun);
+            break;
+        }
+    }
+    else if (logType == DST_LOG_TYPE_NVME)
+    {
+        switch (entry->selfTestRun)
+        {
+        case 0:
+            snprintf(string, stringLength,  "Reserved");
+            break;
+        case 1://short
+            snprintf(string, stringLength,  "Short");
+            break;
+        case 2://extended
+            snprintf(string, stringLength,  "Extended");
+            break;
+        case 0x0E://vendor specific
+            snprintf(string, stringLength,  "Vendor Specific");
+            break;
+        default:
+            snprintf(string, stringLength,  "Unknown - %"PRIX8"h", entry->selfTestRun);
+            break;
+        }
+    }
+    else //print the number
+    {
+        snprintf(string, stringLength,  "Unknown - %"PRIX8"h", entry->selfTestRun);
+    }
+}
+
+static void get_DST_Execution_Status_String(dstLogType logType, ptrDescriptor entry, char *string, size_t stringLength)
+{
+    uint8_t percentRemaining = 0;
+    if (logType == DST_LOG_TYPE_ATA)
+    {
+        percentRemaining = M_Nibble0(entry->selfTestExecutionStatus) * 10;
+    }
+    if (logType == DST_LOG_TYPE_NVME)
+    {
+        switch (M_Nibble1(entry->selfTestExecutionStatus))
+        {
+        case 0:
+            snprintf(string, stringLength, "No Error");
+            break;
+        case 1:
+            snprintf(string, stringLength, "Aborted by command");
+            break;
+        case 2:
+            snprintf(string, stringLength, "Aborted by controller reset");
+            break;
+        case 3:
+            snprintf(string, stringLength, "Aborted by namespace removal");
+            break;
+        case 4:
+            snprintf(string, stringLength, "Aborted by NVM format");
+            break;
+        case 5:
+            snprintf(string, stringLength, "Unknown/Fatal Error");
+            break;
+        case 6:
+            snprintf(string, stringLength, "Unknown Segment Failure");
+            break;
+        case 7:
+            snprintf(string, stringLength, "Failed on segment %" PRIu8 "", entry->segmentNumber);
+            break;
+        case 8:
+            snprintf(string, stringLength, "Aborted for Unknown Reason");
+            break;
+        default:
+            snprintf(string, stringLength, "Reserved");
+            break;
+        }
+    }
+    else
+    {
+        switch (M_Nibble1(entry->selfTestExecutionStatus))
+        {
+        case 0:
+            snprintf(string, stringLength, "Success");
+            break;
+        case 1:
+            snprintf(string, stringLength, "Aborted by host");
+            break;
+        case 2:
+            snprintf(string, stringLength, "Interrupted by reset");
+            break;
+        case 3:
+            snprintf(string, stringLength, "Fatal Error - Unknown");
+            break;
+        case 4:
+            snprintf(string, stringLength, "Unknown Failure Type");
+            break;
+        case 5:
+            snprintf(string, stringLength, "Electrical Failure");
+            break;
+        case 6:
+            snprintf(string, stringLength, "Servo/Seek Failure");
+            break;
+        case 7:
+            snprintf(string, stringLength, "Read Failure");
+            break;
+        case 8:
+            snprintf(string, stringLength, "Handling Damage");
+            break;
+        case 0xF:
+            snprintf(string, stringLength, "In progress");
+            break;
+        default:
+            snprintf(string, stringLength, "Reserved");
+            break;
+        }
+    }
+    if (percentRemaining > 0)
+    {
+        char percentRemainingString[8] = { 0 };
+        snprintf(percentRemainingString, 8, " (%" PRIu8 "%%)", percentRemaining);
+        common_String_Concat(string, stringLength, percentRemainingString);
+    }
+}
+
 int print_DST_Log_Entries(ptrDstLogEntries entries)
 {
     if (!entries)
@@ -1844,190 +2115,14 @@ int print_DST_Log_Entries(ptrDstLogEntries entries)
             //Test
 #define SELF_TEST_RUN_STRING_MAX_LENGTH 22
             char selfTestRunString[SELF_TEST_RUN_STRING_MAX_LENGTH] = { 0 };
-            if (entries->logType == DST_LOG_TYPE_ATA)
-            {
-                switch (entries->dstEntry[iter].selfTestRun)
-                {
-                case 0:
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Offline Data Collect");
-                    break;
-                case 1://short
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Short (offline)");
-                    break;
-                case 2://extended
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Extended (offline)");
-                    break;
-                case 3://conveyance
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Conveyance (offline)");
-                    break;
-                case 4://selective
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Selective (offline)");
-                    break;
-                case 0x81://short
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Short (captive)");
-                    break;
-                case 0x82://extended
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Extended (captive)");
-                    break;
-                case 0x83://conveyance
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Conveyance (captive)");
-                    break;
-                case 0x84://selective
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Selective (captive)");
-                    break;
-                default:
-                    if ((entries->dstEntry[iter].selfTestRun >= 0x40 && entries->dstEntry[iter].selfTestRun <= 0x7E) || (entries->dstEntry[iter].selfTestRun >= 0x90 /*&& entries->dstEntry[iter].selfTestRun <= 0xFF*/))
-                    {
-                        snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Vendor Specific - %"PRIX8"h", entries->dstEntry[iter].selfTestRun);
-                    }
-                    else
-                    {
-                        snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Unknown - %"PRIX8"h", entries->dstEntry[iter].selfTestRun);
-                    }
-                    break;
-                }
-            }
-            else if (entries->logType == DST_LOG_TYPE_SCSI)
-            {
-                switch (entries->dstEntry[iter].selfTestRun)
-                {
-                case 0:
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Unknown (Not in spec)");
-                    break;
-                case 1://short
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Short (background)");
-                    break;
-                case 2://extended
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Extended (background)");
-                    break;
-                case 5://short
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Short (foreground)");
-                    break;
-                case 6://extended
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Extended (foreground)");
-                    break;
-                default:
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Unknown - %"PRIX8"h", entries->dstEntry[iter].selfTestRun);
-                    break;
-                }
-            }
-            else if (entries->logType == DST_LOG_TYPE_NVME)
-            {
-                switch (entries->dstEntry[iter].selfTestRun)
-                {
-                case 0:
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Reserved");
-                    break;
-                case 1://short
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Short");
-                    break;
-                case 2://extended
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Extended");
-                    break;
-                case 0x0E://vendor specific
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Vendor Specific");
-                    break;
-                default:
-                    snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Unknown - %"PRIX8"h", entries->dstEntry[iter].selfTestRun);
-                    break;
-                }
-            }
-            else //print the number
-            {
-                snprintf(selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH,  "Unknown - %"PRIX8"h", entries->dstEntry[iter].selfTestRun);
-            }
+            get_DST_Test_Run_String(entries->logType, &entries->dstEntry[iter], selfTestRunString, SELF_TEST_RUN_STRING_MAX_LENGTH);
             printf("%-21s  ", selfTestRunString);
             //Timestamp
             printf("%-9"PRIu32"  ", entries->dstEntry[iter].lifetimeTimestamp);
             //Execution Status
 #define SELF_TEST_EXECUTION_STATUS_MAX_LENGTH 30
             char status[SELF_TEST_EXECUTION_STATUS_MAX_LENGTH] = { 0 };
-            uint8_t percentRemaining = 0;
-            if (entries->logType == DST_LOG_TYPE_ATA)
-            {
-                percentRemaining = M_Nibble0(entries->dstEntry[iter].selfTestExecutionStatus) * 10;
-            }
-            if (entries->logType == DST_LOG_TYPE_NVME)
-            {
-                switch (M_Nibble1(entries->dstEntry[iter].selfTestExecutionStatus))
-                {
-                case 0:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "No Error");
-                    break;
-                case 1:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Aborted by command");
-                    break;
-                case 2:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Aborted by controller reset");
-                    break;
-                case 3:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Aborted by namespace removal");
-                    break;
-                case 4:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Aborted by NVM format");
-                    break;
-                case 5:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Unknown/Fatal Error");
-                    break;
-                case 6:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Unknown Segment Failure");
-                    break;
-                case 7:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Failed on segment %" PRIu8 "", entries->dstEntry[iter].segmentNumber);
-                    break;
-                case 8:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Aborted for Unknown Reason");
-                    break;
-                default:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Reserved");
-                    break;
-                }
-            }
-            else
-            {
-                switch (M_Nibble1(entries->dstEntry[iter].selfTestExecutionStatus))
-                {
-                case 0:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Success");
-                    break;
-                case 1:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Aborted by host");
-                    break;
-                case 2:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Interrupted by reset");
-                    break;
-                case 3:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Fatal Error - Unknown");
-                    break;
-                case 4:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Unknown Failure Type");
-                    break;
-                case 5:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Electrical Failure");
-                    break;
-                case 6:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Servo/Seek Failure");
-                    break;
-                case 7:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Read Failure");
-                    break;
-                case 8:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Handling Damage");
-                    break;
-                case 0xF:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "In progress");
-                    break;
-                default:
-                    snprintf(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, "Reserved");
-                    break;
-                }
-            }
-            if (percentRemaining > 0)
-            {
-                char percentRemainingString[8] = { 0 };
-                snprintf(percentRemainingString, 8, " (%" PRIu8 "%%)", percentRemaining);
-                common_String_Concat(status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH, percentRemainingString);
-            }
+            get_DST_Execution_Status_String(entries->logType, &entries->dstEntry[iter], status, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH);
             printf("%-26s  ", status);
             //Error LBA
 #define SELF_TEST_ERROR_LBA_STRING_MAX_LENGTH 21
@@ -2079,3 +2174,85 @@ int print_DST_Log_Entries(ptrDstLogEntries entries)
     }
     return SUCCESS;
 }
+
+int write_DST_Log_Entries(ptrDstLogEntries entries, ptrStructuredWriter writer)
+{
+    if (!entries || !writer)
+    {
+        return BAD_PARAMETER;
+    }
+    begin_Structured_Object(writer, "DST Log");
+    switch (entries->logType)
+    {
+    case DST_LOG_TYPE_ATA:
+        write_Structured_String(writer, "Log Type", "ATA");
+        break;
+    case DST_LOG_TYPE_SCSI:
+        write_Structured_String(writer, "Log Type", "SCSI");
+        break;
+    case DST_LOG_TYPE_NVME:
+        write_Structured_String(writer, "Log Type", "NVMe");
+        break;
+    case DST_LOG_TYPE_UNKNOWN:
+    default:
+        write_Structured_String(writer, "Log Type", "Unknown");
+        break;
+    }
+    begin_Structured_Array(writer, "Entries");
+    uint32_t entryNumber = 0;//only counts the entries written, so the numbers have no gaps where invalid descriptors were skipped
+    for (uint8_t iter = 0; iter < entries->numberOfEntries && iter < MAX_DST_ENTRIES; ++iter)
+    {
+        ptrDescriptor entry = &entries->dstEntry[iter];
+        char descriptionString[SELF_TEST_EXECUTION_STATUS_MAX_LENGTH] = { 0 };
+        if (!entry->descriptorValid)
+        {
+            continue;
+        }
+        begin_Structured_Object(writer, NULL);
+        ++entryNumber;
+        write_Structured_Unsigned(writer, "Entry", entryNumber);
+        write_Structured_Unsigned(writer, "Test Code", entry->selfTestRun);
+        get_DST_Test_Run_String(entries->logType, entry, descriptionString, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH);
+        write_Structured_String(writer, "Test", descriptionString);
+        write_Structured_Unsigned(writer, "Timestamp", entry->lifetimeTimestamp);
+        write_Structured_Unsigned(writer, "Execution Status Code", entry->selfTestExecutionStatus);
+        memset(descriptionString, 0, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH);
+        get_DST_Execution_Status_String(entries->logType, entry, descriptionString, SELF_TEST_EXECUTION_STATUS_MAX_LENGTH);
+        write_Structured_String(writer, "Execution Status", descriptionString);
+        if (entry->lbaOfFailure == UINT64_MAX)
+        {
+            write_Structured_String(writer, "Error LBA", NULL);
+        }
+        else
+        {
+            write_Structured_Unsigned(writer, "Error LBA", entry->lbaOfFailure);
+        }
+        if (entries->logType == DST_LOG_TYPE_NVME)
+        {
+            write_Structured_Unsigned(writer, "Segment Number", entry->segmentNumber);
+            if (entry->nsidValid)
+            {
+                write_Structured_Unsigned(writer, "Namespace ID", entry->namespaceID);
+            }
+            if (entry->nvmeStatus.statusCodeTypeValid)
+            {
+                write_Structured_Unsigned(writer, "Status Code Type", entry->nvmeStatus.statusCodeType);
+            }
+            if (entry->nvmeStatus.statusCodeValid)
+            {
+                write_Structured_Unsigned(writer, "Status Code", entry->nvmeStatus.statusCode);
+            }
+        }
+        else
+        {
+            write_Structured_Unsigned(writer, "Checkpoint", entry->checkPointByte);
+            write_Structured_Unsigned(writer, "Sense Key", entry->scsiSenseCode.senseKey);
+            write_Structured_Unsigned(writer, "ASC", entry->scsiSenseCode.additionalSenseCode);
+            write_Structured_Unsigned(writer, "ASCQ", entry->scsiSenseCode.additionalSenseCodeQualifier);
+        }
+        end_Structured_Object(writer);
+    }
+    end_Structured_Array(writer);
+    end_Structured_Object(writer);
+    return SUCCESS;
+}
@@ -0,0 +1,258 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file erase_estimate.c
+// \brief This file defines the functions for estimating erase times from a measured transfer rate instead of the times the drive reports
+
+#include <math.h>
+#include "common.h"
+#include "erase_estimate.h"
+#include "ata_Security.h"
+
+#define ERASE_RATE_CACHE_LINE_LENGTH 512
+
+static bool erase_Rate_Cache_Entry_Matches(tDevice *device, eraseRateCacheEntry *entry)
+{
+    return entry->maxLBA == device->drive_info.deviceMaxLba
+        && entry->logicalBlockSize == device->drive_info.deviceBlockSize
+        && strcmp(entry->modelNumber, device->drive_info.product_identification) == 0
+        && strcmp(entry->firmwareRevision, device->drive_info.product_revision) == 0;
+}
+
+int measure_Erase_Rate(tDevice *device, ptrEraseRateCache cache, bool allowWriteSamples, uint64_t secondsPerDiameter, ptrDiameterThroughput throughput, bool hideLBACounter)
+{
+    int ret = SUCCESS;
+    uint32_t entryIter = 0;
+    if (!throughput)
+    {
+        return BAD_PARAMETER;
+    }
+    if (cache)
+    {
+        for (entryIter = 0; entryIter < cache->numberOfEntries && entryIter < ERASE_RATE_CACHE_MAX_ENTRIES; ++entryIter)
+        {
+            //only use read samples when writes are not allowed. A cached write sample is always better.
+            if (erase_Rate_Cache_Entry_Matches(device, &cache->entries[entryIter]) && (allowWriteSamples == false || cache->entries[entryIter].throughput.testMode == RWV_COMMAND_WRITE))
+            {
+                memcpy(throughput, &cache->entries[entryIter].throughput, sizeof(diameterThroughput));
+                return SUCCESS;
+            }
+        }
+    }
+    ret = measure_Diameter_Throughput(device, allowWriteSamples ? RWV_COMMAND_WRITE : RWV_COMMAND_READ, secondsPerDiameter, throughput, hideLBACounter);
+    if (ret == SUCCESS && cache)
+    {
+        eraseRateCacheEntry *entry = NULL;
+        //replace a read sample for the same drive with this one, otherwise add it or replace the oldest entry
+        for (entryIter = 0; entryIter < cache->numberOfEntries && entryIter < ERASE_RATE_CACHE_MAX_ENTRIES; ++entryIter)
+        {
+            if (erase_Rate_Cache_Entry_Matches(device, &cache->entries[entryIter]))
+            {
+                entry = &cache->entries[entryIter];
+                break;
+            }
+        }
+        if (!entry && cache->numberOfEntries < ERASE_RATE_CACHE_MAX_ENTRIES)
+        {
+            entry = &cache->entries[cache->numberOfEntries];
+            ++cache->numberOfEntries;
+        }
+        else if (!entry)
+        {
+            entry = &cache->entries[0];
+            for (entryIter = 1; entryIter < ERASE_RATE_CACHE_MAX_ENTRIES; ++entryIter)
+            {
+                if (cache->entries[entryIter].measuredTime < entry->measuredTime)
+                {
+                    entry = &cache->entries[entryIter];
+                }
+            }
+        }
+        memset(entry, 0, sizeof(eraseRateCacheEntry));
+        snprintf(entry->modelNumber, MODEL_NUM_LEN + 1, "%s", device->drive_info.product_identification);
+        snprintf(entry->firmwareRevision, FW_REV_LEN + 1, "%s", device->drive_info.product_revision);
+        entry->maxLBA = device->drive_info.deviceMaxLba;
+        entry->logicalBlockSize = device->drive_info.deviceBlockSize;
+        entry->measuredTime = C_CAST(uint64_t, time(NULL));
+        memcpy(&entry->throughput, throughput, sizeof(diameterThroughput));
+    }
+    return ret;
+}
+
+//Time to transfer a span where the rate changes in a straight line from startRate to endRate.
+//This is the integral of 1/rate over the span, which is why a plain average of the two rates is not used.
+static double get_Span_Seconds(double megabytes, double startRate, double endRate)
+{
+    if (megabytes <= 0.0)
+    {
+        return 0.0;
+    }
+    if (fabs(startRate - endRate) < 0.001)
+    {
+        return megabytes / startRate;
+    }
+    return megabytes * log(startRate / endRate) / (startRate - endRate);
+}
+
+static uint64_t get_Overwrite_Seconds(tDevice *device, ptrDiameterThroughput throughput)
+{
+    double megabytesPerLBA = C_CAST(double, device->drive_info.deviceBlockSize) / 1000000.0;
+    uint64_t endLBA = device->drive_info.deviceMaxLba + 1;
+    uint64_t middleLBA = M_Max(throughput->middleLBA, throughput->outerLBA);
+    uint64_t innerLBA = M_Min(M_Max(throughput->innerLBA, middleLBA), endLBA);
+    double seconds = 0.0;
+    seconds += get_Span_Seconds(C_CAST(double, throughput->outerLBA) * megabytesPerLBA, throughput->outerMBPerSecond, throughput->outerMBPerSecond);
+    seconds += get_Span_Seconds(C_CAST(double, middleLBA - throughput->outerLBA) * megabytesPerLBA, throughput->outerMBPerSecond, throughput->middleMBPerSecond);
+    seconds += get_Span_Seconds(C_CAST(double, innerLBA - middleLBA) * megabytesPerLBA, throughput->middleMBPerSecond, throughput->innerMBPerSecond);
+    seconds += get_Span_Seconds(C_CAST(double, endLBA - innerLBA) * megabytesPerLBA, throughput->innerMBPerSecond, throughput->innerMBPerSecond);
+    return C_CAST(uint64_t, ceil(seconds));
+}
+
+int get_Measured_Erase_Time_Estimates(tDevice *device, ptrDiameterThroughput throughput, eraseMethod const eraseMethodList[MAX_SUPPORTED_ERASE_METHODS], uint64_t estimateSeconds[MAX_SUPPORTED_ERASE_METHODS])
+{
+    uint8_t counter = 0;
+    uint64_t overwriteSeconds = 0;
+    bool haveSecurityInfo = false;
+    ataSecurityStatus ataSecurityInfo;
+    if (!throughput || !eraseMethodList || !estimateSeconds || throughput->outerMBPerSecond <= 0.0 || throughput->middleMBPerSecond <= 0.0 || throughput->innerMBPerSecond <= 0.0)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&ataSecurityInfo, 0, sizeof(ataSecurityStatus));
+    overwriteSeconds = get_Overwrite_Seconds(device, throughput);
+    for (counter = 0; counter < MAX_SUPPORTED_ERASE_METHODS; ++counter)
+    {
+        estimateSeconds[counter] = ERASE_ESTIMATE_NOT_AVAILABLE;
+        switch (eraseMethodList[counter].eraseIdentifier)
+        {
+        case ERASE_OVERWRITE:
+        case ERASE_WRITE_SAME:
+        case ERASE_SANITIZE_OVERWRITE:
+            //these all write every LBA, so they are limited by the media rate that was measured
+            estimateSeconds[counter] = overwriteSeconds;
+            break;
+        case ERASE_FORMAT_UNIT:
+            //format on a SSD is closer to an unmap than an overwrite
+            if (!is_SSD(device))
+            {
+                estimateSeconds[counter] = overwriteSeconds;
+            }
+            break;
+        case ERASE_ATA_SECURITY_NORMAL:
+        case ERASE_ATA_SECURITY_ENHANCED:
+            if (!haveSecurityInfo)
+            {
+                get_ATA_Security_Info(device, &ataSecurityInfo, sat_ATA_Security_Protocol_Supported(device));
+                haveSecurityInfo = true;
+            }
+            if (eraseMethodList[counter].eraseIdentifier == ERASE_ATA_SECURITY_NORMAL)
+            {
+                //normal erase is always an overwrite, so use the measured time unless the drive says it takes longer
+                estimateSeconds[counter] = overwriteSeconds;
+                if (ataSecurityInfo.securityEraseUnitTimeMinutes != UINT16_MAX && C_CAST(uint64_t, ataSecurityInfo.securityEraseUnitTimeMinutes) * 60 > overwriteSeconds)
+                {
+                    estimateSeconds[counter] = C_CAST(uint64_t, ataSecurityInfo.securityEraseUnitTimeMinutes) * 60;
+                }
+            }
+            else if (ataSecurityInfo.enhancedSecurityEraseUnitTimeMinutes != UINT16_MAX && ataSecurityInfo.enhancedSecurityEraseUnitTimeMinutes > 0)
+            {
+                //enhanced erase may be a crypto erase, so only the drive's time can be used
+                estimateSeconds[counter] = C_CAST(uint64_t, ataSecurityInfo.enhancedSecurityEraseUnitTimeMinutes) * 60;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return SUCCESS;
+}
+
+int save_Erase_Rate_Cache(const char *cacheFile, ptrEraseRateCache cache)
+{
+    int ret = SUCCESS;
+    FILE *file = NULL;
+    uint32_t entryIter = 0;
+    if (!cacheFile || !cache)
+    {
+        return BAD_PARAMETER;
+    }
+    if ((file = fopen(cacheFile, "w")) == NULL)
+    {
+        return FILE_OPEN_ERROR;
+    }
+    fprintf(file, "#model\tfirmware\tmaxLBA\tblockSize\tmeasuredTime\tmode\touterLBA\touterMBps\tmiddleLBA\tmiddleMBps\tinnerLBA\tinnerMBps\n");
+    for (entryIter = 0; entryIter < cache->numberOfEntries && entryIter < ERASE_RATE_CACHE_MAX_ENTRIES; ++entryIter)
+    {
+        eraseRateCacheEntry *entry = &cache->entries[entryIter];
+        fprintf(file, "%s\t%s\t%" PRIu64 "\t%" PRIu32 "\t%" PRIu64 "\t%d\t%" PRIu64 "\t%.3f\t%" PRIu64 "\t%.3f\t%" PRIu64 "\t%.3f\n", entry->modelNumber, entry->firmwareRevision, entry->maxLBA, entry->logicalBlockSize, entry->measuredTime, C_CAST(int, entry->throughput.testMode),
+            entry->throughput.outerLBA, entry->throughput.outerMBPerSecond, entry->throughput.middleLBA, entry->throughput.middleMBPerSecond, entry->throughput.innerLBA, entry->throughput.innerMBPerSecond);
+    }
+    if (ferror(file))
+    {
+        ret = ERROR_WRITING_FILE;
+    }
+    if (fclose(file) != 0)
+    {
+        ret = ERROR_WRITING_FILE;
+    }
+    return ret;
+}
+
+//copies one tab separated field and returns where the next one starts, or NULL if there is no tab after it
+static char* get_Erase_Rate_Cache_Field(char *line, char *field, size_t fieldSize)
+{
+    char *tab = strchr(line, '\t');
+    if (!tab)
+    {
+        return NULL;
+    }
+    snprintf(field, fieldSize, "%.*s", C_CAST(int, tab - line), line);
+    return tab + 1;
+}
+
+int load_Erase_Rate_Cache(const char *cacheFile, ptrEraseRateCache cache)
+{
+    FILE *file = NULL;
+    char line[ERASE_RATE_CACHE_LINE_LENGTH] = { 0 };
+    if (!cacheFile || !cache)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(cache, 0, sizeof(eraseRateCache));
+    if ((file = fopen(cacheFile, "r")) == NULL)
+    {
+        return FILE_OPEN_ERROR;
+    }
+    while (cache->numberOfEntries < ERASE_RATE_CACHE_MAX_ENTRIES && fgets(line, ERASE_RATE_CACHE_LINE_LENGTH, file))
+    {
+        eraseRateCacheEntry *entry = &cache->entries[cache->numberOfEntries];
+        char *next = line;
+        int testMode = 0;
+        if (line[0] == '#')
+        {
+            continue;
+        }
+        memset(entry, 0, sizeof(eraseRateCacheEntry));
+        next = get_Erase_Rate_Cache_Field(next, entry->modelNumber, MODEL_NUM_LEN + 1);
+        if (next)
+        {
+            next = get_Erase_Rate_Cache_Field(next, entry->firmwareRevision, FW_REV_LEN + 1);
+        }
+        if (next && 10 == sscanf(next, "%" SCNu64 "\t%" SCNu32 "\t%" SCNu64 "\t%d\t%" SCNu64 "\t%lf\t%" SCNu64 "\t%lf\t%" SCNu64 "\t%lf", &entry->maxLBA, &entry->logicalBlockSize, &entry->measuredTime, &testMode,
+            &entry->throughput.outerLBA, &entry->throughput.outerMBPerSecond, &entry->throughput.middleLBA, &entry->throughput.middleMBPerSecond, &entry->throughput.innerLBA, &entry->throughput.innerMBPerSecond))
+        {
+            entry->throughput.testMode = C_CAST(eRWVCommandType, testMode);
+            ++cache->numberOfEntries;
+        }
+    }
+    fclose(file);
+    return SUCCESS;
+}
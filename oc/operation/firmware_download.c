@@ -1213,3 +1213,419 @@ void show_Supported_FWDL_Modes(tDevice *device, ptrSupportedDLModes supportedMod
     }
     return;
 }
+
+typedef struct _firmwareFleetJob
+{
+    ptrFirmwareFleetUpdate fleetUpdate;
+    ptrFirmwareFleetDevice fleetDevice;
+    bool activate;//false = download, true = activate
+    bool selected;//true = this device should be processed in the current pass
+    bool started;
+    bool done;//protected by doneMutex
+    seaMutex doneMutex;
+    seaThread thread;
+}firmwareFleetJob, *ptrFirmwareFleetJob;
+
+//Picks the segment size for a device. The largest size the drive accepts means the fewest commands, but it must also fit what the OS/adapter can transfer,
+//must not be larger than the image, and must stay on the drive's required offset boundary.
+static uint16_t get_Fleet_Segment_Size(tDevice *device, ptrSupportedDLModes supportedModes, uint32_t imageLength)
+{
+    uint32_t segmentSize = supportedModes->maxSegmentSize;
+    uint32_t imageBlocks = (imageLength + LEGACY_DRIVE_SEC_SIZE - 1) / LEGACY_DRIVE_SEC_SIZE;
+    uint32_t boundaryBlocks = supportedModes->driveOffsetBoundaryInBytes / LEGACY_DRIVE_SEC_SIZE;
+    if (segmentSize == UINT32_MAX || segmentSize == 0)
+    {
+        //the drive did not report a maximum, so use its recommendation rather than guessing something large
+        segmentSize = supportedModes->recommendedSegmentSize > 0 ? supportedModes->recommendedSegmentSize : 64;
+    }
+#if defined (_WIN32)
+    if (device->os_info.adapterMaxTransferSize >= LEGACY_DRIVE_SEC_SIZE)
+    {
+        segmentSize = M_Min(segmentSize, device->os_info.adapterMaxTransferSize / LEGACY_DRIVE_SEC_SIZE);
+    }
+#if defined (WINVER) && WINVER >= SEA_WIN32_WINNT_WIN10
+    if (device->os_info.fwdlIOsupport.fwdlIOSupported && device->os_info.fwdlIOsupport.maxXferSize >= LEGACY_DRIVE_SEC_SIZE)
+    {
+        segmentSize = M_Min(segmentSize, device->os_info.fwdlIOsupport.maxXferSize / LEGACY_DRIVE_SEC_SIZE);
+    }
+#endif
+#else
+    M_USE_UNUSED(device);
+#endif
+    segmentSize = M_Min(segmentSize, UINT16_MAX);
+    segmentSize = M_Min(segmentSize, imageBlocks);
+    if (boundaryBlocks > 1 && segmentSize > boundaryBlocks)
+    {
+        segmentSize -= segmentSize % boundaryBlocks;
+    }
+    if (segmentSize < supportedModes->minSegmentSize)
+    {
+        segmentSize = supportedModes->minSegmentSize;
+    }
+    if (segmentSize == 0)
+    {
+        segmentSize = 1;
+    }
+    return C_CAST(uint16_t, M_Min(segmentSize, UINT16_MAX));
+}
+
+static void firmware_Fleet_Download(ptrFirmwareFleetJob job)
+{
+    ptrFirmwareFleetDevice fleetDevice = job->fleetDevice;
+    supportedDLModes supportedModes;
+    firmwareUpdateData updateData;
+    seatimer_t downloadTimer;
+    memset(&supportedModes, 0, sizeof(supportedDLModes));
+    memset(&downloadTimer, 0, sizeof(seatimer_t));
+    memset(&updateData, 0, sizeof(firmwareUpdateData));
+    supportedModes.size = sizeof(supportedDLModes);
+    supportedModes.version = SUPPORTED_FWDL_MODES_VERSION;
+    fleetDevice->downloadResult = get_Supported_FWDL_Modes(fleetDevice->device, &supportedModes);
+    if (fleetDevice->downloadResult != SUCCESS)
+    {
+        return;
+    }
+    if (job->fleetUpdate->stagedActivation)
+    {
+        //staged activation only works when the code can be held until the activate command
+        if (!supportedModes.deferred)
+        {
+            fleetDevice->downloadResult = NOT_SUPPORTED;
+            return;
+        }
+        fleetDevice->modeUsed = DL_FW_DEFERRED;
+    }
+    else if (supportedModes.segmented)
+    {
+        fleetDevice->modeUsed = DL_FW_SEGMENTED;
+    }
+    else if (supportedModes.fullBuffer)
+    {
+        fleetDevice->modeUsed = DL_FW_FULL;
+    }
+    else
+    {
+        fleetDevice->downloadResult = NOT_SUPPORTED;
+        return;
+    }
+    fleetDevice->segmentSizeUsed = get_Fleet_Segment_Size(fleetDevice->device, &supportedModes, job->fleetUpdate->firmwareImageLength);
+    updateData.size = sizeof(firmwareUpdateData);
+    updateData.version = FIRMWARE_UPDATE_DATA_VERSION;
+    updateData.dlMode = fleetDevice->modeUsed;
+    updateData.segmentSize = fleetDevice->segmentSizeUsed;
+    //firmware_Download only reads from this memory, so all devices can share the one image
+    updateData.firmwareFileMem = C_CAST(uint8_t*, C_CAST(uintptr_t, job->fleetUpdate->firmwareImage));
+    updateData.firmwareMemoryLength = job->fleetUpdate->firmwareImageLength;
+    updateData.firmwareSlot = fleetDevice->firmwareSlot;
+    //firmware_Download only reports the average segment time, so time the whole download here
+    start_Timer(&downloadTimer);
+    fleetDevice->downloadResult = firmware_Download(fleetDevice->device, &updateData);
+    stop_Timer(&downloadTimer);
+    fleetDevice->downloadTimeNanoSeconds = get_Nano_Seconds(downloadTimer);
+    if (fleetDevice->modeUsed != DL_FW_DEFERRED)
+    {
+        fleetDevice->activateTimeNanoSeconds = updateData.activateFWTime;
+        fleetDevice->activateResult = fleetDevice->downloadResult;
+    }
+}
+
+static void firmware_Fleet_Activate(ptrFirmwareFleetJob job)
+{
+    ptrFirmwareFleetDevice fleetDevice = job->fleetDevice;
+    firmwareUpdateData updateData;
+    memset(&updateData, 0, sizeof(firmwareUpdateData));
+    updateData.size = sizeof(firmwareUpdateData);
+    updateData.version = FIRMWARE_UPDATE_DATA_VERSION;
+    updateData.dlMode = DL_FW_ACTIVATE;
+    updateData.firmwareFileMem = C_CAST(uint8_t*, C_CAST(uintptr_t, job->fleetUpdate->firmwareImage));
+    updateData.firmwareMemoryLength = job->fleetUpdate->firmwareImageLength;
+    updateData.firmwareSlot = fleetDevice->firmwareSlot;
+    fleetDevice->activateResult = firmware_Download(fleetDevice->device, &updateData);
+    fleetDevice->activateTimeNanoSeconds = updateData.activateFWTime;
+}
+
+static void firmware_Fleet_Job_Thread(void *context)
+{
+    ptrFirmwareFleetJob job = C_CAST(ptrFirmwareFleetJob, context);
+    if (job->activate)
+    {
+        firmware_Fleet_Activate(job);
+    }
+    else
+    {
+        firmware_Fleet_Download(job);
+    }
+    lock_Mutex(job->doneMutex);
+    job->done = true;
+    unlock_Mutex(job->doneMutex);
+}
+
+//Runs every selected job, starting new ones as the total and per controller limits allow, and returns once they have all finished.
+static void run_Firmware_Fleet_Jobs(ptrFirmwareFleetUpdate fleetUpdate, ptrFirmwareFleetJob jobs)
+{
+    uint32_t remaining = 0;
+    uint32_t running = 0;
+    uint32_t jobIter = 0;
+    for (jobIter = 0; jobIter < fleetUpdate->numberOfDevices; ++jobIter)
+    {
+        jobs[jobIter].started = false;
+        jobs[jobIter].done = false;
+        if (jobs[jobIter].selected)
+        {
+            ++remaining;
+        }
+    }
+    while (remaining > 0)
+    {
+        bool progress = false;
+        //start any jobs that fit within the limits
+        for (jobIter = 0; jobIter < fleetUpdate->numberOfDevices; ++jobIter)
+        {
+            uint32_t runningOnController = 0;
+            uint32_t checkIter = 0;
+            if (!jobs[jobIter].selected || jobs[jobIter].started)
+            {
+                continue;
+            }
+            if (fleetUpdate->maxDevicesTotal > 0 && running >= fleetUpdate->maxDevicesTotal)
+            {
+                break;
+            }
+            for (checkIter = 0; checkIter < fleetUpdate->numberOfDevices; ++checkIter)
+            {
+                if (jobs[checkIter].selected && jobs[checkIter].started && jobs[checkIter].thread && jobs[checkIter].fleetDevice->controllerID == jobs[jobIter].fleetDevice->controllerID)
+                {
+                    ++runningOnController;
+                }
+            }
+            if (fleetUpdate->maxDevicesPerController > 0 && runningOnController >= fleetUpdate->maxDevicesPerController)
+            {
+                continue;
+            }
+            jobs[jobIter].started = true;
+            progress = true;
+            if (SUCCESS == create_Thread(&jobs[jobIter].thread, firmware_Fleet_Job_Thread, &jobs[jobIter]))
+            {
+                ++running;
+            }
+            else
+            {
+                //no threads available, so do this one now before moving on
+                jobs[jobIter].thread = NULL;
+                firmware_Fleet_Job_Thread(&jobs[jobIter]);
+                --remaining;
+            }
+        }
+        //collect the jobs that have finished so their slots can be reused
+        for (jobIter = 0; jobIter < fleetUpdate->numberOfDevices; ++jobIter)
+        {
+            bool done = false;
+            if (!jobs[jobIter].thread)
+            {
+                continue;
+            }
+            lock_Mutex(jobs[jobIter].doneMutex);
+            done = jobs[jobIter].done;
+            unlock_Mutex(jobs[jobIter].doneMutex);
+            if (done)
+            {
+                join_Thread(&jobs[jobIter].thread);
+                --running;
+                --remaining;
+                progress = true;
+            }
+        }
+        if (!progress && remaining > 0)
+        {
+            delay_Milliseconds(100);
+        }
+    }
+}
+
+static bool is_Firmware_Fleet_Update_Valid(ptrFirmwareFleetUpdate fleetUpdate)
+{
+    uint32_t deviceIter = 0;
+    if (!fleetUpdate || fleetUpdate->version < FIRMWARE_FLEET_UPDATE_VERSION || fleetUpdate->size < sizeof(firmwareFleetUpdate) || !fleetUpdate->devices || fleetUpdate->numberOfDevices == 0 || !fleetUpdate->firmwareImage || fleetUpdate->firmwareImageLength == 0)
+    {
+        return false;
+    }
+    for (deviceIter = 0; deviceIter < fleetUpdate->numberOfDevices; ++deviceIter)
+    {
+        if (!fleetUpdate->devices[deviceIter].device)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static ptrFirmwareFleetJob create_Firmware_Fleet_Jobs(ptrFirmwareFleetUpdate fleetUpdate, bool activate)
+{
+    uint32_t jobIter = 0;
+    ptrFirmwareFleetJob jobs = C_CAST(ptrFirmwareFleetJob, calloc(fleetUpdate->numberOfDevices, sizeof(firmwareFleetJob)));
+    if (!jobs)
+    {
+        return NULL;
+    }
+    for (jobIter = 0; jobIter < fleetUpdate->numberOfDevices; ++jobIter)
+    {
+        jobs[jobIter].fleetUpdate = fleetUpdate;
+        jobs[jobIter].fleetDevice = &fleetUpdate->devices[jobIter];
+        jobs[jobIter].activate = activate;
+        if (SUCCESS != create_Mutex(&jobs[jobIter].doneMutex))
+        {
+            while (jobIter > 0)
+            {
+                --jobIter;
+                destroy_Mutex(&jobs[jobIter].doneMutex);
+            }
+            safe_Free(jobs)
+            return NULL;
+        }
+    }
+    return jobs;
+}
+
+static void free_Firmware_Fleet_Jobs(ptrFirmwareFleetUpdate fleetUpdate, ptrFirmwareFleetJob *jobs)
+{
+    uint32_t jobIter = 0;
+    for (jobIter = 0; jobIter < fleetUpdate->numberOfDevices; ++jobIter)
+    {
+        destroy_Mutex(&(*jobs)[jobIter].doneMutex);
+    }
+    safe_Free(*jobs)
+}
+
+int firmware_Download_To_Devices(ptrFirmwareFleetUpdate fleetUpdate)
+{
+    int ret = SUCCESS;
+    uint32_t deviceIter = 0;
+    uint8_t *paddedImage = NULL;
+    const uint8_t *callerImage = NULL;
+    uint32_t callerImageLength = 0;
+    ptrFirmwareFleetJob jobs = NULL;
+    if (!is_Firmware_Fleet_Update_Valid(fleetUpdate))
+    {
+        return BAD_PARAMETER;
+    }
+    callerImage = fleetUpdate->firmwareImage;
+    callerImageLength = fleetUpdate->firmwareImageLength;
+    if (fleetUpdate->firmwareImageLength % LEGACY_DRIVE_SEC_SIZE)
+    {
+        //ATA rounds the last segment up to a full sector, which would read past the end of a mapped file.
+        //Make one padded copy for all devices to share instead.
+        uint32_t paddedLength = ((fleetUpdate->firmwareImageLength + LEGACY_DRIVE_SEC_SIZE - 1) / LEGACY_DRIVE_SEC_SIZE) * LEGACY_DRIVE_SEC_SIZE;
+        paddedImage = C_CAST(uint8_t*, calloc_aligned(paddedLength, sizeof(uint8_t), 4096));
+        if (!paddedImage)
+        {
+            return MEMORY_FAILURE;
+        }
+        memcpy(paddedImage, fleetUpdate->firmwareImage, fleetUpdate->firmwareImageLength);
+        fleetUpdate->firmwareImage = paddedImage;
+        fleetUpdate->firmwareImageLength = paddedLength;
+    }
+    jobs = create_Firmware_Fleet_Jobs(fleetUpdate, false);
+    if (!jobs)
+    {
+        fleetUpdate->firmwareImage = callerImage;
+        fleetUpdate->firmwareImageLength = callerImageLength;
+        safe_Free_aligned(paddedImage)
+        return MEMORY_FAILURE;
+    }
+    for (deviceIter = 0; deviceIter < fleetUpdate->numberOfDevices; ++deviceIter)
+    {
+        ptrFirmwareFleetDevice fleetDevice = &fleetUpdate->devices[deviceIter];
+        fleetDevice->downloadResult = UNKNOWN;
+        fleetDevice->activateResult = UNKNOWN;
+        fleetDevice->modeUsed = DL_FW_UNKNOWN;
+        fleetDevice->segmentSizeUsed = 0;
+        fleetDevice->downloadTimeNanoSeconds = 0;
+        fleetDevice->activateTimeNanoSeconds = 0;
+        jobs[deviceIter].selected = true;
+    }
+    run_Firmware_Fleet_Jobs(fleetUpdate, jobs);
+    for (deviceIter = 0; deviceIter < fleetUpdate->numberOfDevices; ++deviceIter)
+    {
+        if (fleetUpdate->devices[deviceIter].downloadResult != SUCCESS)
+        {
+            ret = FAILURE;
+        }
+    }
+    free_Firmware_Fleet_Jobs(fleetUpdate, &jobs);
+    fleetUpdate->firmwareImage = callerImage;
+    fleetUpdate->firmwareImageLength = callerImageLength;
+    safe_Free_aligned(paddedImage)
+    return ret;
+}
+
+int activate_Firmware_On_Devices(ptrFirmwareFleetUpdate fleetUpdate)
+{
+    int ret = SUCCESS;
+    uint32_t deviceIter = 0;
+    uint32_t waveSize = 0;
+    bool waveFailed = false;
+    bool firstWave = true;
+    ptrFirmwareFleetJob jobs = NULL;
+    if (!is_Firmware_Fleet_Update_Valid(fleetUpdate))
+    {
+        return BAD_PARAMETER;
+    }
+    jobs = create_Firmware_Fleet_Jobs(fleetUpdate, true);
+    if (!jobs)
+    {
+        return MEMORY_FAILURE;
+    }
+    waveSize = fleetUpdate->activationWaveSize > 0 ? fleetUpdate->activationWaveSize : fleetUpdate->numberOfDevices;
+    deviceIter = 0;
+    while (deviceIter < fleetUpdate->numberOfDevices)
+    {
+        uint32_t inWave = 0;
+        uint32_t jobIter = 0;
+        for (jobIter = 0; jobIter < fleetUpdate->numberOfDevices; ++jobIter)
+        {
+            jobs[jobIter].selected = false;
+        }
+        //build the next wave from devices that downloaded successfully and are waiting on activation
+        for (; deviceIter < fleetUpdate->numberOfDevices && inWave < waveSize; ++deviceIter)
+        {
+            ptrFirmwareFleetDevice fleetDevice = &fleetUpdate->devices[deviceIter];
+            if (fleetDevice->downloadResult != SUCCESS || fleetDevice->modeUsed != DL_FW_DEFERRED)
+            {
+                continue;
+            }
+            if (waveFailed && fleetUpdate->stopActivationOnFailure)
+            {
+                fleetDevice->activateResult = ABORTED;
+                continue;
+            }
+            jobs[deviceIter].selected = true;
+            ++inWave;
+        }
+        if (inWave == 0)
+        {
+            continue;
+        }
+        if (!firstWave && fleetUpdate->activationWaveDelaySeconds > 0)
+        {
+            delay_Seconds(fleetUpdate->activationWaveDelaySeconds);
+        }
+        firstWave = false;
+        run_Firmware_Fleet_Jobs(fleetUpdate, jobs);
+        for (jobIter = 0; jobIter < fleetUpdate->numberOfDevices; ++jobIter)
+        {
+            if (jobs[jobIter].selected && fleetUpdate->devices[jobIter].activateResult != SUCCESS)
+            {
+                waveFailed = true;
+            }
+        }
+    }
+    for (deviceIter = 0; deviceIter < fleetUpdate->numberOfDevices; ++deviceIter)
+    {
+        if (fleetUpdate->devices[deviceIter].activateResult != SUCCESS)
+        {
+            ret = FAILURE;
+        }
+    }
+    free_Firmware_Fleet_Jobs(fleetUpdate, &jobs);
+    return ret;
+}
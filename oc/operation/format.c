@@ -442,6 +442,11 @@ int run_Format_Unit(tDevice *device, runFormatUnitParameters formatParameters, b
         {
             ret = scsi_Format_Unit(device, fmtpInfo, longList, true, formatParameters.completeList, defectListFormat, 0, dataBuf, dataSize, formatParameters.formatType, formatCommandTimeout);
         }
+        if (ret == SUCCESS)
+        {
+            //block size, protection, and provisioning may be different after a format, so read capabilities from the device again next time they are needed
+            invalidate_Capability_Cache(device);
+        }
 
         //poll for progress
         if (pollForProgress && ret == SUCCESS && !formatParameters.disableImmediate)
@@ -1535,6 +1540,10 @@ int set_Sector_Configuration(tDevice *device, uint32_t sectorSize)
             if (SUCCESS == ret)
             {
                 ret = ata_Set_Sector_Configuration_Ext(device, descriptorCheck, descriptorIndex);
+                if (SUCCESS == ret)
+                {
+                    invalidate_Capability_Cache(device);
+                }
             }
         }
         else //Assume SCSI
@@ -1728,6 +1737,10 @@ int run_NVMe_Format(tDevice * device, runNVMFormatParameters nvmParams, bool pol
         formatCmdOptions.nsid = NVME_ALL_NAMESPACES;
     }
     ret = nvme_Format(device, &formatCmdOptions);
+    if (ret == SUCCESS)
+    {
+        invalidate_Capability_Cache(device);
+    }
     if (pollForProgress && ret == SUCCESS)
     {
         uint32_t delayTimeSeconds = 5;
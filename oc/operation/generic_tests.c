@@ -17,6 +17,13 @@
 #include "sector_repair.h"
 #include "cmds.h"
 #include "operations.h"
+#include "test_checkpoint.h"
+#include "ncq_queue.h"
+#include "platform_helper.h"
+
+#if defined (__linux__) && !defined(VMK_CROSS_COMP) && !defined(UEFI_C_SOURCE) && !defined(DISABLE_NVME_PASSTHROUGH)
+    #define QUEUE_DEPTH_SWEEP_NVME_URING //NVMe commands can be kept in flight from one thread through the device's io_uring
+#endif
 
 int read_Write_Seek_Command(tDevice *device, eRWVCommandType rwvCommand, uint64_t lba, uint8_t *ptrData, uint32_t dataSize)
 {
@@ -32,7 +39,44 @@ int read_Write_Seek_Command(tDevice *device, eRWVCommandType rwvCommand, uint64_
     }
 }
 
-int sequential_RWV(tDevice *device, eRWVCommandType rwvCommand, uint64_t startingLBA, uint64_t range, uint64_t sectorCount, uint64_t *failingLBA, M_ATTR_UNUSED custom_Update updateFunction, M_ATTR_UNUSED void *updateData, bool hideLBACounter)
+//Gets the data buffer for sequential_RWV_Buffer. Verify does not transfer data, so dataBuf is left NULL for it.
+static int get_Sequential_RWV_Buffer(tDevice *device, eRWVCommandType rwvCommand, size_t dataBufSize, ptrPinnedIOBuffer pinnedBuf, uint8_t **dataBuf)
+{
+    memset(pinnedBuf, 0, sizeof(pinnedIOBuffer));
+    *dataBuf = NULL;
+    if (rwvCommand != RWV_COMMAND_VERIFY)
+    {
+        //The whole run uses one buffer, so for large transfers it is worth using hugepages that stay locked for every command.
+        //A device with a buffer pool already gets these from get_Device_Buffer.
+        if (!device->bufferPool && dataBufSize >= PINNED_IO_BUFFER_HUGE_PAGE_SIZE && SUCCESS == allocate_Pinned_IO_Buffer(dataBufSize, pinnedBuf))
+        {
+            *dataBuf = pinnedBuf->buffer;
+        }
+        else
+        {
+            *dataBuf = C_CAST(uint8_t*, get_Device_Buffer(device, dataBufSize));
+        }
+        if (!*dataBuf)
+        {
+            return MEMORY_FAILURE;
+        }
+    }
+    return SUCCESS;
+}
+
+static void release_Sequential_RWV_Buffer(tDevice *device, size_t dataBufSize, ptrPinnedIOBuffer pinnedBuf, uint8_t **dataBuf)
+{
+    if (pinnedBuf->buffer)
+    {
+        free_Pinned_IO_Buffer(pinnedBuf);
+        *dataBuf = NULL;
+    }
+    safe_Release_Device_Buffer(device, *dataBuf, dataBufSize)
+}
+
+//Same as sequential_RWV, but uses a buffer from get_Sequential_RWV_Buffer so that callers running many ranges only allocate it once.
+//dataBuf must hold sectorCount sectors.
+static int sequential_RWV_Buffer(tDevice *device, eRWVCommandType rwvCommand, uint64_t startingLBA, uint64_t range, uint64_t sectorCount, uint64_t *failingLBA, bool hideLBACounter, uint8_t *dataBuf)
 {
     int ret = SUCCESS;
     uint64_t lbaIter = startingLBA;
@@ -41,15 +85,6 @@ int sequential_RWV(tDevice *device, eRWVCommandType rwvCommand, uint64_t startin
     {
         maxSequentialLBA = device->drive_info.deviceMaxLba + 1;//the plus 1 here should make sure we don't go beyond the max lba
     }
-    uint8_t *dataBuf = NULL;
-    if (rwvCommand != RWV_COMMAND_VERIFY)
-    {
-        dataBuf = C_CAST(uint8_t*, calloc_aligned(C_CAST(size_t, sectorCount * device->drive_info.deviceBlockSize), sizeof(uint8_t), device->os_info.minimumAlignment));
-        if (!dataBuf)
-        {
-            return MEMORY_FAILURE;
-        }
-    }
     if (maxSequentialLBA < startingLBA)
     {
         return BAD_PARAMETER;
@@ -60,21 +95,8 @@ int sequential_RWV(tDevice *device, eRWVCommandType rwvCommand, uint64_t startin
         //check that current LBA + sector count doesn't go beyond the maxLBA for the loop
         if ((lbaIter + sectorCount) > maxSequentialLBA)
         {
-            uint8_t *temp = NULL;
-            //adjust the sector count to fit
+            //adjust the sector count to fit. The buffer is already big enough for the shorter transfer, so it is reused as is.
             sectorCount = maxSequentialLBA - lbaIter;
-            if (rwvCommand != RWV_COMMAND_VERIFY)
-            {
-                //reallocate the memory to be sized appropriately for this change
-                temp = C_CAST(uint8_t*, realloc_aligned(dataBuf, 0, C_CAST(size_t, sectorCount * device->drive_info.deviceBlockSize), device->os_info.minimumAlignment));
-                if (!temp)
-                {
-                    perror("memory reallocation failure");
-                    return MEMORY_FAILURE;
-                }
-                dataBuf = temp;
-                memset(dataBuf, 0, C_CAST(size_t, sectorCount * device->drive_info.deviceBlockSize * sizeof(uint8_t)));
-            }
         }
         //print out the current LBA we are rwving
         if (VERBOSITY_QUIET < device->deviceVerbosity && !hideLBACounter)
@@ -152,7 +174,22 @@ int sequential_RWV(tDevice *device, eRWVCommandType rwvCommand, uint64_t startin
         }
         fflush(stdout);
     }
-    safe_Free_aligned(dataBuf)
+    return ret;
+}
+
+int sequential_RWV(tDevice *device, eRWVCommandType rwvCommand, uint64_t startingLBA, uint64_t range, uint64_t sectorCount, uint64_t *failingLBA, M_ATTR_UNUSED custom_Update updateFunction, M_ATTR_UNUSED void *updateData, bool hideLBACounter)
+{
+    int ret = SUCCESS;
+    uint8_t *dataBuf = NULL;
+    size_t dataBufSize = C_CAST(size_t, sectorCount * device->drive_info.deviceBlockSize);
+    pinnedIOBuffer pinnedBuf;
+    ret = get_Sequential_RWV_Buffer(device, rwvCommand, dataBufSize, &pinnedBuf, &dataBuf);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    ret = sequential_RWV_Buffer(device, rwvCommand, startingLBA, range, sectorCount, failingLBA, hideLBACounter, dataBuf);
+    release_Sequential_RWV_Buffer(device, dataBufSize, &pinnedBuf, &dataBuf);
     return ret;
 }
 
@@ -878,39 +915,48 @@ int user_Sequential_Verify_Test(tDevice *device, uint64_t startingLBA, uint64_t
     return user_Sequential_Test(device, RWV_COMMAND_VERIFY, startingLBA, range, errorLimit, stopOnError, repairOnTheFly, repairAtEnd, updateFunction, updateData, hideLBACounter);
 }
 
-int user_Sequential_Test(tDevice *device, eRWVCommandType rwvCommand, uint64_t startingLBA, uint64_t range, uint16_t errorLimit, bool stopOnError, bool repairOnTheFly, bool repairAtEnd, M_ATTR_UNUSED custom_Update updateFunction, M_ATTR_UNUSED void *updateData, bool hideLBACounter)
+int user_Sequential_Test(tDevice *device, eRWVCommandType rwvCommand, uint64_t startingLBA, uint64_t range, uint16_t errorLimit, bool stopOnError, bool repairOnTheFly, bool repairAtEnd, custom_Update updateFunction, void *updateData, bool hideLBACounter)
+{
+    return user_Sequential_Test_Checkpoint(device, rwvCommand, startingLBA, range, errorLimit, stopOnError, repairOnTheFly, repairAtEnd, NULL, updateFunction, updateData, hideLBACounter);
+}
+
+//how many full sized commands to issue between checks for whether it is time to save a checkpoint
+#define SEQUENTIAL_TEST_CHECKPOINT_CHUNK_COMMANDS 1024
+
+//Runs a sequential test from the position in the checkpoint state. This is used for both new and resumed tests.
+//When checkpointFile is not NULL, progress is saved to it periodically and it is removed when the test finishes.
+static int run_User_Sequential_Test(tDevice *device, ptrTestCheckpoint state, const char *checkpointFile, M_ATTR_UNUSED custom_Update updateFunction, M_ATTR_UNUSED void *updateData, bool hideLBACounter)
 {
     int ret = SUCCESS;
-    errorLBA *errorList = NULL;
-    uint64_t errorIndex = 0;
+    eRWVCommandType rwvCommand = C_CAST(eRWVCommandType, state->testMode);
+    errorLBA *errorList = state->errorList;
+    uint16_t errorLimit = state->errorLimit;
+    uint64_t errorIndex = errorLimit != 0 ? state->errorCount : 0;
+    bool stopOnError = state->stopOnError;
+    bool repairOnTheFly = state->repairOnTheFly;
+    bool repairAtEnd = state->repairAtEnd;
     bool errorLimitReached = false;
     uint32_t sectorCount = get_Sector_Count_For_Read_Write(device);
-    //only one of these flags should be set. If they are both set, this makes no sense
-    if ((repairAtEnd && repairOnTheFly) || (repairAtEnd && (errorLimit == 0)))
-    {
-        return BAD_PARAMETER;
-    }
-    if (stopOnError)
-    {
-        //disable the repair flags in this case since they don't make sense
-        repairAtEnd = false;
-        repairOnTheFly = false;
-    }
-    if (errorLimit < 1)
-    {
-        //need to be able to store at least 1 error
-        errorList = C_CAST(errorLBA*, calloc(1 * sizeof(errorLBA), sizeof(errorLBA)));
-    }
-    else
+    uint64_t startingLBA = state->currentLBA;
+    uint64_t endingLBA = state->endingLBA;
+    uint64_t chunkRange = endingLBA - startingLBA;
+    time_t runStartTime = time(NULL);
+    time_t lastCheckpointTime = runStartTime;
+    uint64_t previousElapsedSeconds = state->elapsedSeconds;
+    uint8_t *dataBuf = NULL;
+    size_t dataBufSize = C_CAST(size_t, sectorCount) * device->drive_info.deviceBlockSize;
+    pinnedIOBuffer pinnedBuf;
+    if (checkpointFile)
     {
-        errorList = C_CAST(errorLBA*, calloc(errorLimit * sizeof(errorLBA), sizeof(errorLBA)));
+        //break the range into chunks so there is a chance to save progress as the test runs
+        chunkRange = C_CAST(uint64_t, sectorCount) * SEQUENTIAL_TEST_CHECKPOINT_CHUNK_COMMANDS;
     }
-    if (!errorList)
+    //one buffer is used for every chunk and for the ranges restarted after each error
+    ret = get_Sequential_RWV_Buffer(device, rwvCommand, dataBufSize, &pinnedBuf, &dataBuf);
+    if (ret != SUCCESS)
     {
-        perror("calloc failure\n");
-        return MEMORY_FAILURE;
+        return ret;
     }
-    errorList[0].errorAddress = UINT64_MAX;
     bool autoReadReassign = false;
     bool autoWriteReassign = false;
     if (SUCCESS != get_Automatic_Reallocation_Support(device, &autoWriteReassign, &autoReadReassign))
@@ -918,10 +964,10 @@ int user_Sequential_Test(tDevice *device, eRWVCommandType rwvCommand, uint64_t s
         autoWriteReassign = true;//just in case this fails, default to previous behavior
     }
     //this is escentially a loop over the sequential read function
-    uint64_t endingLBA = startingLBA + range;
-    while (!errorLimitReached)
+    while (!errorLimitReached && startingLBA < endingLBA)
     {
-        if (SUCCESS != sequential_RWV(device, rwvCommand, startingLBA, range, sectorCount, &errorList[errorIndex].errorAddress, updateFunction, updateData, hideLBACounter))
+        uint64_t range = M_Min(chunkRange, endingLBA - startingLBA);
+        if (SUCCESS != sequential_RWV_Buffer(device, rwvCommand, startingLBA, range, sectorCount, &errorList[errorIndex].errorAddress, hideLBACounter, dataBuf))
         {
             if (device->deviceVerbosity > VERBOSITY_QUIET)
             {
@@ -931,7 +977,6 @@ int user_Sequential_Test(tDevice *device, eRWVCommandType rwvCommand, uint64_t s
             }
             //set a new start for next time through the loop to 1 lba past the last error LBA
             startingLBA = errorList[errorIndex].errorAddress + 1;
-            range = endingLBA - startingLBA;
             if (stopOnError || ((errorLimit != 0) && (errorIndex >= errorLimit)))
             {
                 errorLimitReached = true;
@@ -946,9 +991,26 @@ int user_Sequential_Test(tDevice *device, eRWVCommandType rwvCommand, uint64_t s
         }
         else
         {
-            break;
+            startingLBA += range;
+        }
+        if (checkpointFile && difftime(time(NULL), lastCheckpointTime) >= TEST_CHECKPOINT_INTERVAL_SECONDS)
+        {
+            state->currentLBA = startingLBA;
+            state->errorCount = errorLimit != 0 ? errorIndex : (errorList[0].errorAddress != UINT64_MAX ? 1 : 0);
+            state->elapsedSeconds = previousElapsedSeconds + C_CAST(uint64_t, difftime(time(NULL), runStartTime));
+            if (SUCCESS != save_Test_Checkpoint(checkpointFile, state) && device->deviceVerbosity > VERBOSITY_QUIET)
+            {
+                printf("\nWarning: Unable to save checkpoint to %s\n", checkpointFile);
+            }
+            lastCheckpointTime = time(NULL);
         }
     }
+    release_Sequential_RWV_Buffer(device, dataBufSize, &pinnedBuf, &dataBuf);
+    if (checkpointFile)
+    {
+        //the test ran to completion (or hit its error limit) so there is nothing left to resume
+        remove_Test_Checkpoint(checkpointFile);
+    }
     if (device->deviceVerbosity > VERBOSITY_QUIET)
     {
         printf("\n");
@@ -1006,10 +1068,84 @@ int user_Sequential_Test(tDevice *device, eRWVCommandType rwvCommand, uint64_t s
             }
         }
     }
-    safe_Free(errorList)
     return ret;
 }
 
+int user_Sequential_Test_Checkpoint(tDevice *device, eRWVCommandType rwvCommand, uint64_t startingLBA, uint64_t range, uint16_t errorLimit, bool stopOnError, bool repairOnTheFly, bool repairAtEnd, const char *checkpointFile, custom_Update updateFunction, void *updateData, bool hideLBACounter)
+{
+    int ret = SUCCESS;
+    testCheckpoint state;
+    uint64_t endingLBA = startingLBA + range;
+    //only one of these flags should be set. If they are both set, this makes no sense
+    if ((repairAtEnd && repairOnTheFly) || (repairAtEnd && (errorLimit == 0)))
+    {
+        return BAD_PARAMETER;
+    }
+    if (stopOnError)
+    {
+        //disable the repair flags in this case since they don't make sense
+        repairAtEnd = false;
+        repairOnTheFly = false;
+    }
+    if (endingLBA >= device->drive_info.deviceMaxLba || endingLBA < startingLBA)
+    {
+        endingLBA = device->drive_info.deviceMaxLba + 1;//the plus 1 here should make sure we don't go beyond the max lba
+    }
+    init_Test_Checkpoint(device, &state, CHECKPOINT_TEST_SEQUENTIAL_RWV, startingLBA, endingLBA);
+    state.testMode = C_CAST(uint32_t, rwvCommand);
+    state.errorLimit = errorLimit;
+    state.stopOnError = stopOnError;
+    state.repairOnTheFly = repairOnTheFly;
+    state.repairAtEnd = repairAtEnd;
+    //one extra entry since the last error before hitting the limit is still written to the list
+    state.errorList = C_CAST(errorLBA*, calloc(C_CAST(size_t, errorLimit) + 1, sizeof(errorLBA)));
+    if (!state.errorList)
+    {
+        perror("calloc failure\n");
+        return MEMORY_FAILURE;
+    }
+    state.errorList[0].errorAddress = UINT64_MAX;
+    ret = run_User_Sequential_Test(device, &state, checkpointFile, updateFunction, updateData, hideLBACounter);
+    free_Test_Checkpoint(&state);
+    return ret;
+}
+
+int resume_User_Sequential_Test(tDevice *device, const char *checkpointFile, custom_Update updateFunction, void *updateData, bool hideLBACounter)
+{
+    int ret = SUCCESS;
+    testCheckpoint state;
+    if (!checkpointFile)
+    {
+        return BAD_PARAMETER;
+    }
+    ret = load_Test_Checkpoint(checkpointFile, &state);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    if (!is_Checkpoint_For_Device(device, &state, CHECKPOINT_TEST_SEQUENTIAL_RWV) || state.testMode >= C_CAST(uint32_t, RWV_COMMAND_INVALID))
+    {
+        if (device->deviceVerbosity > VERBOSITY_QUIET)
+        {
+            printf("Checkpoint %s is not for a sequential test on this device.\n", checkpointFile);
+        }
+        free_Test_Checkpoint(&state);
+        return BAD_PARAMETER;
+    }
+    if (device->deviceVerbosity > VERBOSITY_QUIET)
+    {
+        printf("Resuming sequential test at LBA %" PRIu64 " of %" PRIu64 " with %" PRIu64 " errors found so far.\n", state.currentLBA, state.endingLBA, state.errorCount);
+    }
+    ret = run_User_Sequential_Test(device, &state, checkpointFile, updateFunction, updateData, hideLBACounter);
+    free_Test_Checkpoint(&state);
+    return ret;
+}
+
+int long_Generic_Test_Checkpoint(tDevice *device, eRWVCommandType rwvCommand, uint16_t errorLimit, bool stopOnError, bool repairOnTheFly, bool repairAtEnd, const char *checkpointFile, custom_Update updateFunction, void *updateData, bool hideLBACounter)
+{
+    return user_Sequential_Test_Checkpoint(device, rwvCommand, 0, device->drive_info.deviceMaxLba, errorLimit, stopOnError, repairOnTheFly, repairAtEnd, checkpointFile, updateFunction, updateData, hideLBACounter);
+}
+
 int user_Timed_Test(tDevice *device, eRWVCommandType rwvCommand, uint64_t startingLBA, uint64_t timeInSeconds, uint16_t errorLimit, bool stopOnError, bool repairOnTheFly, bool repairAtEnd, M_ATTR_UNUSED custom_Update updateFunction, M_ATTR_UNUSED void *updateData, bool hideLBACounter)
 {
     int ret = SUCCESS;
@@ -1332,7 +1468,7 @@ int butterfly_Test(tDevice *device, eRWVCommandType rwvcommand, time_t timeLimit
             currentSectorCount = sectorCount;
         }
     }
-    safe_Free(dataBuf)
+    safe_Free_aligned(dataBuf)
     if (VERBOSITY_QUIET < device->deviceVerbosity)
     {
         printf("\n");
@@ -1363,7 +1499,7 @@ int random_Test(tDevice *device, eRWVCommandType rwvcommand, time_t timeLimitSec
     uint8_t *dataBuf = NULL;
     if (rwvcommand != RWV_COMMAND_VERIFY)
     {
-        dataBuf = C_CAST(uint8_t*, malloc(device->drive_info.deviceBlockSize * sectorCount * sizeof(uint8_t)));
+        dataBuf = C_CAST(uint8_t*, calloc_aligned(device->drive_info.deviceBlockSize * sectorCount, sizeof(uint8_t), device->os_info.minimumAlignment));
         if (!dataBuf)
         {
             return MEMORY_FAILURE;
@@ -1405,7 +1541,7 @@ int random_Test(tDevice *device, eRWVCommandType rwvcommand, time_t timeLimitSec
     {
         printf("\n");
     }
-    safe_Free(dataBuf)
+    safe_Free_aligned(dataBuf)
     return ret;
 }
 
@@ -2223,3 +2359,1647 @@ int diameter_Test_Time(tDevice *device, eRWVCommandType testMode, bool outer, bo
     safe_Free(errorList)
     return ret;
 }
+
+static double get_Diameter_MB_Per_Second(tDevice *device, uint64_t lbasAccessed, seatimer_t timer)
+{
+    double seconds = get_Seconds(timer);
+    if (seconds <= 0.0)
+    {
+        return 0.0;
+    }
+    return (C_CAST(double, lbasAccessed) * C_CAST(double, device->drive_info.deviceBlockSize) / 1000000.0) / seconds;
+}
+
+int measure_Diameter_Throughput(tDevice *device, eRWVCommandType testMode, uint64_t timeInSecondsPerDiameter, ptrDiameterThroughput throughput, bool hideLBACounter)
+{
+    int ret = SUCCESS;
+    errorLBA errorList[1];
+    uint16_t errorOffset = 0;
+    uint64_t lbasAccessed = 0;
+    uint64_t odOrMdLBAsAccessed = 0;
+    seatimer_t diameterTimer;
+    if (!throughput || timeInSecondsPerDiameter == 0 || device->drive_info.deviceMaxLba == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(throughput, 0, sizeof(diameterThroughput));
+    memset(errorList, 0, sizeof(errorList));
+    throughput->testMode = testMode;
+    //OD
+    throughput->outerLBA = 0;
+    memset(&diameterTimer, 0, sizeof(seatimer_t));
+    start_Timer(&diameterTimer);
+    ret = diamter_Test_RWV_Time(device, testMode, throughput->outerLBA, timeInSecondsPerDiameter, 1, errorList, &errorOffset, true, false, &lbasAccessed, hideLBACounter);
+    stop_Timer(&diameterTimer);
+    throughput->outerMBPerSecond = get_Diameter_MB_Per_Second(device, lbasAccessed, diameterTimer);
+    odOrMdLBAsAccessed = lbasAccessed;
+    //MD
+    if (ret == SUCCESS)
+    {
+        throughput->middleLBA = device->drive_info.deviceMaxLba / 2;
+        memset(&diameterTimer, 0, sizeof(seatimer_t));
+        start_Timer(&diameterTimer);
+        ret = diamter_Test_RWV_Time(device, testMode, throughput->middleLBA, timeInSecondsPerDiameter, 1, errorList, &errorOffset, true, false, &lbasAccessed, hideLBACounter);
+        stop_Timer(&diameterTimer);
+        throughput->middleMBPerSecond = get_Diameter_MB_Per_Second(device, lbasAccessed, diameterTimer);
+        odOrMdLBAsAccessed = M_Max(odOrMdLBAsAccessed, lbasAccessed);
+    }
+    //ID. Start far enough from the end that the pass runs for the whole time, the same way diameter_Test_Time does.
+    if (ret == SUCCESS)
+    {
+        throughput->innerLBA = odOrMdLBAsAccessed < device->drive_info.deviceMaxLba ? device->drive_info.deviceMaxLba - odOrMdLBAsAccessed : 0;
+        memset(&diameterTimer, 0, sizeof(seatimer_t));
+        start_Timer(&diameterTimer);
+        ret = diamter_Test_RWV_Time(device, testMode, throughput->innerLBA, timeInSecondsPerDiameter, 1, errorList, &errorOffset, true, false, &lbasAccessed, hideLBACounter);
+        stop_Timer(&diameterTimer);
+        throughput->innerMBPerSecond = get_Diameter_MB_Per_Second(device, lbasAccessed, diameterTimer);
+    }
+    if (VERBOSITY_QUIET < device->deviceVerbosity && !hideLBACounter)
+    {
+        printf("\n");
+    }
+    return ret;
+}
+
+//Layout of the signature written to every logical block by the data integrity test.
+//Everything after the header up to the last 4 bytes is filler generated from the header so that the whole block is covered. The last 4 bytes are a CRC32C of everything before it.
+#define DATA_INTEGRITY_SIGNATURE UINT32_C(0x56494453) //"SDIV" in memory on little endian
+#define DATA_INTEGRITY_MAGIC_OFFSET 0
+#define DATA_INTEGRITY_PASS_OFFSET 4
+#define DATA_INTEGRITY_LBA_OFFSET 8
+#define DATA_INTEGRITY_RUN_ID_OFFSET 16
+#define DATA_INTEGRITY_FILLER_OFFSET 24
+#define DATA_INTEGRITY_CRC_LENGTH 4
+
+typedef enum _eDataIntegrityCheck
+{
+    DATA_INTEGRITY_GOOD,
+    DATA_INTEGRITY_CHECKSUM_FAILURE,
+    DATA_INTEGRITY_MISDIRECTED,
+    DATA_INTEGRITY_STALE
+}eDataIntegrityCheck;
+
+static uint64_t data_Integrity_Filler_Seed(uint64_t lba, uint32_t pass, uint64_t runID)
+{
+    //xorshift generators stall at zero, so make sure something non-zero comes out of this
+    uint64_t seed = lba ^ runID ^ (C_CAST(uint64_t, pass) * UINT64_C(0x9E3779B97F4A7C15));
+    return seed ? seed : UINT64_C(0x9E3779B97F4A7C15);
+}
+
+static void stamp_Data_Integrity_Block(uint8_t *block, uint32_t blockSize, uint64_t lba, uint32_t pass, uint64_t runID)
+{
+    uint32_t magic = DATA_INTEGRITY_SIGNATURE;
+    uint32_t crcOffset = blockSize - DATA_INTEGRITY_CRC_LENGTH;
+    uint32_t offset = DATA_INTEGRITY_FILLER_OFFSET;
+    uint64_t filler = data_Integrity_Filler_Seed(lba, pass, runID);
+    uint32_t crc = 0;
+    memcpy(&block[DATA_INTEGRITY_MAGIC_OFFSET], &magic, sizeof(uint32_t));
+    memcpy(&block[DATA_INTEGRITY_PASS_OFFSET], &pass, sizeof(uint32_t));
+    memcpy(&block[DATA_INTEGRITY_LBA_OFFSET], &lba, sizeof(uint64_t));
+    memcpy(&block[DATA_INTEGRITY_RUN_ID_OFFSET], &runID, sizeof(uint64_t));
+    while (offset < crcOffset)
+    {
+        uint32_t copyLength = M_Min(C_CAST(uint32_t, sizeof(uint64_t)), crcOffset - offset);
+        filler ^= filler << 13;
+        filler ^= filler >> 7;
+        filler ^= filler << 17;
+        memcpy(&block[offset], &filler, copyLength);
+        offset += copyLength;
+    }
+    crc = crc32c(0, block, crcOffset);
+    memcpy(&block[crcOffset], &crc, sizeof(uint32_t));
+}
+
+static eDataIntegrityCheck check_Data_Integrity_Block(const uint8_t *block, uint32_t blockSize, uint64_t expectedLBA, uint32_t expectedPass, uint64_t expectedRunID)
+{
+    uint32_t crcOffset = blockSize - DATA_INTEGRITY_CRC_LENGTH;
+    uint32_t magic = 0, pass = 0, crc = 0;
+    uint64_t lba = 0, runID = 0;
+    memcpy(&crc, &block[crcOffset], sizeof(uint32_t));
+    memcpy(&magic, &block[DATA_INTEGRITY_MAGIC_OFFSET], sizeof(uint32_t));
+    //the CRC covers the filler, so a matching CRC on a block with our signature is enough to trust the header fields
+    if (magic != DATA_INTEGRITY_SIGNATURE || crc != crc32c(0, block, crcOffset))
+    {
+        return DATA_INTEGRITY_CHECKSUM_FAILURE;
+    }
+    memcpy(&pass, &block[DATA_INTEGRITY_PASS_OFFSET], sizeof(uint32_t));
+    memcpy(&lba, &block[DATA_INTEGRITY_LBA_OFFSET], sizeof(uint64_t));
+    memcpy(&runID, &block[DATA_INTEGRITY_RUN_ID_OFFSET], sizeof(uint64_t));
+    if (lba != expectedLBA)
+    {
+        return DATA_INTEGRITY_MISDIRECTED;
+    }
+    if (pass != expectedPass || runID != expectedRunID)
+    {
+        return DATA_INTEGRITY_STALE;
+    }
+    return DATA_INTEGRITY_GOOD;
+}
+
+//Calls the update function each time another percent of a pass's write or check phase is done
+static void update_Data_Integrity_Progress(custom_Update updateFunction, void *updateData, const char *phase, uint32_t pass, uint64_t lba, uint64_t startingLBA, uint64_t endLBA, uint8_t *lastPercent)
+{
+    char message[80] = { 0 };
+    uint8_t percent = C_CAST(uint8_t, ((lba - startingLBA) * 100) / (endLBA - startingLBA));
+    if (!updateFunction || percent == *lastPercent)
+    {
+        return;
+    }
+    *lastPercent = percent;
+    snprintf(message, sizeof(message), "Pass %" PRIu32 " %s LBA %" PRIu64 " (%" PRIu8 "%%)", pass, phase, lba, percent);
+    updateFunction(updateData, message);
+}
+
+int data_Integrity_Test(tDevice *device, uint64_t startingLBA, uint64_t range, uint32_t passes, ptrDataIntegrityResults results, custom_Update updateFunction, void *updateData, bool hideLBACounter)
+{
+    int ret = SUCCESS;
+    uint32_t blockSize = device->drive_info.deviceBlockSize;
+    uint32_t sectorCount = get_Sector_Count_For_Read_Write(device);
+    uint64_t endLBA = 0;
+    uint64_t runID = 0;
+    uint8_t *dataBuf = NULL;
+    uint64_t *failedWrites = NULL;//first LBA of each transfer in this pass that failed to write, in increasing order
+    uint64_t failedWritesAllocated = 0;
+    uint32_t passIter = 0;
+    if (!results || passes == 0 || range == 0 || startingLBA > device->drive_info.deviceMaxLba || blockSize <= (DATA_INTEGRITY_FILLER_OFFSET + DATA_INTEGRITY_CRC_LENGTH) || sectorCount == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(results, 0, sizeof(dataIntegrityResults));
+    results->firstFailingLBA = UINT64_MAX;
+    endLBA = startingLBA + range;
+    if (endLBA > (device->drive_info.deviceMaxLba + 1) || endLBA < startingLBA)
+    {
+        endLBA = device->drive_info.deviceMaxLba + 1;
+    }
+    dataBuf = C_CAST(uint8_t*, calloc_aligned(C_CAST(size_t, sectorCount) * blockSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!dataBuf)
+    {
+        perror("failed to allocate memory!\n");
+        return MEMORY_FAILURE;
+    }
+    //A run ID keeps data left behind by an earlier run of this test from passing as the current pass.
+    seed_64(C_CAST(uint64_t, time(NULL)));
+    runID = xorshiftplus64();
+    for (passIter = 1; ret == SUCCESS && passIter <= passes; ++passIter)
+    {
+        uint64_t lbaIter = 0;
+        uint64_t numberOfFailedWrites = 0;
+        uint64_t failedWriteIter = 0;
+        uint8_t lastPercent = UINT8_MAX;
+        //write the whole range first
+        for (lbaIter = startingLBA; lbaIter < endLBA; lbaIter += sectorCount)
+        {
+            uint32_t transferCount = C_CAST(uint32_t, M_Min(C_CAST(uint64_t, sectorCount), endLBA - lbaIter));
+            uint32_t blockIter = 0;
+            if (VERBOSITY_QUIET < device->deviceVerbosity && !hideLBACounter)
+            {
+                printf("\rPass %" PRIu32 " Writing LBA: %-20" PRIu64 "", passIter, lbaIter);
+                fflush(stdout);
+            }
+            update_Data_Integrity_Progress(updateFunction, updateData, "Writing", passIter, lbaIter, startingLBA, endLBA, &lastPercent);
+            for (blockIter = 0; blockIter < transferCount; ++blockIter)
+            {
+                stamp_Data_Integrity_Block(&dataBuf[C_CAST(size_t, blockIter) * blockSize], blockSize, lbaIter + blockIter, passIter, runID);
+            }
+            if (SUCCESS != write_LBA(device, lbaIter, false, dataBuf, transferCount * blockSize))
+            {
+                ++(results->commandFailures);
+                if (results->firstFailingLBA == UINT64_MAX)
+                {
+                    results->firstFailingLBA = lbaIter;
+                }
+                //remember it so the check does not also report these blocks as corrupt. They hold whatever was there before.
+                if (numberOfFailedWrites == failedWritesAllocated)
+                {
+                    uint64_t newAllocation = failedWritesAllocated == 0 ? 64 : failedWritesAllocated * 2;
+                    uint64_t *temp = C_CAST(uint64_t*, realloc(failedWrites, C_CAST(size_t, newAllocation) * sizeof(uint64_t)));
+                    if (!temp)
+                    {
+                        perror("failed to allocate memory!\n");
+                        ret = MEMORY_FAILURE;
+                        break;
+                    }
+                    failedWrites = temp;
+                    failedWritesAllocated = newAllocation;
+                }
+                failedWrites[numberOfFailedWrites] = lbaIter;
+                ++numberOfFailedWrites;
+                continue;
+            }
+            results->blocksWritten += transferCount;
+        }
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        //make sure nothing is still sitting in the drive's cache before reading back
+        flush_Cache(device);
+        //now read it all back and check every block
+        lastPercent = UINT8_MAX;
+        for (lbaIter = startingLBA; lbaIter < endLBA; lbaIter += sectorCount)
+        {
+            uint32_t transferCount = C_CAST(uint32_t, M_Min(C_CAST(uint64_t, sectorCount), endLBA - lbaIter));
+            uint32_t blockIter = 0;
+            if (failedWriteIter < numberOfFailedWrites && failedWrites[failedWriteIter] == lbaIter)
+            {
+                //already counted as a command failure when the write failed
+                ++failedWriteIter;
+                continue;
+            }
+            if (VERBOSITY_QUIET < device->deviceVerbosity && !hideLBACounter)
+            {
+                printf("\rPass %" PRIu32 " Checking LBA: %-20" PRIu64 "", passIter, lbaIter);
+                fflush(stdout);
+            }
+            update_Data_Integrity_Progress(updateFunction, updateData, "Checking", passIter, lbaIter, startingLBA, endLBA, &lastPercent);
+            if (SUCCESS != read_LBA(device, lbaIter, false, dataBuf, transferCount * blockSize))
+            {
+                ++(results->commandFailures);
+                if (results->firstFailingLBA == UINT64_MAX)
+                {
+                    results->firstFailingLBA = lbaIter;
+                }
+                continue;
+            }
+            for (blockIter = 0; blockIter < transferCount; ++blockIter)
+            {
+                eDataIntegrityCheck check = check_Data_Integrity_Block(&dataBuf[C_CAST(size_t, blockIter) * blockSize], blockSize, lbaIter + blockIter, passIter, runID);
+                ++(results->blocksChecked);
+                switch (check)
+                {
+                case DATA_INTEGRITY_GOOD:
+                    continue;
+                case DATA_INTEGRITY_MISDIRECTED:
+                    ++(results->misdirectedBlocks);
+                    break;
+                case DATA_INTEGRITY_STALE:
+                    ++(results->staleBlocks);
+                    break;
+                case DATA_INTEGRITY_CHECKSUM_FAILURE:
+                default:
+                    ++(results->checksumFailures);
+                    break;
+                }
+                if (results->firstFailingLBA == UINT64_MAX)
+                {
+                    results->firstFailingLBA = lbaIter + blockIter;
+                }
+            }
+        }
+        if (VERBOSITY_QUIET < device->deviceVerbosity && !hideLBACounter)
+        {
+            printf("\n");
+        }
+    }
+    if (ret == SUCCESS && results->firstFailingLBA != UINT64_MAX)
+    {
+        ret = FAILURE;
+    }
+    safe_Free(failedWrites)
+    safe_Free_aligned(dataBuf)
+    return ret;
+}
+
+void print_Data_Integrity_Results(ptrDataIntegrityResults results)
+{
+    if (!results)
+    {
+        return;
+    }
+    printf("\n===Data Integrity Test Results===\n");
+    printf("Blocks Written: %" PRIu64 "\n", results->blocksWritten);
+    printf("Blocks Checked: %" PRIu64 "\n", results->blocksChecked);
+    printf("Command Failures: %" PRIu64 "\n", results->commandFailures);
+    printf("Checksum Failures: %" PRIu64 "\n", results->checksumFailures);
+    printf("Misdirected Blocks: %" PRIu64 "\n", results->misdirectedBlocks);
+    printf("Stale (Lost Write) Blocks: %" PRIu64 "\n", results->staleBlocks);
+    if (results->firstFailingLBA != UINT64_MAX)
+    {
+        printf("First Failing LBA: %" PRIu64 "\n", results->firstFailingLBA);
+    }
+    else
+    {
+        printf("No data integrity errors detected.\n");
+    }
+}
+
+typedef struct _actuatorRangeJob
+{
+    tDevice *device;//private copy of the device so that each range keeps its own last command results
+    eRWVCommandType rwvCommand;
+    uint16_t errorLimit;
+    bool stopOnError;
+    actuatorRangeResult *rangeResult;
+}actuatorRangeJob, *ptrActuatorRangeJob;
+
+static void actuator_Range_RWV(void *context)
+{
+    ptrActuatorRangeJob job = C_CAST(ptrActuatorRangeJob, context);
+    actuatorRangeResult *rangeResult = job->rangeResult;
+    uint64_t currentLBA = rangeResult->startingLBA;
+    uint64_t endLBA = rangeResult->startingLBA + rangeResult->numberOfLBAs;
+    uint32_t sectorCount = get_Sector_Count_For_Read_Write(job->device);
+    seatimer_t rangeTimer;
+    memset(&rangeTimer, 0, sizeof(seatimer_t));
+    rangeResult->result = SUCCESS;
+    rangeResult->firstFailingLBA = UINT64_MAX;
+    start_Timer(&rangeTimer);
+    while (currentLBA < endLBA)
+    {
+        uint64_t failingLBA = UINT64_MAX;
+        //LBA counters are hidden since several ranges are printing at once
+        int ret = sequential_RWV(job->device, job->rwvCommand, currentLBA, endLBA - currentLBA, sectorCount, &failingLBA, NULL, NULL, true);
+        if (ret == SUCCESS)
+        {
+            rangeResult->lbasAccessed += endLBA - currentLBA;
+            break;
+        }
+        if (failingLBA == UINT64_MAX || failingLBA < currentLBA)
+        {
+            //not a media error, so nothing more can be done in this range
+            rangeResult->result = ret;
+            break;
+        }
+        rangeResult->lbasAccessed += failingLBA - currentLBA + 1;
+        ++(rangeResult->errorCount);
+        rangeResult->result = FAILURE;
+        if (rangeResult->firstFailingLBA == UINT64_MAX)
+        {
+            rangeResult->firstFailingLBA = failingLBA;
+        }
+        if (job->stopOnError || (job->errorLimit > 0 && rangeResult->errorCount >= job->errorLimit))
+        {
+            break;
+        }
+        currentLBA = failingLBA + 1;
+    }
+    stop_Timer(&rangeTimer);
+    rangeResult->elapsedNanoSeconds = get_Nano_Seconds(rangeTimer);
+    if (rangeResult->elapsedNanoSeconds > 0)
+    {
+        rangeResult->megaBytesPerSecond = (C_CAST(double, rangeResult->lbasAccessed) * job->device->drive_info.deviceBlockSize / 1000000.0) / (C_CAST(double, rangeResult->elapsedNanoSeconds) / 1000000000.0);
+    }
+}
+
+int actuator_Parallel_RWV_Test(tDevice *device, eRWVCommandType rwvCommand, uint16_t errorLimitPerRange, bool stopOnError, ptrActuatorParallelResults results)
+{
+    int ret = SUCCESS;
+    concurrentRanges ranges;
+    actuatorRangeJob jobs[ACTUATOR_PARALLEL_MAX_RANGES];
+    seaThread threads[ACTUATOR_PARALLEL_MAX_RANGES];
+    seatimer_t totalTimer;
+    uint8_t rangeIter = 0;
+    if (!device || !results)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(results, 0, sizeof(actuatorParallelResults));
+    memset(&ranges, 0, sizeof(concurrentRanges));
+    memset(jobs, 0, sizeof(jobs));
+    memset(threads, 0, sizeof(threads));
+    memset(&totalTimer, 0, sizeof(seatimer_t));
+    ranges.size = sizeof(concurrentRanges);
+    ranges.version = CONCURRENT_RANGES_VERSION;
+    if (SUCCESS == get_Concurrent_Positioning_Ranges(device, &ranges) && ranges.numberOfRanges > 1)
+    {
+        results->numberOfRanges = C_CAST(uint8_t, M_Min(ranges.numberOfRanges, ACTUATOR_PARALLEL_MAX_RANGES));
+        for (rangeIter = 0; rangeIter < results->numberOfRanges; ++rangeIter)
+        {
+            results->range[rangeIter].rangeNumber = ranges.range[rangeIter].rangeNumber;
+            results->range[rangeIter].startingLBA = ranges.range[rangeIter].lowestLBA;
+            results->range[rangeIter].numberOfLBAs = ranges.range[rangeIter].numberOfLBAs;
+        }
+    }
+    else
+    {
+        //single actuator, or ranges not reported. Treat the whole drive as one range
+        results->numberOfRanges = 1;
+        results->range[0].rangeNumber = 0;
+        results->range[0].startingLBA = 0;
+        results->range[0].numberOfLBAs = device->drive_info.deviceMaxLba + 1;
+    }
+    for (rangeIter = 0; rangeIter < results->numberOfRanges; ++rangeIter)
+    {
+        //The OS handle is shared, but each range gets its own copy of everything else in the device structure
+        jobs[rangeIter].device = clone_Device_For_Thread(device);
+        if (!jobs[rangeIter].device)
+        {
+            while (rangeIter > 0)
+            {
+                --rangeIter;
+                free_Device_Clone(&jobs[rangeIter].device);
+            }
+            return MEMORY_FAILURE;
+        }
+        jobs[rangeIter].rwvCommand = rwvCommand;
+        jobs[rangeIter].errorLimit = errorLimitPerRange;
+        jobs[rangeIter].stopOnError = stopOnError;
+        jobs[rangeIter].rangeResult = &results->range[rangeIter];
+    }
+    results->rangesRanInParallel = true;
+    start_Timer(&totalTimer);
+    for (rangeIter = 0; rangeIter < results->numberOfRanges; ++rangeIter)
+    {
+        if (results->numberOfRanges == 1 || SUCCESS != create_Thread(&threads[rangeIter], actuator_Range_RWV, &jobs[rangeIter]))
+        {
+            //no threads available (or nothing to overlap), so run this range now
+            threads[rangeIter] = NULL;
+            if (results->numberOfRanges > 1)
+            {
+                results->rangesRanInParallel = false;
+            }
+            actuator_Range_RWV(&jobs[rangeIter]);
+        }
+    }
+    for (rangeIter = 0; rangeIter < results->numberOfRanges; ++rangeIter)
+    {
+        if (threads[rangeIter])
+        {
+            join_Thread(&threads[rangeIter]);
+        }
+        if (results->range[rangeIter].result != SUCCESS)
+        {
+            ret = results->range[rangeIter].result == MEMORY_FAILURE ? MEMORY_FAILURE : FAILURE;
+        }
+        free_Device_Clone(&jobs[rangeIter].device);
+    }
+    stop_Timer(&totalTimer);
+    results->totalElapsedNanoSeconds = get_Nano_Seconds(totalTimer);
+    return ret;
+}
+
+void print_Actuator_Parallel_Results(ptrActuatorParallelResults results)
+{
+    uint8_t rangeIter = 0;
+    uint64_t totalLBAs = 0;
+    double totalMBPerSecond = 0.0;
+    if (!results)
+    {
+        return;
+    }
+    printf("\n===Actuator Parallel Test Results===\n");
+    printf("%-6s %-20s %-20s %-10s %-20s %-10s\n", "Range", "Starting LBA", "LBAs Accessed", "Errors", "First Failing LBA", "MB/s");
+    for (rangeIter = 0; rangeIter < results->numberOfRanges && rangeIter < ACTUATOR_PARALLEL_MAX_RANGES; ++rangeIter)
+    {
+        actuatorRangeResult *range = &results->range[rangeIter];
+        char failingLBAString[21] = { 0 };
+        if (range->firstFailingLBA == UINT64_MAX)
+        {
+            snprintf(failingLBAString, 21, "None");
+        }
+        else
+        {
+            snprintf(failingLBAString, 21, "%" PRIu64, range->firstFailingLBA);
+        }
+        printf("%-6" PRIu8 " %-20" PRIu64 " %-20" PRIu64 " %-10" PRIu16 " %-20s %-10.2f\n", range->rangeNumber, range->startingLBA, range->lbasAccessed, range->errorCount, failingLBAString, range->megaBytesPerSecond);
+        totalLBAs += range->lbasAccessed;
+        totalMBPerSecond += range->megaBytesPerSecond;
+    }
+    printf("Total LBAs Accessed: %" PRIu64 "\n", totalLBAs);
+    printf("Total Time: %.2f seconds\n", C_CAST(double, results->totalElapsedNanoSeconds) / 1000000000.0);
+    if (results->rangesRanInParallel)
+    {
+        printf("Combined Throughput: %.2f MB/s\n", totalMBPerSecond);
+    }
+    else
+    {
+        printf("NOTE: Ranges were tested one at a time.\n");
+    }
+}
+
+//Shared by the transfers sampling one bin. Each worker takes the next chunk of the bin under the mutex, so chunks are issued in order,
+//but a new transfer is already waiting at the drive when the previous one completes.
+typedef struct _transferRatePipeline
+{
+    seaMutex mutex;
+    eRWVCommandType rwvCommand;
+    uint32_t sectorCount;
+    uint64_t nextLBA;
+    uint64_t endLBA;
+    uint64_t lbasAccessed;
+    int result;
+}transferRatePipeline, *ptrTransferRatePipeline;
+
+typedef struct _transferRateWorker
+{
+    tDevice *device;//private copy of the device so that each worker keeps its own last command results
+    uint8_t *dataBuf;
+    ptrTransferRatePipeline pipeline;
+}transferRateWorker, *ptrTransferRateWorker;
+
+static void transfer_Rate_Worker(void *context)
+{
+    ptrTransferRateWorker worker = C_CAST(ptrTransferRateWorker, context);
+    ptrTransferRatePipeline pipeline = worker->pipeline;
+    while (1)
+    {
+        uint64_t lba = 0;
+        uint32_t count = 0;
+        int ret = SUCCESS;
+        lock_Mutex(pipeline->mutex);
+        if (pipeline->result != SUCCESS || pipeline->nextLBA >= pipeline->endLBA)
+        {
+            unlock_Mutex(pipeline->mutex);
+            break;
+        }
+        lba = pipeline->nextLBA;
+        count = C_CAST(uint32_t, M_Min(C_CAST(uint64_t, pipeline->sectorCount), pipeline->endLBA - lba));
+        pipeline->nextLBA += count;
+        unlock_Mutex(pipeline->mutex);
+        ret = read_Write_Seek_Command(worker->device, pipeline->rwvCommand, lba, worker->dataBuf, count * worker->device->drive_info.deviceBlockSize);
+        lock_Mutex(pipeline->mutex);
+        if (ret == SUCCESS)
+        {
+            pipeline->lbasAccessed += count;
+        }
+        else if (pipeline->result == SUCCESS)
+        {
+            pipeline->result = ret;
+        }
+        unlock_Mutex(pipeline->mutex);
+    }
+}
+
+int zoned_Transfer_Rate_Test(tDevice *device, eRWVCommandType rwvCommand, uint32_t numberOfBins, uint64_t megabytesPerBin, double anomalyThresholdPercent, ptrZonedTransferRateProfile profile, bool hideLBACounter)
+{
+    int ret = SUCCESS;
+    transferRatePipeline pipeline;
+    transferRateWorker workers[ZONED_TRANSFER_RATE_PIPELINE_DEPTH];
+    seaThread threads[ZONED_TRANSFER_RATE_PIPELINE_DEPTH];
+    uint32_t sectorCount = get_Sector_Count_For_Read_Write(device);
+    uint64_t totalLBAs = 0;
+    uint64_t lbasPerBin = 0;
+    uint64_t binSpacing = 0;
+    uint32_t binIter = 0;
+    uint8_t workerIter = 0;
+    double totalMBPerSecond = 0.0;
+    uint32_t measuredBins = 0;
+    if (!device || !profile || (rwvCommand != RWV_COMMAND_READ && rwvCommand != RWV_COMMAND_WRITE) || device->drive_info.deviceMaxLba == 0 || anomalyThresholdPercent < 0.0 || anomalyThresholdPercent >= 100.0)
+    {
+        return BAD_PARAMETER;
+    }
+    if (numberOfBins == 0 || numberOfBins > ZONED_TRANSFER_RATE_MAX_BINS)
+    {
+        numberOfBins = ZONED_TRANSFER_RATE_MAX_BINS;
+    }
+    if (megabytesPerBin == 0)
+    {
+        megabytesPerBin = ZONED_TRANSFER_RATE_DEFAULT_MB_PER_BIN;
+    }
+    if (anomalyThresholdPercent == 0.0)
+    {
+        anomalyThresholdPercent = ZONED_TRANSFER_RATE_DEFAULT_ANOMALY_PERCENT;
+    }
+    totalLBAs = device->drive_info.deviceMaxLba + 1;
+    if (numberOfBins > totalLBAs / sectorCount)
+    {
+        numberOfBins = C_CAST(uint32_t, M_Max(totalLBAs / sectorCount, UINT64_C(1)));
+    }
+    binSpacing = totalLBAs / numberOfBins;
+    lbasPerBin = M_Min((megabytesPerBin * 1000000) / device->drive_info.deviceBlockSize, binSpacing);
+    memset(profile, 0, sizeof(zonedTransferRateProfile));
+    memset(&pipeline, 0, sizeof(transferRatePipeline));
+    memset(workers, 0, sizeof(workers));
+    memset(threads, 0, sizeof(threads));
+    profile->rwvCommand = rwvCommand;
+    profile->numberOfBins = numberOfBins;
+    profile->pipelined = true;
+    pipeline.rwvCommand = rwvCommand;
+    pipeline.sectorCount = sectorCount;
+    if (SUCCESS != create_Mutex(&pipeline.mutex))
+    {
+        return MEMORY_FAILURE;
+    }
+    for (workerIter = 0; workerIter < ZONED_TRANSFER_RATE_PIPELINE_DEPTH; ++workerIter)
+    {
+        workers[workerIter].pipeline = &pipeline;
+        //The OS handle is shared, but each worker gets its own copy of everything else in the device structure
+        workers[workerIter].device = clone_Device_For_Thread(device);
+        workers[workerIter].dataBuf = C_CAST(uint8_t*, calloc_aligned(C_CAST(size_t, sectorCount) * device->drive_info.deviceBlockSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+        if (!workers[workerIter].device || !workers[workerIter].dataBuf)
+        {
+            ret = MEMORY_FAILURE;
+            break;
+        }
+    }
+    for (binIter = 0; ret != MEMORY_FAILURE && binIter < numberOfBins; ++binIter)
+    {
+        transferRateBin *bin = &profile->bin[binIter];
+        seatimer_t binTimer;
+        memset(&binTimer, 0, sizeof(seatimer_t));
+        bin->startingLBA = align_LBA(device, binIter * binSpacing);
+        pipeline.nextLBA = bin->startingLBA;
+        pipeline.endLBA = M_Min(bin->startingLBA + lbasPerBin, totalLBAs);
+        pipeline.lbasAccessed = 0;
+        pipeline.result = SUCCESS;
+        if (VERBOSITY_QUIET < device->deviceVerbosity && !hideLBACounter)
+        {
+            printf("\r%s bin %" PRIu32 " of %" PRIu32 " at LBA: %-20" PRIu64 "", rwvCommand == RWV_COMMAND_WRITE ? "Writing" : "Reading", binIter + 1, numberOfBins, bin->startingLBA);
+            fflush(stdout);
+        }
+        start_Timer(&binTimer);
+        for (workerIter = 1; workerIter < ZONED_TRANSFER_RATE_PIPELINE_DEPTH; ++workerIter)
+        {
+            if (SUCCESS != create_Thread(&threads[workerIter], transfer_Rate_Worker, &workers[workerIter]))
+            {
+                //one transfer at a time still gives a useful curve, just a little lower
+                threads[workerIter] = NULL;
+                profile->pipelined = false;
+            }
+        }
+        transfer_Rate_Worker(&workers[0]);
+        for (workerIter = 1; workerIter < ZONED_TRANSFER_RATE_PIPELINE_DEPTH; ++workerIter)
+        {
+            if (threads[workerIter])
+            {
+                join_Thread(&threads[workerIter]);
+            }
+        }
+        stop_Timer(&binTimer);
+        bin->lbasAccessed = pipeline.lbasAccessed;
+        bin->result = pipeline.result;
+        if (bin->result != SUCCESS)
+        {
+            ret = FAILURE;
+        }
+        else if (get_Nano_Seconds(binTimer) > 0)
+        {
+            bin->megaBytesPerSecond = (C_CAST(double, bin->lbasAccessed) * device->drive_info.deviceBlockSize / 1000000.0) / get_Seconds(binTimer);
+            if (measuredBins == 0 || bin->megaBytesPerSecond < profile->minimumMBPerSecond)
+            {
+                profile->minimumMBPerSecond = bin->megaBytesPerSecond;
+            }
+            if (bin->megaBytesPerSecond > profile->maximumMBPerSecond)
+            {
+                profile->maximumMBPerSecond = bin->megaBytesPerSecond;
+            }
+            totalMBPerSecond += bin->megaBytesPerSecond;
+            ++measuredBins;
+        }
+    }
+    if (VERBOSITY_QUIET < device->deviceVerbosity && !hideLBACounter)
+    {
+        printf("\n");
+    }
+    if (measuredBins > 0)
+    {
+        profile->averageMBPerSecond = totalMBPerSecond / measuredBins;
+    }
+    //compare each bin to the average of its neighbours. Failed bins are skipped since their rate is meaningless.
+    for (binIter = 0; ret != MEMORY_FAILURE && binIter < profile->numberOfBins && profile->numberOfBins > 1; ++binIter)
+    {
+        double neighbourMBPerSecond = 0.0;
+        uint8_t neighbours = 0;
+        if (profile->bin[binIter].result != SUCCESS)
+        {
+            continue;
+        }
+        if (binIter > 0 && profile->bin[binIter - 1].result == SUCCESS)
+        {
+            neighbourMBPerSecond += profile->bin[binIter - 1].megaBytesPerSecond;
+            ++neighbours;
+        }
+        if (binIter + 1 < profile->numberOfBins && profile->bin[binIter + 1].result == SUCCESS)
+        {
+            neighbourMBPerSecond += profile->bin[binIter + 1].megaBytesPerSecond;
+            ++neighbours;
+        }
+        if (neighbours > 0 && profile->bin[binIter].megaBytesPerSecond < (neighbourMBPerSecond / neighbours) * (1.0 - anomalyThresholdPercent / 100.0))
+        {
+            profile->bin[binIter].anomaly = true;
+            ++profile->numberOfAnomalies;
+        }
+    }
+    for (workerIter = 0; workerIter < ZONED_TRANSFER_RATE_PIPELINE_DEPTH; ++workerIter)
+    {
+        free_Device_Clone(&workers[workerIter].device);
+        safe_Free_aligned(workers[workerIter].dataBuf)
+    }
+    destroy_Mutex(&pipeline.mutex);
+    return ret;
+}
+
+void print_Zoned_Transfer_Rate_Profile(ptrZonedTransferRateProfile profile)
+{
+    uint32_t binIter = 0;
+    if (!profile)
+    {
+        return;
+    }
+    printf("\n===Zoned Transfer Rate Profile (%s)===\n", profile->rwvCommand == RWV_COMMAND_WRITE ? "Write" : "Read");
+    printf("%-6s %-20s %s\n", "Bin", "Starting LBA", "MB/s");
+    for (binIter = 0; binIter < profile->numberOfBins && binIter < ZONED_TRANSFER_RATE_MAX_BINS; ++binIter)
+    {
+        transferRateBin *bin = &profile->bin[binIter];
+        if (bin->result != SUCCESS)
+        {
+            printf("%-6" PRIu32 " %-20" PRIu64 " Error\n", binIter, bin->startingLBA);
+        }
+        else
+        {
+            printf("%-6" PRIu32 " %-20" PRIu64 " %-10.2f%s\n", binIter, bin->startingLBA, bin->megaBytesPerSecond, bin->anomaly ? " <-- Slow compared to neighbouring bins" : "");
+        }
+    }
+    printf("Minimum: %.2f MB/s  Maximum: %.2f MB/s  Average: %.2f MB/s\n", profile->minimumMBPerSecond, profile->maximumMBPerSecond, profile->averageMBPerSecond);
+    printf("Anomalies: %" PRIu32 "\n", profile->numberOfAnomalies);
+    if (!profile->pipelined)
+    {
+        printf("NOTE: Transfers were sent one at a time.\n");
+    }
+}
+
+typedef struct _seekClassSamples
+{
+    uint64_t *samples;//SEEK_PROFILE_MAX_SAMPLES entries
+    uint32_t numberOfSamples;
+    uint64_t totalNanoSeconds;
+}seekClassSamples;
+
+static int compare_Seek_Latency(const void *first, const void *second)
+{
+    uint64_t firstLatency = *C_CAST(const uint64_t*, first);
+    uint64_t secondLatency = *C_CAST(const uint64_t*, second);
+    if (firstLatency < secondLatency)
+    {
+        return -1;
+    }
+    return firstLatency > secondLatency ? 1 : 0;
+}
+
+static uint8_t get_Seek_Distance_Bucket(uint64_t distance)
+{
+    uint8_t bucket = 0;
+    while (distance > 0)
+    {
+        ++bucket;
+        distance >>= 1;
+    }
+    return bucket;
+}
+
+//Times one single sector command and adds it to the distance buckets. The distance is from the last LBA accessed.
+static int timed_Seek_Command(tDevice *device, eRWVCommandType rwvCommand, uint64_t lba, uint8_t *dataBuf, uint64_t *lastLBA, seekRangeProfile *range, uint64_t *nanoSeconds)
+{
+    int ret = SUCCESS;
+    seatimer_t commandTimer;
+    seekDistanceBucket *bucket = NULL;
+    memset(&commandTimer, 0, sizeof(seatimer_t));
+    start_Timer(&commandTimer);
+    ret = read_Write_Seek_Command(device, rwvCommand, lba, dataBuf, device->drive_info.deviceBlockSize);
+    stop_Timer(&commandTimer);
+    *nanoSeconds = get_Nano_Seconds(commandTimer);
+    bucket = &range->distance[get_Seek_Distance_Bucket(lba > *lastLBA ? lba - *lastLBA : *lastLBA - lba)];
+    *lastLBA = lba;
+    if (ret == SUCCESS)
+    {
+        ++bucket->numberOfCommands;
+        bucket->totalNanoSeconds += *nanoSeconds;
+        bucket->maximumNanoSeconds = M_Max(bucket->maximumNanoSeconds, *nanoSeconds);
+    }
+    return ret;
+}
+
+static void add_Seek_Class_Sample(seekLatencyStatistics *statistics, seekClassSamples *samples, uint64_t nanoSeconds)
+{
+    if (statistics->numberOfCommands == 0 || nanoSeconds < statistics->minimumNanoSeconds)
+    {
+        statistics->minimumNanoSeconds = nanoSeconds;
+    }
+    statistics->maximumNanoSeconds = M_Max(statistics->maximumNanoSeconds, nanoSeconds);
+    ++statistics->numberOfCommands;
+    samples->totalNanoSeconds += nanoSeconds;
+    if (samples->numberOfSamples < SEEK_PROFILE_MAX_SAMPLES)
+    {
+        samples->samples[samples->numberOfSamples] = nanoSeconds;
+        ++samples->numberOfSamples;
+    }
+}
+
+static void finish_Seek_Class_Statistics(seekLatencyStatistics *statistics, seekClassSamples *samples)
+{
+    if (statistics->numberOfCommands == 0 || samples->numberOfSamples == 0)
+    {
+        return;
+    }
+    statistics->averageNanoSeconds = samples->totalNanoSeconds / statistics->numberOfCommands;
+    qsort(samples->samples, samples->numberOfSamples, sizeof(uint64_t), compare_Seek_Latency);
+    statistics->p50NanoSeconds = samples->samples[(samples->numberOfSamples - 1) * 50 / 100];
+    statistics->p90NanoSeconds = samples->samples[(samples->numberOfSamples - 1) * 90 / 100];
+    statistics->p99NanoSeconds = samples->samples[(samples->numberOfSamples - 1) * 99 / 100];
+}
+
+int seek_Latency_Profile_Test(tDevice *device, eRWVCommandType rwvCommand, time_t timeLimitSeconds, ptrSeekLatencyProfile profile, bool hideLBACounter)
+{
+    int ret = SUCCESS;
+    concurrentRanges ranges;
+    seekClassSamples samples[SEEK_CLASS_COUNT];
+    uint8_t *dataBuf = NULL;
+    uint8_t rangeIter = 0;
+    uint8_t classIter = 0;
+    time_t rangeTimeSeconds = 0;
+    if (!device || !profile || timeLimitSeconds <= 0 || device->drive_info.deviceMaxLba == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(profile, 0, sizeof(seekLatencyProfile));
+    memset(&ranges, 0, sizeof(concurrentRanges));
+    memset(samples, 0, sizeof(samples));
+    profile->rwvCommand = rwvCommand;
+    profile->failingLBA = UINT64_MAX;
+    ranges.size = sizeof(concurrentRanges);
+    ranges.version = CONCURRENT_RANGES_VERSION;
+    if (SUCCESS == get_Concurrent_Positioning_Ranges(device, &ranges) && ranges.numberOfRanges > 1)
+    {
+        profile->numberOfRanges = C_CAST(uint8_t, M_Min(ranges.numberOfRanges, ACTUATOR_PARALLEL_MAX_RANGES));
+        for (rangeIter = 0; rangeIter < profile->numberOfRanges; ++rangeIter)
+        {
+            profile->range[rangeIter].rangeNumber = ranges.range[rangeIter].rangeNumber;
+            profile->range[rangeIter].startingLBA = ranges.range[rangeIter].lowestLBA;
+            profile->range[rangeIter].numberOfLBAs = ranges.range[rangeIter].numberOfLBAs;
+        }
+    }
+    else
+    {
+        profile->numberOfRanges = 1;
+        profile->range[0].startingLBA = 0;
+        profile->range[0].numberOfLBAs = device->drive_info.deviceMaxLba + 1;
+    }
+    dataBuf = C_CAST(uint8_t*, calloc_aligned(device->drive_info.deviceBlockSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!dataBuf)
+    {
+        return MEMORY_FAILURE;
+    }
+    for (classIter = 0; classIter < SEEK_CLASS_COUNT; ++classIter)
+    {
+        samples[classIter].samples = C_CAST(uint64_t*, calloc(SEEK_PROFILE_MAX_SAMPLES, sizeof(uint64_t)));
+        if (!samples[classIter].samples)
+        {
+            ret = MEMORY_FAILURE;
+        }
+    }
+    rangeTimeSeconds = M_Max(timeLimitSeconds / profile->numberOfRanges, 1);
+    seed_64(C_CAST(uint64_t, time(NULL)));
+    for (rangeIter = 0; ret == SUCCESS && rangeIter < profile->numberOfRanges; ++rangeIter)
+    {
+        seekRangeProfile *range = &profile->range[rangeIter];
+        uint64_t rangeLastLBA = range->startingLBA + range->numberOfLBAs - 1;
+        uint64_t trackLBAs = M_Min(M_Max(SEEK_PROFILE_TRACK_TO_TRACK_BYTES / device->drive_info.deviceBlockSize, UINT64_C(1)), range->numberOfLBAs / 4);
+        uint64_t thirdStrokeLBAs = range->numberOfLBAs / 3;
+        uint64_t fullStrokeWindow = M_Max(range->numberOfLBAs / 1000, UINT64_C(1));//random offset at each end so the drive cannot return the same LBAs from its cache
+        uint64_t lastLBA = range->startingLBA;
+        time_t startTime = time(NULL);
+        if (range->numberOfLBAs < 8)
+        {
+            continue;
+        }
+        for (classIter = 0; classIter < SEEK_CLASS_COUNT; ++classIter)
+        {
+            samples[classIter].numberOfSamples = 0;
+            samples[classIter].totalNanoSeconds = 0;
+        }
+        while (ret == SUCCESS && difftime(time(NULL), startTime) < rangeTimeSeconds)
+        {
+            for (classIter = 0; ret == SUCCESS && classIter < SEEK_CLASS_COUNT; ++classIter)
+            {
+                uint64_t fromLBA = 0, toLBA = 0, nanoSeconds = 0;
+                switch (classIter)
+                {
+                case SEEK_CLASS_TRACK_TO_TRACK:
+                    fromLBA = random_Range_64(range->startingLBA, rangeLastLBA - trackLBAs);
+                    toLBA = fromLBA + trackLBAs;
+                    break;
+                case SEEK_CLASS_THIRD_STROKE:
+                    fromLBA = random_Range_64(range->startingLBA, rangeLastLBA - thirdStrokeLBAs);
+                    toLBA = fromLBA + thirdStrokeLBAs;
+                    break;
+                case SEEK_CLASS_FULL_STROKE:
+                default:
+                    fromLBA = random_Range_64(range->startingLBA, range->startingLBA + fullStrokeWindow);
+                    toLBA = random_Range_64(rangeLastLBA - fullStrokeWindow, rangeLastLBA);
+                    break;
+                }
+                //seek both inward and outward
+                if (random_Range_64(0, 1) == 1)
+                {
+                    uint64_t swapLBA = fromLBA;
+                    fromLBA = toLBA;
+                    toLBA = swapLBA;
+                }
+                if (VERBOSITY_QUIET < device->deviceVerbosity && !hideLBACounter)
+                {
+                    printf("\rRange %" PRIu8 " LBA: %-20" PRIu64 "", range->rangeNumber, toLBA);
+                    fflush(stdout);
+                }
+                //the first command only positions the heads. The second is the seek being measured.
+                if (SUCCESS != timed_Seek_Command(device, rwvCommand, fromLBA, dataBuf, &lastLBA, range, &nanoSeconds))
+                {
+                    profile->failingLBA = fromLBA;
+                    ret = FAILURE;
+                }
+                else if (SUCCESS != timed_Seek_Command(device, rwvCommand, toLBA, dataBuf, &lastLBA, range, &nanoSeconds))
+                {
+                    profile->failingLBA = toLBA;
+                    ret = FAILURE;
+                }
+                else
+                {
+                    add_Seek_Class_Sample(&range->seekClass[classIter], &samples[classIter], nanoSeconds);
+                }
+            }
+        }
+        for (classIter = 0; classIter < SEEK_CLASS_COUNT; ++classIter)
+        {
+            finish_Seek_Class_Statistics(&range->seekClass[classIter], &samples[classIter]);
+        }
+    }
+    if (VERBOSITY_QUIET < device->deviceVerbosity && !hideLBACounter)
+    {
+        printf("\n");
+    }
+    for (classIter = 0; classIter < SEEK_CLASS_COUNT; ++classIter)
+    {
+        safe_Free(samples[classIter].samples)
+    }
+    safe_Free_aligned(dataBuf)
+    return ret;
+}
+
+static const char* get_Seek_Class_String(uint8_t seekClass)
+{
+    switch (seekClass)
+    {
+    case SEEK_CLASS_TRACK_TO_TRACK:
+        return "Track To Track";
+    case SEEK_CLASS_THIRD_STROKE:
+        return "Third Stroke";
+    case SEEK_CLASS_FULL_STROKE:
+        return "Full Stroke";
+    default:
+        break;
+    }
+    return "Unknown";
+}
+
+void print_Seek_Latency_Profile(ptrSeekLatencyProfile profile)
+{
+    uint8_t rangeIter = 0;
+    uint8_t classIter = 0;
+    if (!profile)
+    {
+        return;
+    }
+    printf("\n===Seek Latency Profile===\n");
+    for (rangeIter = 0; rangeIter < profile->numberOfRanges && rangeIter < ACTUATOR_PARALLEL_MAX_RANGES; ++rangeIter)
+    {
+        seekRangeProfile *range = &profile->range[rangeIter];
+        if (profile->numberOfRanges > 1)
+        {
+            printf("Range %" PRIu8 " (LBA %" PRIu64 " - %" PRIu64 ")\n", range->rangeNumber, range->startingLBA, range->startingLBA + range->numberOfLBAs - 1);
+        }
+        printf("\t%-16s %-10s %-10s %-10s %-10s %-10s %-10s %-10s\n", "Seek (ms)", "Commands", "Min", "Avg", "50%", "90%", "99%", "Max");
+        for (classIter = 0; classIter < SEEK_CLASS_COUNT; ++classIter)
+        {
+            seekLatencyStatistics *statistics = &range->seekClass[classIter];
+            printf("\t%-16s %-10" PRIu64 " %-10.3f %-10.3f %-10.3f %-10.3f %-10.3f %-10.3f\n", get_Seek_Class_String(classIter), statistics->numberOfCommands,
+                C_CAST(double, statistics->minimumNanoSeconds) / 1000000.0, C_CAST(double, statistics->averageNanoSeconds) / 1000000.0, C_CAST(double, statistics->p50NanoSeconds) / 1000000.0,
+                C_CAST(double, statistics->p90NanoSeconds) / 1000000.0, C_CAST(double, statistics->p99NanoSeconds) / 1000000.0, C_CAST(double, statistics->maximumNanoSeconds) / 1000000.0);
+        }
+    }
+    if (profile->failingLBA != UINT64_MAX)
+    {
+        printf("Stopped on an error at LBA %" PRIu64 "\n", profile->failingLBA);
+    }
+}
+
+void write_Seek_Latency_Profile(ptrSeekLatencyProfile profile, ptrStructuredWriter writer)
+{
+    uint8_t rangeIter = 0;
+    uint8_t classIter = 0;
+    uint8_t bucketIter = 0;
+    if (!profile || !writer)
+    {
+        return;
+    }
+    begin_Structured_Object(writer, "Seek Latency Profile");
+    switch (profile->rwvCommand)
+    {
+    case RWV_COMMAND_READ:
+        write_Structured_String(writer, "Command", "Read");
+        break;
+    case RWV_COMMAND_WRITE:
+        write_Structured_String(writer, "Command", "Write");
+        break;
+    default:
+        write_Structured_String(writer, "Command", "Verify");
+        break;
+    }
+    if (profile->failingLBA != UINT64_MAX)
+    {
+        write_Structured_Unsigned(writer, "Failing LBA", profile->failingLBA);
+    }
+    begin_Structured_Array(writer, "Ranges");
+    for (rangeIter = 0; rangeIter < profile->numberOfRanges && rangeIter < ACTUATOR_PARALLEL_MAX_RANGES; ++rangeIter)
+    {
+        seekRangeProfile *range = &profile->range[rangeIter];
+        begin_Structured_Object(writer, NULL);
+        write_Structured_Unsigned(writer, "Range Number", range->rangeNumber);
+        write_Structured_Unsigned(writer, "Starting LBA", range->startingLBA);
+        write_Structured_Unsigned(writer, "Number Of LBAs", range->numberOfLBAs);
+        begin_Structured_Array(writer, "Seek Classes");
+        for (classIter = 0; classIter < SEEK_CLASS_COUNT; ++classIter)
+        {
+            seekLatencyStatistics *statistics = &range->seekClass[classIter];
+            begin_Structured_Object(writer, NULL);
+            write_Structured_String(writer, "Class", get_Seek_Class_String(classIter));
+            write_Structured_Unsigned(writer, "Commands", statistics->numberOfCommands);
+            write_Structured_Unsigned(writer, "Minimum ns", statistics->minimumNanoSeconds);
+            write_Structured_Unsigned(writer, "Average ns", statistics->averageNanoSeconds);
+            write_Structured_Unsigned(writer, "P50 ns", statistics->p50NanoSeconds);
+            write_Structured_Unsigned(writer, "P90 ns", statistics->p90NanoSeconds);
+            write_Structured_Unsigned(writer, "P99 ns", statistics->p99NanoSeconds);
+            write_Structured_Unsigned(writer, "Maximum ns", statistics->maximumNanoSeconds);
+            end_Structured_Object(writer);
+        }
+        end_Structured_Array(writer);
+        //only buckets that had commands are written to keep the output short
+        begin_Structured_Array(writer, "Seek Distances");
+        for (bucketIter = 0; bucketIter < SEEK_PROFILE_DISTANCE_BUCKETS; ++bucketIter)
+        {
+            seekDistanceBucket *bucket = &range->distance[bucketIter];
+            if (bucket->numberOfCommands == 0)
+            {
+                continue;
+            }
+            begin_Structured_Object(writer, NULL);
+            write_Structured_Unsigned(writer, "Minimum Distance", bucketIter == 0 ? 0 : UINT64_C(1) << (bucketIter - 1));
+            write_Structured_Unsigned(writer, "Commands", bucket->numberOfCommands);
+            write_Structured_Unsigned(writer, "Average ns", bucket->totalNanoSeconds / bucket->numberOfCommands);
+            write_Structured_Unsigned(writer, "Maximum ns", bucket->maximumNanoSeconds);
+            end_Structured_Object(writer);
+        }
+        end_Structured_Array(writer);
+        end_Structured_Object(writer);
+    }
+    end_Structured_Array(writer);
+    end_Structured_Object(writer);
+}
+
+typedef struct _queueDepthWorker
+{
+    tDevice *device;//private copy of the device so that each worker keeps its own last command results
+    uint8_t *dataBuf;
+    uint64_t startingLBA;
+    uint64_t numberOfTransfers;//transfer sized slots in the range. Commands are aligned to these.
+    uint32_t sectorsPerTransfer;
+    uint8_t readPercent;
+    uint64_t durationNanoSeconds;
+    uint64_t randomState;//each worker has its own generator since the common one is not thread safe
+    uint64_t *latencies;
+    uint32_t maxLatencies;
+    uint32_t numberOfLatencies;
+    uint64_t commands;
+    uint64_t failures;
+    uint64_t totalNanoSeconds;
+    uint64_t maximumNanoSeconds;
+}queueDepthWorker, *ptrQueueDepthWorker;
+
+static uint64_t next_Queue_Depth_Random(uint64_t *state)
+{
+    //xorshift64
+    uint64_t value = *state;
+    value ^= value << 13;
+    value ^= value >> 7;
+    value ^= value << 17;
+    *state = value;
+    return value;
+}
+
+static void record_Queue_Depth_Command(ptrQueueDepthWorker worker, uint64_t nanoSeconds, bool failed)
+{
+    if (failed)
+    {
+        ++worker->failures;
+    }
+    ++worker->commands;
+    worker->totalNanoSeconds += nanoSeconds;
+    worker->maximumNanoSeconds = M_Max(worker->maximumNanoSeconds, nanoSeconds);
+    if (worker->numberOfLatencies < worker->maxLatencies)
+    {
+        worker->latencies[worker->numberOfLatencies] = nanoSeconds;
+        ++worker->numberOfLatencies;
+    }
+}
+
+static void queue_Depth_Worker(void *context)
+{
+    ptrQueueDepthWorker worker = C_CAST(ptrQueueDepthWorker, context);
+    uint32_t transferBytes = worker->sectorsPerTransfer * worker->device->drive_info.deviceBlockSize;
+    seatimer_t runTimer;
+    memset(&runTimer, 0, sizeof(seatimer_t));
+    start_Timer(&runTimer);
+    do
+    {
+        seatimer_t commandTimer;
+        uint64_t randomValue = next_Queue_Depth_Random(&worker->randomState);
+        uint64_t lba = worker->startingLBA + (randomValue % worker->numberOfTransfers) * worker->sectorsPerTransfer;
+        eRWVCommandType rwvCommand = (next_Queue_Depth_Random(&worker->randomState) % 100) < worker->readPercent ? RWV_COMMAND_READ : RWV_COMMAND_WRITE;
+        bool failed = false;
+        memset(&commandTimer, 0, sizeof(seatimer_t));
+        start_Timer(&commandTimer);
+        failed = SUCCESS != read_Write_Seek_Command(worker->device, rwvCommand, lba, worker->dataBuf, transferBytes);
+        stop_Timer(&commandTimer);
+        record_Queue_Depth_Command(worker, get_Nano_Seconds(commandTimer), failed);
+        //stop_Timer only saves the current time, so it is used here to check how long this worker has been running
+        stop_Timer(&runTimer);
+    } while (get_Nano_Seconds(runTimer) < worker->durationNanoSeconds);
+}
+
+//One for each command a SATA drive can have queued. The buffer belongs to the command using the slot until its completion is reported.
+typedef struct _queueDepthNCQSlot
+{
+    ptrQueueDepthWorker stats;
+    uint8_t *dataBuf;
+    seatimer_t commandTimer;
+    bool inUse;
+}queueDepthNCQSlot;
+
+static void queue_Depth_NCQ_Completion(void *callbackData, M_ATTR_UNUSED bool writeCommand, M_ATTR_UNUSED uint64_t lba, M_ATTR_UNUSED uint16_t sectorCount, M_ATTR_UNUSED uint8_t *ptrData, int result)
+{
+    queueDepthNCQSlot *slot = C_CAST(queueDepthNCQSlot*, callbackData);
+    stop_Timer(&slot->commandTimer);
+    record_Queue_Depth_Command(slot->stats, get_Nano_Seconds(slot->commandTimer), result != SUCCESS);
+    slot->inUse = false;
+}
+
+//Read/write DMA (and PIO) are not queued commands, so a SATA drive only ever has one of them at a time no matter how many threads send them.
+//This keeps up to depth FPDMA queued commands outstanding instead. Every count and latency goes into stats since completions are all reported on
+//this thread. Latency is measured to when the completion is picked up here, which can be a little after the drive finished the command.
+//Returns the queue depth that was used, which is lower than asked for when the drive supports fewer tags, or 0 if the queue could not be opened.
+static uint16_t run_Queue_Depth_NCQ_Point(tDevice *device, uint16_t depth, ptrQueueDepthWorker stats, queueDepthNCQSlot *slots)
+{
+    ncqQueue queue;
+    seatimer_t runTimer;
+    uint16_t slotIter = 0;
+    uint16_t queueDepth = 0;
+    memset(&runTimer, 0, sizeof(seatimer_t));
+    if (SUCCESS != open_NCQ_Queue(device, C_CAST(uint8_t, M_Min(depth, NCQ_MAX_QUEUE_DEPTH)), &queue))
+    {
+        return 0;
+    }
+    queueDepth = queue.queueDepth;
+    for (slotIter = 0; slotIter < queueDepth; ++slotIter)
+    {
+        slots[slotIter].stats = stats;
+        slots[slotIter].inUse = false;
+    }
+    start_Timer(&runTimer);
+    do
+    {
+        queueDepthNCQSlot *slot = NULL;
+        uint64_t lba = 0;
+        bool writeCommand = false;
+        for (slotIter = 0; slotIter < queueDepth; ++slotIter)
+        {
+            if (!slots[slotIter].inUse)
+            {
+                slot = &slots[slotIter];
+                break;
+            }
+        }
+        if (!slot)
+        {
+            //every tag is outstanding. This reports at least one completion, which frees its slot.
+            complete_NCQ_Commands(&queue, false);
+        }
+        else
+        {
+            lba = stats->startingLBA + (next_Queue_Depth_Random(&stats->randomState) % stats->numberOfTransfers) * stats->sectorsPerTransfer;
+            writeCommand = (next_Queue_Depth_Random(&stats->randomState) % 100) >= stats->readPercent;
+            slot->inUse = true;
+            memset(&slot->commandTimer, 0, sizeof(seatimer_t));
+            start_Timer(&slot->commandTimer);
+            if (SUCCESS != submit_NCQ_Command(&queue, writeCommand, false, lba, slot->dataBuf, C_CAST(uint16_t, stats->sectorsPerTransfer), 0, queue_Depth_NCQ_Completion, slot))
+            {
+                slot->inUse = false;
+                record_Queue_Depth_Command(stats, 0, true);
+            }
+        }
+        stop_Timer(&runTimer);
+    } while (get_Nano_Seconds(runTimer) < stats->durationNanoSeconds);
+    //waits for everything still outstanding and reports it
+    close_NCQ_Queue(&queue);
+    return queueDepth;
+}
+
+#if defined (QUEUE_DEPTH_SWEEP_NVME_URING)
+//One for each NVMe command kept in flight through io_uring. The command is first so that a reaped command is also its slot.
+typedef struct _queueDepthUringSlot
+{
+    nvmeCmdCtx command;
+    uint8_t *dataBuf;//part of one buffer registered with the ring for every slot
+    seatimer_t commandTimer;
+}queueDepthUringSlot;
+
+//Same as run_Queue_Depth_NCQ_Point, but for NVMe: up to depth reads and writes are kept in flight from this thread through the device's io_uring
+//instead of a thread for each one. Returns the queue depth that was used, or 0 if nothing could be sent.
+static uint16_t run_Queue_Depth_Uring_Point(tDevice *device, uint16_t depth, ptrQueueDepthWorker stats, queueDepthUringSlot *slots)
+{
+    nvmeCmdCtx *completed[QUEUE_DEPTH_SWEEP_MAX_DEPTH];
+    int completedResults[QUEUE_DEPTH_SWEEP_MAX_DEPTH];
+    uint16_t freeSlots[QUEUE_DEPTH_SWEEP_MAX_DEPTH];
+    uint16_t numberOfFreeSlots = 0;
+    uint32_t numberCompleted = 0;
+    uint32_t completedIter = 0;
+    uint32_t transferBytes = stats->sectorsPerTransfer * device->drive_info.deviceBlockSize;
+    bool timeLeft = true;
+    seatimer_t runTimer;
+    memset(&runTimer, 0, sizeof(seatimer_t));
+    depth = M_Min(depth, M_Min(QUEUE_DEPTH_SWEEP_MAX_DEPTH, NVME_URING_MAX_QUEUED));
+    for (numberOfFreeSlots = 0; numberOfFreeSlots < depth; ++numberOfFreeSlots)
+    {
+        freeSlots[numberOfFreeSlots] = numberOfFreeSlots;
+    }
+    start_Timer(&runTimer);
+    while (timeLeft || numberOfFreeSlots < depth)
+    {
+        while (timeLeft && numberOfFreeSlots > 0)
+        {
+            queueDepthUringSlot *slot = &slots[freeSlots[numberOfFreeSlots - 1]];
+            uint64_t lba = stats->startingLBA + (next_Queue_Depth_Random(&stats->randomState) % stats->numberOfTransfers) * stats->sectorsPerTransfer;
+            bool writeCommand = (next_Queue_Depth_Random(&stats->randomState) % 100) >= stats->readPercent;
+            int submitRet = SUCCESS;
+            memset(&slot->command, 0, sizeof(nvmeCmdCtx));
+            slot->command.commandType = NVM_CMD;
+            slot->command.cmd.nvmCmd.opcode = writeCommand ? NVME_CMD_WRITE : NVME_CMD_READ;
+            slot->command.commandDirection = writeCommand ? XFER_DATA_OUT : XFER_DATA_IN;
+            slot->command.cmd.nvmCmd.cdw10 = M_DoubleWord0(lba);
+            slot->command.cmd.nvmCmd.cdw11 = M_DoubleWord1(lba);
+            slot->command.cmd.nvmCmd.cdw12 = stats->sectorsPerTransfer - 1;//zero based number of logical blocks
+            slot->command.ptrData = slot->dataBuf;
+            slot->command.dataSize = transferBytes;
+            slot->command.device = device;
+            slot->command.timeout = 15;
+            memset(&slot->commandTimer, 0, sizeof(seatimer_t));
+            start_Timer(&slot->commandTimer);
+            submitRet = submit_NVMe_IO_Uring_Command(&slot->command);
+            if (submitRet == SUCCESS)
+            {
+                --numberOfFreeSlots;
+            }
+            else if (numberOfFreeSlots == depth)
+            {
+                //nothing is in flight, so this will not get better
+                return 0;
+            }
+            else
+            {
+                record_Queue_Depth_Command(stats, 0, true);
+                break;
+            }
+            stop_Timer(&runTimer);
+            timeLeft = get_Nano_Seconds(runTimer) < stats->durationNanoSeconds;
+        }
+        if (numberOfFreeSlots == depth)
+        {
+            continue;
+        }
+        //every slot is busy (or the time is up), so wait for at least one completion
+        if (SUCCESS != reap_NVMe_IO_Uring_Commands(device, 1, completed, completedResults, QUEUE_DEPTH_SWEEP_MAX_DEPTH, &numberCompleted))
+        {
+            //The ring cannot report completions any more, so commands may still be in flight. The caller closes the ring before it frees the slots.
+            return 0;
+        }
+        for (completedIter = 0; completedIter < numberCompleted; ++completedIter)
+        {
+            queueDepthUringSlot *slot = C_CAST(queueDepthUringSlot*, C_CAST(void*, completed[completedIter]));
+            stop_Timer(&slot->commandTimer);
+            record_Queue_Depth_Command(stats, get_Nano_Seconds(slot->commandTimer), completedResults[completedIter] != SUCCESS);
+            freeSlots[numberOfFreeSlots] = C_CAST(uint16_t, slot - slots);
+            ++numberOfFreeSlots;
+        }
+        stop_Timer(&runTimer);
+        timeLeft = get_Nano_Seconds(runTimer) < stats->durationNanoSeconds;
+    }
+    return depth;
+}
+#endif //QUEUE_DEPTH_SWEEP_NVME_URING
+
+int queue_Depth_Sweep_Test(tDevice *device, ptrQueueDepthSweepOptions options, ptrQueueDepthSweepResults results)
+{
+    int ret = SUCCESS;
+    uint16_t maxQueueDepth = 0;
+    uint8_t numberOfTransferSizes = 0;
+    uint32_t defaultTransferSize = 4096;
+    uint32_t *transferSizes = NULL;
+    uint32_t maxSectorsPerTransfer = 0;
+    uint32_t secondsPerPoint = 0;
+    uint64_t startingLBA = 0;
+    uint64_t range = 0;
+    uint8_t sizeIter = 0;
+    uint16_t depth = 0;
+    uint16_t workerIter = 0;
+    queueDepthWorker *workers = NULL;
+    seaThread *threads = NULL;
+    uint64_t *latencies = NULL;
+    queueDepthNCQSlot *ncqSlots = NULL;
+    bool useNCQ = false;
+    bool useUring = false;
+    bool uringClosed = false;
+#if defined (QUEUE_DEPTH_SWEEP_NVME_URING)
+    queueDepthUringSlot *uringSlots = NULL;
+    pinnedIOBuffer uringBuffer;
+    memset(&uringBuffer, 0, sizeof(pinnedIOBuffer));
+#endif
+    if (!device || !options || !results || options->readPercent > 100 || options->numberOfTransferSizes > QUEUE_DEPTH_SWEEP_MAX_TRANSFER_SIZES || options->startingLBA > device->drive_info.deviceMaxLba)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(results, 0, sizeof(queueDepthSweepResults));
+    results->readPercent = options->readPercent;
+    results->commandsQueued = true;
+    maxQueueDepth = options->maxQueueDepth == 0 ? QUEUE_DEPTH_SWEEP_DEFAULT_MAX_DEPTH : M_Min(options->maxQueueDepth, QUEUE_DEPTH_SWEEP_MAX_DEPTH);
+    if (device->drive_info.drive_type == ATA_DRIVE)
+    {
+        ncqQueue probe;
+        if (SUCCESS == open_NCQ_Queue(device, 0, &probe))
+        {
+            useNCQ = true;
+            maxQueueDepth = M_Min(maxQueueDepth, probe.queueDepth);
+            close_NCQ_Queue(&probe);
+        }
+        else
+        {
+            //without NCQ the drive only takes one command at a time, so deeper points would all measure the same thing
+            results->commandsQueued = false;
+            maxQueueDepth = 1;
+            if (VERBOSITY_QUIET < device->deviceVerbosity)
+            {
+                printf("This drive does not support NCQ (or it cannot be used through this interface). Only queue depth 1 will be measured.\n");
+            }
+        }
+    }
+    numberOfTransferSizes = options->numberOfTransferSizes == 0 ? 1 : options->numberOfTransferSizes;
+    transferSizes = options->numberOfTransferSizes == 0 ? &defaultTransferSize : options->transferSizeBytes;
+    secondsPerPoint = options->secondsPerPoint == 0 ? 10 : options->secondsPerPoint;
+    startingLBA = options->startingLBA;
+    range = options->range == 0 || options->range > device->drive_info.deviceMaxLba + 1 - startingLBA ? device->drive_info.deviceMaxLba + 1 - startingLBA : options->range;
+    for (sizeIter = 0; sizeIter < numberOfTransferSizes; ++sizeIter)
+    {
+        uint32_t sectors = (transferSizes[sizeIter] + device->drive_info.deviceBlockSize - 1) / device->drive_info.deviceBlockSize;
+        if (sectors == 0 || sectors > range || (useNCQ && sectors > UINT16_MAX))
+        {
+            return BAD_PARAMETER;
+        }
+        maxSectorsPerTransfer = M_Max(maxSectorsPerTransfer, sectors);
+    }
+#if defined (QUEUE_DEPTH_SWEEP_NVME_URING)
+    if (device->drive_info.drive_type == NVME_DRIVE && device->drive_info.passThroughHacks.passthroughType == NVME_PASSTHROUGH_SYSTEM
+        && maxSectorsPerTransfer <= UINT16_MAX + 1 && C_CAST(uint64_t, maxSectorsPerTransfer) * device->drive_info.deviceBlockSize * maxQueueDepth <= UINT32_MAX)
+    {
+        //One pinned buffer holds every slot's data. Registering it with the ring saves the kernel mapping each command's pages.
+        //Kernels that cannot use registered buffers (before 6.1) still keep the commands in flight through the ring without it.
+        uint32_t slotBytes = maxSectorsPerTransfer * device->drive_info.deviceBlockSize;
+        if (SUCCESS == allocate_Pinned_IO_Buffer(C_CAST(size_t, slotBytes) * maxQueueDepth, &uringBuffer))
+        {
+            uint8_t *registerBuffers[1] = { uringBuffer.buffer };
+            uint32_t registerSizes[1] = { slotBytes * maxQueueDepth };
+            if (SUCCESS == register_NVMe_IO_Uring_Buffers(device, registerBuffers, registerSizes, 1) || SUCCESS == register_NVMe_IO_Uring_Buffers(device, NULL, NULL, 0))
+            {
+                uringSlots = C_CAST(queueDepthUringSlot*, calloc(maxQueueDepth, sizeof(queueDepthUringSlot)));
+                if (!uringSlots)
+                {
+                    if (SUCCESS != register_NVMe_IO_Uring_Buffers(device, NULL, NULL, 0))
+                    {
+                        close_NVMe_IO_Uring(device);
+                    }
+                    free_Pinned_IO_Buffer(&uringBuffer);
+                    return MEMORY_FAILURE;
+                }
+                for (workerIter = 0; workerIter < maxQueueDepth; ++workerIter)
+                {
+                    uringSlots[workerIter].dataBuf = uringBuffer.buffer + C_CAST(size_t, slotBytes) * workerIter;
+                }
+                useUring = true;
+            }
+            else
+            {
+                //a probe command that failed part way may still be using the buffer, so the ring is closed before it is freed
+                close_NVMe_IO_Uring(device);
+                free_Pinned_IO_Buffer(&uringBuffer);
+            }
+        }
+    }
+#endif
+    workers = C_CAST(queueDepthWorker*, calloc(maxQueueDepth, sizeof(queueDepthWorker)));
+    threads = C_CAST(seaThread*, calloc(maxQueueDepth, sizeof(seaThread)));
+    latencies = C_CAST(uint64_t*, calloc(QUEUE_DEPTH_SWEEP_LATENCY_SAMPLES, sizeof(uint64_t)));
+    if (useNCQ)
+    {
+        ncqSlots = C_CAST(queueDepthNCQSlot*, calloc(maxQueueDepth, sizeof(queueDepthNCQSlot)));
+    }
+    if (!workers || !threads || !latencies || (useNCQ && !ncqSlots))
+    {
+        safe_Free(workers)
+        safe_Free(threads)
+        safe_Free(latencies)
+        safe_Free(ncqSlots)
+#if defined (QUEUE_DEPTH_SWEEP_NVME_URING)
+        if (useUring)
+        {
+            if (SUCCESS != register_NVMe_IO_Uring_Buffers(device, NULL, NULL, 0))
+            {
+                close_NVMe_IO_Uring(device);
+            }
+            free_Pinned_IO_Buffer(&uringBuffer);
+            safe_Free(uringSlots)
+        }
+#endif
+        return MEMORY_FAILURE;
+    }
+    seed_64(C_CAST(uint64_t, time(NULL)));
+    for (workerIter = 0; workerIter < maxQueueDepth; ++workerIter)
+    {
+        //The OS handle is shared, but each worker gets its own copy of everything else in the device structure
+        workers[workerIter].device = clone_Device_For_Thread(device);
+        workers[workerIter].dataBuf = C_CAST(uint8_t*, calloc_aligned(C_CAST(size_t, maxSectorsPerTransfer) * device->drive_info.deviceBlockSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+        if (!workers[workerIter].device || !workers[workerIter].dataBuf)
+        {
+            ret = MEMORY_FAILURE;
+            break;
+        }
+        workers[workerIter].randomState = xorshiftplus64() | UINT64_C(1);//xorshift must not start at zero
+        if (useNCQ)
+        {
+            ncqSlots[workerIter].dataBuf = workers[workerIter].dataBuf;
+        }
+    }
+    for (sizeIter = 0; ret != MEMORY_FAILURE && sizeIter < numberOfTransferSizes; ++sizeIter)
+    {
+        uint32_t sectorsPerTransfer = (transferSizes[sizeIter] + device->drive_info.deviceBlockSize - 1) / device->drive_info.deviceBlockSize;
+        for (depth = 1; depth <= maxQueueDepth && results->numberOfPoints < QUEUE_DEPTH_SWEEP_MAX_POINTS; depth = C_CAST(uint16_t, depth * 2))
+        {
+            queueDepthSweepPoint *point = &results->point[results->numberOfPoints];
+            uint32_t latencyCount = 0;
+            uint64_t totalNanoSeconds = 0;
+            seatimer_t pointTimer;
+            memset(&pointTimer, 0, sizeof(seatimer_t));
+            point->queueDepth = depth;
+            point->transferSizeBytes = sectorsPerTransfer * device->drive_info.deviceBlockSize;
+            if (VERBOSITY_QUIET < device->deviceVerbosity)
+            {
+                printf("\rQueue depth %-3" PRIu16 " transfer size %-8" PRIu32 "", depth, point->transferSizeBytes);
+                fflush(stdout);
+            }
+            for (workerIter = 0; workerIter < depth; ++workerIter)
+            {
+                ptrQueueDepthWorker worker = &workers[workerIter];
+                worker->startingLBA = startingLBA;
+                worker->numberOfTransfers = range / sectorsPerTransfer;
+                worker->sectorsPerTransfer = sectorsPerTransfer;
+                worker->readPercent = options->readPercent;
+                worker->durationNanoSeconds = C_CAST(uint64_t, secondsPerPoint) * UINT64_C(1000000000);
+                worker->maxLatencies = QUEUE_DEPTH_SWEEP_LATENCY_SAMPLES / depth;
+                worker->latencies = &latencies[workerIter * worker->maxLatencies];
+                worker->numberOfLatencies = 0;
+                worker->commands = 0;
+                worker->failures = 0;
+                worker->totalNanoSeconds = 0;
+                worker->maximumNanoSeconds = 0;
+            }
+            if (useNCQ || useUring)
+            {
+                //every completion is counted in the first worker, so it gets all the latency samples
+                workers[0].maxLatencies = QUEUE_DEPTH_SWEEP_LATENCY_SAMPLES;
+                workers[0].latencies = latencies;
+                start_Timer(&pointTimer);
+#if defined (QUEUE_DEPTH_SWEEP_NVME_URING)
+                if (useUring)
+                {
+                    point->queueDepthAchieved = run_Queue_Depth_Uring_Point(device, depth, &workers[0], uringSlots);
+                    if (point->queueDepthAchieved == 0)
+                    {
+                        //Commands may still be in flight and using the slots. Closing the ring makes the kernel finish or cancel them
+                        //and drops the registered buffer, so the memory can be freed below.
+                        close_NVMe_IO_Uring(device);
+                        uringClosed = true;
+                    }
+                }
+                else
+#endif
+                {
+                    point->queueDepthAchieved = run_Queue_Depth_NCQ_Point(device, depth, &workers[0], ncqSlots);
+                }
+                stop_Timer(&pointTimer);
+                if (point->queueDepthAchieved == 0)
+                {
+                    ret = FAILURE;
+                    break;
+                }
+            }
+            else
+            {
+                point->queueDepthAchieved = 1;
+                start_Timer(&pointTimer);
+                for (workerIter = 1; workerIter < depth; ++workerIter)
+                {
+                    if (SUCCESS == create_Thread(&threads[workerIter], queue_Depth_Worker, &workers[workerIter]))
+                    {
+                        ++point->queueDepthAchieved;
+                    }
+                    else
+                    {
+                        threads[workerIter] = NULL;
+                    }
+                }
+                queue_Depth_Worker(&workers[0]);
+                for (workerIter = 1; workerIter < depth; ++workerIter)
+                {
+                    if (threads[workerIter])
+                    {
+                        join_Thread(&threads[workerIter]);
+                    }
+                }
+                stop_Timer(&pointTimer);
+            }
+            //gather every worker's counts and latencies. Workers that never started have zero counts.
+            for (workerIter = 0; workerIter < depth; ++workerIter)
+            {
+                ptrQueueDepthWorker worker = &workers[workerIter];
+                point->commands += worker->commands;
+                point->failures += worker->failures;
+                totalNanoSeconds += worker->totalNanoSeconds;
+                point->maximumNanoSeconds = M_Max(point->maximumNanoSeconds, worker->maximumNanoSeconds);
+                memmove(&latencies[latencyCount], worker->latencies, worker->numberOfLatencies * sizeof(uint64_t));
+                latencyCount += worker->numberOfLatencies;
+            }
+            if (point->failures > 0)
+            {
+                ret = FAILURE;
+            }
+            if (point->commands > 0 && get_Seconds(pointTimer) > 0.0)
+            {
+                point->iops = C_CAST(double, point->commands) / get_Seconds(pointTimer);
+                point->megaBytesPerSecond = (C_CAST(double, point->commands - point->failures) * point->transferSizeBytes / 1000000.0) / get_Seconds(pointTimer);
+                point->averageNanoSeconds = totalNanoSeconds / point->commands;
+            }
+            if (latencyCount > 0)
+            {
+                qsort(latencies, latencyCount, sizeof(uint64_t), compare_Seek_Latency);
+                point->p50NanoSeconds = latencies[(latencyCount - 1) * 50 / 100];
+                point->p90NanoSeconds = latencies[(latencyCount - 1) * 90 / 100];
+                point->p99NanoSeconds = latencies[(latencyCount - 1) * 99 / 100];
+                point->p999NanoSeconds = latencies[C_CAST(uint32_t, (C_CAST(uint64_t, latencyCount) - 1) * 999 / 1000)];
+            }
+            ++results->numberOfPoints;
+        }
+    }
+    if (VERBOSITY_QUIET < device->deviceVerbosity)
+    {
+        printf("\n");
+    }
+    for (workerIter = 0; workerIter < maxQueueDepth; ++workerIter)
+    {
+        free_Device_Clone(&workers[workerIter].device);
+        safe_Free_aligned(workers[workerIter].dataBuf)
+    }
+    safe_Free(workers)
+    safe_Free(threads)
+    safe_Free(latencies)
+    safe_Free(ncqSlots)
+#if defined (QUEUE_DEPTH_SWEEP_NVME_URING)
+    if (useUring)
+    {
+        //The ring refuses to drop the buffer while commands are in flight. Close it instead so nothing still points at the memory being freed.
+        if (!uringClosed && SUCCESS != register_NVMe_IO_Uring_Buffers(device, NULL, NULL, 0))
+        {
+            close_NVMe_IO_Uring(device);
+        }
+        free_Pinned_IO_Buffer(&uringBuffer);
+        safe_Free(uringSlots)
+    }
+#endif
+    return ret;
+}
+
+void print_Queue_Depth_Sweep_Results(ptrQueueDepthSweepResults results)
+{
+    uint32_t pointIter = 0;
+    if (!results)
+    {
+        return;
+    }
+    printf("\n===Queue Depth Sweep (%" PRIu8 "%% reads)===\n", results->readPercent);
+    if (!results->commandsQueued)
+    {
+        printf("The drive cannot queue commands, so only queue depth 1 was measured.\n");
+    }
+    printf("%-6s %-10s %-12s %-10s %-10s %-10s %-10s %-10s %-10s %-10s\n", "QD", "Size", "IOPS", "MB/s", "Avg (us)", "50% (us)", "90% (us)", "99% (us)", "99.9% (us)", "Failures");
+    for (pointIter = 0; pointIter < results->numberOfPoints && pointIter < QUEUE_DEPTH_SWEEP_MAX_POINTS; ++pointIter)
+    {
+        queueDepthSweepPoint *point = &results->point[pointIter];
+        printf("%-6" PRIu16 " %-10" PRIu32 " %-12.1f %-10.2f %-10.1f %-10.1f %-10.1f %-10.1f %-10.1f %-10" PRIu64 "%s\n", point->queueDepth, point->transferSizeBytes, point->iops, point->megaBytesPerSecond,
+            C_CAST(double, point->averageNanoSeconds) / 1000.0, C_CAST(double, point->p50NanoSeconds) / 1000.0, C_CAST(double, point->p90NanoSeconds) / 1000.0,
+            C_CAST(double, point->p99NanoSeconds) / 1000.0, C_CAST(double, point->p999NanoSeconds) / 1000.0, point->failures, point->queueDepthAchieved < point->queueDepth ? " (queue depth limited)" : "");
+    }
+}
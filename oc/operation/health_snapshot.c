@@ -0,0 +1,606 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file health_snapshot.c
+// \brief This file defines the functions for reading a device's health information in one pass, reading each log/VPD page only once
+
+#include "operations_Common.h"
+#include "health_snapshot.h"
+#include "logs.h"
+
+//The most device statistics log pages to read in one command when prefetching. Larger logs are left for the decoders to read as they normally do.
+#define HEALTH_SNAPSHOT_MAX_PREFETCH_PAGES 32
+
+//Reads the logs that more than one view needs in as few commands as possible so that the decoders find them in the page cache.
+static void prefetch_Health_Snapshot_Pages(tDevice *device, uint32_t requestedViews)
+{
+    if (device->drive_info.drive_type == ATA_DRIVE)
+    {
+        uint8_t *logBuffer = NULL;
+        uint16_t deviceStatsPages = 0;
+        if (!device->drive_info.ata_Options.generalPurposeLoggingSupported)
+        {
+            return;
+        }
+        logBuffer = C_CAST(uint8_t*, calloc_aligned(LEGACY_DRIVE_SEC_SIZE * HEALTH_SNAPSHOT_MAX_PREFETCH_PAGES, sizeof(uint8_t), device->os_info.minimumAlignment));
+        if (!logBuffer)
+        {
+            return;
+        }
+        //every log size lookup reads the directory, so read it once here
+        if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_DIRECTORY, 0, logBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
+        {
+            deviceStatsPages = M_BytesTo2ByteValue(logBuffer[(ATA_LOG_DEVICE_STATISTICS * 2) + 1], logBuffer[ATA_LOG_DEVICE_STATISTICS * 2]);
+        }
+        //device statistics are used by the statistics view and for the pending and grown counts, so read all pages in one command
+        if (requestedViews & (HEALTH_SNAPSHOT_DEVICE_STATISTICS | HEALTH_SNAPSHOT_DEFECT_COUNTS | HEALTH_SNAPSHOT_DRIVE_INFO)
+            && device->drive_info.softSATFlags.deviceStatisticsSupported && deviceStatsPages > 0 && deviceStatsPages <= HEALTH_SNAPSHOT_MAX_PREFETCH_PAGES)
+        {
+            send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_DEVICE_STATISTICS, 0, logBuffer, deviceStatsPages * LEGACY_DRIVE_SEC_SIZE, 0);
+        }
+        safe_Free_aligned(logBuffer)
+    }
+    else if (device->drive_info.drive_type == SCSI_DRIVE)
+    {
+        //nearly every log page decoder starts by checking the supported pages list
+        uint8_t supportedPages[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+        uint8_t supportedSubpages[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+        uint8_t pageCodes[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+        uint8_t subpageCodes[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+        uint32_t numberOfPages = 0;
+        uint8_t *pageList = supportedPages;
+        uint16_t listIter = LOG_PAGE_HEADER_LENGTH;
+        uint16_t listLength = 0;
+        uint8_t descriptorLength = 1;
+        bool pagesListed = SUCCESS == scsi_Log_Sense_Cmd(device, false, LPC_CUMULATIVE_VALUES, LP_SUPPORTED_LOG_PAGES, 0, 0, supportedPages, LEGACY_DRIVE_SEC_SIZE);
+        if (SUCCESS == scsi_Log_Sense_Cmd(device, false, LPC_CUMULATIVE_VALUES, LP_SUPPORTED_LOG_PAGES_AND_SUBPAGES, 0xFF, 0, supportedSubpages, LEGACY_DRIVE_SEC_SIZE))
+        {
+            pagesListed = true;
+            pageList = supportedSubpages;
+            descriptorLength = 2;
+        }
+        if (!pagesListed)
+        {
+            return;
+        }
+        //then each decoder reads its own pages one at a time, so read them all together first
+        listLength = M_Min(M_BytesTo2ByteValue(pageList[2], pageList[3]) + LOG_PAGE_HEADER_LENGTH, LEGACY_DRIVE_SEC_SIZE);
+        for (; listIter + descriptorLength <= listLength; listIter += descriptorLength)
+        {
+            uint8_t pageCode = pageList[listIter] & 0x3F;
+            uint8_t subpageCode = descriptorLength == 2 ? pageList[listIter + 1] : 0;
+            //the supported lists are already cached, and vendor specific pages (30h and up) are not used by any view
+            if (pageCode == LP_SUPPORTED_LOG_PAGES || subpageCode == 0xFF || pageCode >= 0x30)
+            {
+                continue;
+            }
+            pageCodes[numberOfPages] = pageCode;
+            subpageCodes[numberOfPages] = subpageCode;
+            ++numberOfPages;
+        }
+        if (numberOfPages > 0)
+        {
+            scsi_Prefetch_Log_Pages(device, LPC_CUMULATIVE_VALUES, pageCodes, subpageCodes, numberOfPages, LEGACY_DRIVE_SEC_SIZE);
+        }
+    }
+}
+
+int get_Health_Snapshot(tDevice *device, ptrHealthSnapshot snapshot)
+{
+    int ret = SUCCESS;
+    uint32_t requestedViews = 0;
+    if (!device || !snapshot || snapshot->version < HEALTH_SNAPSHOT_VERSION || snapshot->size < sizeof(healthSnapshot))
+    {
+        return BAD_PARAMETER;
+    }
+    requestedViews = snapshot->requestedViews;
+    memset(snapshot, 0, sizeof(healthSnapshot));
+    snapshot->size = sizeof(healthSnapshot);
+    snapshot->version = HEALTH_SNAPSHOT_VERSION;
+    snapshot->requestedViews = requestedViews;
+    ret = attach_Page_Cache(device);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    prefetch_Health_Snapshot_Pages(device, requestedViews);
+    if (requestedViews & HEALTH_SNAPSHOT_DRIVE_INFO)
+    {
+        int infoRet = NOT_SUPPORTED;
+        switch (device->drive_info.drive_type)
+        {
+        case ATA_DRIVE:
+            snapshot->driveInfo.infoType = DRIVE_INFO_SAS_SATA;
+            infoRet = get_ATA_Drive_Information(device, &snapshot->driveInfo.sasSata);
+            break;
+        case SCSI_DRIVE:
+            snapshot->driveInfo.infoType = DRIVE_INFO_SAS_SATA;
+            infoRet = get_SCSI_Drive_Information(device, &snapshot->driveInfo.sasSata);
+            break;
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+        case NVME_DRIVE:
+            snapshot->driveInfo.infoType = DRIVE_INFO_NVME;
+            infoRet = get_NVMe_Drive_Information(device, &snapshot->driveInfo.nvme);
+            break;
+#endif
+        default:
+            break;
+        }
+        if (infoRet == SUCCESS)
+        {
+            snapshot->validViews |= HEALTH_SNAPSHOT_DRIVE_INFO;
+        }
+    }
+    if (requestedViews & HEALTH_SNAPSHOT_SMART_ATTRIBUTES && SUCCESS == get_SMART_Attributes(device, &snapshot->smartData))
+    {
+        snapshot->validViews |= HEALTH_SNAPSHOT_SMART_ATTRIBUTES;
+    }
+    if (requestedViews & HEALTH_SNAPSHOT_DEVICE_STATISTICS && SUCCESS == get_DeviceStatistics(device, &snapshot->deviceStats))
+    {
+        snapshot->validViews |= HEALTH_SNAPSHOT_DEVICE_STATISTICS;
+    }
+    if (requestedViews & HEALTH_SNAPSHOT_DST_LOG && SUCCESS == get_DST_Log_Entries(device, &snapshot->dstEntries))
+    {
+        snapshot->validViews |= HEALTH_SNAPSHOT_DST_LOG;
+    }
+    if (requestedViews & HEALTH_SNAPSHOT_DEFECT_COUNTS)
+    {
+        snapshot->pendingCountValid = SUCCESS == get_Pending_List_Count(device, &snapshot->pendingCount);
+        snapshot->grownCountValid = SUCCESS == get_Grown_List_Count(device, &snapshot->grownCount);
+        if (snapshot->pendingCountValid || snapshot->grownCountValid)
+        {
+            snapshot->validViews |= HEALTH_SNAPSHOT_DEFECT_COUNTS;
+        }
+    }
+    snapshot->pageCacheHits = device->drive_info.pageCache->hits;
+    snapshot->pageCacheMisses = device->drive_info.pageCache->misses;
+    detach_Page_Cache(device);
+    if (snapshot->validViews != requestedViews)
+    {
+        ret = FAILURE;
+    }
+    return ret;
+}
+
+typedef struct _healthCounterValue
+{
+    uint32_t id;
+    uint64_t value;
+}healthCounterValue;
+
+//The largest number of counters pulled from one raw page. A device statistics page holds 63 statistics, SMART data holds 30 attributes (x2 for nominal and raw)
+#define HEALTH_POLL_MAX_COUNTERS_PER_PAGE 256
+
+//NVMe SMART/health log fields that are tracked. Counters wider than 8 bytes only have their low 8 bytes tracked.
+static const struct
+{
+    uint16_t offset;
+    uint8_t length;
+}nvmeHealthFields[] = {
+    { 0, 1 },//critical warning
+    { 1, 2 },//composite temperature
+    { 3, 1 },//available spare
+    { 5, 1 },//percentage used
+    { 32, 8 },//data units read
+    { 48, 8 },//data units written
+    { 64, 8 },//host read commands
+    { 80, 8 },//host write commands
+    { 96, 8 },//controller busy time
+    { 112, 8 },//power cycles
+    { 128, 8 },//power on hours
+    { 144, 8 },//unsafe shutdowns
+    { 160, 8 },//media and data integrity errors
+    { 176, 8 },//number of error information log entries
+    { 192, 4 },//warning composite temperature time
+    { 196, 4 },//critical composite temperature time
+};
+
+static uint64_t get_Little_Endian_Value(const uint8_t *data, uint8_t length)
+{
+    uint64_t value = 0;
+    while (length > 0)
+    {
+        --length;
+        value = (value << 8) | data[length];
+    }
+    return value;
+}
+
+static uint32_t extract_Health_Counters(eHealthCounterSource source, uint32_t pageID, const uint8_t *data, uint32_t length, healthCounterValue *counters)
+{
+    uint32_t count = 0;
+    uint32_t offset = 0;
+    switch (source)
+    {
+    case HEALTH_COUNTER_ATA_SMART_ATTRIBUTE:
+        for (offset = ATA_SMART_BEGIN_ATTRIBUTES; offset + ATA_SMART_ATTRIBUTE_SIZE <= length && offset < ATA_SMART_END_ATTRIBUTES && count + 2 <= HEALTH_POLL_MAX_COUNTERS_PER_PAGE; offset += ATA_SMART_ATTRIBUTE_SIZE)
+        {
+            uint8_t attributeNumber = data[offset];
+            if (attributeNumber == 0)
+            {
+                continue;
+            }
+            counters[count].id = attributeNumber;
+            counters[count].value = get_Little_Endian_Value(&data[offset + 5], 6);
+            ++count;
+            counters[count].id = UINT32_C(256) + attributeNumber;
+            counters[count].value = data[offset + 3];
+            ++count;
+        }
+        break;
+    case HEALTH_COUNTER_ATA_DEVICE_STATISTIC:
+        //skip the header qword
+        for (offset = 8; offset + 8 <= length && count < HEALTH_POLL_MAX_COUNTERS_PER_PAGE; offset += 8)
+        {
+            uint64_t qword = get_Little_Endian_Value(&data[offset], 8);
+            if (qword & BIT63 && qword & BIT62)
+            {
+                counters[count].id = (pageID << 16) | offset;
+                counters[count].value = qword & UINT64_C(0x00FFFFFFFFFFFFFF);
+                ++count;
+            }
+        }
+        break;
+    case HEALTH_COUNTER_SCSI_LOG_PARAMETER:
+        if (length >= LOG_PAGE_HEADER_LENGTH)
+        {
+            uint32_t pageEnd = M_Min(length, C_CAST(uint32_t, M_BytesTo2ByteValue(data[2], data[3])) + LOG_PAGE_HEADER_LENGTH);
+            for (offset = LOG_PAGE_HEADER_LENGTH; offset + 4 <= pageEnd && count < HEALTH_POLL_MAX_COUNTERS_PER_PAGE; offset += C_CAST(uint32_t, data[offset + 3]) + 4)
+            {
+                uint16_t parameterCode = M_BytesTo2ByteValue(data[offset], data[offset + 1]);
+                uint8_t parameterLength = data[offset + 3];
+                uint8_t valueIter = 0;
+                uint64_t value = 0;
+                if (offset + 4 + parameterLength > pageEnd)
+                {
+                    break;
+                }
+                //big endian. Only the first 8 bytes of longer parameters are tracked.
+                for (valueIter = 0; valueIter < parameterLength && valueIter < 8; ++valueIter)
+                {
+                    value = (value << 8) | data[offset + 4 + valueIter];
+                }
+                counters[count].id = (pageID << 16) | parameterCode;
+                counters[count].value = value;
+                ++count;
+            }
+        }
+        break;
+    case HEALTH_COUNTER_NVME_SMART_LOG:
+        for (offset = 0; offset < sizeof(nvmeHealthFields) / sizeof(nvmeHealthFields[0]); ++offset)
+        {
+            if (nvmeHealthFields[offset].offset + nvmeHealthFields[offset].length <= length)
+            {
+                counters[count].id = nvmeHealthFields[offset].offset;
+                counters[count].value = get_Little_Endian_Value(&data[nvmeHealthFields[offset].offset], nvmeHealthFields[offset].length);
+                ++count;
+            }
+        }
+        break;
+    }
+    return count;
+}
+
+static void add_Health_Counter_Change(ptrHealthPollState state, eHealthCounterSource source, uint32_t id, uint64_t previousValue, uint64_t currentValue, ptrHealthCounterChange changes, uint32_t maxChanges, uint32_t *numberOfChanges)
+{
+    if (changes && *numberOfChanges < maxChanges)
+    {
+        ptrHealthCounterChange change = &changes[*numberOfChanges];
+        change->source = source;
+        change->id = id;
+        change->previousValue = previousValue;
+        change->currentValue = currentValue;
+        change->delta = C_CAST(int64_t, currentValue - previousValue);
+        change->ratePerSecond = state->lastIntervalSeconds > 0 ? C_CAST(double, change->delta) / state->lastIntervalSeconds : 0;
+    }
+    ++(*numberOfChanges);
+}
+
+//Saves a freshly read page in the state. If it differs from the last one, the counters in both are compared and the ones that changed are reported.
+static int update_Health_Poll_Page(ptrHealthPollState state, eHealthCounterSource source, uint32_t pageID, const uint8_t *data, uint32_t length, ptrHealthCounterChange changes, uint32_t maxChanges, uint32_t *numberOfChanges)
+{
+    uint32_t fingerprint = crc32c(0, data, length);
+    healthPollPage *page = NULL;
+    uint32_t pageIter = 0;
+    uint8_t *newData = NULL;
+    for (pageIter = 0; pageIter < state->numberOfPages; ++pageIter)
+    {
+        if (state->pages[pageIter].source == source && state->pages[pageIter].pageID == pageID)
+        {
+            page = &state->pages[pageIter];
+            break;
+        }
+    }
+    if (page && page->length == length && page->fingerprint == fingerprint)
+    {
+        ++(state->pagesUnchanged);
+        return SUCCESS;
+    }
+    ++(state->pagesChanged);
+    if (!page)
+    {
+        if (state->numberOfPages >= HEALTH_POLL_MAX_PAGES)
+        {
+            return SUCCESS;//nowhere to keep it. This page just won't be tracked.
+        }
+        page = &state->pages[state->numberOfPages];
+        ++(state->numberOfPages);
+        memset(page, 0, sizeof(healthPollPage));
+        page->source = source;
+        page->pageID = pageID;
+    }
+    else if (page->data)
+    {
+        healthCounterValue *previousCounters = C_CAST(healthCounterValue*, calloc(HEALTH_POLL_MAX_COUNTERS_PER_PAGE * 2, sizeof(healthCounterValue)));
+        healthCounterValue *currentCounters = NULL;
+        uint32_t previousCount = 0;
+        uint32_t currentCount = 0;
+        uint32_t currentIter = 0;
+        if (!previousCounters)
+        {
+            return MEMORY_FAILURE;
+        }
+        currentCounters = &previousCounters[HEALTH_POLL_MAX_COUNTERS_PER_PAGE];
+        previousCount = extract_Health_Counters(source, pageID, page->data, page->length, previousCounters);
+        currentCount = extract_Health_Counters(source, pageID, data, length, currentCounters);
+        for (currentIter = 0; currentIter < currentCount; ++currentIter)
+        {
+            uint32_t previousIter = 0;
+            uint64_t previousValue = 0;
+            for (previousIter = 0; previousIter < previousCount; ++previousIter)
+            {
+                if (previousCounters[previousIter].id == currentCounters[currentIter].id)
+                {
+                    previousValue = previousCounters[previousIter].value;
+                    break;
+                }
+            }
+            //a counter that just became valid is reported as a change from zero
+            if (previousIter == previousCount || previousValue != currentCounters[currentIter].value)
+            {
+                add_Health_Counter_Change(state, source, currentCounters[currentIter].id, previousValue, currentCounters[currentIter].value, changes, maxChanges, numberOfChanges);
+            }
+        }
+        safe_Free(previousCounters)
+    }
+    newData = C_CAST(uint8_t*, malloc(length));
+    if (!newData)
+    {
+        return MEMORY_FAILURE;
+    }
+    memcpy(newData, data, length);
+    safe_Free(page->data)
+    page->data = newData;
+    page->length = length;
+    page->fingerprint = fingerprint;
+    return SUCCESS;
+}
+
+static int poll_ATA_Health_Counters(tDevice *device, ptrHealthPollState state, ptrHealthCounterChange changes, uint32_t maxChanges, uint32_t *numberOfChanges)
+{
+    int ret = NOT_SUPPORTED;
+    uint8_t *logBuffer = NULL;
+    if (!state->baselineTaken && device->drive_info.ata_Options.generalPurposeLoggingSupported && device->drive_info.softSATFlags.deviceStatisticsSupported)
+    {
+        uint8_t logDirectory[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+        if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_DIRECTORY, 0, logDirectory, LEGACY_DRIVE_SEC_SIZE, 0))
+        {
+            state->ataDeviceStatisticsPages = M_BytesTo2ByteValue(logDirectory[(ATA_LOG_DEVICE_STATISTICS * 2) + 1], logDirectory[ATA_LOG_DEVICE_STATISTICS * 2]);
+            state->ataDeviceStatisticsPages = M_Min(state->ataDeviceStatisticsPages, HEALTH_POLL_MAX_PAGES - 1);
+        }
+    }
+    if (state->ataDeviceStatisticsPages > 1)
+    {
+        logBuffer = C_CAST(uint8_t*, calloc_aligned(C_CAST(size_t, state->ataDeviceStatisticsPages) * LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+        if (!logBuffer)
+        {
+            return MEMORY_FAILURE;
+        }
+        //all pages in one command. Page 0 is only the list of supported pages, so it is not tracked.
+        if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_DEVICE_STATISTICS, 0, logBuffer, state->ataDeviceStatisticsPages * LEGACY_DRIVE_SEC_SIZE, 0))
+        {
+            uint16_t pageIter = 0;
+            ret = SUCCESS;
+            for (pageIter = 1; pageIter < state->ataDeviceStatisticsPages && ret == SUCCESS; ++pageIter)
+            {
+                ret = update_Health_Poll_Page(state, HEALTH_COUNTER_ATA_DEVICE_STATISTIC, pageIter, &logBuffer[pageIter * LEGACY_DRIVE_SEC_SIZE], LEGACY_DRIVE_SEC_SIZE, changes, maxChanges, numberOfChanges);
+            }
+        }
+        safe_Free_aligned(logBuffer)
+        if (ret == MEMORY_FAILURE)
+        {
+            return ret;
+        }
+    }
+    if (is_SMART_Enabled(device))
+    {
+        logBuffer = C_CAST(uint8_t*, calloc_aligned(LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+        if (!logBuffer)
+        {
+            return MEMORY_FAILURE;
+        }
+        if (SUCCESS == ata_SMART_Read_Data(device, logBuffer, LEGACY_DRIVE_SEC_SIZE))
+        {
+            ret = update_Health_Poll_Page(state, HEALTH_COUNTER_ATA_SMART_ATTRIBUTE, 0, logBuffer, LEGACY_DRIVE_SEC_SIZE, changes, maxChanges, numberOfChanges);
+        }
+        safe_Free_aligned(logBuffer)
+    }
+    return ret;
+}
+
+static int poll_SCSI_Health_Counters(tDevice *device, ptrHealthPollState state, ptrHealthCounterChange changes, uint32_t maxChanges, uint32_t *numberOfChanges)
+{
+    int ret = NOT_SUPPORTED;
+    uint8_t pageIter = 0;
+    uint8_t *logBuffer = NULL;
+    uint32_t logBufferLength = UINT16_MAX & ~UINT32_C(0x1FF);//largest multiple of 512 that fits in the allocation length
+    if (!state->baselineTaken)
+    {
+        //pages that are mostly counters
+        const uint8_t counterPages[] = { LP_WRITE_ERROR_COUNTERS, LP_READ_ERROR_COUNTERS, LP_VERIFY_ERROR_COUNTERS, LP_NON_MEDIUM_ERROR, LP_TEMPERATURE, LP_START_STOP_CYCLE_COUNTER, LP_SOLID_STATE_MEDIA, LP_GENERAL_STATISTICS_AND_PERFORMANCE, LP_INFORMATION_EXCEPTIONS };
+        uint8_t supportedPages[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+        state->numberOfSCSILogPages = 0;
+        if (SUCCESS == scsi_Log_Sense_Cmd(device, false, LPC_CUMULATIVE_VALUES, LP_SUPPORTED_LOG_PAGES, 0, 0, supportedPages, LEGACY_DRIVE_SEC_SIZE))
+        {
+            uint16_t listLength = M_Min(M_BytesTo2ByteValue(supportedPages[2], supportedPages[3]), LEGACY_DRIVE_SEC_SIZE - LOG_PAGE_HEADER_LENGTH);
+            uint16_t listIter = 0;
+            for (listIter = LOG_PAGE_HEADER_LENGTH; listIter < listLength + LOG_PAGE_HEADER_LENGTH; ++listIter)
+            {
+                uint8_t counterIter = 0;
+                for (counterIter = 0; counterIter < sizeof(counterPages) && state->numberOfSCSILogPages < HEALTH_POLL_MAX_SCSI_LOG_PAGES; ++counterIter)
+                {
+                    if ((supportedPages[listIter] & 0x3F) == counterPages[counterIter])
+                    {
+                        state->scsiLogPages[state->numberOfSCSILogPages] = counterPages[counterIter];
+                        ++(state->numberOfSCSILogPages);
+                    }
+                }
+            }
+        }
+    }
+    if (state->numberOfSCSILogPages == 0)
+    {
+        return NOT_SUPPORTED;
+    }
+    logBuffer = C_CAST(uint8_t*, calloc_aligned(logBufferLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!logBuffer)
+    {
+        return MEMORY_FAILURE;
+    }
+    for (pageIter = 0; pageIter < state->numberOfSCSILogPages; ++pageIter)
+    {
+        memset(logBuffer, 0, logBufferLength);
+        if (SUCCESS == scsi_Log_Sense_Cmd(device, false, LPC_CUMULATIVE_VALUES, state->scsiLogPages[pageIter], 0, 0, logBuffer, C_CAST(uint16_t, logBufferLength)))
+        {
+            uint32_t pageLength = M_Min(C_CAST(uint32_t, M_BytesTo2ByteValue(logBuffer[2], logBuffer[3])) + LOG_PAGE_HEADER_LENGTH, logBufferLength);
+            ret = update_Health_Poll_Page(state, HEALTH_COUNTER_SCSI_LOG_PARAMETER, C_CAST(uint32_t, state->scsiLogPages[pageIter]) << 8, logBuffer, pageLength, changes, maxChanges, numberOfChanges);
+            if (ret == MEMORY_FAILURE)
+            {
+                break;
+            }
+        }
+    }
+    safe_Free_aligned(logBuffer)
+    return ret;
+}
+
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+static int poll_NVMe_Health_Counters(tDevice *device, ptrHealthPollState state, ptrHealthCounterChange changes, uint32_t maxChanges, uint32_t *numberOfChanges)
+{
+    int ret = NOT_SUPPORTED;
+    uint8_t *logBuffer = C_CAST(uint8_t*, calloc_aligned(NVME_SMART_HEALTH_LOG_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!logBuffer)
+    {
+        return MEMORY_FAILURE;
+    }
+    if (SUCCESS == nvme_Get_SMART_Log_Page(device, NVME_ALL_NAMESPACES, logBuffer, NVME_SMART_HEALTH_LOG_LEN))
+    {
+        ret = update_Health_Poll_Page(state, HEALTH_COUNTER_NVME_SMART_LOG, 0, logBuffer, NVME_SMART_HEALTH_LOG_LEN, changes, maxChanges, numberOfChanges);
+    }
+    safe_Free_aligned(logBuffer)
+    return ret;
+}
+#endif
+
+int poll_Health_Counters(tDevice *device, ptrHealthPollState state, ptrHealthCounterChange changes, uint32_t maxChanges, uint32_t *numberOfChanges)
+{
+    int ret = NOT_SUPPORTED;
+    if (!device || !state || !numberOfChanges || state->version < HEALTH_POLL_STATE_VERSION || state->size < sizeof(healthPollState) || (maxChanges > 0 && !changes))
+    {
+        return BAD_PARAMETER;
+    }
+    *numberOfChanges = 0;
+    state->pagesChanged = 0;
+    state->pagesUnchanged = 0;
+    if (state->baselineTaken)
+    {
+        stop_Timer(&state->intervalTimer);
+        state->lastIntervalSeconds = C_CAST(double, get_Nano_Seconds(state->intervalTimer)) / 1000000000.0;
+    }
+    start_Timer(&state->intervalTimer);
+    switch (device->drive_info.drive_type)
+    {
+    case ATA_DRIVE:
+        ret = poll_ATA_Health_Counters(device, state, changes, maxChanges, numberOfChanges);
+        break;
+    case SCSI_DRIVE:
+        ret = poll_SCSI_Health_Counters(device, state, changes, maxChanges, numberOfChanges);
+        break;
+#if !defined (DISABLE_NVME_PASSTHROUGH)
+    case NVME_DRIVE:
+        ret = poll_NVMe_Health_Counters(device, state, changes, maxChanges, numberOfChanges);
+        break;
+#endif
+    default:
+        break;
+    }
+    if (ret == SUCCESS)
+    {
+        state->baselineTaken = true;
+    }
+    return ret;
+}
+
+void free_Health_Poll_State(ptrHealthPollState state)
+{
+    if (state)
+    {
+        uint32_t pageIter = 0;
+        size_t size = state->size;
+        uint32_t version = state->version;
+        for (pageIter = 0; pageIter < state->numberOfPages && pageIter < HEALTH_POLL_MAX_PAGES; ++pageIter)
+        {
+            safe_Free(state->pages[pageIter].data)
+        }
+        memset(state, 0, sizeof(healthPollState));
+        state->size = size;
+        state->version = version;
+    }
+}
+
+int get_Health_Counter_Values(ptrHealthPollState state, ptrHealthCounterValueEntry values, uint32_t maxValues, uint32_t *numberOfValues)
+{
+    healthCounterValue *counters = NULL;
+    uint32_t pageIter = 0;
+    if (!state || !numberOfValues || state->version < HEALTH_POLL_STATE_VERSION || state->size < sizeof(healthPollState) || (maxValues > 0 && !values))
+    {
+        return BAD_PARAMETER;
+    }
+    *numberOfValues = 0;
+    counters = C_CAST(healthCounterValue*, calloc(HEALTH_POLL_MAX_COUNTERS_PER_PAGE, sizeof(healthCounterValue)));
+    if (!counters)
+    {
+        return MEMORY_FAILURE;
+    }
+    for (pageIter = 0; pageIter < state->numberOfPages && pageIter < HEALTH_POLL_MAX_PAGES; ++pageIter)
+    {
+        healthPollPage *page = &state->pages[pageIter];
+        uint32_t counterCount = 0;
+        uint32_t counterIter = 0;
+        if (!page->data)
+        {
+            continue;
+        }
+        counterCount = extract_Health_Counters(page->source, page->pageID, page->data, page->length, counters);
+        for (counterIter = 0; counterIter < counterCount; ++counterIter)
+        {
+            if (*numberOfValues < maxValues)
+            {
+                values[*numberOfValues].source = page->source;
+                values[*numberOfValues].id = counters[counterIter].id;
+                values[*numberOfValues].value = counters[counterIter].value;
+            }
+            ++(*numberOfValues);
+        }
+    }
+    safe_Free(counters)
+    return SUCCESS;
+}
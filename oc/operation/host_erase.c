@@ -17,10 +17,17 @@
 #include "host_erase.h"
 #include "cmds.h"
 #include "platform_helper.h"
+#include "test_checkpoint.h"
+#include "writesame.h"
+#include "trim_unmap.h"
 
-int erase_Range(tDevice *device, uint64_t eraseRangeStart, uint64_t eraseRangeEnd, uint8_t *pattern, uint32_t patternLength, bool hideLBACounter)
+//When checkpointFile is set, the position is saved into the checkpoint state and written to the file periodically so that resume_Erase_Range can pick up from it.
+static int erase_Range_Internal(tDevice *device, uint64_t eraseRangeStart, uint64_t eraseRangeEnd, uint8_t *pattern, uint32_t patternLength, bool hideLBACounter, const char *checkpointFile, ptrTestCheckpoint state)
 {
     int ret = SUCCESS;
+    time_t runStartTime = time(NULL);
+    time_t lastCheckpointTime = runStartTime;
+    uint64_t previousElapsedSeconds = state ? state->elapsedSeconds : 0;
     uint32_t sectors = get_Sector_Count_For_Read_Write(device);
     uint64_t iter = 0;
     uint32_t dataLength = sectors * device->drive_info.deviceBlockSize;
@@ -119,6 +126,19 @@ int erase_Range(tDevice *device, uint64_t eraseRangeStart, uint64_t eraseRangeEn
                 //update the filesystem cache after writing the boot partition sectors so that no other LBA writes have permission errors - TJE
                 os_Update_File_System_Cache(device);
             }
+            if (checkpointFile && state && difftime(time(NULL), lastCheckpointTime) >= TEST_CHECKPOINT_INTERVAL_SECONDS)
+            {
+                //make sure everything written so far is actually on the media before recording it as done
+                flush_Cache(device);
+                //the last chunk can be longer than what is left of the range, so do not record a position past the end
+                state->currentLBA = M_Min(iter + sectors, eraseRangeEnd);
+                state->elapsedSeconds = previousElapsedSeconds + C_CAST(uint64_t, difftime(time(NULL), runStartTime));
+                if (SUCCESS != save_Test_Checkpoint(checkpointFile, state) && VERBOSITY_QUIET < device->deviceVerbosity)
+                {
+                    printf("\nWarning: Unable to save checkpoint to %s\n", checkpointFile);
+                }
+                lastCheckpointTime = time(NULL);
+            }
         }
         if (VERBOSITY_QUIET < device->deviceVerbosity && FAILURE != ret && !hideLBACounter)
         {
@@ -134,6 +154,11 @@ int erase_Range(tDevice *device, uint64_t eraseRangeStart, uint64_t eraseRangeEn
         }
     }
     flush_Cache(device);
+    if (checkpointFile && ret == SUCCESS)
+    {
+        //finished, so there is nothing left to resume. On failure the checkpoint is kept so the erase can be retried from it.
+        remove_Test_Checkpoint(checkpointFile);
+    }
     if (VERBOSITY_QUIET < device->deviceVerbosity)
     {
         printf("\n");
@@ -144,6 +169,57 @@ int erase_Range(tDevice *device, uint64_t eraseRangeStart, uint64_t eraseRangeEn
     return ret;
 }
 
+int erase_Range(tDevice *device, uint64_t eraseRangeStart, uint64_t eraseRangeEnd, uint8_t *pattern, uint32_t patternLength, bool hideLBACounter)
+{
+    return erase_Range_Internal(device, eraseRangeStart, eraseRangeEnd, pattern, patternLength, hideLBACounter, NULL, NULL);
+}
+
+int erase_Range_Checkpoint(tDevice *device, uint64_t eraseRangeStart, uint64_t eraseRangeEnd, uint8_t *pattern, uint32_t patternLength, bool hideLBACounter, const char *checkpointFile)
+{
+    testCheckpoint state;
+    init_Test_Checkpoint(device, &state, CHECKPOINT_TEST_ERASE_RANGE, eraseRangeStart, eraseRangeEnd);
+    if (pattern)
+    {
+        //the pattern is saved in the checkpoint so the resumed erase writes the same thing
+        state.pattern = pattern;
+        state.patternLength = patternLength;
+    }
+    //nothing in state is allocated here, so it does not need to be freed
+    return erase_Range_Internal(device, eraseRangeStart, eraseRangeEnd, pattern, patternLength, hideLBACounter, checkpointFile, &state);
+}
+
+int resume_Erase_Range(tDevice *device, const char *checkpointFile, bool hideLBACounter)
+{
+    int ret = SUCCESS;
+    testCheckpoint state;
+    if (!checkpointFile)
+    {
+        return BAD_PARAMETER;
+    }
+    ret = load_Test_Checkpoint(checkpointFile, &state);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    if (!is_Checkpoint_For_Device(device, &state, CHECKPOINT_TEST_ERASE_RANGE))
+    {
+        if (VERBOSITY_QUIET < device->deviceVerbosity)
+        {
+            printf("Checkpoint %s is not for an erase on this device.\n", checkpointFile);
+        }
+        free_Test_Checkpoint(&state);
+        return BAD_PARAMETER;
+    }
+    if (VERBOSITY_QUIET < device->deviceVerbosity)
+    {
+        printf("Resuming erase at LBA %" PRIu64 " of %" PRIu64 "\n", state.currentLBA, state.endingLBA);
+    }
+    //currentLBA is always aligned since it is only saved after full aligned writes, so no read-modify-write is done at the start
+    ret = erase_Range_Internal(device, state.currentLBA, state.endingLBA, state.pattern, state.patternLength, hideLBACounter, checkpointFile, &state);
+    free_Test_Checkpoint(&state);
+    return ret;
+}
+
 int erase_Time(tDevice *device, uint64_t eraseStartLBA, time_t eraseTime, uint8_t *pattern, uint32_t patternLength, bool hideLBACounter)
 {
     int ret = UNKNOWN;
@@ -250,3 +326,455 @@ int erase_Time(tDevice *device, uint64_t eraseStartLBA, time_t eraseTime, uint8_
     os_Update_File_System_Cache(device);
     return ret;
 }
+
+static const char* get_Offload_Erase_Command_String(eOffloadEraseCommand method)
+{
+    switch (method)
+    {
+    case OFFLOAD_ERASE_HOST_WRITES:
+        return "Host writes";
+    case OFFLOAD_ERASE_SCSI_WRITE_SAME:
+        return "Write Same";
+    case OFFLOAD_ERASE_ATA_SCT_WRITE_SAME:
+        return "SCT Write Same";
+    case OFFLOAD_ERASE_ATA_ZEROS_EXT:
+        return "Zeros Ext";
+    case OFFLOAD_ERASE_NVME_WRITE_ZEROES:
+        return "Write Zeroes";
+    case OFFLOAD_ERASE_TRIM_UNMAP:
+        return "Trim/Unmap";
+    case OFFLOAD_ERASE_NONE:
+        break;
+    }
+    return "None";
+}
+
+//Device side commands write the same logical sector to every LBA. This checks that the pattern erase_Range would write is one sector repeated,
+//and fills in that sector. allZeroes is set when there is no pattern or the pattern is all zeroes.
+static bool get_Single_Sector_Pattern(tDevice *device, uint8_t *pattern, uint32_t patternLength, uint8_t *sectorPattern, bool *allZeroes)
+{
+    uint32_t blockSize = device->drive_info.deviceBlockSize;
+    uint32_t offset = 0;
+    *allZeroes = true;
+    if (!pattern || patternLength == 0)
+    {
+        memset(sectorPattern, 0, blockSize);
+        return true;
+    }
+    if (patternLength <= blockSize)
+    {
+        //the pattern is repeated through the whole buffer, so the next sector only starts the same way when the pattern evenly divides the sector
+        if (blockSize % patternLength != 0)
+        {
+            return false;
+        }
+        fill_Pattern_Buffer_Into_Another_Buffer(pattern, patternLength, sectorPattern, blockSize);
+    }
+    else
+    {
+        if (patternLength % blockSize != 0)
+        {
+            return false;
+        }
+        memcpy(sectorPattern, pattern, blockSize);
+        for (offset = blockSize; offset < patternLength; offset += blockSize)
+        {
+            if (memcmp(sectorPattern, &pattern[offset], blockSize) != 0)
+            {
+                return false;
+            }
+        }
+    }
+    for (offset = 0; offset < blockSize; ++offset)
+    {
+        if (sectorPattern[offset] != 0)
+        {
+            *allZeroes = false;
+            break;
+        }
+    }
+    return true;
+}
+
+//Picks the fastest command from what the drive reports it supports. Commands that only write zeroes are preferred since the drive can
+//usually do them without any media writes at all.
+static eOffloadEraseCommand choose_Offload_Erase_Command(tDevice *device, bool allZeroes, bool allowDeallocate, uint64_t *maxLBAsPerCommand)
+{
+    uint64_t writeSameMax = 0;
+    *maxLBAsPerCommand = 0;
+    switch (device->drive_info.drive_type)
+    {
+    case NVME_DRIVE:
+        if (allZeroes && device->drive_info.IdentifyData.nvme.ctrl.oncs & BIT3)
+        {
+            *maxLBAsPerCommand = UINT16_MAX + 1;//NLB is 0 based
+            return OFFLOAD_ERASE_NVME_WRITE_ZEROES;
+        }
+        break;
+    case ATA_DRIVE:
+        if (allZeroes && device->drive_info.softSATFlags.zeroExtSupported)
+        {
+            *maxLBAsPerCommand = UINT16_MAX;
+            return OFFLOAD_ERASE_ATA_ZEROS_EXT;
+        }
+        //trim is only an erase when the drive returns zeroes for trimmed LBAs (DRAT and RZAT)
+        if (allZeroes && allowDeallocate && device->drive_info.IdentifyData.ata.Word169 & BIT0 && device->drive_info.IdentifyData.ata.Word069 & BIT14 && device->drive_info.IdentifyData.ata.Word069 & BIT5)
+        {
+            return OFFLOAD_ERASE_TRIM_UNMAP;
+        }
+        if (device->drive_info.IdentifyData.ata.Word206 & BIT2)
+        {
+            return OFFLOAD_ERASE_ATA_SCT_WRITE_SAME;
+        }
+        break;
+    case SCSI_DRIVE:
+        if (is_Write_Same_Supported(device, 0, 0, &writeSameMax))
+        {
+            //write_Same only uses the 16 byte command on SBC2 and later, otherwise the 10 byte command limits the range
+            uint64_t commandMax = device->drive_info.scsiVersion > SCSI_VERSION_SPC ? UINT32_MAX : UINT16_MAX;
+            if (writeSameMax == 0 || writeSameMax > commandMax)
+            {
+                writeSameMax = commandMax;
+            }
+            *maxLBAsPerCommand = writeSameMax;
+            return OFFLOAD_ERASE_SCSI_WRITE_SAME;
+        }
+        break;
+    default:
+        break;
+    }
+    return OFFLOAD_ERASE_NONE;
+}
+
+static int send_Offload_Erase_Command(tDevice *device, eOffloadEraseCommand method, uint64_t lba, uint64_t count, uint8_t *sectorPattern, bool allowDeallocate)
+{
+    switch (method)
+    {
+    case OFFLOAD_ERASE_NVME_WRITE_ZEROES:
+        return nvme_Write_Zeroes(device, lba, C_CAST(uint16_t, count - 1), allowDeallocate);
+    case OFFLOAD_ERASE_ATA_ZEROS_EXT:
+        return ata_Zeros_Ext(device, C_CAST(uint16_t, count), lba, allowDeallocate);
+    case OFFLOAD_ERASE_SCSI_WRITE_SAME:
+        //SCSI always gets a data buffer since NDOB is not supported by every drive
+        return write_Same(device, lba, count, sectorPattern);
+    default:
+        break;
+    }
+    return NOT_SUPPORTED;
+}
+
+//SCT write same runs in the background, so wait for it to finish. Returns ABORTED if the drive stopped it.
+static int wait_For_SCT_Write_Same(tDevice *device, uint64_t startLBA, uint64_t range, bool hideLBACounter)
+{
+    int ret = SUCCESS;
+    bool inProgress = true;
+    double progress = 0.0;
+    while (inProgress)
+    {
+        delay_Seconds(1);
+        ret = get_Writesame_Progress(device, &progress, &inProgress, startLBA, range);
+        if (ret != SUCCESS)
+        {
+            break;
+        }
+        if (inProgress && VERBOSITY_QUIET < device->deviceVerbosity && !hideLBACounter)
+        {
+            printf("\rWrite Same progress: %3.2f%%", progress);
+            fflush(stdout);
+        }
+    }
+    return ret;
+}
+
+//Shared by the writers erasing the part of a range the device command did not. Each writer takes the next chunk under the mutex,
+//so a new write is already waiting at the drive when the previous one completes.
+typedef struct _eraseRangePipeline
+{
+    seaMutex mutex;
+    uint32_t sectorCount;
+    uint64_t nextLBA;
+    uint64_t endLBA;
+    int result;
+}eraseRangePipeline, *ptrEraseRangePipeline;
+
+typedef struct _eraseRangeWriter
+{
+    tDevice *device;//private copy of the device so that each writer keeps its own last command results
+    uint8_t *dataBuf;//already filled with the pattern
+    bool showProgress;
+    ptrEraseRangePipeline pipeline;
+}eraseRangeWriter, *ptrEraseRangeWriter;
+
+static void erase_Range_Writer(void *context)
+{
+    ptrEraseRangeWriter writer = C_CAST(ptrEraseRangeWriter, context);
+    ptrEraseRangePipeline pipeline = writer->pipeline;
+    while (1)
+    {
+        uint64_t lba = 0;
+        uint64_t misalignment = 0;
+        uint32_t count = 0;
+        int ret = SUCCESS;
+        lock_Mutex(pipeline->mutex);
+        if (pipeline->result != SUCCESS || pipeline->nextLBA >= pipeline->endLBA)
+        {
+            unlock_Mutex(pipeline->mutex);
+            break;
+        }
+        lba = pipeline->nextLBA;
+        //a range that does not start on a physical sector boundary gets a shorter first chunk so that every chunk after it is aligned
+        misalignment = lba - align_LBA(writer->device, lba);
+        count = misalignment < pipeline->sectorCount ? pipeline->sectorCount - C_CAST(uint32_t, misalignment) : pipeline->sectorCount;
+        count = C_CAST(uint32_t, M_Min(C_CAST(uint64_t, count), pipeline->endLBA - lba));
+        pipeline->nextLBA += count;
+        unlock_Mutex(pipeline->mutex);
+        if (writer->showProgress)
+        {
+            printf("\rWriting LBA: %-40"PRIu64"", lba);
+            fflush(stdout);
+        }
+        ret = write_LBA(writer->device, lba, false, writer->dataBuf, count * writer->device->drive_info.deviceBlockSize);
+        if (ret == SUCCESS && lba == 0)
+        {
+            //update the filesystem cache after writing the boot partition sectors so that no other LBA writes have permission errors
+            os_Update_File_System_Cache(writer->device);
+        }
+        if (ret != SUCCESS)
+        {
+            lock_Mutex(pipeline->mutex);
+            if (pipeline->result == SUCCESS)
+            {
+                pipeline->result = FAILURE;
+            }
+            unlock_Mutex(pipeline->mutex);
+        }
+    }
+}
+
+//Host writes for erase_Range_Offloaded. Only whole LBAs are written, so unlike erase_Range nothing needs to be read back first,
+//and ERASE_RANGE_PIPELINE_DEPTH writes are kept in flight from cloned devices. Falls back to erase_Range when the writers cannot be set up.
+static int erase_Range_Pipelined(tDevice *device, uint64_t eraseRangeStart, uint64_t eraseRangeEnd, uint8_t *pattern, uint32_t patternLength, bool hideLBACounter)
+{
+    int ret = SUCCESS;
+    eraseRangePipeline pipeline;
+    eraseRangeWriter writers[ERASE_RANGE_PIPELINE_DEPTH];
+    seaThread threads[ERASE_RANGE_PIPELINE_DEPTH];
+    uint32_t sectorCount = get_Sector_Count_For_Read_Write(device);
+    uint32_t dataLength = sectorCount * device->drive_info.deviceBlockSize;
+    uint8_t writerIter = 0;
+    memset(&pipeline, 0, sizeof(eraseRangePipeline));
+    memset(writers, 0, sizeof(writers));
+    memset(threads, 0, sizeof(threads));
+    pipeline.sectorCount = sectorCount;
+    pipeline.nextLBA = eraseRangeStart;
+    pipeline.endLBA = eraseRangeEnd;
+    pipeline.result = SUCCESS;
+    if (SUCCESS != create_Mutex(&pipeline.mutex))
+    {
+        return erase_Range_Internal(device, eraseRangeStart, eraseRangeEnd, pattern, patternLength, hideLBACounter, NULL, NULL);
+    }
+    for (writerIter = 0; writerIter < ERASE_RANGE_PIPELINE_DEPTH; ++writerIter)
+    {
+        writers[writerIter].pipeline = &pipeline;
+        //The OS handle is shared, but each writer gets its own copy of everything else in the device structure
+        writers[writerIter].device = clone_Device_For_Thread(device);
+        writers[writerIter].dataBuf = C_CAST(uint8_t*, calloc_aligned(dataLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+        if (!writers[writerIter].device || !writers[writerIter].dataBuf)
+        {
+            ret = MEMORY_FAILURE;
+            break;
+        }
+        if (pattern)
+        {
+            fill_Pattern_Buffer_Into_Another_Buffer(pattern, patternLength, writers[writerIter].dataBuf, dataLength);
+        }
+    }
+    if (ret == SUCCESS)
+    {
+        writers[0].showProgress = VERBOSITY_QUIET < device->deviceVerbosity && !hideLBACounter;
+        if (VERBOSITY_QUIET < device->deviceVerbosity)
+        {
+            printf("\n");
+        }
+        os_Lock_Device(device);
+        for (writerIter = 1; writerIter < ERASE_RANGE_PIPELINE_DEPTH; ++writerIter)
+        {
+            if (SUCCESS != create_Thread(&threads[writerIter], erase_Range_Writer, &writers[writerIter]))
+            {
+                //fewer writes in flight is slower, but still erases the range
+                threads[writerIter] = NULL;
+            }
+        }
+        erase_Range_Writer(&writers[0]);
+        for (writerIter = 1; writerIter < ERASE_RANGE_PIPELINE_DEPTH; ++writerIter)
+        {
+            if (threads[writerIter])
+            {
+                join_Thread(&threads[writerIter]);
+            }
+        }
+        ret = pipeline.result;
+        if (writers[0].showProgress && ret == SUCCESS)
+        {
+            printf("\rWriting LBA: %-40"PRIu64"", eraseRangeEnd - 1);
+            fflush(stdout);
+        }
+        flush_Cache(device);
+        if (VERBOSITY_QUIET < device->deviceVerbosity)
+        {
+            printf("\n");
+        }
+        os_Unlock_Device(device);
+        os_Update_File_System_Cache(device);
+    }
+    for (writerIter = 0; writerIter < ERASE_RANGE_PIPELINE_DEPTH; ++writerIter)
+    {
+        free_Device_Clone(&writers[writerIter].device);
+        safe_Free_aligned(writers[writerIter].dataBuf)
+    }
+    destroy_Mutex(&pipeline.mutex);
+    if (ret == MEMORY_FAILURE)
+    {
+        ret = erase_Range_Internal(device, eraseRangeStart, eraseRangeEnd, pattern, patternLength, hideLBACounter, NULL, NULL);
+    }
+    return ret;
+}
+
+int erase_Range_Offloaded(tDevice *device, uint64_t eraseRangeStart, uint64_t eraseRangeEnd, uint8_t *pattern, uint32_t patternLength, bool allowDeallocate, bool hideLBACounter, ptrEraseOffloadResult result)
+{
+    int ret = SUCCESS;
+    eraseOffloadResult localResult;
+    seatimer_t deviceTimer, hostTimer;
+    uint64_t lba = eraseRangeStart;
+    uint64_t maxLBAsPerCommand = 0;
+    bool allZeroes = false;
+    eOffloadEraseCommand method = OFFLOAD_ERASE_NONE;
+    uint8_t *sectorPattern = NULL;
+    if (eraseRangeEnd > device->drive_info.deviceMaxLba)
+    {
+        //MAX64 (or anything past the end) means erase to the end of the drive. The end LBA is not erased, so stop just after the max LBA.
+        //This must be done before the range is handed to a device command, which would otherwise be asked to write LBAs that do not exist.
+        eraseRangeEnd = device->drive_info.deviceMaxLba + 1;
+    }
+    if (eraseRangeEnd <= eraseRangeStart || device->drive_info.deviceBlockSize == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&localResult, 0, sizeof(eraseOffloadResult));
+    memset(&deviceTimer, 0, sizeof(seatimer_t));
+    memset(&hostTimer, 0, sizeof(seatimer_t));
+    sectorPattern = C_CAST(uint8_t*, calloc_aligned(device->drive_info.deviceBlockSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!sectorPattern)
+    {
+        perror("calloc failure! Pattern - erase range offloaded");
+        return MEMORY_FAILURE;
+    }
+    if (get_Single_Sector_Pattern(device, pattern, patternLength, sectorPattern, &allZeroes))
+    {
+        method = choose_Offload_Erase_Command(device, allZeroes, allowDeallocate, &maxLBAsPerCommand);
+    }
+    if (method != OFFLOAD_ERASE_NONE)
+    {
+        if (VERBOSITY_QUIET < device->deviceVerbosity)
+        {
+            printf("\nErasing with %s\n", get_Offload_Erase_Command_String(method));
+        }
+        localResult.deviceCommand = method;
+        start_Timer(&deviceTimer);
+        if (method == OFFLOAD_ERASE_TRIM_UNMAP)
+        {
+            //trim_Unmap_Range splits the range into as many commands as it needs and locks the device itself
+            ret = trim_Unmap_Range(device, lba, eraseRangeEnd - lba);
+            if (ret == SUCCESS)
+            {
+                lba = eraseRangeEnd;
+            }
+        }
+        else
+        {
+            os_Lock_Device(device);
+            if (method == OFFLOAD_ERASE_ATA_SCT_WRITE_SAME)
+            {
+                ret = write_Same(device, lba, eraseRangeEnd - lba, allZeroes ? NULL : sectorPattern);
+                if (ret == SUCCESS)
+                {
+                    ret = wait_For_SCT_Write_Same(device, lba, eraseRangeEnd - lba, hideLBACounter);
+                }
+                if (ret == SUCCESS)
+                {
+                    lba = eraseRangeEnd;
+                }
+            }
+            else
+            {
+                while (lba < eraseRangeEnd)
+                {
+                    uint64_t count = M_Min(maxLBAsPerCommand, eraseRangeEnd - lba);
+                    if (VERBOSITY_QUIET < device->deviceVerbosity && !hideLBACounter)
+                    {
+                        printf("\rErasing LBA: %-40"PRIu64"", lba);
+                        fflush(stdout);
+                    }
+                    ret = send_Offload_Erase_Command(device, method, lba, count, sectorPattern, allowDeallocate);
+                    if (ret != SUCCESS)
+                    {
+                        break;
+                    }
+                    lba += count;
+                }
+            }
+            flush_Cache(device);
+            os_Unlock_Device(device);
+        }
+        stop_Timer(&deviceTimer);
+        os_Update_File_System_Cache(device);
+        localResult.lbasErasedByDevice = lba - eraseRangeStart;
+        localResult.deviceNanoseconds = get_Nano_Seconds(deviceTimer);
+        if (VERBOSITY_QUIET < device->deviceVerbosity)
+        {
+            printf("\n");
+            if (ret != SUCCESS)
+            {
+                printf("%s stopped at LBA %" PRIu64 ". The rest of the range will be written by the host.\n", get_Offload_Erase_Command_String(method), lba);
+            }
+        }
+    }
+    if (lba < eraseRangeEnd)
+    {
+        start_Timer(&hostTimer);
+        ret = erase_Range_Pipelined(device, lba, eraseRangeEnd, pattern, patternLength, hideLBACounter);
+        stop_Timer(&hostTimer);
+        localResult.lbasErasedByHost = eraseRangeEnd - lba;
+        localResult.hostNanoseconds = get_Nano_Seconds(hostTimer);
+    }
+    if (localResult.deviceNanoseconds + localResult.hostNanoseconds > 0)
+    {
+        double megabytes = C_CAST(double, (eraseRangeEnd - eraseRangeStart) * device->drive_info.deviceBlockSize) / 1000000.0;
+        double seconds = C_CAST(double, localResult.deviceNanoseconds + localResult.hostNanoseconds) / 1000000000.0;
+        localResult.megabytesPerSecond = megabytes / seconds;
+    }
+    if (result)
+    {
+        memcpy(result, &localResult, sizeof(eraseOffloadResult));
+    }
+    safe_Free_aligned(sectorPattern)
+    return ret;
+}
+
+void print_Erase_Offload_Result(ptrEraseOffloadResult result)
+{
+    if (!result)
+    {
+        return;
+    }
+    printf("\n===Erase Results===\n");
+    if (result->lbasErasedByDevice > 0 || result->deviceCommand != OFFLOAD_ERASE_NONE)
+    {
+        printf("\tErased by drive (%s): %" PRIu64 " LBAs in %.3f seconds\n", get_Offload_Erase_Command_String(result->deviceCommand), result->lbasErasedByDevice, C_CAST(double, result->deviceNanoseconds) / 1000000000.0);
+    }
+    if (result->lbasErasedByHost > 0)
+    {
+        printf("\tErased by host writes: %" PRIu64 " LBAs in %.3f seconds\n", result->lbasErasedByHost, C_CAST(double, result->hostNanoseconds) / 1000000000.0);
+    }
+    printf("\tAchieved rate: %.2f MB/s\n", result->megabytesPerSecond);
+}
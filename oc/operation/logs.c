@@ -209,7 +209,7 @@ int get_ATA_Log_Size(tDevice *device, uint8_t logAddress, uint32_t *logFileSize,
     printf("%s: logAddress %d, gpl=%s, smart=%s\n",__FUNCTION__, logAddress, gpl ? "true":"false", smart ? "true":"false");
     #endif
 
-    uint8_t *logBuffer = C_CAST(uint8_t*, calloc_aligned(LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint8_t *logBuffer = C_CAST(uint8_t*, get_Device_Buffer(device, LEGACY_DRIVE_SEC_SIZE));
     if (!logBuffer)
     {
         return MEMORY_FAILURE;
@@ -256,14 +256,14 @@ int get_ATA_Log_Size(tDevice *device, uint8_t logAddress, uint32_t *logFileSize,
             }
         }
     }
-    safe_Free_aligned(logBuffer)
+    safe_Release_Device_Buffer(device, logBuffer, LEGACY_DRIVE_SEC_SIZE)
     return ret;
 }
 
 int get_SCSI_Log_Size(tDevice *device, uint8_t logPage, uint8_t logSubPage, uint32_t *logFileSize)
 {
     int ret = NOT_SUPPORTED;//assume the log is not supported
-    uint8_t *logBuffer = C_CAST(uint8_t*, calloc_aligned(255, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint8_t *logBuffer = C_CAST(uint8_t*, get_Device_Buffer(device, 255));
     if (!logBuffer)
     {
         return MEMORY_FAILURE;
@@ -330,7 +330,7 @@ int get_SCSI_Log_Size(tDevice *device, uint8_t logPage, uint8_t logSubPage, uint
             *logFileSize = UINT16_MAX;//maximum transfer for a log page, so return this so that the page can at least be read....
         }
     }
-    safe_Free_aligned(logBuffer)
+    safe_Release_Device_Buffer(device, logBuffer, 255)
     return ret;
 }
 
@@ -338,7 +338,7 @@ int get_SCSI_VPD_Page_Size(tDevice *device, uint8_t vpdPage, uint32_t *vpdPageSi
 {
     int ret = NOT_SUPPORTED;//assume the page is not supported
     uint32_t vpdBufferLength = INQ_RETURN_DATA_LENGTH;
-    uint8_t *vpdBuffer = C_CAST(uint8_t *, calloc_aligned(vpdBufferLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint8_t *vpdBuffer = C_CAST(uint8_t*, get_Device_Buffer(device, vpdBufferLength));
     if (!vpdBuffer)
     {
         if (VERBOSITY_QUIET < device->deviceVerbosity)
@@ -371,7 +371,7 @@ int get_SCSI_VPD_Page_Size(tDevice *device, uint8_t vpdPage, uint32_t *vpdPageSi
             }
         }
     }
-    safe_Free_aligned(vpdBuffer)
+    safe_Release_Device_Buffer(device, vpdBuffer, vpdBufferLength)
     return ret;
 }
 
@@ -388,7 +388,9 @@ int get_SCSI_Mode_Page_Size(tDevice *device, eScsiModePageControl mpc, uint8_t m
         sixByte = true;
         modeLength = MODE_PARAMETER_HEADER_6_LEN + SHORT_LBA_BLOCK_DESCRIPTOR_LEN;
     }
-    uint8_t *modeBuffer = C_CAST(uint8_t *, calloc_aligned(modeLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+    //sized for the 6 byte command too so that the buffer does not need to grow if the 10 byte command is retried as a 6 byte command
+    uint32_t modeBufferLength = MODE_PARAMETER_HEADER_6_LEN + SHORT_LBA_BLOCK_DESCRIPTOR_LEN;
+    uint8_t *modeBuffer = C_CAST(uint8_t*, get_Device_Buffer(device, modeBufferLength));
     if (!modeBuffer)
     {
         if (VERBOSITY_QUIET < device->deviceVerbosity)
@@ -414,13 +416,6 @@ int get_SCSI_Mode_Page_Size(tDevice *device, eScsiModePageControl mpc, uint8_t m
             {
                 sixByte = true;
                 modeLength = MODE_PARAMETER_HEADER_6_LEN + SHORT_LBA_BLOCK_DESCRIPTOR_LEN;
-                //reallocate memory!
-                uint8_t *temp = C_CAST(uint8_t*, realloc(modeBuffer, modeLength));
-                if (!temp)
-                {
-                    return MEMORY_FAILURE;
-                }
-                modeBuffer = temp;
             }
         }
     }
@@ -431,7 +426,7 @@ int get_SCSI_Mode_Page_Size(tDevice *device, eScsiModePageControl mpc, uint8_t m
             *modePageSize = modeBuffer[0] + 1;
         }
     }
-    safe_Free_aligned(modeBuffer)
+    safe_Release_Device_Buffer(device, modeBuffer, modeBufferLength)
     return ret;
 }
 
@@ -450,7 +445,9 @@ int get_SCSI_Mode_Page(tDevice *device, eScsiModePageControl mpc, uint8_t modePa
     {
         sixByte = true;
     }
-    uint8_t *modeBuffer = C_CAST(uint8_t *, calloc_aligned(modeLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+    //sized for the 6 byte command too so that the buffer does not need to grow if the 10 byte command is retried as a 6 byte command
+    uint32_t modeBufferLength = M_Max(modeLength, MODE_PARAMETER_HEADER_6_LEN + SHORT_LBA_BLOCK_DESCRIPTOR_LEN);
+    uint8_t *modeBuffer = C_CAST(uint8_t*, get_Device_Buffer(device, modeBufferLength));
     if (!modeBuffer)
     {
         if (VERBOSITY_QUIET < device->deviceVerbosity)
@@ -488,7 +485,7 @@ int get_SCSI_Mode_Page(tDevice *device, eScsiModePageControl mpc, uint8_t modePa
                     }
                     fclose(fpmp);
                     fileOpened = false;
-                    safe_Free_aligned(modeBuffer)
+                    safe_Release_Device_Buffer(device, modeBuffer, modeBufferLength)
                     return ERROR_WRITING_FILE;
                 }
 
@@ -501,6 +498,7 @@ int get_SCSI_Mode_Page(tDevice *device, eScsiModePageControl mpc, uint8_t modePa
                 }
                 else
                 {
+                    safe_Release_Device_Buffer(device, modeBuffer, modeBufferLength)
                     return BAD_PARAMETER;
                 }
             }
@@ -514,7 +512,7 @@ int get_SCSI_Mode_Page(tDevice *device, eScsiModePageControl mpc, uint8_t modePa
                     }
                     fclose(fpmp);
                     fileOpened = false;
-                    safe_Free_aligned(modeBuffer)
+                    safe_Release_Device_Buffer(device, modeBuffer, modeBufferLength)
                     return ERROR_WRITING_FILE;
                 }
 
@@ -532,13 +530,6 @@ int get_SCSI_Mode_Page(tDevice *device, eScsiModePageControl mpc, uint8_t modePa
             {
                 sixByte = true;
                 modeLength = MODE_PARAMETER_HEADER_6_LEN + SHORT_LBA_BLOCK_DESCRIPTOR_LEN;
-                //reallocate memory!
-                uint8_t *temp = C_CAST(uint8_t*, realloc(modeBuffer, modeLength));
-                if (!temp)
-                {
-                    return MEMORY_FAILURE;
-                }
-                modeBuffer = temp;
             }
             else
             {
@@ -575,7 +566,7 @@ int get_SCSI_Mode_Page(tDevice *device, eScsiModePageControl mpc, uint8_t modePa
                     }
                     fclose(fpmp);
                     fileOpened = false;
-                    safe_Free_aligned(modeBuffer)
+                    safe_Release_Device_Buffer(device, modeBuffer, modeBufferLength)
                     return ERROR_WRITING_FILE;
                 }
             }
@@ -587,6 +578,7 @@ int get_SCSI_Mode_Page(tDevice *device, eScsiModePageControl mpc, uint8_t modePa
                 }
                 else
                 {
+                    safe_Release_Device_Buffer(device, modeBuffer, modeBufferLength)
                     return BAD_PARAMETER;
                 }
             }
@@ -600,7 +592,7 @@ int get_SCSI_Mode_Page(tDevice *device, eScsiModePageControl mpc, uint8_t modePa
                     }
                     fclose(fpmp);
                     fileOpened = false;
-                    safe_Free_aligned(modeBuffer)
+                    safe_Release_Device_Buffer(device, modeBuffer, modeBufferLength)
                     return ERROR_WRITING_FILE;
                 }
                 fclose(fpmp);
@@ -612,7 +604,7 @@ int get_SCSI_Mode_Page(tDevice *device, eScsiModePageControl mpc, uint8_t modePa
             ret = FAILURE;
         }
     }
-    safe_Free_aligned(modeBuffer)
+    safe_Release_Device_Buffer(device, modeBuffer, modeBufferLength)
     return ret;
 }
 
@@ -637,7 +629,7 @@ int get_SCSI_Error_History_Size(tDevice *device, uint8_t bufferID, uint32_t *err
     {
         return BAD_PARAMETER;
     }
-    uint8_t *errorHistoryDirectory = C_CAST(uint8_t*, calloc_aligned(2088, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint8_t *errorHistoryDirectory = C_CAST(uint8_t*, get_Device_Buffer(device, 2088));
     if (!errorHistoryDirectory)
     {
         return MEMORY_FAILURE;
@@ -675,7 +667,7 @@ int get_SCSI_Error_History_Size(tDevice *device, uint8_t bufferID, uint32_t *err
             }
         }
     }
-    safe_Free_aligned(errorHistoryDirectory)
+    safe_Release_Device_Buffer(device, errorHistoryDirectory, 2088)
     return ret;
 }
 
@@ -711,7 +703,8 @@ int get_SCSI_Error_History(tDevice *device, uint8_t bufferID, char *logName, boo
         {
             increment = historyLen;
         }
-        historyBuffer = C_CAST(uint8_t *, calloc_aligned(increment, sizeof(uint8_t), device->os_info.minimumAlignment));
+        uint32_t historyBufferSize = increment;//increment is made smaller for the last chunk
+        historyBuffer = C_CAST(uint8_t*, get_Device_Buffer(device, historyBufferSize));
 
         if (!historyBuffer)
         {
@@ -777,7 +770,7 @@ int get_SCSI_Error_History(tDevice *device, uint8_t bufferID, char *logName, boo
                             }
                             fclose(fp_History);
                             logFileOpened = false;
-                            safe_Free_aligned(historyBuffer)
+                            safe_Release_Device_Buffer(device, historyBuffer, historyBufferSize)
                             return ERROR_WRITING_FILE;
                         }
                     }
@@ -799,12 +792,12 @@ int get_SCSI_Error_History(tDevice *device, uint8_t bufferID, char *logName, boo
                 }
                 fclose(fp_History);
                 logFileOpened = false;
-                safe_Free_aligned(historyBuffer)
+                safe_Release_Device_Buffer(device, historyBuffer, historyBufferSize)
                 return ERROR_WRITING_FILE;
             }
             fclose(fp_History);
         }
-        safe_Free_aligned(historyBuffer)
+        safe_Release_Device_Buffer(device, historyBuffer, historyBufferSize)
     }
     return ret;
 }
@@ -940,7 +933,8 @@ int pull_SCSI_G_List(tDevice *device, const char * const filePath)
     int ret = UNKNOWN;
     uint32_t addressDescriptorIndex = 0;
     uint32_t defectDataSize = 8;//set to size of defect data without any address descriptors so we know how much we will be pulling
-    uint8_t *defectData = C_CAST(uint8_t*, calloc_aligned(defectDataSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint32_t defectDataBufferSize = 4096;//large enough for the header and for each chunk read after it
+    uint8_t *defectData = C_CAST(uint8_t*, get_Device_Buffer(device, defectDataBufferSize));
     if (!defectData)
     {
         return MEMORY_FAILURE;
@@ -954,12 +948,6 @@ int pull_SCSI_G_List(tDevice *device, const char * const filePath)
         uint32_t defectListLength = M_BytesTo4ByteValue(defectData[4], defectData[5], defectData[6], defectData[7]);
         //each address descriptor is 8 bytes in size
         defectDataSize = 4096;//pull 4096 at a time
-        uint8_t *temp = C_CAST(uint8_t*, realloc(defectData, defectDataSize * sizeof(uint8_t)));
-        if (!temp)
-        {
-            return MEMORY_FAILURE;
-        }
-        defectData = temp;
         memset(defectData, 0, defectDataSize);
         //now loop to get all the data
         for (addressDescriptorIndex = 0; ((addressDescriptorIndex + 511) * 8) < defectListLength; addressDescriptorIndex += 511)
@@ -986,7 +974,7 @@ int pull_SCSI_G_List(tDevice *device, const char * const filePath)
                         }
                         fclose(gListData);
                         fileOpened = false;
-                        safe_Free_aligned(defectData)
+                        safe_Release_Device_Buffer(device, defectData, defectDataBufferSize)
                         return ERROR_WRITING_FILE;
                     }
                 }
@@ -1000,7 +988,7 @@ int pull_SCSI_G_List(tDevice *device, const char * const filePath)
                         }
                         fclose(gListData);
                         fileOpened = false;
-                        safe_Free_aligned(defectData)
+                        safe_Release_Device_Buffer(device, defectData, defectDataBufferSize)
                         return ERROR_WRITING_FILE;
                     }
                     fclose(gListData);
@@ -1008,7 +996,7 @@ int pull_SCSI_G_List(tDevice *device, const char * const filePath)
             }
         }
     }
-    safe_Free_aligned(defectData)
+    safe_Release_Device_Buffer(device, defectData, defectDataBufferSize)
     return ret;
 }
 
@@ -1046,7 +1034,8 @@ int get_ATA_Log(tDevice *device, uint8_t logAddress, char *logName, char *fileEx
         bool logFromGPL = false;
         bool fileOpened = false;
         FILE *fp_log = NULL;
-        uint8_t *logBuffer = C_CAST(uint8_t *, calloc_aligned(logSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+        uint32_t logBufferSize = logSize;//logSize is cleared when a read fails
+        uint8_t *logBuffer = C_CAST(uint8_t*, get_Device_Buffer(device, logBufferSize));
         if (!logBuffer)
         {
             perror("Calloc Failure!\n");
@@ -1129,7 +1118,7 @@ int get_ATA_Log(tDevice *device, uint8_t logAddress, char *logName, char *fileEx
                             }
                             fclose(fp_log);
                             fileOpened = false;
-                            safe_Free_aligned(logBuffer)
+                            safe_Release_Device_Buffer(device, logBuffer, logBufferSize)
                             return ERROR_WRITING_FILE;
                         }
                         ret = SUCCESS;
@@ -1142,6 +1131,7 @@ int get_ATA_Log(tDevice *device, uint8_t logAddress, char *logName, char *fileEx
                         }
                         else
                         {
+                            safe_Release_Device_Buffer(device, logBuffer, logBufferSize)
                             return BAD_PARAMETER;
                         }
                     }
@@ -1177,7 +1167,7 @@ int get_ATA_Log(tDevice *device, uint8_t logAddress, char *logName, char *fileEx
                             }
                             fclose(fp_log);
                             fileOpened = false;
-                            safe_Free_aligned(logBuffer)
+                            safe_Release_Device_Buffer(device, logBuffer, logBufferSize)
                             return ERROR_WRITING_FILE;
                         }
                         ret = SUCCESS;
@@ -1190,6 +1180,7 @@ int get_ATA_Log(tDevice *device, uint8_t logAddress, char *logName, char *fileEx
                         }
                         else
                         {
+                            safe_Release_Device_Buffer(device, logBuffer, logBufferSize)
                             return BAD_PARAMETER;
                         }
                     }
@@ -1232,7 +1223,7 @@ int get_ATA_Log(tDevice *device, uint8_t logAddress, char *logName, char *fileEx
                         }
                         fclose(fp_log);
                         fileOpened = false;
-                        safe_Free_aligned(logBuffer)
+                        safe_Release_Device_Buffer(device, logBuffer, logBufferSize)
                         return ERROR_WRITING_FILE;
                     }
                     ret = SUCCESS;
@@ -1245,6 +1236,7 @@ int get_ATA_Log(tDevice *device, uint8_t logAddress, char *logName, char *fileEx
                     }
                     else
                     {
+                        safe_Release_Device_Buffer(device, logBuffer, logBufferSize)
                         return BAD_PARAMETER;
                     }
                 }
@@ -1265,13 +1257,13 @@ int get_ATA_Log(tDevice *device, uint8_t logAddress, char *logName, char *fileEx
                 }
                 fclose(fp_log);
                 fileOpened = false;
-                safe_Free_aligned(logBuffer)
+                safe_Release_Device_Buffer(device, logBuffer, logBufferSize)
                 return ERROR_WRITING_FILE;
             }
             fclose(fp_log);
             fileOpened = false;
         }
-        safe_Free_aligned(logBuffer)
+        safe_Release_Device_Buffer(device, logBuffer, logBufferSize)
     }
 
     #ifdef _DEBUG
@@ -1322,7 +1314,7 @@ int get_SCSI_Log(tDevice *device, uint8_t logAddress, uint8_t subpage, char *log
             return BAD_PARAMETER;
         
         //TODO: Improve this since if caller has already has enough memory, no need to allocate this. 
-        logBuffer = C_CAST(uint8_t *, calloc_aligned(pageLen, sizeof(uint8_t), device->os_info.minimumAlignment));
+        logBuffer = C_CAST(uint8_t*, get_Device_Buffer(device, pageLen));
         
         if (!logBuffer)
         {
@@ -1350,7 +1342,7 @@ int get_SCSI_Log(tDevice *device, uint8_t logAddress, uint8_t subpage, char *log
                             perror("Error writing to a file!\n");
                         }
                         fclose(fp_log);
-                        safe_Free_aligned(logBuffer)
+                        safe_Release_Device_Buffer(device, logBuffer, pageLen)
                         return ERROR_WRITING_FILE;
                     }
                     if ((fflush(fp_log) != 0) || ferror(fp_log))
@@ -1360,7 +1352,7 @@ int get_SCSI_Log(tDevice *device, uint8_t logAddress, uint8_t subpage, char *log
                             perror("Error flushing data!\n");
                         }
                         fclose(fp_log);
-                        safe_Free_aligned(logBuffer)
+                        safe_Release_Device_Buffer(device, logBuffer, pageLen)
                         return ERROR_WRITING_FILE;
                     }
                     fclose(fp_log);
@@ -1375,7 +1367,7 @@ int get_SCSI_Log(tDevice *device, uint8_t logAddress, uint8_t subpage, char *log
         {
             ret = FAILURE;
         }
-        safe_Free_aligned(logBuffer)
+        safe_Release_Device_Buffer(device, logBuffer, pageLen)
     }
     return ret;
 }
@@ -1388,7 +1380,7 @@ int get_SCSI_VPD(tDevice *device, uint8_t pageCode, char *logName, char *fileExt
     if (ret == SUCCESS)
     {
         FILE *fp_vpd = NULL;
-        uint8_t *vpdBuffer = C_CAST(uint8_t *, calloc_aligned(vpdBufferLength, sizeof(uint8_t), device->os_info.minimumAlignment));
+        uint8_t *vpdBuffer = C_CAST(uint8_t*, get_Device_Buffer(device, vpdBufferLength));
         bool fileOpened = false;
         if (!vpdBuffer)
         {
@@ -1420,7 +1412,7 @@ int get_SCSI_VPD(tDevice *device, uint8_t pageCode, char *logName, char *fileExt
                     }
                     fclose(fp_vpd);
                     fileOpened = false;
-                    safe_Free_aligned(vpdBuffer)
+                    safe_Release_Device_Buffer(device, vpdBuffer, vpdBufferLength)
                     return ERROR_WRITING_FILE;
                 }
             }
@@ -1432,6 +1424,7 @@ int get_SCSI_VPD(tDevice *device, uint8_t pageCode, char *logName, char *fileExt
                 }
                 else
                 {
+                    safe_Release_Device_Buffer(device, vpdBuffer, vpdBufferLength)
                     return BAD_PARAMETER;
                 }
             }
@@ -1446,13 +1439,13 @@ int get_SCSI_VPD(tDevice *device, uint8_t pageCode, char *logName, char *fileExt
                 }
                 fclose(fp_vpd);
                 fileOpened = false;
-                safe_Free_aligned(vpdBuffer)
+                safe_Release_Device_Buffer(device, vpdBuffer, vpdBufferLength)
                 return ERROR_WRITING_FILE;
             }
             fclose(fp_vpd);
             fileOpened = false;
         }
-        safe_Free_aligned(vpdBuffer)
+        safe_Release_Device_Buffer(device, vpdBuffer, vpdBufferLength)
     }
     return ret;
 }
@@ -2256,7 +2249,7 @@ int print_Supported_Logs(tDevice *device, uint64_t flags)
 int print_Supported_SCSI_Logs(tDevice *device, uint64_t flags)
 { 
     int retStatus = NOT_SUPPORTED;
-    uint8_t *logBuffer = C_CAST(uint8_t*, calloc_aligned(LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint8_t *logBuffer = C_CAST(uint8_t*, get_Device_Buffer(device, LEGACY_DRIVE_SEC_SIZE));
     bool subpagesSupported = true;
     bool gotListOfPages = true;
     M_USE_UNUSED(flags);
@@ -2327,7 +2320,7 @@ int print_Supported_SCSI_Logs(tDevice *device, uint64_t flags)
     {
         printf("SCSI Logs not supported on this device.\n");
     }
-    safe_Free_aligned(logBuffer)
+    safe_Release_Device_Buffer(device, logBuffer, LEGACY_DRIVE_SEC_SIZE)
     return retStatus;
 }
 
@@ -2361,8 +2354,8 @@ static void format_print_ata_logs_info(uint16_t log, uint32_t logSize, bool smar
 int print_Supported_ATA_Logs(tDevice *device, uint64_t flags)
 {
     int retStatus = NOT_SUPPORTED;
-    uint8_t *gplLogBuffer = C_CAST(uint8_t*, calloc_aligned(LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
-    uint8_t *smartLogBuffer = C_CAST(uint8_t*, calloc_aligned(LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint8_t *gplLogBuffer = C_CAST(uint8_t*, get_Device_Buffer(device, LEGACY_DRIVE_SEC_SIZE));
+    uint8_t *smartLogBuffer = C_CAST(uint8_t*, get_Device_Buffer(device, LEGACY_DRIVE_SEC_SIZE));
     M_USE_UNUSED(flags);
     if (smartLogBuffer)
     {
@@ -2373,18 +2366,18 @@ int print_Supported_ATA_Logs(tDevice *device, uint64_t flags)
                 retStatus = ata_SMART_Read_Log(device, ATA_LOG_DIRECTORY, smartLogBuffer, 512);
                 if (retStatus != SUCCESS && retStatus != WARN_INVALID_CHECKSUM)
                 {
-                    safe_Free_aligned(smartLogBuffer)
+                    safe_Release_Device_Buffer(device, smartLogBuffer, LEGACY_DRIVE_SEC_SIZE)
                 }
             }
             else
             {
                 retStatus = NOT_SUPPORTED;
-                safe_Free_aligned(smartLogBuffer)
+                safe_Release_Device_Buffer(device, smartLogBuffer, LEGACY_DRIVE_SEC_SIZE)
             }
         }
         else
         {
-            safe_Free_aligned(smartLogBuffer)
+            safe_Release_Device_Buffer(device, smartLogBuffer, LEGACY_DRIVE_SEC_SIZE)
         }
     }
     if (gplLogBuffer)
@@ -2393,12 +2386,12 @@ int print_Supported_ATA_Logs(tDevice *device, uint64_t flags)
         {
             if (SUCCESS != send_ATA_Read_Log_Ext_Cmd(device, ATA_LOG_DIRECTORY, 0, gplLogBuffer, LEGACY_DRIVE_SEC_SIZE, 0))
             {
-                safe_Free_aligned(gplLogBuffer)
+                safe_Release_Device_Buffer(device, gplLogBuffer, LEGACY_DRIVE_SEC_SIZE)
             }
         }
         else
         {
-            safe_Free_aligned(gplLogBuffer)
+            safe_Release_Device_Buffer(device, gplLogBuffer, LEGACY_DRIVE_SEC_SIZE)
         }
     }
     if (gplLogBuffer || smartLogBuffer)
@@ -2543,8 +2536,8 @@ int print_Supported_ATA_Logs(tDevice *device, uint64_t flags)
                 format_print_ata_logs_info(log, M_Max(gplLogSize, smartLogSize), M_ToBool(smartLogSize), M_ToBool(gplLogSize), bug);
             }
         }
-        safe_Free_aligned(smartLogBuffer)
-        safe_Free_aligned(gplLogBuffer)
+        safe_Release_Device_Buffer(device, smartLogBuffer, LEGACY_DRIVE_SEC_SIZE)
+        safe_Release_Device_Buffer(device, gplLogBuffer, LEGACY_DRIVE_SEC_SIZE)
         retStatus = SUCCESS;//set success if we were able to get at least one of the log directories to use
         if (atLeastOneBug)
         {
@@ -2865,7 +2858,7 @@ int pull_Generic_Log(tDevice *device, uint8_t logNum, uint8_t subpage, eLogPullM
         	case PULL_LOG_RAW_MODE:
             	if (SUCCESS == get_ATA_Log_Size(device, logNum, &logSize, true, false))
             	{
-                	genericLogBuf = C_CAST(uint8_t*, calloc_aligned(logSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+                	genericLogBuf = C_CAST(uint8_t*, get_Device_Buffer(device, logSize));
                 	if (genericLogBuf)
                 	{
                     	retStatus = get_ATA_Log(device, logNum, NULL, NULL, true, false, true, genericLogBuf, logSize, NULL, transferSizeBytes,0);
@@ -2894,7 +2887,7 @@ int pull_Generic_Log(tDevice *device, uint8_t logNum, uint8_t subpage, eLogPullM
         case PULL_LOG_RAW_MODE:
             if (SUCCESS == get_SCSI_Log_Size(device, logNum, subpage, &logSize))
             {
-                genericLogBuf = C_CAST(uint8_t*, calloc_aligned(logSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+                genericLogBuf = C_CAST(uint8_t*, get_Device_Buffer(device, logSize));
                 if (genericLogBuf)
                 {
                     retStatus = get_SCSI_Log(device, logNum, subpage, NULL, NULL, true, genericLogBuf, logSize, NULL);
@@ -2919,7 +2912,7 @@ int pull_Generic_Log(tDevice *device, uint8_t logNum, uint8_t subpage, eLogPullM
     default:
         break;
     }
-    safe_Free_aligned(genericLogBuf)
+    safe_Release_Device_Buffer(device, genericLogBuf, logSize)
     return retStatus;
 }
 
@@ -2944,7 +2937,7 @@ int pull_Generic_Error_History(tDevice *device, uint8_t bufferID, eLogPullMode m
     case PULL_LOG_RAW_MODE:
         if (SUCCESS == get_SCSI_Error_History_Size(device, bufferID, &logSize, false, rb16))
         {
-            genericLogBuf = C_CAST(uint8_t*, calloc_aligned(logSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+            genericLogBuf = C_CAST(uint8_t*, get_Device_Buffer(device, logSize));
             if (genericLogBuf)
             {
                 retStatus = get_SCSI_Error_History(device, bufferID, NULL, false, rb16, NULL, true, genericLogBuf, logSize, NULL, transferSizeBytes, NULL);
@@ -2962,7 +2955,7 @@ int pull_Generic_Error_History(tDevice *device, uint8_t bufferID, eLogPullMode m
     default:
         break;
     }
-    safe_Free_aligned(genericLogBuf)
+    safe_Release_Device_Buffer(device, genericLogBuf, logSize)
     return retStatus;
 }
 
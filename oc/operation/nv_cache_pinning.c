@@ -0,0 +1,473 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file nv_cache_pinning.c
+// \brief This file defines the functions for tracking how often LBAs are accessed and pinning the most accessed ones in the NV cache of a hybrid drive
+
+#include "common.h"
+#include "nv_cache_pinning.h"
+
+#define NV_CACHE_RANGE_ENTRIES_PER_BLOCK 64 //8 byte LBA range entries in each 512B block, same as a TRIM
+#define NV_CACHE_MAX_DATA_BLOCKS 8 //512B blocks sent per add/remove command
+#define NV_CACHE_MAX_PINNED_SET_BLOCKS 1024 //limit on blocks read back with query pinned set
+#define NV_CACHE_LOADED_EXTENT_HEAT 1 //heat given to extents that are already pinned when the map is created. The lowest heat that can still be selected.
+
+static uint32_t nv_Cache_Extent_Hash(uint64_t extent)
+{
+    //fibonacci hashing. Extents next to each other end up far apart in the table.
+    return C_CAST(uint32_t, (extent * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+}
+
+static uint64_t nv_Cache_Extent_Blocks(ptrNVCacheHeatMap heatMap, uint64_t extent)
+{
+    uint64_t startLBA = extent * heatMap->extentSize;
+    if (startLBA > heatMap->maxLBA)
+    {
+        return 0;
+    }
+    return M_Min(C_CAST(uint64_t, heatMap->extentSize), heatMap->maxLBA + 1 - startLBA);
+}
+
+static nvCacheExtent* insert_NV_Cache_Extent(nvCacheExtent *table, uint32_t tableSize, uint64_t extent)
+{
+    uint32_t slot = nv_Cache_Extent_Hash(extent) & (tableSize - 1);
+    while (table[slot].used && table[slot].extent != extent)
+    {
+        slot = (slot + 1) & (tableSize - 1);
+    }
+    return &table[slot];
+}
+
+//halves every extent's heat and drops the extents that reach zero, unless they are pinned. The table is rebuilt since entries cannot be removed in place with linear probing.
+static int decay_NV_Cache_Heat_Map(ptrNVCacheHeatMap heatMap)
+{
+    uint32_t slotIter = 0;
+    nvCacheExtent *newTable = C_CAST(nvCacheExtent*, calloc(heatMap->tableSize, sizeof(nvCacheExtent)));
+    if (!newTable)
+    {
+        return MEMORY_FAILURE;
+    }
+    heatMap->numberOfExtents = 0;
+    for (slotIter = 0; slotIter < heatMap->tableSize; ++slotIter)
+    {
+        nvCacheExtent *old = &heatMap->table[slotIter];
+        if (old->used)
+        {
+            old->heat >>= 1;
+            if (old->heat > 0 || old->pinned)
+            {
+                memcpy(insert_NV_Cache_Extent(newTable, heatMap->tableSize, old->extent), old, sizeof(nvCacheExtent));
+                ++heatMap->numberOfExtents;
+            }
+        }
+    }
+    safe_Free(heatMap->table)
+    heatMap->table = newTable;
+    ++heatMap->decays;
+    return SUCCESS;
+}
+
+static nvCacheExtent* get_NV_Cache_Extent(ptrNVCacheHeatMap heatMap, uint64_t extent)
+{
+    nvCacheExtent *entry = insert_NV_Cache_Extent(heatMap->table, heatMap->tableSize, extent);
+    if (!entry->used)
+    {
+        uint8_t decayCount = 0;
+        //pinned extents are never dropped, so stop trying once the counts would all be zero
+        while (heatMap->numberOfExtents >= heatMap->maxExtents && decayCount < 32)
+        {
+            if (SUCCESS != decay_NV_Cache_Heat_Map(heatMap))
+            {
+                return NULL;
+            }
+            ++decayCount;
+        }
+        if (heatMap->numberOfExtents >= heatMap->maxExtents)
+        {
+            return NULL;
+        }
+        entry = insert_NV_Cache_Extent(heatMap->table, heatMap->tableSize, extent);
+        entry->used = true;
+        entry->extent = extent;
+        ++heatMap->numberOfExtents;
+    }
+    return entry;
+}
+
+static void get_NV_Cache_Range_Entry(uint8_t *entry, uint64_t *lba, uint16_t *range)
+{
+    *lba = M_BytesTo8ByteValue(0, 0, entry[5], entry[4], entry[3], entry[2], entry[1], entry[0]);
+    *range = M_BytesTo2ByteValue(entry[7], entry[6]);
+}
+
+static void set_NV_Cache_Range_Entry(uint8_t *entry, uint64_t lba, uint16_t range)
+{
+    entry[0] = M_Byte0(lba);
+    entry[1] = M_Byte1(lba);
+    entry[2] = M_Byte2(lba);
+    entry[3] = M_Byte3(lba);
+    entry[4] = M_Byte4(lba);
+    entry[5] = M_Byte5(lba);
+    entry[6] = M_Byte0(range);
+    entry[7] = M_Byte1(range);
+}
+
+int create_NV_Cache_Heat_Map(tDevice *device, uint16_t extentSize, uint32_t maxExtents, ptrNVCacheHeatMap heatMap)
+{
+    uint64_t nvCacheSize = 0;
+    uint64_t pinnedSetBlocks = 0;
+    uint64_t blockIter = 0;
+    uint8_t *pinnedSet = NULL;
+    bool done = false;
+    if (!device || !heatMap)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(heatMap, 0, sizeof(nvCacheHeatMap));
+    if (device->drive_info.drive_type != ATA_DRIVE)
+    {
+        return NOT_SUPPORTED;
+    }
+    //words 215-216 are the NV cache size in logical blocks. Word 214 bit 4 is set when the NV cache feature set is enabled.
+    if (device->drive_info.IdentifyData.ata.Word214 == UINT16_MAX || !(device->drive_info.IdentifyData.ata.Word214 & BIT4))
+    {
+        return NOT_SUPPORTED;
+    }
+    nvCacheSize = M_WordsTo4ByteValue(device->drive_info.IdentifyData.ata.Word216, device->drive_info.IdentifyData.ata.Word215);
+    if (nvCacheSize == 0 || nvCacheSize == UINT32_MAX)
+    {
+        return NOT_SUPPORTED;
+    }
+    heatMap->extentSize = extentSize > 0 ? extentSize : NV_CACHE_HEAT_MAP_DEFAULT_EXTENT_SIZE;
+    heatMap->maxLBA = device->drive_info.deviceMaxLba;
+    heatMap->pinnedCapacity = nvCacheSize;
+    heatMap->hysteresisPercent = NV_CACHE_HEAT_MAP_DEFAULT_HYSTERESIS;
+    heatMap->maxExtents = maxExtents > 0 ? maxExtents : NV_CACHE_HEAT_MAP_DEFAULT_MAX_EXTENTS;
+    //make sure a full pinned set always fits with room left over for candidates
+    heatMap->maxExtents = C_CAST(uint32_t, M_Min(M_Max(C_CAST(uint64_t, heatMap->maxExtents), ((nvCacheSize / heatMap->extentSize) + 1) * 2), UINT64_C(0x40000000)));
+    heatMap->tableSize = 1;
+    while (heatMap->tableSize < heatMap->maxExtents * 2)
+    {
+        heatMap->tableSize <<= 1;
+    }
+    heatMap->table = C_CAST(nvCacheExtent*, calloc(heatMap->tableSize, sizeof(nvCacheExtent)));
+    pinnedSet = C_CAST(uint8_t*, calloc_aligned(LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!heatMap->table || !pinnedSet)
+    {
+        safe_Free_aligned(pinnedSet)
+        free_NV_Cache_Heat_Map(heatMap);
+        return MEMORY_FAILURE;
+    }
+    //read back what is already pinned, one block at a time until an empty entry
+    pinnedSetBlocks = M_Min((nvCacheSize / heatMap->extentSize) / NV_CACHE_RANGE_ENTRIES_PER_BLOCK + 1, C_CAST(uint64_t, NV_CACHE_MAX_PINNED_SET_BLOCKS));
+    for (blockIter = 0; !done && blockIter < pinnedSetBlocks; ++blockIter)
+    {
+        uint16_t entryIter = 0;
+        memset(pinnedSet, 0, LEGACY_DRIVE_SEC_SIZE);
+        if (SUCCESS != ata_NV_Query_Pinned_Set(device, blockIter, pinnedSet, LEGACY_DRIVE_SEC_SIZE))
+        {
+            break;
+        }
+        for (entryIter = 0; entryIter < NV_CACHE_RANGE_ENTRIES_PER_BLOCK; ++entryIter)
+        {
+            uint64_t lba = 0;
+            uint16_t range = 0;
+            uint64_t extent = 0;
+            get_NV_Cache_Range_Entry(&pinnedSet[entryIter * 8], &lba, &range);
+            if (range == 0)
+            {
+                done = true;
+                break;
+            }
+            for (extent = lba / heatMap->extentSize; extent <= (lba + range - 1) / heatMap->extentSize; ++extent)
+            {
+                nvCacheExtent *entry = get_NV_Cache_Extent(heatMap, extent);
+                if (entry && !entry->pinned)
+                {
+                    //the heat from the earlier run is not known. With none, the first update would unpin everything before any accesses are recorded.
+                    entry->pinned = true;
+                    entry->heat = M_Max(entry->heat, C_CAST(uint32_t, NV_CACHE_LOADED_EXTENT_HEAT));
+                    heatMap->pinnedBlocks += nv_Cache_Extent_Blocks(heatMap, extent);
+                }
+            }
+        }
+    }
+    safe_Free_aligned(pinnedSet)
+    return SUCCESS;
+}
+
+int record_NV_Cache_Access(ptrNVCacheHeatMap heatMap, uint64_t lba, uint64_t count)
+{
+    uint64_t extent = 0;
+    uint64_t lastExtent = 0;
+    if (!heatMap || !heatMap->table || count == 0 || lba > heatMap->maxLBA)
+    {
+        return BAD_PARAMETER;
+    }
+    lastExtent = M_Min(lba + count - 1, heatMap->maxLBA) / heatMap->extentSize;
+    for (extent = lba / heatMap->extentSize; extent <= lastExtent; ++extent)
+    {
+        nvCacheExtent *entry = get_NV_Cache_Extent(heatMap, extent);
+        if (entry && entry->heat < UINT32_MAX)
+        {
+            ++entry->heat;
+        }
+    }
+    return SUCCESS;
+}
+
+int read_NV_Cache_Access_Trace(ptrNVCacheHeatMap heatMap, const char *traceFile, uint64_t *accessesRead)
+{
+    FILE *trace = NULL;
+    char line[256] = { 0 };
+    uint64_t accesses = 0;
+    if (!heatMap || !traceFile)
+    {
+        return BAD_PARAMETER;
+    }
+    trace = fopen(traceFile, "r");
+    if (!trace)
+    {
+        return FILE_OPEN_ERROR;
+    }
+    while (fgets(line, sizeof(line), trace))
+    {
+        unsigned long long lba = 0;
+        unsigned long long count = 0;
+        if (2 == sscanf(line, "%llu %llu", &lba, &count) && SUCCESS == record_NV_Cache_Access(heatMap, C_CAST(uint64_t, lba), C_CAST(uint64_t, count)))
+        {
+            ++accesses;
+        }
+    }
+    fclose(trace);
+    if (accessesRead)
+    {
+        *accessesRead = accesses;
+    }
+    return SUCCESS;
+}
+
+int record_NV_Cache_Misses(tDevice *device, ptrNVCacheHeatMap heatMap, uint32_t *rangesRead)
+{
+    int ret = SUCCESS;
+    uint8_t *misses = NULL;
+    uint16_t entryIter = 0;
+    uint32_t ranges = 0;
+    if (!device || !heatMap)
+    {
+        return BAD_PARAMETER;
+    }
+    misses = C_CAST(uint8_t*, calloc_aligned(LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!misses)
+    {
+        return MEMORY_FAILURE;
+    }
+    ret = ata_NV_Query_Misses(device, misses);
+    if (ret == SUCCESS)
+    {
+        for (entryIter = 0; entryIter < NV_CACHE_RANGE_ENTRIES_PER_BLOCK; ++entryIter)
+        {
+            uint64_t lba = 0;
+            uint16_t range = 0;
+            get_NV_Cache_Range_Entry(&misses[entryIter * 8], &lba, &range);
+            if (range > 0 && SUCCESS == record_NV_Cache_Access(heatMap, lba, range))
+            {
+                ++ranges;
+            }
+        }
+    }
+    safe_Free_aligned(misses)
+    if (rangesRead)
+    {
+        *rangesRead = ranges;
+    }
+    return ret;
+}
+
+typedef struct _nvCacheCandidate
+{
+    nvCacheExtent *entry;
+    uint64_t score;
+    bool selected;
+}nvCacheCandidate;
+
+static int compare_NV_Cache_Candidate(const void *first, const void *second)
+{
+    const nvCacheCandidate *a = C_CAST(const nvCacheCandidate*, first);
+    const nvCacheCandidate *b = C_CAST(const nvCacheCandidate*, second);
+    //hottest first
+    if (a->score > b->score)
+    {
+        return -1;
+    }
+    else if (a->score < b->score)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+//Sends one add or remove command for a list of candidates, one range entry per extent, and updates the map once the drive accepts it.
+static int send_NV_Cache_Pinned_Set_Change(tDevice *device, ptrNVCacheHeatMap heatMap, bool addToSet, bool populateImmediately, nvCacheCandidate **changes, uint32_t numberOfChanges, uint8_t *dataBuf)
+{
+    int ret = SUCCESS;
+    uint32_t changeIter = 0;
+    uint32_t dataBlocks = (numberOfChanges + NV_CACHE_RANGE_ENTRIES_PER_BLOCK - 1) / NV_CACHE_RANGE_ENTRIES_PER_BLOCK;
+    memset(dataBuf, 0, dataBlocks * LEGACY_DRIVE_SEC_SIZE);
+    for (changeIter = 0; changeIter < numberOfChanges; ++changeIter)
+    {
+        uint64_t extent = changes[changeIter]->entry->extent;
+        set_NV_Cache_Range_Entry(&dataBuf[changeIter * 8], extent * heatMap->extentSize, C_CAST(uint16_t, nv_Cache_Extent_Blocks(heatMap, extent)));
+    }
+    if (addToSet)
+    {
+        ret = ata_NV_Cache_Add_LBAs_To_Cache(device, populateImmediately, dataBuf, dataBlocks * LEGACY_DRIVE_SEC_SIZE);
+    }
+    else
+    {
+        ret = ata_NV_Remove_LBAs_From_Cache(device, false, dataBuf, dataBlocks * LEGACY_DRIVE_SEC_SIZE);
+    }
+    if (ret == SUCCESS)
+    {
+        for (changeIter = 0; changeIter < numberOfChanges; ++changeIter)
+        {
+            nvCacheExtent *entry = changes[changeIter]->entry;
+            entry->pinned = addToSet;
+            if (addToSet)
+            {
+                heatMap->pinnedBlocks += nv_Cache_Extent_Blocks(heatMap, entry->extent);
+            }
+            else
+            {
+                heatMap->pinnedBlocks -= M_Min(nv_Cache_Extent_Blocks(heatMap, entry->extent), heatMap->pinnedBlocks);
+            }
+        }
+    }
+    return ret;
+}
+
+int update_NV_Cache_Pinned_Set(tDevice *device, ptrNVCacheHeatMap heatMap, bool populateImmediately, ptrNVCachePinningResult result)
+{
+    int ret = SUCCESS;
+    nvCacheCandidate *candidates = NULL;
+    nvCacheCandidate **changes = NULL;
+    uint8_t *dataBuf = NULL;
+    uint32_t numberOfCandidates = 0;
+    uint32_t slotIter = 0;
+    uint32_t candidateIter = 0;
+    uint64_t capacityLeft = 0;
+    uint8_t pass = 0;
+    if (!device || !heatMap || !heatMap->table)
+    {
+        return BAD_PARAMETER;
+    }
+    if (result)
+    {
+        memset(result, 0, sizeof(nvCachePinningResult));
+    }
+    candidates = C_CAST(nvCacheCandidate*, calloc(M_Max(heatMap->numberOfExtents, UINT32_C(1)), sizeof(nvCacheCandidate)));
+    changes = C_CAST(nvCacheCandidate**, calloc(NV_CACHE_RANGE_ENTRIES_PER_BLOCK * NV_CACHE_MAX_DATA_BLOCKS, sizeof(nvCacheCandidate*)));
+    dataBuf = C_CAST(uint8_t*, calloc_aligned(NV_CACHE_MAX_DATA_BLOCKS * LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!candidates || !changes || !dataBuf)
+    {
+        safe_Free(candidates)
+        safe_Free(changes)
+        safe_Free_aligned(dataBuf)
+        return MEMORY_FAILURE;
+    }
+    for (slotIter = 0; slotIter < heatMap->tableSize && numberOfCandidates < heatMap->numberOfExtents; ++slotIter)
+    {
+        nvCacheExtent *entry = &heatMap->table[slotIter];
+        if (entry->used && (entry->heat > 0 || entry->pinned))
+        {
+            candidates[numberOfCandidates].entry = entry;
+            candidates[numberOfCandidates].score = entry->heat;
+            if (entry->pinned)
+            {
+                candidates[numberOfCandidates].score += (C_CAST(uint64_t, entry->heat) * heatMap->hysteresisPercent) / 100;
+            }
+            ++numberOfCandidates;
+        }
+    }
+    qsort(candidates, numberOfCandidates, sizeof(nvCacheCandidate), compare_NV_Cache_Candidate);
+    capacityLeft = heatMap->pinnedCapacity;
+    for (candidateIter = 0; candidateIter < numberOfCandidates; ++candidateIter)
+    {
+        uint64_t blocks = nv_Cache_Extent_Blocks(heatMap, candidates[candidateIter].entry->extent);
+        if (candidates[candidateIter].score > 0 && blocks > 0 && blocks <= capacityLeft)
+        {
+            candidates[candidateIter].selected = true;
+            capacityLeft -= blocks;
+        }
+    }
+    //pass 0 removes what went cold to make room, pass 1 adds what became hot
+    for (pass = 0; ret == SUCCESS && pass < 2; ++pass)
+    {
+        bool addToSet = pass == 1;
+        uint32_t numberOfChanges = 0;
+        for (candidateIter = 0; ret == SUCCESS && candidateIter <= numberOfCandidates; ++candidateIter)
+        {
+            if (candidateIter < numberOfCandidates)
+            {
+                nvCacheCandidate *candidate = &candidates[candidateIter];
+                if (candidate->selected && candidate->entry->pinned)
+                {
+                    if (result && addToSet)
+                    {
+                        ++result->extentsKept;
+                    }
+                    continue;
+                }
+                if (candidate->selected != addToSet || candidate->entry->pinned == addToSet)
+                {
+                    continue;
+                }
+                changes[numberOfChanges] = candidate;
+                ++numberOfChanges;
+            }
+            //send when the buffer is full or at the end of the list
+            if (numberOfChanges > 0 && (numberOfChanges == NV_CACHE_RANGE_ENTRIES_PER_BLOCK * NV_CACHE_MAX_DATA_BLOCKS || candidateIter == numberOfCandidates))
+            {
+                ret = send_NV_Cache_Pinned_Set_Change(device, heatMap, addToSet, populateImmediately, changes, numberOfChanges, dataBuf);
+                if (ret == SUCCESS && result)
+                {
+                    if (addToSet)
+                    {
+                        result->extentsPinned += numberOfChanges;
+                    }
+                    else
+                    {
+                        result->extentsUnpinned += numberOfChanges;
+                    }
+                }
+                numberOfChanges = 0;
+            }
+        }
+    }
+    if (result)
+    {
+        result->pinnedBlocks = heatMap->pinnedBlocks;
+    }
+    safe_Free(candidates)
+    safe_Free(changes)
+    safe_Free_aligned(dataBuf)
+    return ret;
+}
+
+void free_NV_Cache_Heat_Map(ptrNVCacheHeatMap heatMap)
+{
+    if (heatMap)
+    {
+        safe_Free(heatMap->table)
+        heatMap->numberOfExtents = 0;
+        heatMap->tableSize = 0;
+    }
+}
@@ -0,0 +1,410 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file nvme_namespaces.c
+// \brief This file defines the functions for running the same operation on every namespace of an NVMe controller at the same time
+
+#if !defined(DISABLE_NVME_PASSTHROUGH)
+#include "common.h"
+#include "nvme_namespaces.h"
+#include "generic_tests.h"
+#include "trim_unmap.h"
+#include "platform_helper.h"
+
+int get_NVMe_Active_Namespace_List(tDevice *device, ptrNVMeNamespaceList namespaces)
+{
+    int ret = SUCCESS;
+    uint8_t *namespaceListData = NULL;
+    uint32_t offset = 0;
+    if (!device || !namespaces)
+    {
+        return BAD_PARAMETER;
+    }
+    if (device->drive_info.drive_type != NVME_DRIVE)
+    {
+        return NOT_SUPPORTED;
+    }
+    memset(namespaces, 0, sizeof(nvmeNamespaceList));
+    namespaceListData = C_CAST(uint8_t*, get_Device_Buffer(device, NVME_IDENTIFY_DATA_LEN));
+    if (!namespaceListData)
+    {
+        return MEMORY_FAILURE;
+    }
+    //namespace ID 0 asks for every active namespace ID above 0
+    ret = nvme_Identify(device, namespaceListData, 0, NVME_IDENTIFY_ALL_ACTIVE_NS);
+    if (ret == SUCCESS)
+    {
+        for (offset = 0; offset < NVME_IDENTIFY_DATA_LEN && namespaces->numberOfNamespaces < NVME_MAX_NAMESPACE_LIST; offset += 4)
+        {
+            uint32_t namespaceID = M_BytesTo4ByteValue(namespaceListData[offset + 3], namespaceListData[offset + 2], namespaceListData[offset + 1], namespaceListData[offset + 0]);
+            if (namespaceID == 0)
+            {
+                //the list ends at the first unused entry
+                break;
+            }
+            namespaces->namespaceIDs[namespaces->numberOfNamespaces] = namespaceID;
+            ++namespaces->numberOfNamespaces;
+        }
+    }
+    else if (device->drive_info.IdentifyData.nvme.ctrl.nn > 0)
+    {
+        //NVMe 1.0 controllers do not have the list (VER is reserved in 1.0, so it reads as 0) and reject it as an invalid field, but their namespaces
+        //are numbered 1 through NN. Some may not be active, and will fail when used. Any other error is returned since the controller should have the list.
+        bool doNotRetry = false, more = false;
+        uint8_t statusCodeType = 0, statusCode = 0;
+        uint16_t majorVersion = M_Word1(device->drive_info.IdentifyData.nvme.ctrl.ver);
+        uint8_t minorVersion = M_Byte1(device->drive_info.IdentifyData.nvme.ctrl.ver);
+        get_NVMe_Status_Fields_From_DWord(device->drive_info.lastNVMeResult.lastNVMeStatus, &doNotRetry, &more, &statusCodeType, &statusCode);
+        if ((majorVersion < 1 || (majorVersion == 1 && minorVersion < 1))
+            || (statusCodeType == NVME_SCT_GENERIC_COMMAND_STATUS && statusCode == NVME_GEN_SC_INVALID_FIELD_))
+        {
+            uint32_t namespaceID = 0;
+            for (namespaceID = 1; namespaceID <= device->drive_info.IdentifyData.nvme.ctrl.nn && namespaces->numberOfNamespaces < NVME_MAX_NAMESPACE_LIST; ++namespaceID)
+            {
+                namespaces->namespaceIDs[namespaces->numberOfNamespaces] = namespaceID;
+                ++namespaces->numberOfNamespaces;
+            }
+            ret = SUCCESS;
+        }
+    }
+    safe_Release_Device_Buffer(device, namespaceListData, NVME_IDENTIFY_DATA_LEN)
+    return ret;
+}
+
+typedef struct _nvmeNamespaceJobs
+{
+    tDevice *device;
+    ptrNVMeNamespaceList namespaces;
+    nvmeNamespaceRoutine routine;
+    void *context;
+    bool ioCommands;
+    ptrNVMeNamespaceResults results;
+    seaMutex mutex;
+    uint32_t nextNamespace;//index of the next namespace for a worker to take. Protected by mutex.
+}nvmeNamespaceJobs, *ptrNVMeNamespaceJobs;
+
+//Gets a device for one namespace. ownHandle is set when a new handle was opened that must be closed, otherwise the device is a clone.
+static int open_NVMe_Namespace_Device(tDevice *device, uint32_t namespaceID, bool ioCommands, tDevice **namespaceDevice, bool *ownHandle)
+{
+    int ret = SUCCESS;
+    nvmeIDNameSpaces *nsData = NULL;
+    *ownHandle = false;
+    if (ioCommands && namespaceID != device->drive_info.namespaceID)
+    {
+#if defined (__linux__) && !defined(VMK_CROSS_COMP) && !defined(UEFI_C_SOURCE)
+        char handle[OS_HANDLE_NAME_MAX_LENGTH] = { 0 };
+        ret = get_NVMe_Namespace_Handle(device, namespaceID, handle, OS_HANDLE_NAME_MAX_LENGTH);
+        if (ret != SUCCESS)
+        {
+            return ret;
+        }
+        *namespaceDevice = C_CAST(tDevice*, calloc(1, sizeof(tDevice)));
+        if (!*namespaceDevice)
+        {
+            return MEMORY_FAILURE;
+        }
+        (*namespaceDevice)->sanity.size = sizeof(tDevice);
+        (*namespaceDevice)->sanity.version = DEVICE_BLOCK_VERSION;
+        (*namespaceDevice)->dFlags = device->dFlags;
+        (*namespaceDevice)->deviceVerbosity = device->deviceVerbosity;
+        ret = get_Device(handle, *namespaceDevice);
+        if (ret != SUCCESS)
+        {
+            safe_Free(*namespaceDevice)
+        }
+        else
+        {
+            *ownHandle = true;
+        }
+        return ret;
+#else
+        //no way to find another namespace's handle on this OS yet
+        return NOT_SUPPORTED;
+#endif
+    }
+    *namespaceDevice = clone_Device_For_Thread(device);
+    if (!*namespaceDevice)
+    {
+        return MEMORY_FAILURE;
+    }
+    if (namespaceID == device->drive_info.namespaceID)
+    {
+        return SUCCESS;
+    }
+    //Admin commands carry the namespace ID, so they can go through the same handle. Only what discovery read for the namespace has to change.
+    (*namespaceDevice)->drive_info.namespaceID = namespaceID;
+    (*namespaceDevice)->drive_info.pageCache = NULL;//cached pages belong to the original namespace
+    invalidate_Capability_Cache(*namespaceDevice);
+    nsData = &(*namespaceDevice)->drive_info.IdentifyData.nvme.ns;
+    ret = nvme_Identify(*namespaceDevice, C_CAST(uint8_t*, nsData), namespaceID, NVME_IDENTIFY_NS);
+    if (ret == SUCCESS)
+    {
+        (*namespaceDevice)->drive_info.deviceBlockSize = C_CAST(uint32_t, power_Of_Two(nsData->lbaf[M_GETBITRANGE(nsData->flbas, 3, 0)].lbaDS));
+        (*namespaceDevice)->drive_info.devicePhyBlockSize = (*namespaceDevice)->drive_info.deviceBlockSize;
+        (*namespaceDevice)->drive_info.deviceMaxLba = nsData->nsze - 1;
+    }
+    else
+    {
+        free_Device_Clone(namespaceDevice);
+    }
+    return ret;
+}
+
+//Each worker takes the next namespace in the list until none are left, so the number of threads can be lower than the number of namespaces.
+static void nvme_Namespace_Worker(void *context)
+{
+    ptrNVMeNamespaceJobs jobs = C_CAST(ptrNVMeNamespaceJobs, context);
+    while (true)
+    {
+        uint32_t namespaceIndex = 0;
+        tDevice *namespaceDevice = NULL;
+        bool ownHandle = false;
+        seatimer_t namespaceTimer;
+        nvmeNamespaceResult *result = NULL;
+        lock_Mutex(jobs->mutex);
+        namespaceIndex = jobs->nextNamespace;
+        if (namespaceIndex < jobs->namespaces->numberOfNamespaces)
+        {
+            ++jobs->nextNamespace;
+        }
+        unlock_Mutex(jobs->mutex);
+        if (namespaceIndex >= jobs->namespaces->numberOfNamespaces)
+        {
+            break;
+        }
+        result = &jobs->results->namespaces[namespaceIndex];
+        memset(&namespaceTimer, 0, sizeof(seatimer_t));
+        start_Timer(&namespaceTimer);
+        result->result = open_NVMe_Namespace_Device(jobs->device, result->namespaceID, jobs->ioCommands, &namespaceDevice, &ownHandle);
+        if (result->result == SUCCESS)
+        {
+            result->result = jobs->routine(namespaceDevice, namespaceIndex, jobs->context);
+            if (ownHandle)
+            {
+                close_Device(namespaceDevice);
+                safe_Free(namespaceDevice)
+            }
+            else
+            {
+                free_Device_Clone(&namespaceDevice);
+            }
+        }
+        stop_Timer(&namespaceTimer);
+        result->timeNanoSeconds = get_Nano_Seconds(namespaceTimer);
+    }
+}
+
+int run_On_NVMe_Namespaces(tDevice *device, ptrNVMeNamespaceList namespaces, nvmeNamespaceRoutine routine, void *context, bool ioCommands, uint32_t maxThreads, ptrNVMeNamespaceResults results)
+{
+    int ret = SUCCESS;
+    ptrNVMeNamespaceList activeNamespaces = NULL;
+    nvmeNamespaceJobs jobs;
+    seaThread *threads = NULL;
+    uint32_t numberOfThreads = maxThreads > 0 ? maxThreads : NVME_NAMESPACE_DEFAULT_THREADS;
+    uint32_t iter = 0;
+    seatimer_t totalTimer;
+    if (!device || !routine || !results || (namespaces && namespaces->numberOfNamespaces > NVME_MAX_NAMESPACE_LIST))
+    {
+        return BAD_PARAMETER;
+    }
+    if (device->drive_info.drive_type != NVME_DRIVE)
+    {
+        return NOT_SUPPORTED;
+    }
+    memset(results, 0, sizeof(nvmeNamespaceResults));
+    if (!namespaces)
+    {
+        activeNamespaces = C_CAST(ptrNVMeNamespaceList, calloc(1, sizeof(nvmeNamespaceList)));
+        if (!activeNamespaces)
+        {
+            return MEMORY_FAILURE;
+        }
+        ret = get_NVMe_Active_Namespace_List(device, activeNamespaces);
+        if (ret != SUCCESS)
+        {
+            safe_Free(activeNamespaces)
+            return ret;
+        }
+        namespaces = activeNamespaces;
+    }
+    results->numberOfNamespaces = namespaces->numberOfNamespaces;
+    for (iter = 0; iter < namespaces->numberOfNamespaces; ++iter)
+    {
+        results->namespaces[iter].namespaceID = namespaces->namespaceIDs[iter];
+    }
+    numberOfThreads = M_Min(numberOfThreads, namespaces->numberOfNamespaces);
+    memset(&jobs, 0, sizeof(nvmeNamespaceJobs));
+    jobs.device = device;
+    jobs.namespaces = namespaces;
+    jobs.routine = routine;
+    jobs.context = context;
+    jobs.ioCommands = ioCommands;
+    jobs.results = results;
+    threads = C_CAST(seaThread*, calloc(M_Max(numberOfThreads, 1), sizeof(seaThread)));
+    if (!threads || SUCCESS != create_Mutex(&jobs.mutex))
+    {
+        safe_Free(threads)
+        safe_Free(activeNamespaces)
+        return MEMORY_FAILURE;
+    }
+    memset(&totalTimer, 0, sizeof(seatimer_t));
+    start_Timer(&totalTimer);
+    //this thread is also a worker, so only numberOfThreads - 1 more are started
+    for (iter = 1; iter < numberOfThreads; ++iter)
+    {
+        if (SUCCESS == create_Thread(&threads[iter], nvme_Namespace_Worker, &jobs))
+        {
+            results->ranInParallel = true;
+        }
+        else
+        {
+            //the workers that did start (or this thread) pick up the namespaces this one would have done
+            threads[iter] = NULL;
+        }
+    }
+    nvme_Namespace_Worker(&jobs);
+    for (iter = 1; iter < numberOfThreads; ++iter)
+    {
+        if (threads[iter])
+        {
+            join_Thread(&threads[iter]);
+        }
+    }
+    stop_Timer(&totalTimer);
+    results->totalTimeNanoSeconds = get_Nano_Seconds(totalTimer);
+    for (iter = 0; iter < results->numberOfNamespaces; ++iter)
+    {
+        switch (results->namespaces[iter].result)
+        {
+        case SUCCESS:
+            ++results->namespacesPassed;
+            break;
+        case NOT_SUPPORTED:
+            ++results->namespacesNotSupported;
+            break;
+        default:
+            ++results->namespacesFailed;
+            break;
+        }
+    }
+    if (results->namespacesPassed != results->numberOfNamespaces)
+    {
+        ret = FAILURE;
+    }
+    destroy_Mutex(&jobs.mutex);
+    safe_Free(threads)
+    safe_Free(activeNamespaces)
+    return ret;
+}
+
+static int nvme_Namespace_Format(tDevice *namespaceDevice, M_ATTR_UNUSED uint32_t namespaceIndex, void *context)
+{
+    runNVMFormatParameters nvmParams = *C_CAST(runNVMFormatParameters*, context);
+    nvmParams.currentNamespace = true;
+    //progress is not polled since the namespaces would all be printing at once. The format command itself does not complete until the format is done on most controllers.
+    return run_NVMe_Format(namespaceDevice, nvmParams, false);
+}
+
+int run_NVMe_Format_On_Namespaces(tDevice *device, ptrNVMeNamespaceList namespaces, runNVMFormatParameters nvmParams, uint32_t maxThreads, ptrNVMeNamespaceResults results)
+{
+    int ret = SUCCESS;
+    uint32_t iter = 0;
+    if (!device || !results)
+    {
+        return BAD_PARAMETER;
+    }
+    if (device->drive_info.drive_type != NVME_DRIVE)
+    {
+        return NOT_SUPPORTED;
+    }
+    //FNA bit 0: a format applies to every namespace. Bit 1: a secure erase applies to every namespace.
+    if ((device->drive_info.IdentifyData.nvme.ctrl.fna & BIT0)
+        || (nvmParams.secureEraseSettings != NVM_FMT_SE_NO_SECURE_ERASE_REQUESTED && (device->drive_info.IdentifyData.nvme.ctrl.fna & BIT1)))
+    {
+        return NOT_SUPPORTED;
+    }
+    ret = run_On_NVMe_Namespaces(device, namespaces, nvme_Namespace_Format, &nvmParams, false, maxThreads, results);
+    if (ret == SUCCESS || ret == FAILURE)
+    {
+        //Each namespace is formatted through its own copy of the device, so if the caller's own namespace was formatted, its identify data, block size,
+        //max LBA and capability cache are still from before the format. Read them again.
+        for (iter = 0; iter < results->numberOfNamespaces; ++iter)
+        {
+            if (results->namespaces[iter].namespaceID == device->drive_info.namespaceID)
+            {
+                invalidate_Capability_Cache(device);
+                fill_In_NVMe_Device_Info(device);
+                break;
+            }
+        }
+    }
+    return ret;
+}
+
+typedef struct _nvmeNamespaceSmartLogs
+{
+    nvmeSmartLog *smartLogs;
+    uint32_t numberOfSmartLogs;
+}nvmeNamespaceSmartLogs;
+
+static int nvme_Namespace_SMART_Log(tDevice *namespaceDevice, uint32_t namespaceIndex, void *context)
+{
+    nvmeNamespaceSmartLogs *logs = C_CAST(nvmeNamespaceSmartLogs*, context);
+    if (namespaceIndex >= logs->numberOfSmartLogs)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&logs->smartLogs[namespaceIndex], 0, sizeof(nvmeSmartLog));
+    return nvme_Get_SMART_Log_Page(namespaceDevice, namespaceDevice->drive_info.namespaceID, C_CAST(uint8_t*, &logs->smartLogs[namespaceIndex]), sizeof(nvmeSmartLog));
+}
+
+int get_NVMe_SMART_Log_For_Namespaces(tDevice *device, ptrNVMeNamespaceList namespaces, nvmeSmartLog *smartLogs, uint32_t numberOfSmartLogs, uint32_t maxThreads, ptrNVMeNamespaceResults results)
+{
+    nvmeNamespaceSmartLogs logs;
+    if (!device || !smartLogs || !results || (namespaces && numberOfSmartLogs < namespaces->numberOfNamespaces))
+    {
+        return BAD_PARAMETER;
+    }
+    if (device->drive_info.drive_type != NVME_DRIVE)
+    {
+        return NOT_SUPPORTED;
+    }
+    //LPA bit 0: the controller keeps the SMART / health log for each namespace
+    if (!(device->drive_info.IdentifyData.nvme.ctrl.lpa & BIT0))
+    {
+        return NOT_SUPPORTED;
+    }
+    logs.smartLogs = smartLogs;
+    logs.numberOfSmartLogs = numberOfSmartLogs;
+    return run_On_NVMe_Namespaces(device, namespaces, nvme_Namespace_SMART_Log, &logs, false, maxThreads, results);
+}
+
+static int nvme_Namespace_Deallocate(tDevice *namespaceDevice, M_ATTR_UNUSED uint32_t namespaceIndex, M_ATTR_UNUSED void *context)
+{
+    return nvme_Deallocate_Range(namespaceDevice, 0, namespaceDevice->drive_info.deviceMaxLba + 1);
+}
+
+int nvme_Deallocate_Namespaces(tDevice *device, ptrNVMeNamespaceList namespaces, uint32_t maxThreads, ptrNVMeNamespaceResults results)
+{
+    return run_On_NVMe_Namespaces(device, namespaces, nvme_Namespace_Deallocate, NULL, true, maxThreads, results);
+}
+
+static int nvme_Namespace_Short_Read_Test(tDevice *namespaceDevice, M_ATTR_UNUSED uint32_t namespaceIndex, M_ATTR_UNUSED void *context)
+{
+    return short_Generic_Read_Test(namespaceDevice, NULL, NULL, true);
+}
+
+int short_Generic_Read_Test_On_Namespaces(tDevice *device, ptrNVMeNamespaceList namespaces, uint32_t maxThreads, ptrNVMeNamespaceResults results)
+{
+    return run_On_NVMe_Namespaces(device, namespaces, nvme_Namespace_Short_Read_Test, NULL, true, maxThreads, results);
+}
+
+#endif //DISABLE_NVME_PASSTHROUGH
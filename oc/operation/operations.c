@@ -696,7 +696,7 @@ int get_Supported_Erase_Methods(tDevice *device, eraseMethod const eraseMethodLi
     sanitizeFeaturesSupported sanitizeInfo;
     uint64_t maxNumberOfLogicalBlocksPerCommand = 0;
     bool formatUnitAdded = false;
-    bool isWriteSameSupported = is_Write_Same_Supported(device, 0, C_CAST(uint32_t, device->drive_info.deviceMaxLba), &maxNumberOfLogicalBlocksPerCommand);
+    bool isWriteSameSupported = is_Write_Same_Supported(device, 0, device->drive_info.deviceMaxLba + 1, &maxNumberOfLogicalBlocksPerCommand);
     bool isFormatUnitSupported = is_Format_Unit_Supported(device, NULL);
     eraseMethod * currentErase = C_CAST(eraseMethod*, eraseMethodList);
     if (!currentErase)
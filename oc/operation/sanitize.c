@@ -507,6 +507,11 @@ int run_Sanitize_Operation(tDevice *device, eSanitizeOperations sanitizeOperatio
     default:
         return NOT_SUPPORTED;
     }
+    if (ret == SUCCESS)
+    {
+        //sanitize can change reported capabilities, so read them from the device again next time they are needed
+        invalidate_Capability_Cache(device);
+    }
 
     if (pollForProgress && ret == SUCCESS)
     {
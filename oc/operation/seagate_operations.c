@@ -1681,6 +1681,10 @@ int seagate_Quick_Format(tDevice *device)
         os_Lock_Device(device);
         ret = ata_SMART_Command(device, ATA_SMART_EXEC_OFFLINE_IMM, 0xD3, NULL, 0, timeout, false, 0);
         os_Unlock_Device(device);
+        if (ret == SUCCESS)
+        {
+            invalidate_Capability_Cache(device);
+        }
     }
     return ret;
 }
@@ -27,7 +27,7 @@ int get_SMART_Attributes(tDevice *device, smartLogData * smartAttrs)
     {
         ataSMARTAttribute currentAttribute;
         uint16_t            smartIter = 0;
-        uint8_t *ATAdataBuffer = C_CAST(uint8_t *, calloc_aligned(LEGACY_DRIVE_SEC_SIZE, sizeof(uint8_t), device->os_info.minimumAlignment));
+        uint8_t *ATAdataBuffer = C_CAST(uint8_t *, get_Device_Buffer(device, LEGACY_DRIVE_SEC_SIZE));
         if (ATAdataBuffer == NULL)
         {
             perror("Calloc Failure!\n");
@@ -86,7 +86,7 @@ int get_SMART_Attributes(tDevice *device, smartLogData * smartAttrs)
                 }
             }
         }
-        safe_Free_aligned(ATAdataBuffer)
+        safe_Release_Device_Buffer(device, ATAdataBuffer, LEGACY_DRIVE_SEC_SIZE)
     }
     #if !defined(DISABLE_NVME_PASSTHROUGH)
     else if (device->drive_info.drive_type == NVME_DRIVE) 
@@ -1441,6 +1441,108 @@ int print_SMART_Attributes(tDevice *device, eSMARTAttrOutMode outputMode)
     return ret;
 }
 
+int write_SMART_Attributes(tDevice *device, ptrStructuredWriter writer)
+{
+    int ret = UNKNOWN;
+    smartLogData smartData;
+    if (!writer)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&smartData, 0, sizeof(smartLogData));
+    ret = get_SMART_Attributes(device, &smartData);
+    if (ret != SUCCESS)
+    {
+        return ret;
+    }
+    if (device->drive_info.drive_type == ATA_DRIVE)
+    {
+        char *attributeName = C_CAST(char *, calloc(MAX_ATTRIBUTE_NAME_LENGTH, sizeof(char)));
+        if (!attributeName)
+        {
+            return MEMORY_FAILURE;
+        }
+        begin_Structured_Array(writer, "SMART Attributes");
+        for (uint16_t iter = 0; iter < 256; ++iter)
+        {
+            ataSMARTValue *currentAttribute = &smartData.attributes.ataSMARTAttr.attributes[iter];
+            uint64_t rawValue = 0;
+            if (!currentAttribute->valid || currentAttribute->data.attributeNumber == 0)
+            {
+                continue;
+            }
+            memset(attributeName, 0, MAX_ATTRIBUTE_NAME_LENGTH);
+            get_Attribute_Name(device, C_CAST(uint8_t, iter), &attributeName);
+            for (uint8_t rawIter = 0; rawIter < 7; ++rawIter)
+            {
+                rawValue |= C_CAST(uint64_t, currentAttribute->data.rawData[rawIter]) << (8 * rawIter);
+            }
+            begin_Structured_Object(writer, NULL);
+            write_Structured_Unsigned(writer, "ID", currentAttribute->data.attributeNumber);
+            write_Structured_String(writer, "Name", attributeName[0] != '\0' ? attributeName : NULL);
+            write_Structured_Unsigned(writer, "Status", currentAttribute->data.status);
+            write_Structured_Bool(writer, "Pre-fail", currentAttribute->isWarrantied);
+            write_Structured_Unsigned(writer, "Nominal", currentAttribute->data.nominal);
+            write_Structured_Unsigned(writer, "Worst", currentAttribute->data.worstEver);
+            if (currentAttribute->thresholdDataValid)
+            {
+                write_Structured_Unsigned(writer, "Threshold", currentAttribute->thresholdData.thresholdValue);
+            }
+            else
+            {
+                write_Structured_String(writer, "Threshold", NULL);
+            }
+            write_Structured_Unsigned(writer, "Raw", rawValue);
+            end_Structured_Object(writer);
+        }
+        end_Structured_Array(writer);
+        safe_Free(attributeName)
+    }
+    #if !defined(DISABLE_NVME_PASSTHROUGH)
+    else if (device->drive_info.drive_type == NVME_DRIVE)
+    {
+        int64_t temperature = C_CAST(int64_t, M_BytesTo2ByteValue(smartData.attributes.nvmeSMARTAttr.temperature[1], smartData.attributes.nvmeSMARTAttr.temperature[0])) - 273;
+        begin_Structured_Object(writer, "SMART Attributes");
+        write_Structured_Unsigned(writer, "Critical Warnings", smartData.attributes.nvmeSMARTAttr.criticalWarning & 0x1F);
+        write_Structured_Signed(writer, "Temperature (C)", temperature);
+        write_Structured_Unsigned(writer, "Available Spare (%)", smartData.attributes.nvmeSMARTAttr.availSpare);
+        write_Structured_Unsigned(writer, "Available Spare Threshold (%)", smartData.attributes.nvmeSMARTAttr.spareThresh);
+        write_Structured_Unsigned(writer, "Percentage Used", smartData.attributes.nvmeSMARTAttr.percentUsed);
+        write_Structured_Double(writer, "Data Units Read", convert_128bit_to_double(smartData.attributes.nvmeSMARTAttr.dataUnitsRead));
+        write_Structured_Double(writer, "Data Units Written", convert_128bit_to_double(smartData.attributes.nvmeSMARTAttr.dataUnitsWritten));
+        write_Structured_Double(writer, "Host Read Commands", convert_128bit_to_double(smartData.attributes.nvmeSMARTAttr.hostReads));
+        write_Structured_Double(writer, "Host Write Commands", convert_128bit_to_double(smartData.attributes.nvmeSMARTAttr.hostWrites));
+        write_Structured_Double(writer, "Controller Busy Time", convert_128bit_to_double(smartData.attributes.nvmeSMARTAttr.ctrlBusyTime));
+        write_Structured_Double(writer, "Power Cycles", convert_128bit_to_double(smartData.attributes.nvmeSMARTAttr.powerCycles));
+        write_Structured_Double(writer, "Power On Hours", convert_128bit_to_double(smartData.attributes.nvmeSMARTAttr.powerOnHours));
+        write_Structured_Double(writer, "Unsafe Shutdowns", convert_128bit_to_double(smartData.attributes.nvmeSMARTAttr.unsafeShutdowns));
+        write_Structured_Double(writer, "Media Errors", convert_128bit_to_double(smartData.attributes.nvmeSMARTAttr.mediaErrors));
+        write_Structured_Double(writer, "Error Information Log Entries", convert_128bit_to_double(smartData.attributes.nvmeSMARTAttr.numErrLogEntries));
+        write_Structured_Unsigned(writer, "Warning Composite Temperature Time", smartData.attributes.nvmeSMARTAttr.warningTempTime);
+        write_Structured_Unsigned(writer, "Critical Composite Temperature Time", smartData.attributes.nvmeSMARTAttr.criticalCompTime);
+        begin_Structured_Array(writer, "Temperature Sensors (C)");
+        for (uint8_t temperatureSensorCount = 0; temperatureSensorCount < 8; temperatureSensorCount++)
+        {
+            if (smartData.attributes.nvmeSMARTAttr.tempSensor[temperatureSensorCount] != 0)
+            {
+                write_Structured_Signed(writer, NULL, C_CAST(int64_t, smartData.attributes.nvmeSMARTAttr.tempSensor[temperatureSensorCount]) - 273);
+            }
+        }
+        end_Structured_Array(writer);
+        write_Structured_Unsigned(writer, "Thermal Management T1 Trans Count", smartData.attributes.nvmeSMARTAttr.thermalMgmtTemp1TransCount);
+        write_Structured_Unsigned(writer, "Thermal Management T2 Trans Count", smartData.attributes.nvmeSMARTAttr.thermalMgmtTemp2TransCount);
+        write_Structured_Unsigned(writer, "Thermal Management T1 Total Time", smartData.attributes.nvmeSMARTAttr.totalTimeThermalMgmtTemp1);
+        write_Structured_Unsigned(writer, "Thermal Management T2 Total Time", smartData.attributes.nvmeSMARTAttr.totalTimeThermalMgmtTemp2);
+        end_Structured_Object(writer);
+    }
+    #endif
+    else
+    {
+        ret = NOT_SUPPORTED;
+    }
+    return ret;
+}
+
 bool is_SMART_Command_Transport_Supported(tDevice *device)
 {
     bool supported = false;
@@ -1987,7 +2089,7 @@ int scsi_SMART_Check(tDevice *device, ptrSmartTripInfo tripInfo)
     }
     if (sendRequestSense)
     {
-        uint8_t *senseData = C_CAST(uint8_t*, calloc_aligned(SPC3_SENSE_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+        uint8_t *senseData = C_CAST(uint8_t*, get_Device_Buffer(device, SPC3_SENSE_LEN));
         scsi_Request_Sense_Cmd(device, false, senseData, SPC3_SENSE_LEN);
         uint8_t senseKey = 0, asc = 0, ascq = 0, fru = 0;
         get_Sense_Key_ASC_ASCQ_FRU(senseData, SPC3_SENSE_LEN, &senseKey, &asc, &ascq, &fru);
@@ -2026,7 +2128,7 @@ int scsi_SMART_Check(tDevice *device, ptrSmartTripInfo tripInfo)
                 ret = UNKNOWN;
             }
         }
-        safe_Free_aligned(senseData)
+        safe_Release_Device_Buffer(device, senseData, SPC3_SENSE_LEN)
     }
     if (temporarilyEnableMRIEMode6)
     {
@@ -2149,6 +2251,10 @@ int run_SMART_Check(tDevice *device, ptrSmartTripInfo tripInfo)
 bool is_SMART_Enabled(tDevice *device)
 {
     bool enabled = false;
+    if (device->drive_info.capabilities.smartEnabledValid)
+    {
+        return device->drive_info.capabilities.smartEnabled;
+    }
     switch (device->drive_info.drive_type)
     {
     case ATA_DRIVE:
@@ -2167,7 +2273,7 @@ bool is_SMART_Enabled(tDevice *device)
     case SCSI_DRIVE:
     {
         //read the informational exceptions mode page and check MRIE value for something other than 0
-        uint8_t *infoExceptionsControl = C_CAST(uint8_t*, calloc_aligned(12 + MODE_PARAMETER_HEADER_10_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+        uint8_t *infoExceptionsControl = C_CAST(uint8_t*, get_Device_Buffer(device, 12 + MODE_PARAMETER_HEADER_10_LEN));
         if (!infoExceptionsControl)
         {
             perror("calloc failure for infoExceptionsControl");
@@ -2187,12 +2293,14 @@ bool is_SMART_Enabled(tDevice *device)
                 enabled = true;
             }
         }
-        safe_Free_aligned(infoExceptionsControl)
+        safe_Release_Device_Buffer(device, infoExceptionsControl, 12 + MODE_PARAMETER_HEADER_10_LEN)
     }
     break;
     default:
         break;
     }
+    device->drive_info.capabilities.smartEnabled = enabled;
+    device->drive_info.capabilities.smartEnabledValid = true;
     return enabled;
 }
 
@@ -2642,6 +2750,10 @@ int enable_Disable_SMART_Feature(tDevice *device, bool enable)
             {
                 ret = ata_SMART_Disable_Operations(device);
             }
+            if (ret == SUCCESS)
+            {
+                invalidate_Capability_Cache(device);
+            }
         }
     }
     else if (device->drive_info.drive_type == SCSI_DRIVE)
@@ -2715,7 +2827,7 @@ int get_SCSI_Informational_Exceptions_Info(tDevice *device, eScsiModePageControl
     //if logData is non-null, read the log page...do this first in case a mode select is being performed after this function call!
     if (logData)
     {
-        uint8_t *infoLogPage = C_CAST(uint8_t*, calloc_aligned(LP_INFORMATION_EXCEPTIONS_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+        uint8_t *infoLogPage = C_CAST(uint8_t*, get_Device_Buffer(device, LP_INFORMATION_EXCEPTIONS_LEN));
         if (infoLogPage)
         {
             if (SUCCESS == scsi_Log_Sense_Cmd(device, true, LPC_CUMULATIVE_VALUES, LP_INFORMATION_EXCEPTIONS, 0, 0, infoLogPage, LP_INFORMATION_EXCEPTIONS_LEN))
@@ -2731,11 +2843,11 @@ int get_SCSI_Informational_Exceptions_Info(tDevice *device, eScsiModePageControl
                     logData->mostRecentTemperatureReading = infoLogPage[10];
                 }
             }
-            safe_Free_aligned(infoLogPage)
+            safe_Release_Device_Buffer(device, infoLogPage, LP_INFORMATION_EXCEPTIONS_LEN)
         }
     }
     //read the mode page
-    uint8_t *infoControlPage = C_CAST(uint8_t*, calloc_aligned(MODE_PARAMETER_HEADER_10_LEN + MP_INFORMATION_EXCEPTIONS_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint8_t *infoControlPage = C_CAST(uint8_t*, get_Device_Buffer(device, MODE_PARAMETER_HEADER_10_LEN + MP_INFORMATION_EXCEPTIONS_LEN));
     if (infoControlPage)
     {
         bool gotData = false;
@@ -2771,7 +2883,7 @@ int get_SCSI_Informational_Exceptions_Info(tDevice *device, eScsiModePageControl
                 controlData->reportCount = M_BytesTo4ByteValue(infoControlPage[headerLength + 8], infoControlPage[headerLength + 9], infoControlPage[headerLength + 10], infoControlPage[headerLength + 11]);
             }
         }
-        safe_Free_aligned(infoControlPage)
+        safe_Release_Device_Buffer(device, infoControlPage, MODE_PARAMETER_HEADER_10_LEN + MP_INFORMATION_EXCEPTIONS_LEN)
     }
     return ret;
 }
@@ -2779,7 +2891,7 @@ int get_SCSI_Informational_Exceptions_Info(tDevice *device, eScsiModePageControl
 int set_SCSI_Informational_Exceptions_Info(tDevice *device, bool save, ptrInformationalExceptionsControl controlData)
 {
     int ret = SUCCESS;
-    uint8_t *infoControlPage = C_CAST(uint8_t*, calloc_aligned(MODE_PARAMETER_HEADER_10_LEN + MP_INFORMATION_EXCEPTIONS_LEN, sizeof(uint8_t), device->os_info.minimumAlignment));
+    uint8_t *infoControlPage = C_CAST(uint8_t*, get_Device_Buffer(device, MODE_PARAMETER_HEADER_10_LEN + MP_INFORMATION_EXCEPTIONS_LEN));
     if (!infoControlPage)
     {
         return MEMORY_FAILURE;
@@ -2862,7 +2974,12 @@ int set_SCSI_Informational_Exceptions_Info(tDevice *device, bool save, ptrInform
     {
         ret = scsi_Mode_Select_10(device, modePageDataOffset + MP_INFORMATION_EXCEPTIONS_LEN, true, save, false, infoControlPage, modePageDataOffset + MP_INFORMATION_EXCEPTIONS_LEN);
     }
-    safe_Free_aligned(infoControlPage)
+    if (ret == SUCCESS)
+    {
+        //MRIE controls whether SMART is reported as enabled, so the cached value is no longer valid
+        invalidate_Capability_Cache(device);
+    }
+    safe_Release_Device_Buffer(device, infoControlPage, MODE_PARAMETER_HEADER_10_LEN + MP_INFORMATION_EXCEPTIONS_LEN)
     return ret;
 }
 
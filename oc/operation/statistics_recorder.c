@@ -0,0 +1,697 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file statistics_recorder.c
+// \brief This file defines the functions for recording device counters over time into a compact binary file and reading them back by time range
+
+#include "common.h"
+#include "statistics_recorder.h"
+
+//File layout (all fixed size values are little endian):
+//  file header: signature, version, header length, serial number, model number, CRC32C of the header before it
+//  any number of blocks, each with:
+//      block header: magic, number of samples, number of columns, payload length, first timestamp, last timestamp, payload CRC32C, reserved, CRC32C of the block header before it
+//      payload (all values are LEB128 varints):
+//          number of columns, then the column keys in order, each stored as the difference from the previous key
+//          timestamps: the difference between each pair of samples, stored as a column (so a steady sample rate is stored as a single run)
+//          each column: first value, then the zigzag encoded change from the previous sample. A change of 0 is followed by how many samples in a row did not change.
+#define STATISTICS_RECORDING_SIGNATURE "SEASTATS"
+#define STATISTICS_RECORDING_SIGNATURE_LENGTH 8
+#define STATISTICS_RECORDING_SERIAL_LENGTH 24 //SERIAL_NUM_LEN + 1 rounded up to 4 bytes
+#define STATISTICS_RECORDING_MODEL_LENGTH 44 //MODEL_NUM_LEN + 1 rounded up to 4 bytes
+#define STATISTICS_RECORDING_HEADER_LENGTH (STATISTICS_RECORDING_SIGNATURE_LENGTH + 4 + 4 + STATISTICS_RECORDING_SERIAL_LENGTH + STATISTICS_RECORDING_MODEL_LENGTH + 4)
+#define STATISTICS_RECORDING_BLOCK_MAGIC UINT32_C(0x4B4C4253) //"SBLK"
+#define STATISTICS_RECORDING_BLOCK_HEADER_LENGTH 44
+#define STATISTICS_RECORDING_MAX_VARINT_LENGTH 10
+
+static void put_Recording_Uint32(uint8_t *buffer, size_t *offset, uint32_t value)
+{
+    buffer[(*offset)++] = M_Byte0(value);
+    buffer[(*offset)++] = M_Byte1(value);
+    buffer[(*offset)++] = M_Byte2(value);
+    buffer[(*offset)++] = M_Byte3(value);
+}
+
+static void put_Recording_Uint64(uint8_t *buffer, size_t *offset, uint64_t value)
+{
+    put_Recording_Uint32(buffer, offset, M_DoubleWord0(value));
+    put_Recording_Uint32(buffer, offset, M_DoubleWord1(value));
+}
+
+static uint32_t get_Recording_Uint32(const uint8_t *buffer, size_t offset)
+{
+    return M_BytesTo4ByteValue(buffer[offset + 3], buffer[offset + 2], buffer[offset + 1], buffer[offset]);
+}
+
+static uint64_t get_Recording_Uint64(const uint8_t *buffer, size_t offset)
+{
+    uint64_t low = get_Recording_Uint32(buffer, offset);
+    uint64_t high = get_Recording_Uint32(buffer, offset + 4);
+    return (high << 32) | low;
+}
+
+static void put_Varint(uint8_t *buffer, size_t *offset, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer[(*offset)++] = C_CAST(uint8_t, (value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    buffer[(*offset)++] = C_CAST(uint8_t, value);
+}
+
+static bool get_Varint(const uint8_t *buffer, size_t length, size_t *offset, uint64_t *value)
+{
+    uint8_t shift = 0;
+    *value = 0;
+    while (*offset < length && shift < 64)
+    {
+        uint8_t byte = buffer[(*offset)++];
+        *value |= C_CAST(uint64_t, byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+//Zigzag encoding keeps small negative changes (ex: temperature going down) small
+static uint64_t zigzag_Encode(uint64_t previous, uint64_t current)
+{
+    int64_t delta = C_CAST(int64_t, current - previous);
+    return (C_CAST(uint64_t, delta) << 1) ^ C_CAST(uint64_t, delta >> 63);
+}
+
+static uint64_t zigzag_Decode(uint64_t previous, uint64_t encoded)
+{
+    return previous + ((encoded >> 1) ^ (~(encoded & 1) + 1));
+}
+
+static void encode_Column(uint8_t *buffer, size_t *offset, const uint64_t *series, uint32_t count)
+{
+    uint32_t iter = 1;
+    if (count == 0)
+    {
+        return;
+    }
+    put_Varint(buffer, offset, series[0]);
+    while (iter < count)
+    {
+        if (series[iter] == series[iter - 1])
+        {
+            uint32_t run = 1;
+            while (iter + run < count && series[iter + run] == series[iter - 1])
+            {
+                ++run;
+            }
+            put_Varint(buffer, offset, 0);
+            put_Varint(buffer, offset, run);
+            iter += run;
+        }
+        else
+        {
+            put_Varint(buffer, offset, zigzag_Encode(series[iter - 1], series[iter]));
+            ++iter;
+        }
+    }
+}
+
+static bool decode_Column(const uint8_t *buffer, size_t length, size_t *offset, uint64_t *series, uint32_t count)
+{
+    uint32_t iter = 1;
+    if (count == 0)
+    {
+        return true;
+    }
+    if (!get_Varint(buffer, length, offset, &series[0]))
+    {
+        return false;
+    }
+    while (iter < count)
+    {
+        uint64_t encoded = 0;
+        if (!get_Varint(buffer, length, offset, &encoded))
+        {
+            return false;
+        }
+        if (encoded == 0)
+        {
+            uint64_t run = 0;
+            if (!get_Varint(buffer, length, offset, &run) || run == 0 || run > C_CAST(uint64_t, count - iter))
+            {
+                return false;
+            }
+            for (; run > 0; --run, ++iter)
+            {
+                series[iter] = series[iter - 1];
+            }
+        }
+        else
+        {
+            series[iter] = zigzag_Decode(series[iter - 1], encoded);
+            ++iter;
+        }
+    }
+    return true;
+}
+
+static bool is_Recording_Header_Valid(const uint8_t *header)
+{
+    return memcmp(header, STATISTICS_RECORDING_SIGNATURE, STATISTICS_RECORDING_SIGNATURE_LENGTH) == 0
+        && get_Recording_Uint32(header, STATISTICS_RECORDING_HEADER_LENGTH - 4) == crc32c(0, header, STATISTICS_RECORDING_HEADER_LENGTH - 4);
+}
+
+int open_Statistics_Recorder(tDevice *device, const char *recordingFile, uint32_t samplesPerBlock, ptrStatisticsRecorder recorder)
+{
+    uint8_t header[STATISTICS_RECORDING_HEADER_LENGTH] = { 0 };
+    bool newFile = true;
+    FILE *existing = NULL;
+    if (!device || !recordingFile || !recorder)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(recorder, 0, sizeof(statisticsRecorder));
+    recorder->samplesPerBlock = samplesPerBlock > 0 ? samplesPerBlock : STATISTICS_RECORDER_DEFAULT_SAMPLES_PER_BLOCK;
+    if ((existing = fopen(recordingFile, "rb")) != NULL)
+    {
+        size_t headerRead = fread(header, sizeof(uint8_t), STATISTICS_RECORDING_HEADER_LENGTH, existing);
+        fclose(existing);
+        if (headerRead > 0)
+        {
+            char serialNumber[STATISTICS_RECORDING_SERIAL_LENGTH] = { 0 };
+            if (headerRead != STATISTICS_RECORDING_HEADER_LENGTH || !is_Recording_Header_Valid(header))
+            {
+                return FILE_OPEN_ERROR;
+            }
+            if (get_Recording_Uint32(header, STATISTICS_RECORDING_SIGNATURE_LENGTH) > STATISTICS_RECORDING_VERSION)
+            {
+                return NOT_SUPPORTED;
+            }
+            //only add to files for this device
+            memcpy(serialNumber, &header[STATISTICS_RECORDING_SIGNATURE_LENGTH + 8], SERIAL_NUM_LEN);
+            if (strncmp(serialNumber, device->drive_info.serialNumber, SERIAL_NUM_LEN) != 0)
+            {
+                return BAD_PARAMETER;
+            }
+            newFile = false;
+        }
+    }
+    if ((recorder->file = fopen(recordingFile, "ab")) == NULL)
+    {
+        return FILE_OPEN_ERROR;
+    }
+    if (newFile)
+    {
+        size_t offset = 0;
+        memset(header, 0, STATISTICS_RECORDING_HEADER_LENGTH);
+        memcpy(header, STATISTICS_RECORDING_SIGNATURE, STATISTICS_RECORDING_SIGNATURE_LENGTH);
+        offset = STATISTICS_RECORDING_SIGNATURE_LENGTH;
+        put_Recording_Uint32(header, &offset, STATISTICS_RECORDING_VERSION);
+        put_Recording_Uint32(header, &offset, STATISTICS_RECORDING_HEADER_LENGTH);
+        memcpy(&header[offset], device->drive_info.serialNumber, M_Min(SERIAL_NUM_LEN, strlen(device->drive_info.serialNumber)));
+        offset += STATISTICS_RECORDING_SERIAL_LENGTH;
+        memcpy(&header[offset], device->drive_info.product_identification, M_Min(MODEL_NUM_LEN, strlen(device->drive_info.product_identification)));
+        offset += STATISTICS_RECORDING_MODEL_LENGTH;
+        put_Recording_Uint32(header, &offset, crc32c(0, header, offset));
+        if (fwrite(header, sizeof(uint8_t), STATISTICS_RECORDING_HEADER_LENGTH, recorder->file) != STATISTICS_RECORDING_HEADER_LENGTH || fflush(recorder->file) != 0)
+        {
+            fclose(recorder->file);
+            recorder->file = NULL;
+            return ERROR_WRITING_FILE;
+        }
+    }
+    recorder->timestamps = C_CAST(uint64_t*, calloc(recorder->samplesPerBlock, sizeof(uint64_t)));
+    if (!recorder->timestamps)
+    {
+        fclose(recorder->file);
+        recorder->file = NULL;
+        return MEMORY_FAILURE;
+    }
+    return SUCCESS;
+}
+
+int flush_Statistics_Recorder(ptrStatisticsRecorder recorder)
+{
+    int ret = SUCCESS;
+    uint8_t *block = NULL;
+    uint64_t *timestampDeltas = NULL;
+    size_t blockLength = 0;
+    size_t offset = STATISTICS_RECORDING_BLOCK_HEADER_LENGTH;
+    size_t headerOffset = 0;
+    uint32_t columnIter = 0;
+    uint32_t sampleIter = 0;
+    if (!recorder || !recorder->file)
+    {
+        return BAD_PARAMETER;
+    }
+    if (recorder->numberOfSamples == 0)
+    {
+        return SUCCESS;
+    }
+    //worst case is every value changing by a full 64 bits
+    blockLength = STATISTICS_RECORDING_BLOCK_HEADER_LENGTH + STATISTICS_RECORDING_MAX_VARINT_LENGTH * (C_CAST(size_t, recorder->numberOfColumns) + 1 + (C_CAST(size_t, recorder->numberOfColumns) + 1) * recorder->numberOfSamples);
+    block = C_CAST(uint8_t*, malloc(blockLength));
+    timestampDeltas = C_CAST(uint64_t*, calloc(recorder->numberOfSamples, sizeof(uint64_t)));
+    if (!block || !timestampDeltas)
+    {
+        safe_Free(block)
+        safe_Free(timestampDeltas)
+        return MEMORY_FAILURE;
+    }
+    put_Varint(block, &offset, recorder->numberOfColumns);
+    for (columnIter = 0; columnIter < recorder->numberOfColumns; ++columnIter)
+    {
+        put_Varint(block, &offset, recorder->columnKeys[columnIter] - (columnIter > 0 ? recorder->columnKeys[columnIter - 1] : 0));
+    }
+    for (sampleIter = 1; sampleIter < recorder->numberOfSamples; ++sampleIter)
+    {
+        timestampDeltas[sampleIter - 1] = recorder->timestamps[sampleIter] - recorder->timestamps[sampleIter - 1];
+    }
+    encode_Column(block, &offset, timestampDeltas, recorder->numberOfSamples - 1);
+    for (columnIter = 0; columnIter < recorder->numberOfColumns; ++columnIter)
+    {
+        encode_Column(block, &offset, &recorder->values[C_CAST(size_t, columnIter) * recorder->samplesPerBlock], recorder->numberOfSamples);
+    }
+    put_Recording_Uint32(block, &headerOffset, STATISTICS_RECORDING_BLOCK_MAGIC);
+    put_Recording_Uint32(block, &headerOffset, recorder->numberOfSamples);
+    put_Recording_Uint32(block, &headerOffset, recorder->numberOfColumns);
+    put_Recording_Uint32(block, &headerOffset, C_CAST(uint32_t, offset - STATISTICS_RECORDING_BLOCK_HEADER_LENGTH));
+    put_Recording_Uint64(block, &headerOffset, recorder->timestamps[0]);
+    put_Recording_Uint64(block, &headerOffset, recorder->timestamps[recorder->numberOfSamples - 1]);
+    put_Recording_Uint32(block, &headerOffset, crc32c(0, &block[STATISTICS_RECORDING_BLOCK_HEADER_LENGTH], offset - STATISTICS_RECORDING_BLOCK_HEADER_LENGTH));
+    put_Recording_Uint32(block, &headerOffset, 0);//reserved
+    put_Recording_Uint32(block, &headerOffset, crc32c(0, block, headerOffset));
+    if (fwrite(block, sizeof(uint8_t), offset, recorder->file) != offset || fflush(recorder->file) != 0)
+    {
+        ret = ERROR_WRITING_FILE;
+    }
+    else
+    {
+        recorder->numberOfSamples = 0;
+        ++(recorder->blocksWritten);
+    }
+    safe_Free(block)
+    safe_Free(timestampDeltas)
+    return ret;
+}
+
+static bool find_Recorder_Column(ptrStatisticsRecorder recorder, uint64_t key, uint32_t *index)
+{
+    uint32_t low = 0;
+    uint32_t high = recorder->numberOfColumns;
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        if (recorder->columnKeys[middle] < key)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    *index = low;
+    return low < recorder->numberOfColumns && recorder->columnKeys[low] == key;
+}
+
+//Only called with no samples waiting, so the values array does not need to be moved around
+static int add_Recorder_Column(ptrStatisticsRecorder recorder, uint64_t key, uint32_t index)
+{
+    if (recorder->numberOfColumns == recorder->columnsAllocated)
+    {
+        uint32_t newAllocation = recorder->columnsAllocated > 0 ? recorder->columnsAllocated * 2 : 64;
+        uint64_t *newKeys = C_CAST(uint64_t*, realloc(recorder->columnKeys, newAllocation * sizeof(uint64_t)));
+        uint64_t *newCurrentValues = NULL;
+        uint64_t *newValues = NULL;
+        if (!newKeys)
+        {
+            return MEMORY_FAILURE;
+        }
+        recorder->columnKeys = newKeys;
+        newCurrentValues = C_CAST(uint64_t*, realloc(recorder->currentValues, newAllocation * sizeof(uint64_t)));
+        if (!newCurrentValues)
+        {
+            return MEMORY_FAILURE;
+        }
+        recorder->currentValues = newCurrentValues;
+        newValues = C_CAST(uint64_t*, realloc(recorder->values, C_CAST(size_t, newAllocation) * recorder->samplesPerBlock * sizeof(uint64_t)));
+        if (!newValues)
+        {
+            return MEMORY_FAILURE;
+        }
+        recorder->values = newValues;
+        recorder->columnsAllocated = newAllocation;
+    }
+    memmove(&recorder->columnKeys[index + 1], &recorder->columnKeys[index], (recorder->numberOfColumns - index) * sizeof(uint64_t));
+    memmove(&recorder->currentValues[index + 1], &recorder->currentValues[index], (recorder->numberOfColumns - index) * sizeof(uint64_t));
+    recorder->columnKeys[index] = key;
+    recorder->currentValues[index] = 0;
+    ++(recorder->numberOfColumns);
+    return SUCCESS;
+}
+
+int record_Statistics_Sample(ptrStatisticsRecorder recorder, uint64_t timestamp, uint32_t numberOfValues, const uint64_t *columnKeys, const uint64_t *values)
+{
+    int ret = SUCCESS;
+    uint32_t valueIter = 0;
+    uint32_t columnIter = 0;
+    if (!recorder || !recorder->file || (numberOfValues > 0 && (!columnKeys || !values)))
+    {
+        return BAD_PARAMETER;
+    }
+    if ((recorder->numberOfSamples > 0 || recorder->blocksWritten > 0) && timestamp < recorder->lastTimestamp)
+    {
+        return BAD_PARAMETER;
+    }
+    //new columns start a new block so that every sample in a block has the same columns
+    for (valueIter = 0; valueIter < numberOfValues; ++valueIter)
+    {
+        uint32_t index = 0;
+        if (!find_Recorder_Column(recorder, columnKeys[valueIter], &index))
+        {
+            if (recorder->numberOfSamples > 0 && SUCCESS != (ret = flush_Statistics_Recorder(recorder)))
+            {
+                return ret;
+            }
+            if (SUCCESS != (ret = add_Recorder_Column(recorder, columnKeys[valueIter], index)))
+            {
+                return ret;
+            }
+        }
+    }
+    for (valueIter = 0; valueIter < numberOfValues; ++valueIter)
+    {
+        uint32_t index = 0;
+        if (find_Recorder_Column(recorder, columnKeys[valueIter], &index))
+        {
+            recorder->currentValues[index] = values[valueIter];
+        }
+    }
+    recorder->timestamps[recorder->numberOfSamples] = timestamp;
+    for (columnIter = 0; columnIter < recorder->numberOfColumns; ++columnIter)
+    {
+        recorder->values[C_CAST(size_t, columnIter) * recorder->samplesPerBlock + recorder->numberOfSamples] = recorder->currentValues[columnIter];
+    }
+    ++(recorder->numberOfSamples);
+    recorder->lastTimestamp = timestamp;
+    if (recorder->numberOfSamples >= recorder->samplesPerBlock)
+    {
+        ret = flush_Statistics_Recorder(recorder);
+    }
+    return ret;
+}
+
+int record_Health_Counters(tDevice *device, ptrHealthPollState state, ptrStatisticsRecorder recorder, uint64_t timestamp)
+{
+    int ret = SUCCESS;
+    uint32_t numberOfChanges = 0;
+    uint32_t numberOfValues = 0;
+    ptrHealthCounterValueEntry counterValues = NULL;
+    uint64_t *keys = NULL;
+    uint64_t *values = NULL;
+    uint32_t valueIter = 0;
+    if (!device || !state || !recorder)
+    {
+        return BAD_PARAMETER;
+    }
+    if (SUCCESS != (ret = poll_Health_Counters(device, state, NULL, 0, &numberOfChanges)))
+    {
+        return ret;
+    }
+    //nothing changed since the last sample, so only the timestamp needs to be recorded
+    if (numberOfChanges == 0 && recorder->numberOfColumns > 0)
+    {
+        return record_Statistics_Sample(recorder, timestamp, 0, NULL, NULL);
+    }
+    if (SUCCESS != (ret = get_Health_Counter_Values(state, NULL, 0, &numberOfValues)) || numberOfValues == 0)
+    {
+        return ret;
+    }
+    counterValues = C_CAST(ptrHealthCounterValueEntry, calloc(numberOfValues, sizeof(healthCounterValueEntry)));
+    keys = C_CAST(uint64_t*, calloc(numberOfValues, sizeof(uint64_t)));
+    values = C_CAST(uint64_t*, calloc(numberOfValues, sizeof(uint64_t)));
+    if (counterValues && keys && values)
+    {
+        ret = get_Health_Counter_Values(state, counterValues, numberOfValues, &numberOfValues);
+        for (valueIter = 0; ret == SUCCESS && valueIter < numberOfValues; ++valueIter)
+        {
+            keys[valueIter] = STATISTICS_RECORDER_HEALTH_COUNTER_KEY(counterValues[valueIter].source, counterValues[valueIter].id);
+            values[valueIter] = counterValues[valueIter].value;
+        }
+        if (ret == SUCCESS)
+        {
+            ret = record_Statistics_Sample(recorder, timestamp, numberOfValues, keys, values);
+        }
+    }
+    else
+    {
+        ret = MEMORY_FAILURE;
+    }
+    safe_Free(counterValues)
+    safe_Free(keys)
+    safe_Free(values)
+    return ret;
+}
+
+int close_Statistics_Recorder(ptrStatisticsRecorder recorder)
+{
+    int ret = SUCCESS;
+    if (!recorder)
+    {
+        return BAD_PARAMETER;
+    }
+    if (recorder->file)
+    {
+        ret = flush_Statistics_Recorder(recorder);
+        if (fclose(recorder->file) != 0 && ret == SUCCESS)
+        {
+            ret = ERROR_WRITING_FILE;
+        }
+    }
+    safe_Free(recorder->columnKeys)
+    safe_Free(recorder->currentValues)
+    safe_Free(recorder->timestamps)
+    safe_Free(recorder->values)
+    memset(recorder, 0, sizeof(statisticsRecorder));
+    return ret;
+}
+
+static bool is_Block_Header_Valid(const uint8_t *data, size_t fileLength, size_t offset)
+{
+    return offset + STATISTICS_RECORDING_BLOCK_HEADER_LENGTH <= fileLength
+        && get_Recording_Uint32(data, offset) == STATISTICS_RECORDING_BLOCK_MAGIC
+        && get_Recording_Uint32(data, offset + STATISTICS_RECORDING_BLOCK_HEADER_LENGTH - 4) == crc32c(0, &data[offset], STATISTICS_RECORDING_BLOCK_HEADER_LENGTH - 4)
+        && C_CAST(uint64_t, get_Recording_Uint32(data, offset + 12)) <= fileLength - offset - STATISTICS_RECORDING_BLOCK_HEADER_LENGTH;
+}
+
+int open_Statistics_Recording(const char *recordingFile, ptrStatisticsRecording recording)
+{
+    int ret = SUCCESS;
+    size_t offset = 0;
+    uint32_t blocksAllocated = 0;
+    if (!recordingFile || !recording)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(recording, 0, sizeof(statisticsRecording));
+    if (SUCCESS != (ret = map_File_Read_Only(recordingFile, &recording->mapping)))
+    {
+        return ret;
+    }
+    if (recording->mapping.length < STATISTICS_RECORDING_HEADER_LENGTH || memcmp(recording->mapping.data, STATISTICS_RECORDING_SIGNATURE, STATISTICS_RECORDING_SIGNATURE_LENGTH) != 0)
+    {
+        unmap_File(&recording->mapping);
+        return INVALID_LENGTH;
+    }
+    if (!is_Recording_Header_Valid(recording->mapping.data))
+    {
+        unmap_File(&recording->mapping);
+        return WARN_INVALID_CHECKSUM;
+    }
+    if (get_Recording_Uint32(recording->mapping.data, STATISTICS_RECORDING_SIGNATURE_LENGTH) > STATISTICS_RECORDING_VERSION)
+    {
+        unmap_File(&recording->mapping);
+        return NOT_SUPPORTED;
+    }
+    offset = get_Recording_Uint32(recording->mapping.data, STATISTICS_RECORDING_SIGNATURE_LENGTH + 4);
+    memcpy(recording->serialNumber, &recording->mapping.data[STATISTICS_RECORDING_SIGNATURE_LENGTH + 8], SERIAL_NUM_LEN);
+    memcpy(recording->modelNumber, &recording->mapping.data[STATISTICS_RECORDING_SIGNATURE_LENGTH + 8 + STATISTICS_RECORDING_SERIAL_LENGTH], MODEL_NUM_LEN);
+    //Build the index from the block headers alone. A damaged block (ex: the program was stopped while writing it) is skipped by searching for the next valid block header.
+    while (offset + STATISTICS_RECORDING_BLOCK_HEADER_LENGTH <= recording->mapping.length)
+    {
+        const uint8_t *data = recording->mapping.data;
+        statisticsRecordingBlock *block = NULL;
+        if (!is_Block_Header_Valid(data, recording->mapping.length, offset))
+        {
+            ++(recording->corruptBlocksSkipped);
+            ++offset;
+            while (offset + STATISTICS_RECORDING_BLOCK_HEADER_LENGTH <= recording->mapping.length && !is_Block_Header_Valid(data, recording->mapping.length, offset))
+            {
+                ++offset;
+            }
+            continue;
+        }
+        if (recording->numberOfBlocks == blocksAllocated)
+        {
+            uint32_t newAllocation = blocksAllocated > 0 ? blocksAllocated * 2 : 64;
+            statisticsRecordingBlock *newBlocks = C_CAST(statisticsRecordingBlock*, realloc(recording->blocks, newAllocation * sizeof(statisticsRecordingBlock)));
+            if (!newBlocks)
+            {
+                close_Statistics_Recording(recording);
+                return MEMORY_FAILURE;
+            }
+            recording->blocks = newBlocks;
+            blocksAllocated = newAllocation;
+        }
+        block = &recording->blocks[recording->numberOfBlocks];
+        block->numberOfSamples = get_Recording_Uint32(data, offset + 4);
+        block->numberOfColumns = get_Recording_Uint32(data, offset + 8);
+        block->payloadLength = get_Recording_Uint32(data, offset + 12);
+        block->firstTimestamp = get_Recording_Uint64(data, offset + 16);
+        block->lastTimestamp = get_Recording_Uint64(data, offset + 24);
+        block->offset = offset + STATISTICS_RECORDING_BLOCK_HEADER_LENGTH;
+        ++(recording->numberOfBlocks);
+        offset = block->offset + block->payloadLength;
+    }
+    return SUCCESS;
+}
+
+//Decodes a whole block and calls back for the samples in the time range
+static int scan_Statistics_Block(ptrStatisticsRecording recording, statisticsRecordingBlock *block, uint64_t startTime, uint64_t endTime, statisticsSampleCallback callback, void *callbackData)
+{
+    int ret = SUCCESS;
+    const uint8_t *payload = &recording->mapping.data[block->offset];
+    size_t offset = 0;
+    uint64_t numberOfColumns = 0;
+    uint64_t *keys = NULL;
+    uint64_t *timestamps = NULL;
+    uint64_t *values = NULL;
+    uint64_t *sample = NULL;
+    uint32_t columnIter = 0;
+    uint32_t sampleIter = 0;
+    if (block->numberOfSamples == 0 || get_Recording_Uint32(recording->mapping.data, block->offset - 12) != crc32c(0, payload, block->payloadLength))
+    {
+        return WARN_INVALID_CHECKSUM;
+    }
+    if (!get_Varint(payload, block->payloadLength, &offset, &numberOfColumns) || numberOfColumns != block->numberOfColumns)
+    {
+        return WARN_INVALID_CHECKSUM;
+    }
+    keys = C_CAST(uint64_t*, calloc(block->numberOfColumns + 1, sizeof(uint64_t)));
+    timestamps = C_CAST(uint64_t*, calloc(block->numberOfSamples, sizeof(uint64_t)));
+    values = C_CAST(uint64_t*, calloc((C_CAST(size_t, block->numberOfColumns) + 1) * block->numberOfSamples, sizeof(uint64_t)));
+    sample = C_CAST(uint64_t*, calloc(block->numberOfColumns + 1, sizeof(uint64_t)));
+    if (!keys || !timestamps || !values || !sample)
+    {
+        ret = MEMORY_FAILURE;
+    }
+    for (columnIter = 0; ret == SUCCESS && columnIter < block->numberOfColumns; ++columnIter)
+    {
+        uint64_t keyDelta = 0;
+        if (!get_Varint(payload, block->payloadLength, &offset, &keyDelta))
+        {
+            ret = WARN_INVALID_CHECKSUM;
+        }
+        keys[columnIter] = keyDelta + (columnIter > 0 ? keys[columnIter - 1] : 0);
+    }
+    //timestamps are stored as the difference between samples. Decode those into the values array for now, then add them up.
+    if (ret == SUCCESS && !decode_Column(payload, block->payloadLength, &offset, values, block->numberOfSamples - 1))
+    {
+        ret = WARN_INVALID_CHECKSUM;
+    }
+    if (ret == SUCCESS)
+    {
+        timestamps[0] = block->firstTimestamp;
+        for (sampleIter = 1; sampleIter < block->numberOfSamples; ++sampleIter)
+        {
+            timestamps[sampleIter] = timestamps[sampleIter - 1] + values[sampleIter - 1];
+        }
+    }
+    for (columnIter = 0; ret == SUCCESS && columnIter < block->numberOfColumns; ++columnIter)
+    {
+        if (!decode_Column(payload, block->payloadLength, &offset, &values[C_CAST(size_t, columnIter) * block->numberOfSamples], block->numberOfSamples))
+        {
+            ret = WARN_INVALID_CHECKSUM;
+        }
+    }
+    for (sampleIter = 0; ret == SUCCESS && sampleIter < block->numberOfSamples; ++sampleIter)
+    {
+        if (timestamps[sampleIter] < startTime || timestamps[sampleIter] > endTime)
+        {
+            continue;
+        }
+        for (columnIter = 0; columnIter < block->numberOfColumns; ++columnIter)
+        {
+            sample[columnIter] = values[C_CAST(size_t, columnIter) * block->numberOfSamples + sampleIter];
+        }
+        if (callback(callbackData, timestamps[sampleIter], block->numberOfColumns, keys, sample))
+        {
+            ret = ABORTED;
+        }
+    }
+    safe_Free(keys)
+    safe_Free(timestamps)
+    safe_Free(values)
+    safe_Free(sample)
+    return ret;
+}
+
+int scan_Statistics_Recording(ptrStatisticsRecording recording, uint64_t startTime, uint64_t endTime, statisticsSampleCallback callback, void *callbackData)
+{
+    int ret = SUCCESS;
+    uint32_t low = 0;
+    uint32_t high = 0;
+    uint32_t blockIter = 0;
+    if (!recording || !recording->mapping.data || !callback || startTime > endTime)
+    {
+        return BAD_PARAMETER;
+    }
+    //find the first block that ends at or after the start of the range
+    high = recording->numberOfBlocks;
+    while (low < high)
+    {
+        uint32_t middle = low + (high - low) / 2;
+        if (recording->blocks[middle].lastTimestamp < startTime)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    for (blockIter = low; blockIter < recording->numberOfBlocks && recording->blocks[blockIter].firstTimestamp <= endTime; ++blockIter)
+    {
+        int blockRet = scan_Statistics_Block(recording, &recording->blocks[blockIter], startTime, endTime, callback, callbackData);
+        if (blockRet == ABORTED || blockRet == MEMORY_FAILURE)
+        {
+            return blockRet;
+        }
+        else if (blockRet != SUCCESS)
+        {
+            ret = blockRet;//keep going. Later blocks may still be readable.
+        }
+    }
+    return ret;
+}
+
+void close_Statistics_Recording(ptrStatisticsRecording recording)
+{
+    if (recording)
+    {
+        unmap_File(&recording->mapping);
+        safe_Free(recording->blocks)
+        memset(recording, 0, sizeof(statisticsRecording));
+    }
+}
@@ -0,0 +1,273 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file streaming_workload.c
+// \brief This file defines the functions for running a multi-stream recording workload with the ATA streaming feature set and measuring deadline misses
+
+#include "common.h"
+#include "streaming_workload.h"
+
+typedef struct _streamState
+{
+    uint64_t nextLBA;
+    uint64_t nextDueNanoSeconds;//relative to the start of the workload
+    uint64_t totalNanoSeconds;
+    uint64_t *latencies;
+    uint32_t numberOfLatencies;
+}streamState;
+
+static int compare_Stream_Latency(const void *first, const void *second)
+{
+    uint64_t a = *C_CAST(const uint64_t*, first);
+    uint64_t b = *C_CAST(const uint64_t*, second);
+    if (a < b)
+    {
+        return -1;
+    }
+    else if (a > b)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+int streaming_Workload_Test(tDevice *device, ptrStreamingWorkloadOptions options, ptrStreamingWorkloadResults results)
+{
+    int ret = SUCCESS;
+    streamState state[STREAMING_WORKLOAD_MAX_STREAMS];
+    uint8_t *dataBuf = NULL;
+    uint64_t *latencies = NULL;
+    uint32_t transferBytes = 0;
+    uint32_t sectorsPerTransfer = 0;
+    uint64_t range = 0;
+    uint64_t lbasPerStream = 0;
+    uint64_t periodNanoSeconds = 0;
+    uint64_t deadlineNanoSeconds = 0;
+    uint64_t durationNanoSeconds = 0;
+    uint64_t elapsedNanoSeconds = 0;
+    uint8_t streamIter = 0;
+    seatimer_t runTimer;
+    if (!device || !options || !results || options->numberOfStreams == 0 || options->numberOfStreams > STREAMING_WORKLOAD_MAX_STREAMS || options->kilobitsPerSecond == 0 || options->startingLBA > device->drive_info.deviceMaxLba)
+    {
+        return BAD_PARAMETER;
+    }
+    if (device->drive_info.drive_type != ATA_DRIVE || !(device->drive_info.IdentifyData.ata.Word084 & BIT4) || device->drive_info.IdentifyData.ata.Word084 == UINT16_MAX)
+    {
+        return NOT_SUPPORTED;
+    }
+    transferBytes = options->transferSizeBytes ? options->transferSizeBytes : STREAMING_WORKLOAD_DEFAULT_TRANSFER_SIZE;
+    sectorsPerTransfer = M_Max(transferBytes / device->drive_info.deviceBlockSize, UINT32_C(1));
+    //stream commands take a 16bit sector count where 0 means 65536
+    sectorsPerTransfer = M_Min(sectorsPerTransfer, UINT32_C(65536));
+    transferBytes = sectorsPerTransfer * device->drive_info.deviceBlockSize;
+    range = device->drive_info.deviceMaxLba + 1 - options->startingLBA;
+    if (options->range > 0)
+    {
+        range = M_Min(options->range, range);
+    }
+    lbasPerStream = ((range / options->numberOfStreams) / sectorsPerTransfer) * sectorsPerTransfer;
+    if (lbasPerStream == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(results, 0, sizeof(streamingWorkloadResults));
+    memset(state, 0, sizeof(state));
+    memset(&runTimer, 0, sizeof(seatimer_t));
+    results->numberOfStreams = options->numberOfStreams;
+    results->transferSizeBytes = transferBytes;
+    results->kilobitsPerSecond = options->kilobitsPerSecond;
+    results->granularityMicroseconds = M_WordsTo4ByteValue(device->drive_info.IdentifyData.ata.Word099, device->drive_info.IdentifyData.ata.Word098);
+    //time between commands for one stream to hold its bitrate
+    periodNanoSeconds = (C_CAST(uint64_t, transferBytes) * UINT64_C(8000000)) / options->kilobitsPerSecond;
+    if (options->deadlineMicroseconds > 0)
+    {
+        deadlineNanoSeconds = C_CAST(uint64_t, options->deadlineMicroseconds) * UINT64_C(1000);
+        if (results->granularityMicroseconds > 0)
+        {
+            //CCTL is in units of the stream granularity. Round up so that the drive is never given less time than requested.
+            uint64_t cctl = (options->deadlineMicroseconds + results->granularityMicroseconds - 1) / results->granularityMicroseconds;
+            results->commandCCTL = C_CAST(uint8_t, M_Min(cctl, UINT64_C(255)));
+        }
+    }
+    else
+    {
+        deadlineNanoSeconds = periodNanoSeconds / options->numberOfStreams;
+    }
+    results->deadlineMicroseconds = C_CAST(uint32_t, deadlineNanoSeconds / UINT64_C(1000));
+    durationNanoSeconds = C_CAST(uint64_t, options->durationSeconds) * UINT64_C(1000000000);
+
+    dataBuf = C_CAST(uint8_t*, calloc_aligned(transferBytes, sizeof(uint8_t), device->os_info.minimumAlignment));
+    latencies = C_CAST(uint64_t*, calloc(C_CAST(size_t, STREAMING_WORKLOAD_LATENCY_SAMPLES) * options->numberOfStreams, sizeof(uint64_t)));
+    if (!dataBuf || !latencies)
+    {
+        safe_Free_aligned(dataBuf)
+        safe_Free(latencies)
+        return MEMORY_FAILURE;
+    }
+    fill_Random_Pattern_In_Buffer(dataBuf, transferBytes);
+
+    for (streamIter = 0; streamIter < options->numberOfStreams; ++streamIter)
+    {
+        streamStatistics *stream = &results->stream[streamIter];
+        stream->streamID = streamIter;
+        stream->startingLBA = options->startingLBA + streamIter * lbasPerStream;
+        stream->numberOfLBAs = lbasPerStream;
+        state[streamIter].nextLBA = stream->startingLBA;
+        //stagger the first command of each stream so that the writes interleave instead of arriving in bursts
+        state[streamIter].nextDueNanoSeconds = (periodNanoSeconds / options->numberOfStreams) * streamIter;
+        state[streamIter].latencies = &latencies[streamIter * STREAMING_WORKLOAD_LATENCY_SAMPLES];
+        if (SUCCESS != ata_Configure_Stream(device, streamIter, true, false, results->commandCCTL, C_CAST(uint16_t, M_Min(sectorsPerTransfer, UINT16_MAX))))
+        {
+            if (VERBOSITY_QUIET < device->deviceVerbosity)
+            {
+                printf("Unable to configure stream %" PRIu8 "\n", streamIter);
+            }
+            ret = FAILURE;
+            break;
+        }
+    }
+
+    start_Timer(&runTimer);
+    while (ret == SUCCESS)
+    {
+        streamState *next = NULL;
+        streamStatistics *stream = NULL;
+        uint8_t nextStream = 0;
+        uint64_t nanoSeconds = 0;
+        int writeResult = SUCCESS;
+        seatimer_t commandTimer;
+        //stop_Timer only saves the current time, so it is used here to check how long the workload has been running
+        stop_Timer(&runTimer);
+        elapsedNanoSeconds = get_Nano_Seconds(runTimer);
+        if (elapsedNanoSeconds >= durationNanoSeconds)
+        {
+            break;
+        }
+        for (streamIter = 0; streamIter < options->numberOfStreams; ++streamIter)
+        {
+            if (!next || state[streamIter].nextDueNanoSeconds < next->nextDueNanoSeconds)
+            {
+                next = &state[streamIter];
+                nextStream = streamIter;
+            }
+        }
+        if (next->nextDueNanoSeconds > elapsedNanoSeconds)
+        {
+            uint64_t waitNanoSeconds = next->nextDueNanoSeconds - elapsedNanoSeconds;
+            if (waitNanoSeconds >= UINT64_C(1000000))
+            {
+                delay_Milliseconds(C_CAST(uint32_t, M_Min(waitNanoSeconds / UINT64_C(1000000), UINT64_C(1000))));
+            }
+            continue;
+        }
+        stream = &results->stream[nextStream];
+        if (elapsedNanoSeconds - next->nextDueNanoSeconds > deadlineNanoSeconds)
+        {
+            ++stream->lateStarts;
+        }
+        //not every OS returns RTFRs for a command that completed without error, so make sure old ones are not read back
+        memset(&device->drive_info.lastCommandRTFRs, 0, sizeof(ataReturnTFRs));
+        memset(&commandTimer, 0, sizeof(seatimer_t));
+        start_Timer(&commandTimer);
+        writeResult = send_ATA_Write_Stream_Cmd(device, nextStream, false, options->writeContinuous, results->commandCCTL, next->nextLBA, dataBuf, transferBytes);
+        stop_Timer(&commandTimer);
+        nanoSeconds = get_Nano_Seconds(commandTimer);
+        ++stream->commands;
+        if (writeResult == SUCCESS)
+        {
+            stream->bytesWritten += transferBytes;
+            if (options->writeContinuous && device->drive_info.lastCommandRTFRs.status & BIT5)
+            {
+                ++stream->streamErrorsReported;
+            }
+        }
+        else if (device->drive_info.lastCommandRTFRs.error & BIT0)
+        {
+            ++stream->completionTimeouts;
+        }
+        else
+        {
+            ++stream->failures;
+        }
+        if (nanoSeconds > deadlineNanoSeconds)
+        {
+            ++stream->deadlineMisses;
+        }
+        if (stream->commands == 1 || nanoSeconds < stream->minimumNanoSeconds)
+        {
+            stream->minimumNanoSeconds = nanoSeconds;
+        }
+        stream->maximumNanoSeconds = M_Max(stream->maximumNanoSeconds, nanoSeconds);
+        next->totalNanoSeconds += nanoSeconds;
+        if (next->numberOfLatencies < STREAMING_WORKLOAD_LATENCY_SAMPLES)
+        {
+            next->latencies[next->numberOfLatencies] = nanoSeconds;
+            ++next->numberOfLatencies;
+        }
+        next->nextDueNanoSeconds += periodNanoSeconds;
+        next->nextLBA += sectorsPerTransfer;
+        if (next->nextLBA >= stream->startingLBA + stream->numberOfLBAs)
+        {
+            next->nextLBA = stream->startingLBA;
+        }
+    }
+
+    for (streamIter = 0; streamIter < options->numberOfStreams; ++streamIter)
+    {
+        streamStatistics *stream = &results->stream[streamIter];
+        //remove the stream so that the drive does not keep resources set aside for it
+        ata_Configure_Stream(device, streamIter, false, false, 0, 0);
+        if (stream->commands > 0)
+        {
+            stream->averageNanoSeconds = state[streamIter].totalNanoSeconds / stream->commands;
+        }
+        if (state[streamIter].numberOfLatencies > 0)
+        {
+            qsort(state[streamIter].latencies, state[streamIter].numberOfLatencies, sizeof(uint64_t), compare_Stream_Latency);
+            stream->p99NanoSeconds = state[streamIter].latencies[(state[streamIter].numberOfLatencies - 1) * 99 / 100];
+        }
+        if (elapsedNanoSeconds > 0)
+        {
+            stream->achievedKilobitsPerSecond = (C_CAST(double, stream->bytesWritten) * 8.0 / 1000.0) / (C_CAST(double, elapsedNanoSeconds) / 1000000000.0);
+        }
+    }
+    safe_Free_aligned(dataBuf)
+    safe_Free(latencies)
+    return ret;
+}
+
+void print_Streaming_Workload_Results(ptrStreamingWorkloadResults results)
+{
+    uint8_t streamIter = 0;
+    if (!results)
+    {
+        return;
+    }
+    printf("\n===Streaming Workload===\n");
+    printf("Streams: %" PRIu8 " at %" PRIu32 " kbit/s, %" PRIu32 " bytes per command\n", results->numberOfStreams, results->kilobitsPerSecond, results->transferSizeBytes);
+    printf("Deadline: %" PRIu32 " us", results->deadlineMicroseconds);
+    if (results->commandCCTL > 0)
+    {
+        printf(" (CCTL %" PRIu8 " x %" PRIu32 " us)\n", results->commandCCTL, results->granularityMicroseconds);
+    }
+    else
+    {
+        printf(" (not sent to the drive)\n");
+    }
+    printf("%-7s %-10s %-12s %-10s %-10s %-10s %-10s %-10s %-10s %-10s %-10s %-10s\n", "Stream", "Commands", "kbit/s", "Min (ms)", "Avg (ms)", "99% (ms)", "Max (ms)", "Missed", "Timeouts", "Stream Err", "Late", "Failures");
+    for (streamIter = 0; streamIter < results->numberOfStreams && streamIter < STREAMING_WORKLOAD_MAX_STREAMS; ++streamIter)
+    {
+        streamStatistics *stream = &results->stream[streamIter];
+        printf("%-7" PRIu8 " %-10" PRIu64 " %-12.1f %-10.2f %-10.2f %-10.2f %-10.2f %-10" PRIu64 " %-10" PRIu64 " %-10" PRIu64 " %-10" PRIu64 " %-10" PRIu64 "\n", stream->streamID, stream->commands, stream->achievedKilobitsPerSecond,
+            C_CAST(double, stream->minimumNanoSeconds) / 1000000.0, C_CAST(double, stream->averageNanoSeconds) / 1000000.0, C_CAST(double, stream->p99NanoSeconds) / 1000000.0, C_CAST(double, stream->maximumNanoSeconds) / 1000000.0,
+            stream->deadlineMisses, stream->completionTimeouts, stream->streamErrorsReported, stream->lateStarts, stream->failures);
+    }
+}
@@ -0,0 +1,324 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file test_checkpoint.c
+// \brief This file defines the functions for saving and loading checkpoints so that long running tests can be resumed after being interrupted
+
+#include "common.h"
+#include "test_checkpoint.h"
+#if defined (_WIN32)
+#include <windows.h>
+#include <io.h>
+#elif !defined (UEFI_C_SOURCE)
+#include <unistd.h>
+#endif
+
+//File layout (all values are little endian):
+//  header: signature, version, then the fixed fields in the order they are in testCheckpoint
+//  errorCount entries of: errorAddress (8 bytes), repairStatus (4 bytes)
+//  patternLength bytes of pattern
+//  CRC32C of everything before it (4 bytes)
+#define TEST_CHECKPOINT_SIGNATURE "SEACKPT"
+#define TEST_CHECKPOINT_SIGNATURE_LENGTH 8
+#define TEST_CHECKPOINT_HEADER_LENGTH (TEST_CHECKPOINT_SIGNATURE_LENGTH + 4 + 4 + 4 + (SERIAL_NUM_LEN + 1) + 3 + (5 * 8) + 2 + 3 + 1 + 8 + 4)
+#define TEST_CHECKPOINT_ERROR_ENTRY_LENGTH 12
+
+static void put_Checkpoint_Bytes(uint8_t *buffer, size_t *offset, const void *data, size_t length)
+{
+    memcpy(&buffer[*offset], data, length);
+    *offset += length;
+}
+
+static void put_Checkpoint_Uint32(uint8_t *buffer, size_t *offset, uint32_t value)
+{
+    buffer[(*offset)++] = M_Byte0(value);
+    buffer[(*offset)++] = M_Byte1(value);
+    buffer[(*offset)++] = M_Byte2(value);
+    buffer[(*offset)++] = M_Byte3(value);
+}
+
+static void put_Checkpoint_Uint64(uint8_t *buffer, size_t *offset, uint64_t value)
+{
+    put_Checkpoint_Uint32(buffer, offset, M_DoubleWord0(value));
+    put_Checkpoint_Uint32(buffer, offset, M_DoubleWord1(value));
+}
+
+static uint32_t get_Checkpoint_Uint32(const uint8_t *buffer, size_t *offset)
+{
+    uint32_t value = M_BytesTo4ByteValue(buffer[*offset + 3], buffer[*offset + 2], buffer[*offset + 1], buffer[*offset]);
+    *offset += 4;
+    return value;
+}
+
+static uint64_t get_Checkpoint_Uint64(const uint8_t *buffer, size_t *offset)
+{
+    uint64_t low = get_Checkpoint_Uint32(buffer, offset);
+    uint64_t high = get_Checkpoint_Uint32(buffer, offset);
+    return (high << 32) | low;
+}
+
+void init_Test_Checkpoint(tDevice *device, ptrTestCheckpoint checkpoint, eCheckpointTestType testType, uint64_t startingLBA, uint64_t endingLBA)
+{
+    if (!device || !checkpoint)
+    {
+        return;
+    }
+    memset(checkpoint, 0, sizeof(testCheckpoint));
+    checkpoint->testType = testType;
+    memcpy(checkpoint->serialNumber, device->drive_info.serialNumber, SERIAL_NUM_LEN);
+    checkpoint->deviceMaxLba = device->drive_info.deviceMaxLba;
+    checkpoint->startingLBA = startingLBA;
+    checkpoint->endingLBA = endingLBA;
+    checkpoint->currentLBA = startingLBA;
+}
+
+int save_Test_Checkpoint(const char *checkpointFile, ptrTestCheckpoint checkpoint)
+{
+    int ret = SUCCESS;
+    size_t fileLength = 0;
+    size_t offset = 0;
+    uint8_t *fileData = NULL;
+    char *tempFileName = NULL;
+    size_t tempFileNameLength = 0;
+    FILE *tempFile = NULL;
+    uint64_t errorIter = 0;
+    if (!checkpointFile || !checkpoint || (checkpoint->errorCount > 0 && !checkpoint->errorList) || (checkpoint->patternLength > 0 && !checkpoint->pattern))
+    {
+        return BAD_PARAMETER;
+    }
+    fileLength = TEST_CHECKPOINT_HEADER_LENGTH + C_CAST(size_t, checkpoint->errorCount) * TEST_CHECKPOINT_ERROR_ENTRY_LENGTH + checkpoint->patternLength + sizeof(uint32_t);
+    fileData = C_CAST(uint8_t*, calloc(fileLength, sizeof(uint8_t)));
+    tempFileNameLength = strlen(checkpointFile) + 5;//".tmp" + NULL
+    tempFileName = C_CAST(char*, calloc(tempFileNameLength, sizeof(char)));
+    if (!fileData || !tempFileName)
+    {
+        safe_Free(fileData)
+        safe_Free(tempFileName)
+        return MEMORY_FAILURE;
+    }
+    snprintf(tempFileName, tempFileNameLength, "%s.tmp", checkpointFile);
+    put_Checkpoint_Bytes(fileData, &offset, TEST_CHECKPOINT_SIGNATURE, TEST_CHECKPOINT_SIGNATURE_LENGTH);
+    put_Checkpoint_Uint32(fileData, &offset, TEST_CHECKPOINT_VERSION);
+    put_Checkpoint_Uint32(fileData, &offset, C_CAST(uint32_t, checkpoint->testType));
+    put_Checkpoint_Uint32(fileData, &offset, checkpoint->testMode);
+    put_Checkpoint_Bytes(fileData, &offset, checkpoint->serialNumber, SERIAL_NUM_LEN + 1);
+    offset += 3;//reserved
+    put_Checkpoint_Uint64(fileData, &offset, checkpoint->deviceMaxLba);
+    put_Checkpoint_Uint64(fileData, &offset, checkpoint->startingLBA);
+    put_Checkpoint_Uint64(fileData, &offset, checkpoint->endingLBA);
+    put_Checkpoint_Uint64(fileData, &offset, checkpoint->currentLBA);
+    put_Checkpoint_Uint64(fileData, &offset, checkpoint->elapsedSeconds);
+    fileData[offset++] = M_Byte0(checkpoint->errorLimit);
+    fileData[offset++] = M_Byte1(checkpoint->errorLimit);
+    fileData[offset++] = checkpoint->stopOnError ? 1 : 0;
+    fileData[offset++] = checkpoint->repairOnTheFly ? 1 : 0;
+    fileData[offset++] = checkpoint->repairAtEnd ? 1 : 0;
+    offset += 1;//reserved
+    put_Checkpoint_Uint64(fileData, &offset, checkpoint->errorCount);
+    put_Checkpoint_Uint32(fileData, &offset, checkpoint->patternLength);
+    for (errorIter = 0; errorIter < checkpoint->errorCount; ++errorIter)
+    {
+        put_Checkpoint_Uint64(fileData, &offset, checkpoint->errorList[errorIter].errorAddress);
+        put_Checkpoint_Uint32(fileData, &offset, C_CAST(uint32_t, checkpoint->errorList[errorIter].repairStatus));
+    }
+    if (checkpoint->patternLength > 0)
+    {
+        put_Checkpoint_Bytes(fileData, &offset, checkpoint->pattern, checkpoint->patternLength);
+    }
+    put_Checkpoint_Uint32(fileData, &offset, crc32c(0, fileData, offset));
+    //write everything to a temporary file and make sure it is on disk before replacing the old checkpoint with it.
+    if ((tempFile = fopen(tempFileName, "wb")) == NULL)
+    {
+        ret = FILE_OPEN_ERROR;
+    }
+    else
+    {
+        bool writeFailed = fwrite(fileData, sizeof(uint8_t), fileLength, tempFile) != fileLength || fflush(tempFile) != 0;
+#if defined (_WIN32)
+        if (!writeFailed && _commit(_fileno(tempFile)) != 0)
+        {
+            writeFailed = true;
+        }
+#elif !defined (UEFI_C_SOURCE)
+        if (!writeFailed && fsync(fileno(tempFile)) != 0)
+        {
+            writeFailed = true;
+        }
+#endif
+        if (fclose(tempFile) != 0)
+        {
+            writeFailed = true;
+        }
+        if (writeFailed)
+        {
+            ret = ERROR_WRITING_FILE;
+            remove(tempFileName);
+        }
+        else
+        {
+#if defined (_WIN32)
+            //rename() will not replace an existing file on Windows
+            if (!MoveFileExA(tempFileName, checkpointFile, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+#else
+            if (rename(tempFileName, checkpointFile) != 0)
+#endif
+            {
+                ret = ERROR_WRITING_FILE;
+                remove(tempFileName);
+            }
+        }
+    }
+    safe_Free(fileData)
+    safe_Free(tempFileName)
+    return ret;
+}
+
+int load_Test_Checkpoint(const char *checkpointFile, ptrTestCheckpoint checkpoint)
+{
+    int ret = SUCCESS;
+    FILE *file = NULL;
+    long fileSize = 0;
+    size_t fileLength = 0;
+    size_t offset = 0;
+    uint8_t *fileData = NULL;
+    uint64_t errorIter = 0;
+    if (!checkpointFile || !checkpoint)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(checkpoint, 0, sizeof(testCheckpoint));
+    if ((file = fopen(checkpointFile, "rb")) == NULL)
+    {
+        return FILE_OPEN_ERROR;
+    }
+    if (fseek(file, 0, SEEK_END) != 0 || (fileSize = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0)
+    {
+        fclose(file);
+        return FILE_OPEN_ERROR;
+    }
+    fileLength = C_CAST(size_t, fileSize);
+    if (fileLength < (TEST_CHECKPOINT_HEADER_LENGTH + sizeof(uint32_t)))
+    {
+        fclose(file);
+        return INVALID_LENGTH;
+    }
+    fileData = C_CAST(uint8_t*, calloc(fileLength, sizeof(uint8_t)));
+    if (!fileData)
+    {
+        fclose(file);
+        return MEMORY_FAILURE;
+    }
+    if (fread(fileData, sizeof(uint8_t), fileLength, file) != fileLength)
+    {
+        fclose(file);
+        safe_Free(fileData)
+        return INVALID_LENGTH;
+    }
+    fclose(file);
+    offset = fileLength - sizeof(uint32_t);
+    if (memcmp(fileData, TEST_CHECKPOINT_SIGNATURE, TEST_CHECKPOINT_SIGNATURE_LENGTH) != 0 || get_Checkpoint_Uint32(fileData, &offset) != crc32c(0, fileData, fileLength - sizeof(uint32_t)))
+    {
+        safe_Free(fileData)
+        return WARN_INVALID_CHECKSUM;
+    }
+    offset = TEST_CHECKPOINT_SIGNATURE_LENGTH;
+    if (get_Checkpoint_Uint32(fileData, &offset) != TEST_CHECKPOINT_VERSION)
+    {
+        safe_Free(fileData)
+        return NOT_SUPPORTED;
+    }
+    checkpoint->testType = C_CAST(eCheckpointTestType, get_Checkpoint_Uint32(fileData, &offset));
+    checkpoint->testMode = get_Checkpoint_Uint32(fileData, &offset);
+    memcpy(checkpoint->serialNumber, &fileData[offset], SERIAL_NUM_LEN);
+    offset += SERIAL_NUM_LEN + 1 + 3;
+    checkpoint->deviceMaxLba = get_Checkpoint_Uint64(fileData, &offset);
+    checkpoint->startingLBA = get_Checkpoint_Uint64(fileData, &offset);
+    checkpoint->endingLBA = get_Checkpoint_Uint64(fileData, &offset);
+    checkpoint->currentLBA = get_Checkpoint_Uint64(fileData, &offset);
+    checkpoint->elapsedSeconds = get_Checkpoint_Uint64(fileData, &offset);
+    checkpoint->errorLimit = M_BytesTo2ByteValue(fileData[offset + 1], fileData[offset]);
+    offset += 2;
+    checkpoint->stopOnError = fileData[offset++] != 0;
+    checkpoint->repairOnTheFly = fileData[offset++] != 0;
+    checkpoint->repairAtEnd = fileData[offset++] != 0;
+    offset += 1;
+    checkpoint->errorCount = get_Checkpoint_Uint64(fileData, &offset);
+    checkpoint->patternLength = get_Checkpoint_Uint32(fileData, &offset);
+    if (checkpoint->errorCount > UINT16_MAX || (TEST_CHECKPOINT_HEADER_LENGTH + checkpoint->errorCount * TEST_CHECKPOINT_ERROR_ENTRY_LENGTH + checkpoint->patternLength + sizeof(uint32_t)) != fileLength)
+    {
+        memset(checkpoint, 0, sizeof(testCheckpoint));
+        safe_Free(fileData)
+        return INVALID_LENGTH;
+    }
+    //allocate enough for the error limit (plus the one the tests write when they reach it) so the list can keep growing when the test is resumed
+    checkpoint->errorList = C_CAST(ptrErrorLBA, calloc(M_Max(C_CAST(size_t, checkpoint->errorLimit), C_CAST(size_t, checkpoint->errorCount)) + 1, sizeof(errorLBA)));
+    if (checkpoint->patternLength > 0)
+    {
+        checkpoint->pattern = C_CAST(uint8_t*, calloc(checkpoint->patternLength, sizeof(uint8_t)));
+    }
+    if (!checkpoint->errorList || (checkpoint->patternLength > 0 && !checkpoint->pattern))
+    {
+        free_Test_Checkpoint(checkpoint);
+        safe_Free(fileData)
+        return MEMORY_FAILURE;
+    }
+    checkpoint->errorList[0].errorAddress = UINT64_MAX;
+    for (errorIter = 0; errorIter < checkpoint->errorCount; ++errorIter)
+    {
+        checkpoint->errorList[errorIter].errorAddress = get_Checkpoint_Uint64(fileData, &offset);
+        checkpoint->errorList[errorIter].repairStatus = C_CAST(eRepairStatus, get_Checkpoint_Uint32(fileData, &offset));
+    }
+    if (checkpoint->patternLength > 0)
+    {
+        memcpy(checkpoint->pattern, &fileData[offset], checkpoint->patternLength);
+    }
+    safe_Free(fileData)
+    return ret;
+}
+
+void free_Test_Checkpoint(ptrTestCheckpoint checkpoint)
+{
+    if (checkpoint)
+    {
+        safe_Free(checkpoint->errorList)
+        safe_Free(checkpoint->pattern)
+        checkpoint->errorCount = 0;
+        checkpoint->patternLength = 0;
+    }
+}
+
+bool is_Checkpoint_For_Device(tDevice *device, ptrTestCheckpoint checkpoint, eCheckpointTestType testType)
+{
+    if (!device || !checkpoint)
+    {
+        return false;
+    }
+    return checkpoint->testType == testType
+        && checkpoint->deviceMaxLba == device->drive_info.deviceMaxLba
+        && strncmp(checkpoint->serialNumber, device->drive_info.serialNumber, SERIAL_NUM_LEN) == 0
+        && checkpoint->currentLBA >= checkpoint->startingLBA
+        && checkpoint->currentLBA <= checkpoint->endingLBA;
+}
+
+int remove_Test_Checkpoint(const char *checkpointFile)
+{
+    FILE *file = NULL;
+    if (!checkpointFile)
+    {
+        return BAD_PARAMETER;
+    }
+    if ((file = fopen(checkpointFile, "rb")) == NULL)
+    {
+        return SUCCESS;
+    }
+    fclose(file);
+    return remove(checkpointFile) == 0 ? SUCCESS : FAILURE;
+}
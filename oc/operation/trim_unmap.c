@@ -77,7 +77,7 @@ bool is_ATA_Data_Set_Management_XL_Supported(tDevice * device)
     return supported;
 }
 
-bool is_Trim_Or_Unmap_Supported(tDevice *device, uint32_t *maxTrimOrUnmapBlockDescriptors, uint32_t *maxLBACount)
+static bool read_Trim_Or_Unmap_Support(tDevice *device, uint32_t *maxTrimOrUnmapBlockDescriptors, uint32_t *maxLBACount)
 {
     bool supported = false;
     switch (device->drive_info.drive_type)
@@ -166,6 +166,27 @@ bool is_Trim_Or_Unmap_Supported(tDevice *device, uint32_t *maxTrimOrUnmapBlockDe
     return supported;
 }
 
+bool is_Trim_Or_Unmap_Supported(tDevice *device, uint32_t *maxTrimOrUnmapBlockDescriptors, uint32_t *maxLBACount)
+{
+    if (!device->drive_info.capabilities.trimUnmapValid)
+    {
+        uint32_t maxDescriptors = 0, maxLBAs = 0;
+        device->drive_info.capabilities.trimUnmapSupported = read_Trim_Or_Unmap_Support(device, &maxDescriptors, &maxLBAs);
+        device->drive_info.capabilities.trimUnmapMaxBlockDescriptors = maxDescriptors;
+        device->drive_info.capabilities.trimUnmapMaxLBACount = maxLBAs;
+        device->drive_info.capabilities.trimUnmapValid = true;
+    }
+    if (maxTrimOrUnmapBlockDescriptors)
+    {
+        *maxTrimOrUnmapBlockDescriptors = device->drive_info.capabilities.trimUnmapMaxBlockDescriptors;
+    }
+    if (maxLBACount)
+    {
+        *maxLBACount = device->drive_info.capabilities.trimUnmapMaxLBACount;
+    }
+    return device->drive_info.capabilities.trimUnmapSupported;
+}
+
 int trim_Unmap_Range(tDevice *device, uint64_t startLBA, uint64_t range)
 {
     int ret = UNKNOWN;
@@ -15,7 +15,9 @@
 #include "platform_helper.h"
 #include "writesame.h"
 
-bool is_Write_Same_Supported(tDevice *device, M_ATTR_UNUSED uint64_t startingLBA, uint64_t requesedNumberOfLogicalBlocks, uint64_t *maxNumberOfLogicalBlocksPerCommand)
+//Only reads what the device reports, which does not depend on the range. When the block limits VPD page reports the max write same length,
+//blockLimitsReported is set and is_Write_Same_Supported decides support for each requested range from it and the WSNZ bit.
+static bool read_Write_Same_Support(tDevice *device, uint64_t *maxNumberOfLogicalBlocksPerCommand, bool *blockLimitsReported, bool *wsnz)
 {
     bool supported = false;
     if (device->drive_info.drive_type == ATA_DRIVE)
@@ -167,31 +169,9 @@ bool is_Write_Same_Supported(tDevice *device, M_ATTR_UNUSED uint64_t startingLBA
                     uint16_t pageLength = M_BytesTo2ByteValue(blockLimits[2], blockLimits[3]);
                     if (pageLength >= 0x3C)//earlier specs, this page was shorter
                     {
-                        bool wsnz = M_ToBool(blockLimits[4] & BIT0);
+                        *wsnz = M_ToBool(blockLimits[4] & BIT0);
                         *maxNumberOfLogicalBlocksPerCommand = M_BytesTo8ByteValue(blockLimits[36], blockLimits[37], blockLimits[38], blockLimits[39], blockLimits[40], blockLimits[41], blockLimits[42], blockLimits[43]);
-                        if (*maxNumberOfLogicalBlocksPerCommand >= requesedNumberOfLogicalBlocks)
-                        {
-                            if (*maxNumberOfLogicalBlocksPerCommand > UINT32_MAX && wsnz)
-                            {
-                                //this case is that the drive supports a range LARGER than is allowed in a single command and a range must be specified...which is weird, but stupid.
-                                supported = false;
-                            }
-                            else
-                            {
-                                supported = true;
-                            }
-                        }
-                        else if (*maxNumberOfLogicalBlocksPerCommand == 0 && !wsnz)//checking for write-same non-zero bit. If this is set, then there SHOULD be a limit listed. If not, then I guess this is not supported on this device-TJE
-                        {
-                            //Device does not report a limit. This can be a backwards-compatible thing, or it could mean the device supports any length.
-                            //Because of this, call it supported since we don't have any reason to otherwise think write same is not supported.
-                            supported = true;
-                        }
-                        else
-                        {
-                            //This case should only be hit when the requested range is larger than the device supports, or no max range was reported AND the WSNZ bit is set (meaning the command is not really supported)
-                            supported = false;
-                        }
+                        *blockLimitsReported = true;
                     }
                 }
                 safe_Free_aligned(blockLimits)
@@ -201,6 +181,49 @@ bool is_Write_Same_Supported(tDevice *device, M_ATTR_UNUSED uint64_t startingLBA
     return supported;
 }
 
+bool is_Write_Same_Supported(tDevice *device, M_ATTR_UNUSED uint64_t startingLBA, uint64_t requesedNumberOfLogicalBlocks, uint64_t *maxNumberOfLogicalBlocksPerCommand)
+{
+    capabilityCache *capabilities = &device->drive_info.capabilities;
+    bool supported = false;
+    if (!capabilities->writeSameValid)
+    {
+        //Only what the device reports is cached. The requested range is checked against it below on every call.
+        uint64_t maxLBAs = 0;
+        bool blockLimitsReported = false;
+        bool wsnz = false;
+        capabilities->writeSameSupported = read_Write_Same_Support(device, &maxLBAs, &blockLimitsReported, &wsnz);
+        capabilities->writeSameMaxLBAsPerCommand = maxLBAs;
+        capabilities->writeSameBlockLimitsReported = blockLimitsReported;
+        capabilities->writeSameNonZero = wsnz;
+        capabilities->writeSameValid = true;
+    }
+    supported = capabilities->writeSameSupported;
+    if (capabilities->writeSameBlockLimitsReported)
+    {
+        if (capabilities->writeSameMaxLBAsPerCommand >= requesedNumberOfLogicalBlocks)
+        {
+            //a max larger than a single command can specify while a range must be specified (WSNZ) is weird, but cannot be used
+            supported = !(capabilities->writeSameMaxLBAsPerCommand > UINT32_MAX && capabilities->writeSameNonZero);
+        }
+        else if (capabilities->writeSameMaxLBAsPerCommand == 0 && !capabilities->writeSameNonZero)//checking for write-same non-zero bit. If this is set, then there SHOULD be a limit listed. If not, then I guess this is not supported on this device-TJE
+        {
+            //Device does not report a limit. This can be a backwards-compatible thing, or it could mean the device supports any length.
+            //Because of this, call it supported since we don't have any reason to otherwise think write same is not supported.
+            supported = true;
+        }
+        else
+        {
+            //the requested range is larger than the device supports, or no max range was reported AND the WSNZ bit is set (meaning the command is not really supported)
+            supported = false;
+        }
+    }
+    if (maxNumberOfLogicalBlocksPerCommand)
+    {
+        *maxNumberOfLogicalBlocksPerCommand = capabilities->writeSameMaxLBAsPerCommand;
+    }
+    return supported;
+}
+
 //we need to know where we started at and the range in order to properly calculate progress
 int get_Writesame_Progress(tDevice *device, double *progress, bool *writeSameInProgress, uint64_t startingLBA, uint64_t range)
 {
@@ -387,19 +410,24 @@ int writesame(tDevice *device, uint64_t startingLba, uint64_t numberOfLogicalBlo
     //first check if the device supports the write same command
     if (is_Write_Same_Supported(device, startingLba, numberOfLogicalBlocks, &maxWriteSameRange) && (maxWriteSameRange >= numberOfLogicalBlocks || maxWriteSameRange == 0 || (startingLba + numberOfLogicalBlocks) == (device->drive_info.deviceMaxLba + UINT64_C(1))))
     {
-        uint32_t zeroPatternBufLen = 0;
-        uint8_t *zeroPatternBuf = NULL;
+        uint32_t patternBufLen = 0;
+        uint8_t *patternBuf = NULL;
         if (device->drive_info.drive_type != ATA_DRIVE)
         {
-            if (!pattern && patternLength != device->drive_info.deviceBlockSize)
+            if (!pattern || patternLength != device->drive_info.deviceBlockSize)
             {
                 //only allocate this memory for SCSI drives because they need a sector telling what to use as a pattern, whereas ATA has a feature that does not require this, and why bother sending an extra command/data transfer when it isn't neded for our application
-                zeroPatternBufLen = device->drive_info.deviceBlockSize;
-                zeroPatternBuf = C_CAST(uint8_t*, calloc_aligned(zeroPatternBufLen, sizeof(uint8_t), device->os_info.minimumAlignment));
-                if (!zeroPatternBuf)
+                patternBufLen = device->drive_info.deviceBlockSize;
+                patternBuf = C_CAST(uint8_t*, calloc_aligned(patternBufLen, sizeof(uint8_t), device->os_info.minimumAlignment));
+                if (!patternBuf)
                 {
                     perror("Error allocating logical sector sized buffer for zero pattern\n");
                 }
+                else if (pattern && patternLength > 0)
+                {
+                    //a pattern shorter (or longer) than a sector was given, so repeat it across the whole sector instead of quietly writing zeros
+                    fill_Pattern_Buffer_Into_Another_Buffer(pattern, M_Min(patternLength, patternBufLen), patternBuf, patternBufLen);
+                }
             }
             if ((startingLba + numberOfLogicalBlocks) == (device->drive_info.deviceMaxLba + UINT64_C(1)))//adding 1 since a FULL write same should be every sector including the maxLBA due to zero indexing.
             {
@@ -415,7 +443,7 @@ int writesame(tDevice *device, uint64_t startingLba, uint64_t numberOfLogicalBlo
         }
         else
         {
-            ret = write_Same(device, startingLba, numberOfLogicalBlocks, zeroPatternBuf);//null for the pattern means we'll write a bunch of zeros
+            ret = write_Same(device, startingLba, numberOfLogicalBlocks, patternBuf);//null for the pattern means we'll write a bunch of zeros
         }
         //if the user wants us to poll for progress, then start polling
         if (ret == SUCCESS && pollForProgress && device->drive_info.drive_type == ATA_DRIVE)
@@ -473,7 +501,7 @@ int writesame(tDevice *device, uint64_t startingLba, uint64_t numberOfLogicalBlo
                 delay_Seconds(delayTime);
             }
         }
-        safe_Free_aligned(zeroPatternBuf)
+        safe_Free_aligned(patternBuf)
     }
     else
     {
@@ -0,0 +1,126 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file ata_taskfile_lba_test.c
+// \brief Builds 48bit LBA ATA commands for an LBA above 2^32 and decodes the LBA back out of the taskfile that would be sent to the drive.
+//        The passthrough layer is replaced with a stub that keeps a copy of the taskfile, so no drive is needed.
+//        Build and run from the repository root:
+//        gcc -std=gnu11 -D_GNU_SOURCE -Ioc/include/common -Ioc/include/operation -idirafter oc/include/transport oc/tests/ata_taskfile_lba_test.c oc/transport/ata_cmds.c -o ata_taskfile_lba_test && ./ata_taskfile_lba_test
+
+#include "ata_helper_func.h"
+#include "scsi_helper.h"
+#include "sat_helper_func.h"
+#include "psp_legacy_helper.h"
+#include "cypress_legacy_helper.h"
+#include "prolific_legacy_helper.h"
+#include "ti_legacy_helper.h"
+#include "nec_legacy_helper.h"
+#include "csmi_legacy_pt_cdb_helper.h"
+
+#define TEST_LBA UINT64_C(0x0000123456789ABC)
+
+static ataTFRBlock lastTaskfile;
+static uint32_t commandsCaptured = 0;
+
+//Passthrough stub. The device is set up as SAT so every command built in ata_cmds.c ends up here.
+int send_SAT_Passthrough_Command(tDevice *device, ataPassthroughCommand  *ataCommandOptions)
+{
+    M_USE_UNUSED(device);
+    memcpy(&lastTaskfile, &ataCommandOptions->tfr, sizeof(ataTFRBlock));
+    ++commandsCaptured;
+    return SUCCESS;
+}
+
+//Everything below is only here so that ata_cmds.c links. None of it is reached by the commands tested.
+int send_PSP_Legacy_Passthrough_Command(tDevice *device, ataPassthroughCommand *ataCommandOptions) { M_USE_UNUSED(device); M_USE_UNUSED(ataCommandOptions); return NOT_SUPPORTED; }
+int send_Cypress_Legacy_Passthrough_Command(tDevice *device, ataPassthroughCommand *ataCommandOptions) { M_USE_UNUSED(device); M_USE_UNUSED(ataCommandOptions); return NOT_SUPPORTED; }
+int send_Prolific_Legacy_Passthrough_Command(tDevice *device, ataPassthroughCommand *ataCommandOptions) { M_USE_UNUSED(device); M_USE_UNUSED(ataCommandOptions); return NOT_SUPPORTED; }
+int send_TI_Legacy_Passthrough_Command(tDevice *device, ataPassthroughCommand *ataCommandOptions) { M_USE_UNUSED(device); M_USE_UNUSED(ataCommandOptions); return NOT_SUPPORTED; }
+int send_NEC_Legacy_Passthrough_Command(tDevice *device, ataPassthroughCommand *ataCommandOptions) { M_USE_UNUSED(device); M_USE_UNUSED(ataCommandOptions); return NOT_SUPPORTED; }
+int send_CSMI_Legacy_ATA_Passthrough(tDevice *device, ataPassthroughCommand  *ataCommandOptions) { M_USE_UNUSED(device); M_USE_UNUSED(ataCommandOptions); return NOT_SUPPORTED; }
+bool os_Is_Infinite_Timeout_Supported(void) { return false; }
+void print_Return_Enum(char *funcName, int ret) { M_USE_UNUSED(funcName); M_USE_UNUSED(ret); }
+void delay_Milliseconds(uint32_t milliseconds) { M_USE_UNUSED(milliseconds); }
+bool is_Checksum_Valid(uint8_t *ptrData, uint32_t dataSize, uint32_t *firstInvalidSector) { M_USE_UNUSED(ptrData); M_USE_UNUSED(dataSize); M_USE_UNUSED(firstInvalidSector); return true; }
+void *calloc_aligned(size_t num, size_t size, size_t alignment) { M_USE_UNUSED(alignment); return calloc(num, size); }
+void free_aligned(void* ptr) { free(ptr); }
+bool read_Page_Cache(tDevice *device, ePageCacheSource source, uint32_t address, uint32_t page, uint64_t qualifier, uint8_t *ptrData, uint32_t dataSize)
+{
+    M_USE_UNUSED(device); M_USE_UNUSED(source); M_USE_UNUSED(address); M_USE_UNUSED(page); M_USE_UNUSED(qualifier); M_USE_UNUSED(ptrData); M_USE_UNUSED(dataSize);
+    return false;
+}
+void write_Page_Cache(tDevice *device, ePageCacheSource source, uint32_t address, uint32_t page, uint64_t qualifier, const uint8_t *ptrData, uint32_t dataSize)
+{
+    M_USE_UNUSED(device); M_USE_UNUSED(source); M_USE_UNUSED(address); M_USE_UNUSED(page); M_USE_UNUSED(qualifier); M_USE_UNUSED(ptrData); M_USE_UNUSED(dataSize);
+}
+
+static uint64_t decode_Taskfile_LBA(ataTFRBlock *tfr)
+{
+    return M_BytesTo8ByteValue(0, 0, tfr->LbaHi48, tfr->LbaMid48, tfr->LbaLow48, tfr->LbaHi, tfr->LbaMid, tfr->LbaLow);
+}
+
+static int check_Taskfile_LBA(const char *commandName, int ret, uint32_t capturedBefore)
+{
+    uint64_t decodedLBA = decode_Taskfile_LBA(&lastTaskfile);
+    if (ret != SUCCESS || commandsCaptured != capturedBefore + 1)
+    {
+        printf("FAIL: %s was not sent\n", commandName);
+        return 1;
+    }
+    if (decodedLBA != TEST_LBA)
+    {
+        printf("FAIL: %s LBA decoded as %" PRIX64 "h, expected %" PRIX64 "h\n", commandName, decodedLBA, TEST_LBA);
+        return 1;
+    }
+    printf("PASS: %s\n", commandName);
+    return 0;
+}
+
+int main(void)
+{
+    int failures = 0;
+    uint32_t capturedBefore = 0;
+    uint8_t data[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+    tDevice device;
+    memset(&device, 0, sizeof(tDevice));
+    device.drive_info.drive_type = ATA_DRIVE;
+    device.drive_info.deviceBlockSize = LEGACY_DRIVE_SEC_SIZE;
+    device.drive_info.passThroughHacks.passthroughType = ATA_PASSTHROUGH_SAT;
+
+    capturedBefore = commandsCaptured;
+    failures += check_Taskfile_LBA("Zeros Ext", ata_Zeros_Ext(&device, 1, TEST_LBA, false), capturedBefore);
+
+    capturedBefore = commandsCaptured;
+    failures += check_Taskfile_LBA("Remove Element And Truncate", ata_Remove_Element_And_Truncate(&device, 1, TEST_LBA), capturedBefore);
+
+    capturedBefore = commandsCaptured;
+    failures += check_Taskfile_LBA("NCQ Non Data", ata_NCQ_Non_Data(&device, 0, 0, 0, 1, TEST_LBA, 0), capturedBefore);
+
+    capturedBefore = commandsCaptured;
+    failures += check_Taskfile_LBA("Receive FPDMA Queued", ata_NCQ_Receive_FPDMA_Queued(&device, 1, 1, 0, 1, TEST_LBA, 0, data), capturedBefore);
+
+    capturedBefore = commandsCaptured;
+    failures += check_Taskfile_LBA("Send FPDMA Queued", ata_NCQ_Send_FPDMA_Queued(&device, 1, 1, 0, 1, TEST_LBA, 0, data), capturedBefore);
+
+    capturedBefore = commandsCaptured;
+    failures += check_Taskfile_LBA("Read FPDMA Queued", ata_NCQ_Read_FPDMA_Queued(&device, false, TEST_LBA, data, 1, 0, 1, 0), capturedBefore);
+
+    capturedBefore = commandsCaptured;
+    failures += check_Taskfile_LBA("Write FPDMA Queued", ata_NCQ_Write_FPDMA_Queued(&device, false, TEST_LBA, data, 1, 0, 1, 0), capturedBefore);
+
+    if (failures)
+    {
+        printf("%d command(s) put the wrong LBA in the taskfile\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("All commands put the LBA in the taskfile correctly\n");
+    return EXIT_SUCCESS;
+}
@@ -316,6 +316,21 @@ int ata_Read_Log_Ext(tDevice *device, uint8_t logAddress, uint16_t pageNumber, u
     int ret = UNKNOWN;
     ataPassthroughCommand ataCommandOptions;
 
+    if (device->drive_info.pageCache && ptrData && dataSize >= LEGACY_DRIVE_SEC_SIZE && dataSize % LEGACY_DRIVE_SEC_SIZE == 0)
+    {
+        //pages are cached individually so that a single page request can be answered from a larger read of the whole log
+        bool cached = true;
+        uint32_t pageIter = 0;
+        for (pageIter = 0; cached && pageIter < dataSize / LEGACY_DRIVE_SEC_SIZE; ++pageIter)
+        {
+            cached = read_Page_Cache(device, PAGE_CACHE_ATA_GPL_LOG, logAddress, pageNumber + pageIter, featureRegister, &ptrData[pageIter * LEGACY_DRIVE_SEC_SIZE], LEGACY_DRIVE_SEC_SIZE);
+        }
+        if (cached)
+        {
+            return SUCCESS;
+        }
+    }
+
     if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
     {
         if (useDMA)
@@ -417,6 +432,15 @@ int ata_Read_Log_Ext(tDevice *device, uint8_t logAddress, uint16_t pageNumber, u
         }
     }
 
+    if (ret == SUCCESS && device->drive_info.pageCache)
+    {
+        uint32_t pageIter = 0;
+        for (pageIter = 0; pageIter < dataSize / LEGACY_DRIVE_SEC_SIZE; ++pageIter)
+        {
+            write_Page_Cache(device, PAGE_CACHE_ATA_GPL_LOG, logAddress, pageNumber + pageIter, featureRegister, &ptrData[pageIter * LEGACY_DRIVE_SEC_SIZE], LEGACY_DRIVE_SEC_SIZE);
+        }
+    }
+
     if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
     {
         if (useDMA)
@@ -718,7 +742,12 @@ int ata_SMART_Command(tDevice *device, uint8_t feature, uint8_t lbaLo, uint8_t *
 
 int ata_SMART_Read_Log(tDevice *device, uint8_t logAddress, uint8_t *ptrData, uint32_t dataSize)
 {
-    int ret = ata_SMART_Command(device, ATA_SMART_READ_LOG, logAddress, ptrData, dataSize, 15, false, 0);
+    int ret = UNKNOWN;
+    if (read_Page_Cache(device, PAGE_CACHE_ATA_SMART_LOG, logAddress, 0, 0, ptrData, dataSize))
+    {
+        return SUCCESS;
+    }
+    ret = ata_SMART_Command(device, ATA_SMART_READ_LOG, logAddress, ptrData, dataSize, 15, false, 0);
     if (ret == SUCCESS)
     {
         uint32_t invalidSec = 0;
@@ -743,6 +772,10 @@ int ata_SMART_Read_Log(tDevice *device, uint8_t logAddress, uint8_t *ptrData, ui
             break;
         }
     }
+    if (ret == SUCCESS)
+    {
+        write_Page_Cache(device, PAGE_CACHE_ATA_SMART_LOG, logAddress, 0, 0, ptrData, dataSize);
+    }
     return ret;
 }
 int ata_SMART_Write_Log(tDevice *device, uint8_t logAddress, uint8_t *ptrData, uint32_t dataSize, bool forceRTFRs)
@@ -757,7 +790,12 @@ int ata_SMART_Offline(tDevice *device, uint8_t subcommand, uint32_t timeout)
 
 int ata_SMART_Read_Data(tDevice *device, uint8_t *ptrData, uint32_t dataSize)
 {
-    int ret = ata_SMART_Command(device, ATA_SMART_READ_DATA, 0, ptrData, dataSize, 15, false, 0);
+    int ret = UNKNOWN;
+    if (read_Page_Cache(device, PAGE_CACHE_ATA_SMART_DATA, 0, 0, 0, ptrData, dataSize))
+    {
+        return SUCCESS;
+    }
+    ret = ata_SMART_Command(device, ATA_SMART_READ_DATA, 0, ptrData, dataSize, 15, false, 0);
     if (ret == SUCCESS)
     {
         uint32_t invalidSec = 0;
@@ -770,6 +808,10 @@ int ata_SMART_Read_Data(tDevice *device, uint8_t *ptrData, uint32_t dataSize)
                 printf("Warning: Checksum is invalid\n");
             }
         }
+        else
+        {
+            write_Page_Cache(device, PAGE_CACHE_ATA_SMART_DATA, 0, 0, 0, ptrData, dataSize);
+        }
     }
     return ret;
 }
@@ -791,7 +833,12 @@ int ata_SMART_Disable_Operations(tDevice *device)
 
 int ata_SMART_Read_Thresholds(tDevice *device, uint8_t *ptrData, uint32_t dataSize)
 {
-    int ret = ata_SMART_Command(device, ATA_SMART_RDATTR_THRESH, 0, ptrData, dataSize, 15, false, 0);
+    int ret = UNKNOWN;
+    if (read_Page_Cache(device, PAGE_CACHE_ATA_SMART_THRESHOLDS, 0, 0, 0, ptrData, dataSize))
+    {
+        return SUCCESS;
+    }
+    ret = ata_SMART_Command(device, ATA_SMART_RDATTR_THRESH, 0, ptrData, dataSize, 15, false, 0);
     if (ret == SUCCESS)
     {
         uint32_t invalidSec = 0;
@@ -804,6 +851,10 @@ int ata_SMART_Read_Thresholds(tDevice *device, uint8_t *ptrData, uint32_t dataSi
                 printf("Warning: Checksum is invalid\n");
             }
         }
+        else
+        {
+            write_Page_Cache(device, PAGE_CACHE_ATA_SMART_THRESHOLDS, 0, 0, 0, ptrData, dataSize);
+        }
     }
     return ret;
 }
@@ -1885,7 +1936,7 @@ int ata_Configure_Stream(tDevice *device, uint8_t streamID, bool addRemoveStream
     //set default cctl
     ataCommandOptions.tfr.Feature48 = defaultCCTL;
     //set stream ID
-    ataCommandOptions.tfr.ErrorFeature = streamID & 0x03;//stream ID is specified by bits 2:0
+    ataCommandOptions.tfr.ErrorFeature = streamID & 0x07;//stream ID is specified by bits 2:0
     //set add/remove stream bit
     if (addRemoveStreamBit)
     {
@@ -4595,10 +4646,10 @@ int ata_Zeros_Ext(tDevice *device, uint16_t numberOfLogicalSectors, uint64_t lba
     ataCommandOptions.tfr.SectorCount48 = M_Byte1(numberOfLogicalSectors);
     ataCommandOptions.tfr.LbaLow = M_Byte0(lba);
     ataCommandOptions.tfr.LbaMid = M_Byte1(lba);
-    ataCommandOptions.tfr.LbaHi = M_Byte3(lba);
-    ataCommandOptions.tfr.LbaLow48 = M_Byte4(lba);
-    ataCommandOptions.tfr.LbaMid48 = M_Byte5(lba);
-    ataCommandOptions.tfr.LbaHi48 = M_Byte6(lba);
+    ataCommandOptions.tfr.LbaHi = M_Byte2(lba);
+    ataCommandOptions.tfr.LbaLow48 = M_Byte3(lba);
+    ataCommandOptions.tfr.LbaMid48 = M_Byte4(lba);
+    ataCommandOptions.tfr.LbaHi48 = M_Byte5(lba);
     ataCommandOptions.tfr.DeviceHead = DEVICE_REG_BACKWARDS_COMPATIBLE_BITS;
     ataCommandOptions.tfr.DeviceHead |= LBA_MODE_BIT;
     if (device->drive_info.ata_Options.isDevice1)
@@ -4753,10 +4804,10 @@ int ata_Remove_Element_And_Truncate(tDevice *device, uint32_t elementIdentifier,
     }
     ataCommandOptions.tfr.LbaLow = M_Byte0(requestedMaxLBA);
     ataCommandOptions.tfr.LbaMid = M_Byte1(requestedMaxLBA);
-    ataCommandOptions.tfr.LbaHi = M_Byte3(requestedMaxLBA);
-    ataCommandOptions.tfr.LbaLow48 = M_Byte4(requestedMaxLBA);
-    ataCommandOptions.tfr.LbaMid48 = M_Byte5(requestedMaxLBA);
-    ataCommandOptions.tfr.LbaHi48 = M_Byte6(requestedMaxLBA);
+    ataCommandOptions.tfr.LbaHi = M_Byte2(requestedMaxLBA);
+    ataCommandOptions.tfr.LbaLow48 = M_Byte3(requestedMaxLBA);
+    ataCommandOptions.tfr.LbaMid48 = M_Byte4(requestedMaxLBA);
+    ataCommandOptions.tfr.LbaHi48 = M_Byte5(requestedMaxLBA);
     
     
     if (device->drive_info.ata_Options.isDevice1)
@@ -4852,10 +4903,10 @@ int ata_NCQ_Non_Data(tDevice *device, uint8_t subCommand /*bits 4:0*/, uint16_t
     ataCommandOptions.tfr.SectorCount = ncqTag << 3;//shift into bits 7:3
     ataCommandOptions.tfr.LbaLow = M_Byte0(lba);
     ataCommandOptions.tfr.LbaMid = M_Byte1(lba);
-    ataCommandOptions.tfr.LbaHi = M_Byte3(lba);
-    ataCommandOptions.tfr.LbaLow48 = M_Byte4(lba);
-    ataCommandOptions.tfr.LbaMid48 = M_Byte5(lba);
-    ataCommandOptions.tfr.LbaHi48 = M_Byte6(lba);
+    ataCommandOptions.tfr.LbaHi = M_Byte2(lba);
+    ataCommandOptions.tfr.LbaLow48 = M_Byte3(lba);
+    ataCommandOptions.tfr.LbaMid48 = M_Byte4(lba);
+    ataCommandOptions.tfr.LbaHi48 = M_Byte5(lba);
     ataCommandOptions.tfr.aux1 = M_Byte0(auxilary);
     ataCommandOptions.tfr.aux2 = M_Byte1(auxilary);
     ataCommandOptions.tfr.aux3 = M_Byte2(auxilary);
@@ -4929,10 +4980,10 @@ int ata_NCQ_Receive_FPDMA_Queued(tDevice *device, uint8_t subCommand /*bits 5:0*
     ataCommandOptions.tfr.SectorCount = ncqTag << 3;//shift into bits 7:3
     ataCommandOptions.tfr.LbaLow = M_Byte0(lba);
     ataCommandOptions.tfr.LbaMid = M_Byte1(lba);
-    ataCommandOptions.tfr.LbaHi = M_Byte3(lba);
-    ataCommandOptions.tfr.LbaLow48 = M_Byte4(lba);
-    ataCommandOptions.tfr.LbaMid48 = M_Byte5(lba);
-    ataCommandOptions.tfr.LbaHi48 = M_Byte6(lba);
+    ataCommandOptions.tfr.LbaHi = M_Byte2(lba);
+    ataCommandOptions.tfr.LbaLow48 = M_Byte3(lba);
+    ataCommandOptions.tfr.LbaMid48 = M_Byte4(lba);
+    ataCommandOptions.tfr.LbaHi48 = M_Byte5(lba);
     ataCommandOptions.tfr.aux1 = M_Byte0(auxilary);
     ataCommandOptions.tfr.aux2 = M_Byte1(auxilary);
     ataCommandOptions.tfr.aux3 = M_Byte2(auxilary);
@@ -4992,10 +5043,10 @@ int ata_NCQ_Send_FPDMA_Queued(tDevice *device, uint8_t subCommand /*bits 5:0*/,
     ataCommandOptions.tfr.SectorCount = ncqTag << 3;//shift into bits 7:3
     ataCommandOptions.tfr.LbaLow = M_Byte0(lba);
     ataCommandOptions.tfr.LbaMid = M_Byte1(lba);
-    ataCommandOptions.tfr.LbaHi = M_Byte3(lba);
-    ataCommandOptions.tfr.LbaLow48 = M_Byte4(lba);
-    ataCommandOptions.tfr.LbaMid48 = M_Byte5(lba);
-    ataCommandOptions.tfr.LbaHi48 = M_Byte6(lba);
+    ataCommandOptions.tfr.LbaHi = M_Byte2(lba);
+    ataCommandOptions.tfr.LbaLow48 = M_Byte3(lba);
+    ataCommandOptions.tfr.LbaMid48 = M_Byte4(lba);
+    ataCommandOptions.tfr.LbaHi48 = M_Byte5(lba);
     ataCommandOptions.tfr.aux1 = M_Byte0(auxilary);
     ataCommandOptions.tfr.aux2 = M_Byte1(auxilary);
     ataCommandOptions.tfr.aux3 = M_Byte2(auxilary);
@@ -5066,10 +5117,10 @@ int ata_NCQ_Read_FPDMA_Queued(tDevice *device, bool fua, uint64_t lba, uint8_t *
     ataCommandOptions.tfr.SectorCount = ncqTag << 3;//shift into bits 7:3
     ataCommandOptions.tfr.LbaLow = M_Byte0(lba);
     ataCommandOptions.tfr.LbaMid = M_Byte1(lba);
-    ataCommandOptions.tfr.LbaHi = M_Byte3(lba);
-    ataCommandOptions.tfr.LbaLow48 = M_Byte4(lba);
-    ataCommandOptions.tfr.LbaMid48 = M_Byte5(lba);
-    ataCommandOptions.tfr.LbaHi48 = M_Byte6(lba);
+    ataCommandOptions.tfr.LbaHi = M_Byte2(lba);
+    ataCommandOptions.tfr.LbaLow48 = M_Byte3(lba);
+    ataCommandOptions.tfr.LbaMid48 = M_Byte4(lba);
+    ataCommandOptions.tfr.LbaHi48 = M_Byte5(lba);
     ataCommandOptions.tfr.aux1 = RESERVED;
     ataCommandOptions.tfr.aux2 = RESERVED;
     ataCommandOptions.tfr.aux3 = RESERVED;
@@ -5126,10 +5177,10 @@ int ata_NCQ_Write_FPDMA_Queued(tDevice *device, bool fua, uint64_t lba, uint8_t
     ataCommandOptions.tfr.SectorCount = ncqTag << 3;//shift into bits 7:3
     ataCommandOptions.tfr.LbaLow = M_Byte0(lba);
     ataCommandOptions.tfr.LbaMid = M_Byte1(lba);
-    ataCommandOptions.tfr.LbaHi = M_Byte3(lba);
-    ataCommandOptions.tfr.LbaLow48 = M_Byte4(lba);
-    ataCommandOptions.tfr.LbaMid48 = M_Byte5(lba);
-    ataCommandOptions.tfr.LbaHi48 = M_Byte6(lba);
+    ataCommandOptions.tfr.LbaHi = M_Byte2(lba);
+    ataCommandOptions.tfr.LbaLow48 = M_Byte3(lba);
+    ataCommandOptions.tfr.LbaMid48 = M_Byte4(lba);
+    ataCommandOptions.tfr.LbaHi48 = M_Byte5(lba);
     ataCommandOptions.tfr.aux1 = RESERVED;
     ataCommandOptions.tfr.aux2 = RESERVED;
     ataCommandOptions.tfr.aux3 = RESERVED;
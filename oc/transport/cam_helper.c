@@ -68,6 +68,7 @@ int get_Device( const char *filename, tDevice *device )
 	char *deviceHandle = NULL;
 	deviceHandle = strdup(filename);
 	device->os_info.cam_dev = NULL;//initialize this to NULL (which it already should be) just to make sure everything else functions as expected
+	device->bufferPool = NULL;//only enable_Device_Buffer_Pool creates one
 #if !defined(DISABLE_NVME_PASSTHROUGH)
 	struct nvme_get_nsid gnsid;
 
@@ -943,6 +944,7 @@ static int ada_filter( const struct dirent *entry )
 
 int close_Device(tDevice *dev)
 {
+    disable_Device_Buffer_Pool(dev);
     if (dev->os_info.cam_dev)
     {
         cam_close_device(dev->os_info.cam_dev);
@@ -257,6 +257,8 @@ int fill_Drive_Info_Data(tDevice *device)
             status = BAD_PARAMETER;
             return status;
         }
+        //discovery is starting over, so anything previously cached may not apply anymore
+        invalidate_Capability_Cache(device);
         switch (device->drive_info.interface_type)
         {
         case IDE_INTERFACE:
@@ -478,6 +480,11 @@ int firmware_Download_Command(tDevice *device, eDownloadMode dlMode, uint32_t of
         ret = NOT_SUPPORTED;
         break;
     }
+    if (ret == SUCCESS && (dlMode == DL_FW_ACTIVATE || lastSegment))
+    {
+        //new firmware may be running now, so any cached capabilities need to be read from the device again
+        invalidate_Capability_Cache(device);
+    }
 #ifdef _DEBUG
     printf("<--%s (%d)\n",__FUNCTION__, ret);
 #endif
@@ -741,6 +748,10 @@ int write_Same(tDevice *device, uint64_t startingLba, uint64_t numberOfLogicalBl
 bool is_Write_Psuedo_Uncorrectable_Supported(tDevice *device)
 {
     bool supported = false;
+    if (device->drive_info.capabilities.writePsuedoUncorrectableValid)
+    {
+        return device->drive_info.capabilities.writePsuedoUncorrectableSupported;
+    }
     switch (device->drive_info.drive_type)
     {
     case ATA_DRIVE:
@@ -770,6 +781,8 @@ bool is_Write_Psuedo_Uncorrectable_Supported(tDevice *device)
     default:
         break;
     }
+    device->drive_info.capabilities.writePsuedoUncorrectableSupported = supported;
+    device->drive_info.capabilities.writePsuedoUncorrectableValid = true;
     return supported;
 }
 
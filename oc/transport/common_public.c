@@ -1965,6 +1965,126 @@ uint64_t align_LBA(tDevice *device, uint64_t LBA)
     return LBA;
 }
 
+void invalidate_Capability_Cache(tDevice *device)
+{
+    if (device)
+    {
+        memset(&device->drive_info.capabilities, 0, sizeof(capabilityCache));
+    }
+}
+
+int attach_Page_Cache(tDevice *device)
+{
+    if (!device || device->drive_info.pageCache)
+    {
+        return BAD_PARAMETER;
+    }
+    device->drive_info.pageCache = C_CAST(ptrPageCache, calloc(1, sizeof(pageCache)));
+    if (!device->drive_info.pageCache)
+    {
+        return MEMORY_FAILURE;
+    }
+    return SUCCESS;
+}
+
+void detach_Page_Cache(tDevice *device)
+{
+    if (device && device->drive_info.pageCache)
+    {
+        uint32_t entryIter = 0;
+        for (entryIter = 0; entryIter < device->drive_info.pageCache->numberOfEntries; ++entryIter)
+        {
+            safe_Free(device->drive_info.pageCache->entries[entryIter].data)
+        }
+        safe_Free(device->drive_info.pageCache->entries)
+        safe_Free(device->drive_info.pageCache)
+    }
+}
+
+static ptrPageCacheEntry find_Page_Cache_Entry(ptrPageCache cache, ePageCacheSource source, uint32_t address, uint32_t page, uint64_t qualifier)
+{
+    uint32_t entryIter = 0;
+    for (entryIter = 0; entryIter < cache->numberOfEntries; ++entryIter)
+    {
+        ptrPageCacheEntry entry = &cache->entries[entryIter];
+        if (entry->source == source && entry->address == address && entry->page == page && entry->qualifier == qualifier)
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+bool read_Page_Cache(tDevice *device, ePageCacheSource source, uint32_t address, uint32_t page, uint64_t qualifier, uint8_t *ptrData, uint32_t dataSize)
+{
+    ptrPageCacheEntry entry = NULL;
+    if (!device || !device->drive_info.pageCache || !ptrData || dataSize == 0)
+    {
+        return false;
+    }
+    entry = find_Page_Cache_Entry(device->drive_info.pageCache, source, address, page, qualifier);
+    if (!entry || entry->length < dataSize)
+    {
+        ++(device->drive_info.pageCache->misses);
+        return false;
+    }
+    memcpy(ptrData, entry->data, dataSize);
+    ++(device->drive_info.pageCache->hits);
+    return true;
+}
+
+void write_Page_Cache(tDevice *device, ePageCacheSource source, uint32_t address, uint32_t page, uint64_t qualifier, const uint8_t *ptrData, uint32_t dataSize)
+{
+    ptrPageCache cache = NULL;
+    ptrPageCacheEntry entry = NULL;
+    uint8_t *data = NULL;
+    if (!device || !device->drive_info.pageCache || !ptrData || dataSize == 0)
+    {
+        return;
+    }
+    cache = device->drive_info.pageCache;
+    entry = find_Page_Cache_Entry(cache, source, address, page, qualifier);
+    if (entry && entry->length >= dataSize)
+    {
+        //already holding at least this much
+        return;
+    }
+    //Failing to cache is not an error. The next request will just go to the device.
+    data = C_CAST(uint8_t*, malloc(dataSize));
+    if (!data)
+    {
+        return;
+    }
+    memcpy(data, ptrData, dataSize);
+    if (!entry)
+    {
+        if (cache->numberOfEntries == cache->entriesAllocated)
+        {
+            uint32_t newCount = cache->entriesAllocated > 0 ? cache->entriesAllocated * 2 : 16;
+            ptrPageCacheEntry temp = C_CAST(ptrPageCacheEntry, realloc(cache->entries, newCount * sizeof(pageCacheEntry)));
+            if (!temp)
+            {
+                safe_Free(data)
+                return;
+            }
+            cache->entries = temp;
+            cache->entriesAllocated = newCount;
+        }
+        entry = &cache->entries[cache->numberOfEntries];
+        ++(cache->numberOfEntries);
+        entry->source = source;
+        entry->address = address;
+        entry->page = page;
+        entry->qualifier = qualifier;
+    }
+    else
+    {
+        safe_Free(entry->data)
+    }
+    entry->data = data;
+    entry->length = dataSize;
+}
+
 
 int remove_Duplicate_Devices(tDevice *deviceList, volatile uint32_t * numberOfDevices, removeDuplicateDriveType rmvDevFlag)
 {
@@ -4441,3 +4561,119 @@ bool setup_Passthrough_Hacks_By_ID(tDevice *device)
     }
     return success;
 }
+
+static void clear_Last_Command_Results(tDevice *device)
+{
+    memset(&device->drive_info.lastCommandRTFRs, 0, sizeof(ataReturnTFRs));
+    memset(&device->drive_info.ataSenseData, 0, sizeof(device->drive_info.ataSenseData));
+    memset(device->drive_info.lastCommandSenseData, 0, SPC3_SENSE_LEN);
+    memset(&device->drive_info.lastNVMeResult, 0, sizeof(device->drive_info.lastNVMeResult));
+    device->drive_info.lastCommandTimeNanoSeconds = 0;
+    device->os_info.last_error = 0;
+}
+
+tDevice* clone_Device_For_Thread(tDevice *device)
+{
+    tDevice *clone = NULL;
+    if (!device)
+    {
+        return NULL;
+    }
+    clone = C_CAST(tDevice*, malloc(sizeof(tDevice)));
+    if (clone)
+    {
+        //A shallow copy is enough for the OS handle, CSMI and RAID data, which are only read while sending commands, and the buffer pool, which has its own lock.
+        //The page cache is changed on every lookup without a lock, so the copy does not get it.
+        memcpy(clone, device, sizeof(tDevice));
+        clear_Last_Command_Results(clone);
+        clone->drive_info.pageCache = NULL;
+#if defined (__linux__) && !defined(VMK_CROSS_COMP) && !defined(UEFI_C_SOURCE)
+        clone->os_info.nvmeUring = NULL;//each copy sets up its own ring on its first NVMe IO command
+#endif
+    }
+    return clone;
+}
+
+void free_Device_Clone(tDevice **clone)
+{
+    if (clone)
+    {
+#if defined (__linux__) && !defined(VMK_CROSS_COMP) && !defined(UEFI_C_SOURCE)
+        if (*clone)
+        {
+            close_NVMe_IO_Uring(*clone);
+        }
+#endif
+        safe_Free(*clone)
+    }
+}
+
+int get_Last_Command_Results(tDevice *device, ptrCommandResults results)
+{
+    if (!device || !results)
+    {
+        return BAD_PARAMETER;
+    }
+    memcpy(&results->rtfrs, &device->drive_info.lastCommandRTFRs, sizeof(ataReturnTFRs));
+    results->ataSenseDataValid = device->drive_info.ataSenseData.validData;
+    results->ataSenseKey = device->drive_info.ataSenseData.senseKey;
+    results->ataAdditionalSenseCode = device->drive_info.ataSenseData.additionalSenseCode;
+    results->ataAdditionalSenseCodeQualifier = device->drive_info.ataSenseData.additionalSenseCodeQualifier;
+    memcpy(results->senseData, device->drive_info.lastCommandSenseData, SPC3_SENSE_LEN);
+    results->nvmeCommandSpecific = device->drive_info.lastNVMeResult.lastNVMeCommandSpecific;
+    results->nvmeStatus = device->drive_info.lastNVMeResult.lastNVMeStatus;
+    results->commandTimeNanoSeconds = device->drive_info.lastCommandTimeNanoSeconds;
+    results->osLastError = device->os_info.last_error;
+    return SUCCESS;
+}
+
+int enable_Device_Buffer_Pool(tDevice *device)
+{
+    if (!device)
+    {
+        return BAD_PARAMETER;
+    }
+    if (device->bufferPool)
+    {
+        return SUCCESS;
+    }
+    //pool buffers are page aligned, which is always enough for os_info.minimumAlignment
+    return create_Aligned_Buffer_Pool(&device->bufferPool);
+}
+
+void disable_Device_Buffer_Pool(tDevice *device)
+{
+    if (device)
+    {
+        destroy_Aligned_Buffer_Pool(&device->bufferPool);
+    }
+}
+
+void* get_Device_Buffer(tDevice *device, size_t size)
+{
+    if (!device)
+    {
+        return NULL;
+    }
+    if (device->bufferPool)
+    {
+        return get_Pooled_Buffer(device->bufferPool, size);
+    }
+    return calloc_aligned(size, sizeof(uint8_t), device->os_info.minimumAlignment);
+}
+
+void release_Device_Buffer(tDevice *device, void *buffer, size_t size)
+{
+    if (!device || !buffer)
+    {
+        return;
+    }
+    if (device->bufferPool)
+    {
+        return_Pooled_Buffer(device->bufferPool, buffer, size);
+    }
+    else
+    {
+        free_aligned(buffer);
+    }
+}
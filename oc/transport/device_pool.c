@@ -0,0 +1,306 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file device_pool.c
+// \brief Keeps devices open with their discovered information so that callers can lease them instead of calling get_Device and close_Device for every operation
+
+#include "device_pool.h"
+
+int create_Device_Pool(ptrDevicePool pool, uint64_t discoveryFlags, eVerbosityLevels verbosity, uint32_t revalidateSeconds)
+{
+    if (!pool)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(pool, 0, sizeof(devicePool));
+    if (SUCCESS != create_Mutex(&pool->mutex))
+    {
+        return MEMORY_FAILURE;
+    }
+    pool->discoveryFlags = discoveryFlags;
+    pool->verbosity = verbosity;
+    pool->revalidateSeconds = revalidateSeconds;
+    return SUCCESS;
+}
+
+static int open_Pool_Device(ptrDevicePool pool, const char *handle, tDevice **device)
+{
+    int ret = SUCCESS;
+    *device = C_CAST(tDevice*, calloc(1, sizeof(tDevice)));
+    if (!*device)
+    {
+        return MEMORY_FAILURE;
+    }
+    (*device)->sanity.size = sizeof(tDevice);
+    (*device)->sanity.version = DEVICE_BLOCK_VERSION;
+    (*device)->dFlags = pool->discoveryFlags;
+    (*device)->deviceVerbosity = pool->verbosity;
+    ret = get_Device(handle, *device);
+    if (ret != SUCCESS)
+    {
+        safe_Free(*device)
+    }
+    else
+    {
+        //pooled devices stay open and are polled over and over, so keep their command buffers around too. Not having a buffer pool is not an error.
+        enable_Device_Buffer_Pool(*device);
+    }
+    return ret;
+}
+
+static void close_Pool_Device(tDevice **device)
+{
+    if (*device)
+    {
+        close_Device(*device);
+        safe_Free(*device)
+    }
+}
+
+static devicePoolEntry* find_Device_Pool_Entry(ptrDevicePool pool, const char *handle)
+{
+    uint32_t entryIter = 0;
+    for (entryIter = 0; entryIter < pool->numberOfEntries; ++entryIter)
+    {
+        if (strcmp(pool->entries[entryIter].handle, handle) == 0)
+        {
+            return &pool->entries[entryIter];
+        }
+    }
+    return NULL;
+}
+
+//Called with the entry marked exclusive and the pool mutex unlocked, since opening a device can take a while.
+static int revalidate_Entry(ptrDevicePool pool, devicePoolEntry *entry, bool *replaced)
+{
+    int ret = SUCCESS;
+    tDevice *fresh = NULL;
+    bool sameDevice = false;
+    ret = open_Pool_Device(pool, entry->handle, &fresh);
+    if (ret != SUCCESS)
+    {
+        //device is gone. Keep its identity to compare against if something shows up at this handle again.
+        close_Pool_Device(&entry->device);
+        entry->needsRevalidation = true;
+        return ret;
+    }
+    sameDevice = entry->lastValidated != 0
+        && fresh->drive_info.worldWideName == entry->worldWideName
+        && strcmp(fresh->drive_info.serialNumber, entry->serialNumber) == 0
+        && strcmp(fresh->drive_info.product_identification, entry->modelNumber) == 0;
+    if (sameDevice && entry->device && !entry->needsRevalidation)
+    {
+        //nothing changed, so keep the device that is already open
+        close_Pool_Device(&fresh);
+    }
+    else
+    {
+        if (!sameDevice && entry->lastValidated != 0)
+        {
+            ++entry->generation;
+            if (replaced)
+            {
+                *replaced = true;
+            }
+        }
+        if (entry->lastValidated != 0)
+        {
+            ++entry->reopens;
+        }
+        close_Pool_Device(&entry->device);
+        entry->device = fresh;
+        entry->worldWideName = fresh->drive_info.worldWideName;
+        snprintf(entry->serialNumber, SERIAL_NUM_LEN + 1, "%s", fresh->drive_info.serialNumber);
+        snprintf(entry->modelNumber, MODEL_NUM_LEN + 1, "%s", fresh->drive_info.product_identification);
+    }
+    entry->needsRevalidation = false;
+    entry->lastValidated = time(NULL);
+    return SUCCESS;
+}
+
+static bool is_Device_Pool_Entry_Due(ptrDevicePool pool, devicePoolEntry *entry)
+{
+    return !entry->device || entry->needsRevalidation
+        || (pool->revalidateSeconds > 0 && difftime(time(NULL), entry->lastValidated) >= C_CAST(double, pool->revalidateSeconds));
+}
+
+int get_Device_Lease(ptrDevicePool pool, const char *handle, eDeviceLeaseType type, uint32_t timeoutMilliseconds, ptrDeviceLease lease)
+{
+    int ret = SUCCESS;
+    devicePoolEntry *entry = NULL;
+    uint32_t waitedMilliseconds = 0;
+    if (!pool || !pool->mutex || !handle || !lease || strlen(handle) >= OS_HANDLE_NAME_MAX_LENGTH)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(lease, 0, sizeof(deviceLease));
+    lock_Mutex(pool->mutex);
+    entry = find_Device_Pool_Entry(pool, handle);
+    if (!entry)
+    {
+        if (pool->numberOfEntries >= DEVICE_POOL_MAX_DEVICES)
+        {
+            unlock_Mutex(pool->mutex);
+            return FAILURE;
+        }
+        entry = &pool->entries[pool->numberOfEntries];
+        memset(entry, 0, sizeof(devicePoolEntry));
+        snprintf(entry->handle, OS_HANDLE_NAME_MAX_LENGTH, "%s", handle);
+        ++pool->numberOfEntries;
+    }
+    while (true)
+    {
+        if (!entry->exclusiveLease && entry->sharedLeases == 0 && is_Device_Pool_Entry_Due(pool, entry))
+        {
+            entry->exclusiveLease = true;
+            unlock_Mutex(pool->mutex);
+            ret = revalidate_Entry(pool, entry, NULL);
+            lock_Mutex(pool->mutex);
+            entry->exclusiveLease = false;
+            if (ret != SUCCESS)
+            {
+                break;
+            }
+        }
+        //shared leases are still given out while a check is due, so that a steady stream of shared users is never blocked. The check happens once they are all released.
+        if (entry->device && !entry->exclusiveLease && (type == DEVICE_LEASE_SHARED || entry->sharedLeases == 0))
+        {
+            if (type == DEVICE_LEASE_SHARED)
+            {
+                //own copy so that each lease keeps its own last command results. The OS handle is shared.
+                lease->device = clone_Device_For_Thread(entry->device);
+                if (!lease->device)
+                {
+                    ret = MEMORY_FAILURE;
+                    break;
+                }
+                ++entry->sharedLeases;
+            }
+            else
+            {
+                lease->device = entry->device;
+                entry->exclusiveLease = true;
+            }
+            lease->pool = pool;
+            lease->entryIndex = C_CAST(uint32_t, entry - pool->entries);
+            lease->type = type;
+            lease->generation = entry->generation;
+            ret = SUCCESS;
+            break;
+        }
+        if (waitedMilliseconds >= timeoutMilliseconds)
+        {
+            ret = IN_PROGRESS;
+            break;
+        }
+        unlock_Mutex(pool->mutex);
+        delay_Milliseconds(1);
+        ++waitedMilliseconds;
+        lock_Mutex(pool->mutex);
+    }
+    unlock_Mutex(pool->mutex);
+    return ret;
+}
+
+void release_Device_Lease(ptrDeviceLease lease, int lastResult)
+{
+    devicePoolEntry *entry = NULL;
+    if (!lease || !lease->pool || !lease->device)
+    {
+        return;
+    }
+    lock_Mutex(lease->pool->mutex);
+    entry = &lease->pool->entries[lease->entryIndex];
+    if (lease->type == DEVICE_LEASE_SHARED)
+    {
+        free_Device_Clone(&lease->device);
+        if (entry->sharedLeases > 0)
+        {
+            --entry->sharedLeases;
+        }
+    }
+    else
+    {
+        entry->exclusiveLease = false;
+    }
+    switch (lastResult)
+    {
+    case OS_PASSTHROUGH_FAILURE:
+    case FILE_OPEN_ERROR:
+    case PERMISSION_DENIED:
+        //these are what the OS layers return once a handle is no longer connected to a device
+        entry->needsRevalidation = true;
+        break;
+    default:
+        break;
+    }
+    unlock_Mutex(lease->pool->mutex);
+    memset(lease, 0, sizeof(deviceLease));
+}
+
+int revalidate_Device_Pool_Entry(ptrDevicePool pool, const char *handle, bool *replaced)
+{
+    int ret = SUCCESS;
+    devicePoolEntry *entry = NULL;
+    if (!pool || !pool->mutex || !handle)
+    {
+        return BAD_PARAMETER;
+    }
+    if (replaced)
+    {
+        *replaced = false;
+    }
+    lock_Mutex(pool->mutex);
+    entry = find_Device_Pool_Entry(pool, handle);
+    if (!entry)
+    {
+        unlock_Mutex(pool->mutex);
+        return NOT_SUPPORTED;
+    }
+    if (entry->exclusiveLease || entry->sharedLeases > 0)
+    {
+        unlock_Mutex(pool->mutex);
+        return IN_PROGRESS;
+    }
+    entry->exclusiveLease = true;
+    unlock_Mutex(pool->mutex);
+    ret = revalidate_Entry(pool, entry, replaced);
+    lock_Mutex(pool->mutex);
+    entry->exclusiveLease = false;
+    unlock_Mutex(pool->mutex);
+    return ret;
+}
+
+int close_Device_Pool(ptrDevicePool pool)
+{
+    uint32_t entryIter = 0;
+    if (!pool || !pool->mutex)
+    {
+        return BAD_PARAMETER;
+    }
+    lock_Mutex(pool->mutex);
+    for (entryIter = 0; entryIter < pool->numberOfEntries; ++entryIter)
+    {
+        if (pool->entries[entryIter].exclusiveLease || pool->entries[entryIter].sharedLeases > 0)
+        {
+            unlock_Mutex(pool->mutex);
+            return IN_PROGRESS;
+        }
+    }
+    for (entryIter = 0; entryIter < pool->numberOfEntries; ++entryIter)
+    {
+        close_Pool_Device(&pool->entries[entryIter].device);
+    }
+    pool->numberOfEntries = 0;
+    unlock_Mutex(pool->mutex);
+    destroy_Mutex(&pool->mutex);
+    return SUCCESS;
+}
@@ -0,0 +1,296 @@
+//
+// Do NOT modify or remove this copyright and license
+//
+// Copyright (c) 2012-2021 Seagate Technology LLC and/or its Affiliates, All Rights Reserved
+//
+// This software is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// ******************************************************************************************
+//
+// \file ncq_queue.c
+// \brief Keeps track of NCQ tags so that more than one FPDMA queued command can be outstanding to a SATA drive at a time
+
+#include "ncq_queue.h"
+#include "ata_helper_func.h"
+
+static void run_NCQ_Command(ncqCommand *command)
+{
+    if (command->writeCommand)
+    {
+        command->result = ata_NCQ_Write_FPDMA_Queued(command->device, command->fua, command->lba, command->ptrData, command->sectorCount, command->prio, command->ncqTag, 0);
+    }
+    else
+    {
+        command->result = ata_NCQ_Read_FPDMA_Queued(command->device, command->fua, command->lba, command->ptrData, command->sectorCount, command->prio, command->ncqTag, 0);
+    }
+}
+
+static void finish_NCQ_Command(ncqCommand *command)
+{
+    lock_Mutex(command->queue->mutex);
+    command->queue->tagsComplete |= UINT32_C(1) << command->ncqTag;
+    unlock_Mutex(command->queue->mutex);
+    post_Semaphore(command->queue->completed);
+}
+
+//Sleeps until a command is submitted on this tag, sends it, and goes back to sleep, until close_NCQ_Queue stops it
+static void ncq_Worker_Thread(void *context)
+{
+    ncqCommand *command = C_CAST(ncqCommand*, context);
+    while (true)
+    {
+        wait_Semaphore(command->start);
+        if (command->queue->stopWorkers)
+        {
+            break;
+        }
+        run_NCQ_Command(command);
+        finish_NCQ_Command(command);
+    }
+}
+
+int open_NCQ_Queue(tDevice *device, uint8_t queueDepth, ptrNCQQueue queue)
+{
+    uint8_t driveQueueDepth = 0;
+    uint8_t tagIter = 0;
+    bool workersAvailable = false;
+    if (!device || !queue)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(queue, 0, sizeof(ncqQueue));
+    if (device->drive_info.drive_type != ATA_DRIVE)
+    {
+        return NOT_SUPPORTED;
+    }
+    //Only Serial ATA devices set the bits in words 76-79
+    if (device->drive_info.IdentifyData.ata.Word076 == 0 || device->drive_info.IdentifyData.ata.Word076 == UINT16_MAX || !(device->drive_info.IdentifyData.ata.Word076 & BIT8))
+    {
+        return NOT_SUPPORTED;
+    }
+    driveQueueDepth = C_CAST(uint8_t, M_GETBITRANGE(device->drive_info.IdentifyData.ata.Word075, 4, 0) + 1);
+    if (queueDepth == 0 || queueDepth > driveQueueDepth)
+    {
+        queueDepth = driveQueueDepth;
+    }
+    if (SUCCESS != create_Mutex(&queue->mutex))
+    {
+        return MEMORY_FAILURE;
+    }
+    queue->device = device;
+    queue->queueDepth = queueDepth;
+    //without the completion semaphore there is no way to wait for a worker, so every command is done by the submitting thread
+    workersAvailable = SUCCESS == create_Semaphore(&queue->completed, 0);
+    for (tagIter = 0; tagIter < queueDepth; ++tagIter)
+    {
+        ncqCommand *command = &queue->command[tagIter];
+        command->queue = queue;
+        command->ncqTag = tagIter;
+        command->device = clone_Device_For_Thread(device);
+        if (!command->device)
+        {
+            close_NCQ_Queue(queue);
+            return MEMORY_FAILURE;
+        }
+        if (workersAvailable && SUCCESS == create_Semaphore(&command->start, 0))
+        {
+            if (SUCCESS != create_Thread(&command->thread, ncq_Worker_Thread, command))
+            {
+                //this tag's commands are done by the submitting thread
+                command->thread = NULL;
+                destroy_Semaphore(&command->start);
+            }
+        }
+    }
+    return SUCCESS;
+}
+
+static void report_NCQ_Command(ptrNCQQueue queue, ncqCommand *command)
+{
+    if (command->result == SUCCESS)
+    {
+        ++queue->commandsCompleted;
+    }
+    else
+    {
+        ++queue->commandsFailed;
+    }
+    if (command->callback)
+    {
+        command->callback(command->callbackData, command->writeCommand, command->lba, command->sectorCount, command->ptrData, command->result);
+    }
+    queue->tagsInUse &= ~(UINT32_C(1) << command->ncqTag);
+}
+
+//Called once nothing is outstanding. If the NQ bit is clear, the log holds the tag and LBA of the command that failed.
+//The failing command is found by its LBA rather than its tag since the OS or HBA may have assigned a different tag.
+//If the OS already read this log while handling the error (libata does), NQ will be set and every failed command is retried.
+static int recover_NCQ_Errors(ptrNCQQueue queue)
+{
+    int ret = SUCCESS;
+    uint8_t errorLog[LEGACY_DRIVE_SEC_SIZE] = { 0 };
+    uint8_t tagIter = 0;
+    ++queue->errorRecoveries;
+    queue->failingTagValid = false;
+    if (SUCCESS == send_ATA_Read_Log_Ext_Cmd(queue->device, ATA_LOG_NCQ_COMMAND_ERROR_LOG, 0, errorLog, LEGACY_DRIVE_SEC_SIZE, 0) && !(errorLog[0] & BIT7))
+    {
+        queue->failingTagValid = true;
+        queue->failingTag = C_CAST(uint8_t, M_GETBITRANGE(errorLog[0], 4, 0));
+        queue->failingLBA = M_BytesTo8ByteValue(0, 0, errorLog[10], errorLog[9], errorLog[8], errorLog[6], errorLog[5], errorLog[4]);
+    }
+    for (tagIter = 0; tagIter < queue->queueDepth; ++tagIter)
+    {
+        ncqCommand *command = &queue->command[tagIter];
+        if (!(queue->tagsFailed & (UINT32_C(1) << tagIter)))
+        {
+            continue;
+        }
+        if (!queue->failingTagValid || queue->failingLBA < command->lba || queue->failingLBA >= command->lba + command->sectorCount)
+        {
+            //aborted because of another command's error
+            ++queue->commandsRetried;
+            run_NCQ_Command(command);
+        }
+        if (command->result != SUCCESS)
+        {
+            ret = FAILURE;
+        }
+        report_NCQ_Command(queue, command);
+    }
+    queue->tagsFailed = 0;
+    return ret;
+}
+
+int complete_NCQ_Commands(ptrNCQQueue queue, bool waitForAll)
+{
+    int ret = SUCCESS;
+    uint32_t reported = 0;
+    if (!queue || !queue->mutex)
+    {
+        return BAD_PARAMETER;
+    }
+    while (queue->tagsInUse)
+    {
+        uint32_t tagsComplete = 0;
+        uint32_t tagsOutstanding = 0;
+        uint8_t tagIter = 0;
+        lock_Mutex(queue->mutex);
+        tagsComplete = queue->tagsComplete;
+        queue->tagsComplete = 0;
+        unlock_Mutex(queue->mutex);
+        for (tagIter = 0; tagIter < queue->queueDepth; ++tagIter)
+        {
+            ncqCommand *command = &queue->command[tagIter];
+            if (!(tagsComplete & (UINT32_C(1) << tagIter)))
+            {
+                continue;
+            }
+            if (command->result == SUCCESS)
+            {
+                report_NCQ_Command(queue, command);
+                ++reported;
+            }
+            else
+            {
+                queue->tagsFailed |= UINT32_C(1) << tagIter;
+            }
+        }
+        tagsOutstanding = queue->tagsInUse & ~queue->tagsFailed;
+        if (queue->tagsFailed && tagsOutstanding == 0)
+        {
+            if (SUCCESS != recover_NCQ_Errors(queue))
+            {
+                ret = FAILURE;
+            }
+            ++reported;
+            continue;
+        }
+        if (!waitForAll && reported > 0 && queue->tagsFailed == 0)
+        {
+            break;
+        }
+        if (tagsOutstanding)
+        {
+            //Sleep until a worker finishes a command. Every finished command posts once, so this can wake for a command that was already
+            //picked up above. That only costs an extra pass, and a command still running always has a post coming.
+            wait_Semaphore(queue->completed);
+        }
+    }
+    return ret;
+}
+
+int submit_NCQ_Command(ptrNCQQueue queue, bool writeCommand, bool fua, uint64_t lba, uint8_t *ptrData, uint16_t sectorCount, uint8_t prio, ncqCompletionCallback callback, void *callbackData)
+{
+    uint8_t tagIter = 0;
+    ncqCommand *command = NULL;
+    if (!queue || !queue->mutex || !ptrData || sectorCount == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    while (!command)
+    {
+        for (tagIter = 0; tagIter < queue->queueDepth; ++tagIter)
+        {
+            if (!(queue->tagsInUse & (UINT32_C(1) << tagIter)))
+            {
+                command = &queue->command[tagIter];
+                break;
+            }
+        }
+        if (!command)
+        {
+            complete_NCQ_Commands(queue, false);
+        }
+    }
+    command->writeCommand = writeCommand;
+    command->fua = fua;
+    command->prio = prio & 0x03;
+    command->lba = lba;
+    command->ptrData = ptrData;
+    command->sectorCount = sectorCount;
+    command->callback = callback;
+    command->callbackData = callbackData;
+    command->result = UNKNOWN;
+    command->submitOrder = queue->submitCounter++;
+    queue->tagsInUse |= UINT32_C(1) << command->ncqTag;
+    if (command->thread)
+    {
+        post_Semaphore(command->start);
+    }
+    else
+    {
+        //still works, just one command at a time
+        run_NCQ_Command(command);
+        finish_NCQ_Command(command);
+    }
+    return SUCCESS;
+}
+
+void close_NCQ_Queue(ptrNCQQueue queue)
+{
+    uint8_t tagIter = 0;
+    if (!queue)
+    {
+        return;
+    }
+    if (queue->mutex)
+    {
+        complete_NCQ_Commands(queue, true);
+    }
+    queue->stopWorkers = true;
+    for (tagIter = 0; tagIter < NCQ_MAX_QUEUE_DEPTH; ++tagIter)
+    {
+        ncqCommand *command = &queue->command[tagIter];
+        if (command->thread)
+        {
+            post_Semaphore(command->start);
+            join_Thread(&command->thread);
+        }
+        destroy_Semaphore(&command->start);
+        free_Device_Clone(&command->device);
+    }
+    destroy_Semaphore(&queue->completed);
+    destroy_Mutex(&queue->mutex);
+}
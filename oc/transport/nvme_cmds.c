@@ -367,6 +367,38 @@ int nvme_Write_Uncorrectable(tDevice *device, uint64_t startingLBA, uint16_t num
     return ret;
 }
 
+int nvme_Write_Zeroes(tDevice *device, uint64_t startingLBA, uint16_t numberOfLogicalBlocks, bool deallocate)
+{
+    int ret = SUCCESS;
+    nvmeCmdCtx nvmCommand;
+    memset(&nvmCommand, 0, sizeof(nvmeCmdCtx));
+    nvmCommand.commandType = NVM_CMD;
+    nvmCommand.cmd.nvmCmd.opcode = NVME_CMD_WRITE_ZEROS;
+    nvmCommand.commandDirection = XFER_NO_DATA;
+    nvmCommand.ptrData = NULL;
+    nvmCommand.dataSize = 0;
+    nvmCommand.cmd.nvmCmd.cdw10 = M_DoubleWord0(startingLBA);//lba
+    nvmCommand.cmd.nvmCmd.cdw11 = M_DoubleWord1(startingLBA);//lba
+    nvmCommand.cmd.nvmCmd.cdw12 = numberOfLogicalBlocks;
+    if (deallocate)
+    {
+        nvmCommand.cmd.nvmCmd.cdw12 |= BIT25;
+    }
+    nvmCommand.timeout = 15;
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        printf("Sending NVMe Write Zeroes Command\n");
+    }
+    ret = nvme_Cmd(device, &nvmCommand);
+    //TODO: Need a function to print out some verbose information for any/all commands (if possible)
+    //Command specific return codes:
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        print_Return_Enum("Write Zeroes", ret);
+    }
+    return ret;
+}
+
 int nvme_Dataset_Management(tDevice *device, uint8_t numberOfRanges, bool deallocate, bool integralDatasetForWrite, bool integralDatasetForRead, uint8_t *ptrData, uint32_t dataLength)
 {
     int ret = SUCCESS;
@@ -779,6 +811,12 @@ int nvme_Get_Log_Page(tDevice *device, nvmeGetLogPageCmdOpts * getLogPageCmdOpts
     nvmeCmdCtx getLogPage;
     uint32_t dWord10 = 0;
     uint32_t numDwords = 0;
+    //the log specific field and retain asynchronous event bit change what the controller does, so they are part of the cache key
+    uint32_t cacheAddress = M_BytesTo4ByteValue(0, C_CAST(uint8_t, getLogPageCmdOpts->rae & 0x01), C_CAST(uint8_t, getLogPageCmdOpts->lsp & 0x0F), getLogPageCmdOpts->lid);
+    if (read_Page_Cache(device, PAGE_CACHE_NVME_LOG_PAGE, cacheAddress, getLogPageCmdOpts->nsid, getLogPageCmdOpts->offset, getLogPageCmdOpts->addr, getLogPageCmdOpts->dataLen))
+    {
+        return SUCCESS;
+    }
     memset(&getLogPage, 0, sizeof(getLogPage));
     getLogPage.cmd.adminCmd.opcode = NVME_ADMIN_CMD_GET_LOG_PAGE;
     getLogPage.commandType = NVM_ADMIN_CMD;
@@ -815,6 +853,10 @@ int nvme_Get_Log_Page(tDevice *device, nvmeGetLogPageCmdOpts * getLogPageCmdOpts
     }
 
     ret = nvme_Cmd(device, &getLogPage);
+    if (ret == SUCCESS)
+    {
+        write_Page_Cache(device, PAGE_CACHE_NVME_LOG_PAGE, cacheAddress, getLogPageCmdOpts->nsid, getLogPageCmdOpts->offset, getLogPageCmdOpts->addr, getLogPageCmdOpts->dataLen);
+    }
 
     if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
     {
@@ -204,6 +204,124 @@ int scsi_Send_Cdb(tDevice *device, uint8_t *cdb, eCDBLen cdbLen, uint8_t *pdata,
     return scsi_Send_Cdb_Int(device, cdb, cdbLen, pdata, dataLen, dataDirection, senseData, senseDataLen, timeoutSeconds, false, false);
 }
 
+#if defined (__linux__) && !defined(VMK_CROSS_COMP) && !defined(UEFI_C_SOURCE)
+//Sends the batch with the sg queue. Returns NOT_SUPPORTED when this handle cannot queue commands so that the caller sends them one at a time.
+static int scsi_Send_Cdb_Batch_SG(tDevice *device, ptrScsiBatchCommand commands, uint32_t count)
+{
+    int ret = SUCCESS;
+    uint32_t cmdIter = 0;
+    ScsiIoCtx *contexts = NULL;
+    int *results = NULL;
+    uint8_t *senseBuffers = NULL;
+    switch (device->drive_info.interface_type)
+    {
+    case SCSI_INTERFACE:
+    case IDE_INTERFACE:
+    case USB_INTERFACE:
+    case IEEE_1394_INTERFACE:
+        break;
+    default:
+        //NVMe translation and RAID/custom IO functions do not go through sg
+        return NOT_SUPPORTED;
+    }
+    contexts = C_CAST(ScsiIoCtx*, calloc(count, sizeof(ScsiIoCtx)));
+    results = C_CAST(int*, calloc(count, sizeof(int)));
+    senseBuffers = C_CAST(uint8_t*, calloc(C_CAST(size_t, count) * SPC3_SENSE_LEN, sizeof(uint8_t)));
+    if (!contexts || !results || !senseBuffers)
+    {
+        safe_Free(contexts)
+        safe_Free(results)
+        safe_Free(senseBuffers)
+        return MEMORY_FAILURE;
+    }
+    for (cmdIter = 0; cmdIter < count; ++cmdIter)
+    {
+        contexts[cmdIter].device = device;
+        contexts[cmdIter].psense = &senseBuffers[C_CAST(size_t, cmdIter) * SPC3_SENSE_LEN];
+        contexts[cmdIter].senseDataSize = SPC3_SENSE_LEN;
+        memcpy(&contexts[cmdIter].cdb[0], commands[cmdIter].cdb, commands[cmdIter].cdbLen);
+        contexts[cmdIter].cdbLength = C_CAST(uint8_t, commands[cmdIter].cdbLen);
+        contexts[cmdIter].direction = commands[cmdIter].dataDirection;
+        contexts[cmdIter].pdata = commands[cmdIter].pdata;
+        contexts[cmdIter].dataLength = commands[cmdIter].dataLen;
+        contexts[cmdIter].timeout = M_Max(commands[cmdIter].timeoutSeconds, device->drive_info.defaultTimeoutSeconds);
+        if (commands[cmdIter].timeoutSeconds == 0)
+        {
+            contexts[cmdIter].timeout = M_Max(15, device->drive_info.defaultTimeoutSeconds);
+        }
+    }
+    ret = send_sg_io_Batch(contexts, count, results);
+    if (ret != NOT_SUPPORTED && ret != MEMORY_FAILURE)
+    {
+        ret = SUCCESS;
+        for (cmdIter = 0; cmdIter < count; ++cmdIter)
+        {
+            senseDataFields senseFields;
+            memset(&senseFields, 0, sizeof(senseDataFields));
+            //same checks as private_SCSI_Send_CDB
+            get_Sense_Data_Fields(contexts[cmdIter].psense, contexts[cmdIter].senseDataSize, &senseFields);
+            commands[cmdIter].result = check_Sense_Key_ASC_ASCQ_And_FRU(device, senseFields.scsiStatusCodes.senseKey, senseFields.scsiStatusCodes.asc, senseFields.scsiStatusCodes.ascq, senseFields.scsiStatusCodes.fru);
+            if (commands[cmdIter].result == SUCCESS && results[cmdIter] != SUCCESS)
+            {
+                commands[cmdIter].result = results[cmdIter];
+            }
+            if (commands[cmdIter].senseData)
+            {
+                memcpy(commands[cmdIter].senseData, contexts[cmdIter].psense, SPC3_SENSE_LEN);
+            }
+            if (commands[cmdIter].result != SUCCESS)
+            {
+                ret = FAILURE;
+            }
+        }
+        //keep the last command's sense data in the device like any other command would
+        memcpy(device->drive_info.lastCommandSenseData, contexts[count - 1].psense, SPC3_SENSE_LEN);
+    }
+    safe_Free(contexts)
+    safe_Free(results)
+    safe_Free(senseBuffers)
+    return ret;
+}
+#endif
+
+int scsi_Send_Cdb_Batch(tDevice *device, ptrScsiBatchCommand commands, uint32_t count)
+{
+    int ret = SUCCESS;
+    uint32_t cmdIter = 0;
+    if (!device || !commands || count == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    for (cmdIter = 0; cmdIter < count; ++cmdIter)
+    {
+        if (!commands[cmdIter].cdb || commands[cmdIter].cdbLen == CDB_LEN_UNKNOWN || (!commands[cmdIter].pdata && commands[cmdIter].dataLen != 0))
+        {
+            return BAD_PARAMETER;
+        }
+    }
+#if defined (__linux__) && !defined(VMK_CROSS_COMP) && !defined(UEFI_C_SOURCE)
+    //verbose output is printed per command, so keep the one at a time path for it to keep the output in order
+    if (device->deviceVerbosity < VERBOSITY_COMMAND_VERBOSE)
+    {
+        ret = scsi_Send_Cdb_Batch_SG(device, commands, count);
+        if (ret != NOT_SUPPORTED)
+        {
+            return ret;
+        }
+        ret = SUCCESS;
+    }
+#endif
+    for (cmdIter = 0; cmdIter < count; ++cmdIter)
+    {
+        commands[cmdIter].result = scsi_Send_Cdb(device, commands[cmdIter].cdb, commands[cmdIter].cdbLen, commands[cmdIter].pdata, commands[cmdIter].dataLen, commands[cmdIter].dataDirection, commands[cmdIter].senseData, commands[cmdIter].senseData ? SPC3_SENSE_LEN : 0, commands[cmdIter].timeoutSeconds);
+        if (commands[cmdIter].result != SUCCESS)
+        {
+            ret = FAILURE;
+        }
+    }
+    return ret;
+}
+
 int scsi_SecurityProtocol_In(tDevice *device, uint8_t securityProtocol, uint16_t securityProtocolSpecific, bool inc512, uint32_t allocationLength, uint8_t *ptrData)
 {
     int       ret = FAILURE;
@@ -431,6 +549,10 @@ int scsi_Log_Sense_Cmd(tDevice *device, bool saveParameters, uint8_t pageControl
     int       ret       = FAILURE;
     uint8_t   cdb[CDB_LEN_10]       = { 0 };
 
+    if (!saveParameters && read_Page_Cache(device, PAGE_CACHE_SCSI_LOG_SENSE, pageCode, subpageCode, M_WordsTo4ByteValue(pageControl, paramPointer), ptrData, dataSize))
+    {
+        return SUCCESS;
+    }
     if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
     {
         printf("Sending SCSI Log Sense Command, page code: 0x%02" PRIx8 "\n", pageCode);
@@ -453,6 +575,10 @@ int scsi_Log_Sense_Cmd(tDevice *device, bool saveParameters, uint8_t pageControl
     if (dataSize > 0)
     {
         ret = scsi_Send_Cdb(device, &cdb[0], sizeof(cdb), ptrData, dataSize, XFER_DATA_IN, device->drive_info.lastCommandSenseData, SPC3_SENSE_LEN, 15);
+        if (ret == SUCCESS && !saveParameters)
+        {
+            write_Page_Cache(device, PAGE_CACHE_SCSI_LOG_SENSE, pageCode, subpageCode, M_WordsTo4ByteValue(pageControl, paramPointer), ptrData, dataSize);
+        }
     }
     else
     {
@@ -465,6 +591,71 @@ int scsi_Log_Sense_Cmd(tDevice *device, bool saveParameters, uint8_t pageControl
     return ret;
 }
 
+int scsi_Prefetch_Log_Pages(tDevice *device, uint8_t pageControl, uint8_t *pageCodes, uint8_t *subpageCodes, uint32_t numberOfPages, uint16_t dataSize)
+{
+    int ret = SUCCESS;
+    uint32_t pageIter = 0;
+    ptrScsiBatchCommand commands = NULL;
+    uint8_t *cdbs = NULL;
+    uint8_t *logData = NULL;
+    if (!device || !pageCodes || !subpageCodes || numberOfPages == 0 || dataSize == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    if (!device->drive_info.pageCache)
+    {
+        //nowhere to keep the pages, so reading them now would only read them twice
+        return NOT_SUPPORTED;
+    }
+    commands = C_CAST(ptrScsiBatchCommand, calloc(numberOfPages, sizeof(scsiBatchCommand)));
+    cdbs = C_CAST(uint8_t*, calloc(C_CAST(size_t, numberOfPages) * CDB_LEN_10, sizeof(uint8_t)));
+    logData = C_CAST(uint8_t*, calloc_aligned(C_CAST(size_t, numberOfPages) * dataSize, sizeof(uint8_t), device->os_info.minimumAlignment));
+    if (!commands || !cdbs || !logData)
+    {
+        safe_Free(commands)
+        safe_Free(cdbs)
+        safe_Free_aligned(logData)
+        return MEMORY_FAILURE;
+    }
+    for (pageIter = 0; pageIter < numberOfPages; ++pageIter)
+    {
+        uint8_t *cdb = &cdbs[C_CAST(size_t, pageIter) * CDB_LEN_10];
+        cdb[OPERATION_CODE] = LOG_SENSE_CMD;
+        cdb[2] |= (pageControl & 0x03) << 6;
+        cdb[2] |= pageCodes[pageIter] & 0x3F;
+        cdb[3] = subpageCodes[pageIter];
+        cdb[7] = M_Byte1(dataSize);
+        cdb[8] = M_Byte0(dataSize);
+        commands[pageIter].cdb = cdb;
+        commands[pageIter].cdbLen = CDB_LEN_10;
+        commands[pageIter].pdata = &logData[C_CAST(size_t, pageIter) * dataSize];
+        commands[pageIter].dataLen = dataSize;
+        commands[pageIter].dataDirection = XFER_DATA_IN;
+        commands[pageIter].timeoutSeconds = 15;
+    }
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        printf("Sending %" PRIu32 " SCSI Log Sense Commands together\n", numberOfPages);
+    }
+    ret = scsi_Send_Cdb_Batch(device, commands, numberOfPages);
+    for (pageIter = 0; pageIter < numberOfPages; ++pageIter)
+    {
+        //same key as scsi_Log_Sense_Cmd uses with a parameter pointer of 0, so that it finds these pages
+        if (commands[pageIter].result == SUCCESS)
+        {
+            write_Page_Cache(device, PAGE_CACHE_SCSI_LOG_SENSE, pageCodes[pageIter], subpageCodes[pageIter], M_WordsTo4ByteValue(pageControl, 0), commands[pageIter].pdata, dataSize);
+        }
+    }
+    if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
+    {
+        print_Return_Enum("Prefetch Log Pages", ret);
+    }
+    safe_Free(commands)
+    safe_Free(cdbs)
+    safe_Free_aligned(logData)
+    return ret;
+}
+
 int scsi_Log_Select_Cmd(tDevice *device, bool pcr, bool sp, uint8_t pageControl, uint8_t pageCode, uint8_t subpageCode, uint16_t parameterListLength, uint8_t* ptrData, uint32_t dataSize)
 {
     int ret = UNKNOWN;
@@ -824,6 +1015,12 @@ int scsi_Inquiry(tDevice *device, uint8_t *pdata, uint32_t dataLength, uint8_t p
     int ret = FAILURE;
     uint8_t cdb[CDB_LEN_6] = { 0 };
 
+    //only VPD pages are cached. Standard inquiry also updates the device structure, so it is always sent.
+    if (evpd && !cmdDt && read_Page_Cache(device, PAGE_CACHE_SCSI_INQUIRY, pageCode, 1, 0, pdata, dataLength))
+    {
+        return SUCCESS;
+    }
+
     if (VERBOSITY_COMMAND_NAMES <= device->deviceVerbosity)
     {
         if (evpd)
@@ -896,6 +1093,10 @@ int scsi_Inquiry(tDevice *device, uint8_t *pdata, uint32_t dataLength, uint8_t p
             }
             device->drive_info.scsiVersion = version;//changing this to one of these version numbers to keep the rest of the library code that would use this simple. - TJE
         }
+        else if (ret == SUCCESS && evpd && !cmdDt)
+        {
+            write_Page_Cache(device, PAGE_CACHE_SCSI_INQUIRY, pageCode, 1, 0, pdata, dataLength);
+        }
     }
     else
     {
@@ -30,6 +30,7 @@
 #include <sys/mman.h> //for mmap pci reads. Potential to move. 
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <poll.h>
 #include <errno.h>
 #include <libgen.h>//for basename and dirname
 #include "sg_helper.h"
@@ -41,6 +42,19 @@
 #include "sntl_helper.h"
 #endif
 
+//NVMe IO commands go through io_uring when the kernel headers have uring passthrough commands (5.19 and later).
+//Define DISABLE_NVME_URING to always use the NVMe ioctls.
+#if !defined(DISABLE_NVME_PASSTHROUGH) && !defined(DISABLE_NVME_URING) && defined (__has_include)
+    #if __has_include (<linux/io_uring.h>)
+        #include <linux/io_uring.h>
+        #include <sys/syscall.h>
+        #include <sys/uio.h>
+        #if defined (IORING_SETUP_SQE128) && defined (NVME_URING_CMD_IO) && defined (__NR_io_uring_setup)
+            #define SG_HELPER_NVME_URING
+        #endif
+    #endif
+#endif
+
 #if defined(DEGUG_SCAN_TIME)
 #include "common_platform.h"
 #endif
@@ -836,6 +850,8 @@ int get_Device(const char *filename, tDevice *device)
     #if defined (_DEBUG)
     printf("%s: Getting device for %s\n", __FUNCTION__, filename);
     #endif
+    device->bufferPool = NULL;//only enable_Device_Buffer_Pool creates one
+    device->os_info.nvmeUring = NULL;//created on the first NVMe IO command
 
     if(is_Block_Device_Handle(filename))
     {
@@ -1138,110 +1154,73 @@ int send_IO( ScsiIoCtx *scsiIoCtx )
     return ret;
 }
 
-int send_sg_io( ScsiIoCtx *scsiIoCtx )
+//Fills in everything in the SG header except the sense buffer
+static int setup_SG_IO_Header(ScsiIoCtx *scsiIoCtx, sg_io_hdr_t *io_hdr)
 {
-    sg_io_hdr_t io_hdr;
-    uint8_t     *localSenseBuffer = NULL;
-    int         ret          = SUCCESS;
-    seatimer_t  commandTimer;
-#ifdef _DEBUG
-    printf("-->%s \n",__FUNCTION__);
-#endif
-
-
-    memset(&commandTimer,0,sizeof(seatimer_t));
-    //int idx = 0;
-    // Start with zapping the io_hdr
-    memset(&io_hdr, 0, sizeof(sg_io_hdr_t));
-
-    if (VERBOSITY_BUFFERS <= scsiIoCtx->device->deviceVerbosity)
-    {
-        printf("Sending command with send_IO\n");
-    }
-
-    // Set up the io_hdr
-    io_hdr.interface_id = 'S';
-    io_hdr.cmd_len = scsiIoCtx->cdbLength;
-    // Use user's sense or local?
-    if ((scsiIoCtx->senseDataSize) && (scsiIoCtx->psense != NULL))
-    {
-        io_hdr.mx_sb_len = scsiIoCtx->senseDataSize;
-        io_hdr.sbp = scsiIoCtx->psense;
-    }
-    else
-    {
-        localSenseBuffer = C_CAST(uint8_t *, calloc_aligned(SPC3_SENSE_LEN, sizeof(uint8_t), scsiIoCtx->device->os_info.minimumAlignment));
-        if (!localSenseBuffer)
-        {
-            return MEMORY_FAILURE;
-        }
-        io_hdr.mx_sb_len = SPC3_SENSE_LEN;
-        io_hdr.sbp = localSenseBuffer;
-    }
-
+    io_hdr->interface_id = 'S';
+    io_hdr->cmd_len = scsiIoCtx->cdbLength;
     switch (scsiIoCtx->direction)
     {
     case XFER_NO_DATA:
     case SG_DXFER_NONE:
-        io_hdr.dxfer_direction = SG_DXFER_NONE;
+        io_hdr->dxfer_direction = SG_DXFER_NONE;
         break;
     case XFER_DATA_IN:
     case SG_DXFER_FROM_DEV:
-        io_hdr.dxfer_direction = SG_DXFER_FROM_DEV;
+        io_hdr->dxfer_direction = SG_DXFER_FROM_DEV;
         break;
     case XFER_DATA_OUT:
     case SG_DXFER_TO_DEV:
-        io_hdr.dxfer_direction = SG_DXFER_TO_DEV;
+        io_hdr->dxfer_direction = SG_DXFER_TO_DEV;
         break;
     case SG_DXFER_TO_FROM_DEV:
-        io_hdr.dxfer_direction = SG_DXFER_TO_FROM_DEV;
+        io_hdr->dxfer_direction = SG_DXFER_TO_FROM_DEV;
         break;
         //case SG_DXFER_UNKNOWN:
-        //io_hdr.dxfer_direction = SG_DXFER_UNKNOWN;
+        //io_hdr->dxfer_direction = SG_DXFER_UNKNOWN;
         //break;
     default:
         if (VERBOSITY_QUIET < scsiIoCtx->device->deviceVerbosity)
         {
             printf("%s Didn't understand direction\n", __FUNCTION__);
         }
-        safe_Free_aligned(localSenseBuffer)
         return BAD_PARAMETER;
     }
 
-    io_hdr.dxfer_len = scsiIoCtx->dataLength;
-    io_hdr.dxferp = scsiIoCtx->pdata;
-    io_hdr.cmdp = scsiIoCtx->cdb;
+    io_hdr->dxfer_len = scsiIoCtx->dataLength;
+    io_hdr->dxferp = scsiIoCtx->pdata;
+    io_hdr->cmdp = scsiIoCtx->cdb;
     if (scsiIoCtx->device->drive_info.defaultTimeoutSeconds > 0 && scsiIoCtx->device->drive_info.defaultTimeoutSeconds > scsiIoCtx->timeout)
     {
-        io_hdr.timeout = scsiIoCtx->device->drive_info.defaultTimeoutSeconds;
+        io_hdr->timeout = scsiIoCtx->device->drive_info.defaultTimeoutSeconds;
         //this check is to make sure on commands that set a very VERY large timeout (*cough* *cough* ata security) that we DON'T do a conversion and leave the time as the max...
         if (scsiIoCtx->device->drive_info.defaultTimeoutSeconds < SG_MAX_CMD_TIMEOUT_SECONDS)
         {
-            io_hdr.timeout *= 1000;//convert to milliseconds
+            io_hdr->timeout *= 1000;//convert to milliseconds
         }
         else
         {
-            io_hdr.timeout = UINT32_MAX;//no timeout or maximum timeout
+            io_hdr->timeout = UINT32_MAX;//no timeout or maximum timeout
         }
     }
     else
     {
         if (scsiIoCtx->timeout != 0)
         {
-            io_hdr.timeout = scsiIoCtx->timeout;
+            io_hdr->timeout = scsiIoCtx->timeout;
             //this check is to make sure on commands that set a very VERY large timeout (*cough* *cough* ata security) that we DON'T do a conversion and leave the time as the max...
             if (scsiIoCtx->timeout < SG_MAX_CMD_TIMEOUT_SECONDS)
             {
-                io_hdr.timeout *= 1000;//convert to milliseconds
+                io_hdr->timeout *= 1000;//convert to milliseconds
             }
             else
             {
-                io_hdr.timeout = UINT32_MAX;//no timeout or maximum timeout
+                io_hdr->timeout = UINT32_MAX;//no timeout or maximum timeout
             }
         }
         else
         {
-            io_hdr.timeout = 15 * 1000;//default to 15 second timeout
+            io_hdr->timeout = 15 * 1000;//default to 15 second timeout
         }
     }
     
@@ -1250,36 +1229,21 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
     scsiIoCtx->returnStatus.senseKey = 0;
     scsiIoCtx->returnStatus.asc = 0;
     scsiIoCtx->returnStatus.ascq = 0;
-    //print_io_hdr(&io_hdr);
-    //printf("scsiIoCtx->device->os_info.fd = %d\n", scsiIoCtx->device->os_info.fd);
-    start_Timer(&commandTimer);
-    ret = ioctl(scsiIoCtx->device->os_info.fd, SG_IO, &io_hdr);
-    stop_Timer(&commandTimer);
-    scsiIoCtx->device->os_info.last_error = errno;
-    if (ret < 0)
-    {
-        ret = OS_PASSTHROUGH_FAILURE;
-        if (VERBOSITY_COMMAND_VERBOSE <= scsiIoCtx->device->deviceVerbosity)
-        {
-            if (scsiIoCtx->device->os_info.last_error != 0)
-            {
-                printf("Error: ");
-                print_Errno_To_Screen(scsiIoCtx->device->os_info.last_error);
-            }
-        }
-    }
-
-    //print_io_hdr(&io_hdr);
+    return SUCCESS;
+}
 
-    if (io_hdr.sb_len_wr)
+//Translates the status in a completed SG header into a return code and fills in scsiIoCtx->returnStatus. ret is the result of submitting the command.
+static int get_SG_IO_Header_Result(ScsiIoCtx *scsiIoCtx, sg_io_hdr_t *io_hdr, int ret)
+{
+    if (io_hdr->sb_len_wr)
     {
-        scsiIoCtx->returnStatus.format  = io_hdr.sbp[0];
-        get_Sense_Key_ASC_ASCQ_FRU(io_hdr.sbp, io_hdr.mx_sb_len, &scsiIoCtx->returnStatus.senseKey, &scsiIoCtx->returnStatus.asc, &scsiIoCtx->returnStatus.ascq, &scsiIoCtx->returnStatus.fru);
+        scsiIoCtx->returnStatus.format  = io_hdr->sbp[0];
+        get_Sense_Key_ASC_ASCQ_FRU(io_hdr->sbp, io_hdr->mx_sb_len, &scsiIoCtx->returnStatus.senseKey, &scsiIoCtx->returnStatus.asc, &scsiIoCtx->returnStatus.ascq, &scsiIoCtx->returnStatus.fru);
     }
 
     if (VERBOSITY_COMMAND_VERBOSE <= scsiIoCtx->device->deviceVerbosity)
     {
-        switch(io_hdr.info & SG_INFO_DIRECT_IO_MASK)
+        switch(io_hdr->info & SG_INFO_DIRECT_IO_MASK)
         {
         case SG_INFO_INDIRECT_IO:
             printf("SG IO Issued as Indirect IO\n");
@@ -1296,16 +1260,16 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
         }
     }
 
-    if ((io_hdr.info & SG_INFO_OK_MASK) != SG_INFO_OK)
+    if ((io_hdr->info & SG_INFO_OK_MASK) != SG_INFO_OK)
     {
         //something has gone wrong. Sense data may or may not have been returned.
         //Check the masked status, host status and driver status to see what happened.
-        if (io_hdr.masked_status != 0) //SAM_STAT_GOOD???
+        if (io_hdr->masked_status != 0) //SAM_STAT_GOOD???
         {
             if (VERBOSITY_COMMAND_VERBOSE <= scsiIoCtx->device->deviceVerbosity)
             {
-                printf("SG Masked Status = %02" PRIX8 "h", io_hdr.masked_status);
-                switch (io_hdr.masked_status)
+                printf("SG Masked Status = %02" PRIX8 "h", io_hdr->masked_status);
+                switch (io_hdr->masked_status)
                 {
                 case GOOD:
                     printf(" - Good\n");
@@ -1346,7 +1310,7 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
                     break;
                 }
             }
-            if (io_hdr.sb_len_wr == 0)
+            if (io_hdr->sb_len_wr == 0)
             {
                 if (VERBOSITY_COMMAND_VERBOSE <= scsiIoCtx->device->deviceVerbosity)
                 {
@@ -1356,12 +1320,12 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
                 ret = OS_PASSTHROUGH_FAILURE;
             }
         }
-        if (io_hdr.host_status != 0)
+        if (io_hdr->host_status != 0)
         {
             if (VERBOSITY_COMMAND_VERBOSE <= scsiIoCtx->device->deviceVerbosity)
             {
-                printf("SG Host Status = %02" PRIX16 "h", io_hdr.host_status);
-                switch (io_hdr.host_status)
+                printf("SG Host Status = %02" PRIX16 "h", io_hdr->host_status);
+                switch (io_hdr->host_status)
                 {
                 case OPENSEA_SG_ERR_DID_OK:
                     printf(" - No Error\n");
@@ -1404,7 +1368,7 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
                     break;
                 }
             }
-            if (io_hdr.sb_len_wr == 0)//Doing this because some drivers may set an error even if the command otherwise went through and sense data was available.
+            if (io_hdr->sb_len_wr == 0)//Doing this because some drivers may set an error even if the command otherwise went through and sense data was available.
             {
                 if (VERBOSITY_COMMAND_VERBOSE <= scsiIoCtx->device->deviceVerbosity)
                 {
@@ -1413,12 +1377,12 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
                 ret = OS_PASSTHROUGH_FAILURE;
             }
         }
-        if (io_hdr.driver_status != 0)
+        if (io_hdr->driver_status != 0)
         {
             if (VERBOSITY_COMMAND_VERBOSE <= scsiIoCtx->device->deviceVerbosity)
             {
-                printf("SG Driver Status = %02" PRIX16 "h", io_hdr.driver_status);
-                switch (io_hdr.driver_status & OPENSEA_SG_ERR_DRIVER_MASK)
+                printf("SG Driver Status = %02" PRIX16 "h", io_hdr->driver_status);
+                switch (io_hdr->driver_status & OPENSEA_SG_ERR_DRIVER_MASK)
                 {
                 case OPENSEA_SG_ERR_DRIVER_OK:
                     printf(" - Driver OK");
@@ -1452,7 +1416,7 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
                     break;
                 }
                 //now error suggestions
-                switch (io_hdr.driver_status & OPENSEA_SG_ERR_SUGGEST_MASK)
+                switch (io_hdr->driver_status & OPENSEA_SG_ERR_SUGGEST_MASK)
                 {
                 case OPENSEA_SG_ERR_SUGGEST_NONE:
                     break;//no suggestions, nothing necessary to print
@@ -1477,7 +1441,7 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
                 }
                 printf("\n");
             }
-            if (io_hdr.sb_len_wr == 0)
+            if (io_hdr->sb_len_wr == 0)
             {
                 if (VERBOSITY_COMMAND_VERBOSE <= scsiIoCtx->device->deviceVerbosity)
                 {
@@ -1489,12 +1453,235 @@ int send_sg_io( ScsiIoCtx *scsiIoCtx )
         }
 
     }
+    return ret;
+}
+
+int send_sg_io( ScsiIoCtx *scsiIoCtx )
+{
+    sg_io_hdr_t io_hdr;
+    uint8_t     *localSenseBuffer = NULL;
+    int         ret          = SUCCESS;
+    seatimer_t  commandTimer;
+#ifdef _DEBUG
+    printf("-->%s \n",__FUNCTION__);
+#endif
+
+
+    memset(&commandTimer,0,sizeof(seatimer_t));
+    //int idx = 0;
+    // Start with zapping the io_hdr
+    memset(&io_hdr, 0, sizeof(sg_io_hdr_t));
+
+    if (VERBOSITY_BUFFERS <= scsiIoCtx->device->deviceVerbosity)
+    {
+        printf("Sending command with send_IO\n");
+    }
+
+    // Use user's sense or local?
+    if ((scsiIoCtx->senseDataSize) && (scsiIoCtx->psense != NULL))
+    {
+        io_hdr.mx_sb_len = scsiIoCtx->senseDataSize;
+        io_hdr.sbp = scsiIoCtx->psense;
+    }
+    else
+    {
+        localSenseBuffer = C_CAST(uint8_t *, get_Device_Buffer(scsiIoCtx->device, SPC3_SENSE_LEN));
+        if (!localSenseBuffer)
+        {
+            return MEMORY_FAILURE;
+        }
+        io_hdr.mx_sb_len = SPC3_SENSE_LEN;
+        io_hdr.sbp = localSenseBuffer;
+    }
+
+    ret = setup_SG_IO_Header(scsiIoCtx, &io_hdr);
+    if (ret != SUCCESS)
+    {
+        safe_Release_Device_Buffer(scsiIoCtx->device, localSenseBuffer, SPC3_SENSE_LEN)
+        return ret;
+    }
+    //print_io_hdr(&io_hdr);
+    //printf("scsiIoCtx->device->os_info.fd = %d\n", scsiIoCtx->device->os_info.fd);
+    start_Timer(&commandTimer);
+    ret = ioctl(scsiIoCtx->device->os_info.fd, SG_IO, &io_hdr);
+    stop_Timer(&commandTimer);
+    scsiIoCtx->device->os_info.last_error = errno;
+    if (ret < 0)
+    {
+        ret = OS_PASSTHROUGH_FAILURE;
+        if (VERBOSITY_COMMAND_VERBOSE <= scsiIoCtx->device->deviceVerbosity)
+        {
+            if (scsiIoCtx->device->os_info.last_error != 0)
+            {
+                printf("Error: ");
+                print_Errno_To_Screen(scsiIoCtx->device->os_info.last_error);
+            }
+        }
+    }
+
+    //print_io_hdr(&io_hdr);
+
+    ret = get_SG_IO_Header_Result(scsiIoCtx, &io_hdr, ret);
 
     scsiIoCtx->device->drive_info.lastCommandTimeNanoSeconds = get_Nano_Seconds(commandTimer);
 #ifdef _DEBUG
     printf("<--%s (%d)\n",__FUNCTION__, ret);
 #endif
-    safe_Free_aligned(localSenseBuffer)
+    safe_Release_Device_Buffer(scsiIoCtx->device, localSenseBuffer, SPC3_SENSE_LEN)
+    return ret;
+}
+
+typedef struct _sgBatchEntry
+{
+    sg_io_hdr_t io_hdr;
+    seatimer_t commandTimer;
+    bool done;//result is final
+}sgBatchEntry;
+
+int send_sg_io_Batch(ScsiIoCtx *scsiIoCtx, uint32_t count, int *results)
+{
+    int ret = SUCCESS;
+    tDevice *device = NULL;
+    sgBatchEntry *entries = NULL;
+    uint32_t cmdIter = 0, nextToSubmit = 0, inFlight = 0, finished = 0;
+    bool draining = false;//waiting failed once. Nothing more is sent, but what is already queued must still be read back.
+    if (!scsiIoCtx || !results || count == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    device = scsiIoCtx[0].device;
+    //only the sg driver can queue commands written to its handle. bsg and block handles only support the SG_IO ioctl.
+    if (!is_SCSI_Generic_Handle(device->os_info.name))
+    {
+        return NOT_SUPPORTED;
+    }
+    entries = C_CAST(sgBatchEntry*, calloc(count, sizeof(sgBatchEntry)));
+    if (!entries)
+    {
+        return MEMORY_FAILURE;
+    }
+    for (cmdIter = 0; cmdIter < count; ++cmdIter)
+    {
+        results[cmdIter] = UNKNOWN;
+        if (scsiIoCtx[cmdIter].device != device || !scsiIoCtx[cmdIter].psense || scsiIoCtx[cmdIter].senseDataSize == 0)
+        {
+            results[cmdIter] = BAD_PARAMETER;
+        }
+        else
+        {
+            entries[cmdIter].io_hdr.mx_sb_len = C_CAST(unsigned char, M_Min(scsiIoCtx[cmdIter].senseDataSize, UINT8_MAX));
+            entries[cmdIter].io_hdr.sbp = scsiIoCtx[cmdIter].psense;
+            entries[cmdIter].io_hdr.pack_id = C_CAST(int, cmdIter);
+            entries[cmdIter].io_hdr.usr_ptr = &entries[cmdIter];
+            results[cmdIter] = setup_SG_IO_Header(&scsiIoCtx[cmdIter], &entries[cmdIter].io_hdr);
+        }
+        if (results[cmdIter] != SUCCESS)
+        {
+            entries[cmdIter].done = true;
+            ++finished;
+        }
+    }
+    while (finished < count)
+    {
+        sg_io_hdr_t completed;
+        sgBatchEntry *entry = NULL;
+        struct pollfd pollHandle;
+        //queue as many as the driver allows before waiting for any of them
+        while (!draining && nextToSubmit < count && inFlight < SG_MAX_QUEUE)
+        {
+            if (results[nextToSubmit] != SUCCESS)
+            {
+                ++nextToSubmit;
+                continue;
+            }
+            start_Timer(&entries[nextToSubmit].commandTimer);
+            if (write(device->os_info.fd, &entries[nextToSubmit].io_hdr, sizeof(sg_io_hdr_t)) < 0)
+            {
+                device->os_info.last_error = errno;
+                if ((errno == EAGAIN || errno == EDOM) && inFlight > 0)
+                {
+                    //driver queue is full. Try this one again after something completes.
+                    break;
+                }
+                results[nextToSubmit] = OS_PASSTHROUGH_FAILURE;
+                entries[nextToSubmit].done = true;
+                ++finished;
+            }
+            else
+            {
+                results[nextToSubmit] = IN_PROGRESS;
+                ++inFlight;
+            }
+            ++nextToSubmit;
+        }
+        if (inFlight == 0)
+        {
+            if (draining)
+            {
+                break;
+            }
+            continue;
+        }
+        //each command's own timeout is enforced by the kernel, so waiting without a timeout here still returns
+        pollHandle.fd = device->os_info.fd;
+        pollHandle.events = POLLIN;
+        pollHandle.revents = 0;
+        if (poll(&pollHandle, 1, -1) < 0 && errno != EINTR)
+        {
+            device->os_info.last_error = errno;
+            ret = OS_PASSTHROUGH_FAILURE;
+            if (draining)
+            {
+                break;
+            }
+            draining = true;
+            continue;
+        }
+        memset(&completed, 0, sizeof(sg_io_hdr_t));
+        completed.interface_id = 'S';
+        if (read(device->os_info.fd, &completed, sizeof(sg_io_hdr_t)) < 0)
+        {
+            if (errno == EAGAIN || errno == EINTR)
+            {
+                continue;
+            }
+            device->os_info.last_error = errno;
+            ret = OS_PASSTHROUGH_FAILURE;
+            if (draining)
+            {
+                break;
+            }
+            draining = true;
+            continue;
+        }
+        entry = C_CAST(sgBatchEntry*, completed.usr_ptr);
+        if (!entry || entry < entries || entry >= entries + count)
+        {
+            //completion for a command someone else wrote to this handle. Nothing can be done with it.
+            continue;
+        }
+        cmdIter = C_CAST(uint32_t, entry - entries);
+        stop_Timer(&entry->commandTimer);
+        entry->done = true;
+        --inFlight;
+        ++finished;
+        results[cmdIter] = get_SG_IO_Header_Result(&scsiIoCtx[cmdIter], &completed, SUCCESS);
+        device->drive_info.lastCommandTimeNanoSeconds = get_Nano_Seconds(entry->commandTimer);
+    }
+    if (ret != SUCCESS)
+    {
+        //The handle stopped working. Anything not completed failed, including anything that could not be read back while draining.
+        //Those stay queued in the sg driver. It only copies data and sense data into the caller's buffers when read() picks the command up,
+        //so the buffers can still be freed, but their completions are never read and the handle should be closed.
+        for (cmdIter = 0; cmdIter < count; ++cmdIter)
+        {
+            if (!entries[cmdIter].done)
+            {
+                results[cmdIter] = OS_PASSTHROUGH_FAILURE;
+            }
+        }
+    }
+    safe_Free(entries)
     return ret;
 }
 
@@ -1779,6 +1966,8 @@ int close_Device(tDevice *dev)
     int retValue = 0;
     if (dev)
     {
+        disable_Device_Buffer_Pool(dev);
+        close_NVMe_IO_Uring(dev);
         retValue = close(dev->os_info.fd);
         dev->os_info.last_error = errno;
         if ( retValue == 0)
@@ -1797,7 +1986,524 @@ int close_Device(tDevice *dev)
     }
 }
 
+#if defined (SG_HELPER_NVME_URING)
+#define NVME_URING_ENTRIES NVME_URING_MAX_QUEUED //threads get their own ring through clone_Device_For_Thread
+#define NVME_URING_SQE_SIZE 128 //IORING_SETUP_SQE128 is needed to fit struct nvme_uring_cmd
+#define NVME_URING_CQE_SIZE 32 //IORING_SETUP_CQE32 is needed to get the command specific result back
+#define NVME_URING_POLL_SPINS 100000 //checks of the completion ring before sleeping in the kernel. Most fast NVMe commands finish in this time.
+
+typedef struct _nvmeUringContext
+{
+    bool available;//false when the kernel or device cannot send NVMe commands through io_uring. The ioctls are used instead.
+    uint32_t inFlight;//commands from submit_NVMe_IO_Uring_Command that have not been reaped yet
+    int ngFd;//NVMe generic (ng) character handle for the namespace. Registered with the ring as fixed file 0.
+    int ringFd;
+    uint8_t *sqRing;
+    size_t sqRingSize;
+    uint8_t *cqRing;//same as sqRing when the kernel maps both rings together
+    size_t cqRingSize;
+    uint8_t *sqes;
+    size_t sqesSize;
+    uint32_t *sqTail;
+    uint32_t sqMask;
+    uint32_t *sqArray;
+    uint32_t *cqHead;
+    uint32_t *cqTail;
+    uint32_t cqMask;
+    uint8_t *cqes;
+    uint32_t numberOfFixedBuffers;
+    struct iovec fixedBuffers[NVME_URING_MAX_FIXED_BUFFERS];
+}nvmeUringContext;
+
+static uint8_t* map_NVMe_Uring(int ringFd, size_t size, off_t offset)
+{
+    void *mapped = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, offset);
+    return mapped == MAP_FAILED ? NULL : C_CAST(uint8_t*, mapped);
+}
+
+//closes the ring and the generic handle, but keeps the context so that the device does not try to set it up again
+static void release_NVMe_Uring(nvmeUringContext *ring)
+{
+    if (ring->sqes)
+    {
+        munmap(ring->sqes, ring->sqesSize);
+    }
+    if (ring->cqRing && ring->cqRing != ring->sqRing)
+    {
+        munmap(ring->cqRing, ring->cqRingSize);
+    }
+    if (ring->sqRing)
+    {
+        munmap(ring->sqRing, ring->sqRingSize);
+    }
+    ring->sqes = NULL;
+    ring->cqRing = NULL;
+    ring->sqRing = NULL;
+    if (ring->ringFd >= 0)
+    {
+        close(ring->ringFd);//also unregisters the file and buffers
+        ring->ringFd = -1;
+    }
+    if (ring->ngFd >= 0)
+    {
+        close(ring->ngFd);
+        ring->ngFd = -1;
+    }
+    ring->numberOfFixedBuffers = 0;
+    ring->inFlight = 0;
+    ring->available = false;
+}
+
+//Adds one NVMe IO command to the submission ring. The kernel does not see it until io_uring_enter is called.
+static void queue_NVMe_Uring_Cmd(nvmeUringContext *ring, nvmeCmdCtx *nvmeIoCtx, uint64_t userData)
+{
+    uint32_t tail = *ring->sqTail;//only this thread adds to the submission ring
+    uint32_t index = tail & ring->sqMask;
+    struct io_uring_sqe *sqe = C_CAST(struct io_uring_sqe*, C_CAST(void*, ring->sqes + index * NVME_URING_SQE_SIZE));
+    struct nvme_uring_cmd *uringCmd = NULL;
+    memset(sqe, 0, NVME_URING_SQE_SIZE);
+    sqe->opcode = IORING_OP_URING_CMD;
+    sqe->flags = IOSQE_FIXED_FILE;
+    sqe->fd = 0;//index of the registered generic handle
+    sqe->cmd_op = NVME_URING_CMD_IO;
+    sqe->user_data = userData;
+    uringCmd = C_CAST(struct nvme_uring_cmd*, C_CAST(void*, sqe->cmd));
+    uringCmd->opcode = nvmeIoCtx->cmd.nvmCmd.opcode;
+    uringCmd->flags = nvmeIoCtx->cmd.nvmCmd.flags;
+    //The IO ioctls fill in the namespace of the handle, but the kernel rejects uring commands that do not name the namespace of the generic handle
+    uringCmd->nsid = nvmeIoCtx->cmd.nvmCmd.nsid ? nvmeIoCtx->cmd.nvmCmd.nsid : nvmeIoCtx->device->drive_info.namespaceID;
+    uringCmd->cdw2 = nvmeIoCtx->cmd.nvmCmd.cdw2;
+    uringCmd->cdw3 = nvmeIoCtx->cmd.nvmCmd.cdw3;
+    uringCmd->addr = C_CAST(uint64_t, C_CAST(uintptr_t, nvmeIoCtx->ptrData));
+    uringCmd->data_len = nvmeIoCtx->dataSize;
+    uringCmd->cdw10 = nvmeIoCtx->cmd.nvmCmd.cdw10;
+    uringCmd->cdw11 = nvmeIoCtx->cmd.nvmCmd.cdw11;
+    uringCmd->cdw12 = nvmeIoCtx->cmd.nvmCmd.cdw12;
+    uringCmd->cdw13 = nvmeIoCtx->cmd.nvmCmd.cdw13;
+    uringCmd->cdw14 = nvmeIoCtx->cmd.nvmCmd.cdw14;
+    uringCmd->cdw15 = nvmeIoCtx->cmd.nvmCmd.cdw15;
+    uringCmd->timeout_ms = nvmeIoCtx->timeout ? nvmeIoCtx->timeout * 1000 : 15000;//timeout is in seconds, so converting to milliseconds
+    #if defined (IORING_URING_CMD_FIXED)
+    if (nvmeIoCtx->ptrData && nvmeIoCtx->dataSize > 0)
+    {
+        uint32_t bufferIter = 0;
+        for (bufferIter = 0; bufferIter < ring->numberOfFixedBuffers; ++bufferIter)
+        {
+            uint8_t *base = C_CAST(uint8_t*, ring->fixedBuffers[bufferIter].iov_base);
+            if (nvmeIoCtx->ptrData >= base && nvmeIoCtx->dataSize <= ring->fixedBuffers[bufferIter].iov_len
+                && C_CAST(size_t, nvmeIoCtx->ptrData - base) <= ring->fixedBuffers[bufferIter].iov_len - nvmeIoCtx->dataSize)
+            {
+                sqe->uring_cmd_flags = IORING_URING_CMD_FIXED;
+                sqe->buf_index = C_CAST(uint16_t, bufferIter);
+                break;
+            }
+        }
+    }
+    #endif
+    ring->sqArray[index] = index;
+    __atomic_store_n(ring->sqTail, tail + 1, __ATOMIC_RELEASE);
+}
+
+//Passes the command added by queue_NVMe_Uring_Cmd to the kernel. Returns 0 or a negative errno.
+static int32_t enter_NVMe_Uring_Cmd(nvmeUringContext *ring)
+{
+    if (syscall(__NR_io_uring_enter, ring->ringFd, 1, 0, 0, NULL, 0) < 1)
+    {
+        //the entry was not consumed, so take it back out of the ring
+        int32_t error = errno ? -errno : -EAGAIN;
+        __atomic_store_n(ring->sqTail, *ring->sqTail - 1, __ATOMIC_RELEASE);
+        return error;
+    }
+    return 0;
+}
+
+//Takes the next completion off the ring. When wait is false and nothing has completed, this returns -EAGAIN right away.
+//Returns 0 or a negative errno. result is the NVMe status or a negative errno for the command.
+static int32_t get_NVMe_Uring_Completion(nvmeUringContext *ring, bool wait, uint64_t *userData, int32_t *result, uint64_t *commandSpecific)
+{
+    uint32_t head = *ring->cqHead;
+    uint32_t spins = 0;
+    struct io_uring_cqe *cqe = NULL;
+    //poll the completion ring first, since sleeping and waking up again takes longer than a fast command
+    while (__atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE) == head)
+    {
+        if (!wait)
+        {
+            return -EAGAIN;
+        }
+        else if (spins < NVME_URING_POLL_SPINS)
+        {
+            ++spins;
+        }
+        else if (syscall(__NR_io_uring_enter, ring->ringFd, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0) < 0 && errno != EINTR)
+        {
+            return -errno;
+        }
+    }
+    cqe = C_CAST(struct io_uring_cqe*, C_CAST(void*, ring->cqes + (head & ring->cqMask) * NVME_URING_CQE_SIZE));
+    *userData = cqe->user_data;
+    *result = cqe->res;
+    *commandSpecific = cqe->big_cqe[0];
+    __atomic_store_n(ring->cqHead, head + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+//Sends one NVMe IO command and waits for it. Nothing else may be in flight on the ring.
+//Returns the NVMe status the same way the ioctls do, or a negative errno.
+//If the command cannot be passed in or waited for, it may still complete later, so the ring is marked unavailable and only closed after that.
+static int32_t send_NVMe_Uring_Cmd(nvmeUringContext *ring, nvmeCmdCtx *nvmeIoCtx, uint64_t *commandSpecific)
+{
+    uint64_t userData = 0;
+    int32_t result = 0;
+    int32_t error = 0;
+    queue_NVMe_Uring_Cmd(ring, nvmeIoCtx, 0);
+    if ((error = enter_NVMe_Uring_Cmd(ring)) < 0 || (error = get_NVMe_Uring_Completion(ring, true, &userData, &result, commandSpecific)) < 0)
+    {
+        ring->available = false;
+        return error;
+    }
+    return result;
+}
+
+//Fills in the completion of a command the same way the ioctls do. Returns SUCCESS or OS_PASSTHROUGH_FAILURE.
+static int set_NVMe_Uring_Completion(nvmeCmdCtx *nvmeIoCtx, int32_t result, uint64_t commandSpecific)
+{
+    tDevice *device = nvmeIoCtx->device;
+    device->os_info.last_error = result < 0 ? -result : 0;
+    if (result < 0)
+    {
+        if (VERBOSITY_COMMAND_VERBOSE <= device->deviceVerbosity)
+        {
+            printf("Error: ");
+            print_Errno_To_Screen(device->os_info.last_error);
+        }
+        return OS_PASSTHROUGH_FAILURE;
+    }
+    nvmeIoCtx->commandCompletionData.commandSpecific = C_CAST(uint32_t, commandSpecific);
+    nvmeIoCtx->commandCompletionData.dw3Valid = true;
+    nvmeIoCtx->commandCompletionData.dw0Valid = true;
+    nvmeIoCtx->commandCompletionData.statusAndCID = C_CAST(uint32_t, result) << 17;//shift into place since we don't get the phase tag or command ID bits and these are the status field
+    return SUCCESS;
+}
+
+static int setup_NVMe_Uring(tDevice *device)
+{
+    nvmeUringContext *ring = NULL;
+    struct io_uring_params params;
+    char ngHandle[OS_HANDLE_NAME_MAX_LENGTH] = { 0 };
+    unsigned int controller = 0, namespaceNum = 0;
+    nvmeCmdCtx probe;
+    uint64_t commandSpecific = 0;
+    ring = C_CAST(nvmeUringContext*, calloc(1, sizeof(nvmeUringContext)));
+    if (!ring)
+    {
+        return MEMORY_FAILURE;
+    }
+    ring->ngFd = -1;
+    ring->ringFd = -1;
+    device->os_info.nvmeUring = ring;
+    //the generic handle is numbered the same as the block handle: /dev/nvme0n1 is /dev/ng0n1. Kernels before 5.13 do not have it.
+    if (sscanf(device->os_info.name, "/dev/nvme%un%u", &controller, &namespaceNum) != 2)
+    {
+        return NOT_SUPPORTED;
+    }
+    snprintf(ngHandle, OS_HANDLE_NAME_MAX_LENGTH, "/dev/ng%un%u", controller, namespaceNum);
+    if ((ring->ngFd = open(ngHandle, O_RDWR)) < 0)
+    {
+        ring->ngFd = -1;
+        return NOT_SUPPORTED;
+    }
+    memset(&params, 0, sizeof(struct io_uring_params));
+    params.flags = IORING_SETUP_SQE128 | IORING_SETUP_CQE32;
+    //ENOSYS before kernel 5.1, EINVAL for the larger entries before 5.19
+    ring->ringFd = C_CAST(int, syscall(__NR_io_uring_setup, NVME_URING_ENTRIES, &params));
+    if (ring->ringFd < 0)
+    {
+        ring->ringFd = -1;
+        release_NVMe_Uring(ring);
+        return NOT_SUPPORTED;
+    }
+    ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    ring->cqRingSize = params.cq_off.cqes + params.cq_entries * NVME_URING_CQE_SIZE;
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        ring->sqRingSize = M_Max(ring->sqRingSize, ring->cqRingSize);
+        ring->cqRingSize = ring->sqRingSize;
+    }
+    ring->sqesSize = params.sq_entries * NVME_URING_SQE_SIZE;
+    ring->sqRing = map_NVMe_Uring(ring->ringFd, ring->sqRingSize, IORING_OFF_SQ_RING);
+    if (ring->sqRing)
+    {
+        ring->cqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? ring->sqRing : map_NVMe_Uring(ring->ringFd, ring->cqRingSize, IORING_OFF_CQ_RING);
+    }
+    if (ring->cqRing)
+    {
+        ring->sqes = map_NVMe_Uring(ring->ringFd, ring->sqesSize, IORING_OFF_SQES);
+    }
+    if (!ring->sqes || syscall(__NR_io_uring_register, ring->ringFd, IORING_REGISTER_FILES, &ring->ngFd, 1) < 0)
+    {
+        release_NVMe_Uring(ring);
+        return MEMORY_FAILURE;
+    }
+    ring->sqTail = C_CAST(uint32_t*, C_CAST(void*, ring->sqRing + params.sq_off.tail));
+    ring->sqMask = *C_CAST(uint32_t*, C_CAST(void*, ring->sqRing + params.sq_off.ring_mask));
+    ring->sqArray = C_CAST(uint32_t*, C_CAST(void*, ring->sqRing + params.sq_off.array));
+    ring->cqHead = C_CAST(uint32_t*, C_CAST(void*, ring->cqRing + params.cq_off.head));
+    ring->cqTail = C_CAST(uint32_t*, C_CAST(void*, ring->cqRing + params.cq_off.tail));
+    ring->cqMask = *C_CAST(uint32_t*, C_CAST(void*, ring->cqRing + params.cq_off.ring_mask));
+    ring->cqes = ring->cqRing + params.cq_off.cqes;
+    //Kernels before 5.19 make the ring but do not know uring passthrough commands, and security modules can refuse them.
+    //A flush has no data and is safe to send, so it is sent once here to find out. Any NVMe status back, even an error, means the path works,
+    //so errors from later commands always belong to those commands.
+    memset(&probe, 0, sizeof(nvmeCmdCtx));
+    probe.commandType = NVM_CMD;
+    probe.cmd.nvmCmd.opcode = NVME_CMD_FLUSH;
+    probe.commandDirection = XFER_NO_DATA;
+    probe.device = device;
+    probe.timeout = 15;
+    if (send_NVMe_Uring_Cmd(ring, &probe, &commandSpecific) < 0)
+    {
+        release_NVMe_Uring(ring);
+        return NOT_SUPPORTED;
+    }
+    ring->available = true;
+    return SUCCESS;
+}
+
+//Returns the device's ring, setting it up on first use, or NULL when NVMe commands cannot go through io_uring
+static nvmeUringContext* get_NVMe_Uring(tDevice *device)
+{
+    if (!device->os_info.nvmeUring)
+    {
+        //when this fails the context is kept without a ring, so it is only tried once per device
+        setup_NVMe_Uring(device);
+    }
+    if (!device->os_info.nvmeUring || !device->os_info.nvmeUring->available)
+    {
+        return NULL;
+    }
+    return device->os_info.nvmeUring;
+}
+
+//Returns false when the command needs to be sent with the ioctls instead.
+static bool send_NVMe_IO_Through_Uring(nvmeCmdCtx *nvmeIoCtx, seatimer_t *commandTimer, int *ret)
+{
+    nvmeUringContext *ring = NULL;
+    int32_t result = 0;
+    uint64_t commandSpecific = 0;
+    if (nvmeIoCtx->cmd.nvmCmd.metadata)
+    {
+        //the metadata length is only known to the kernel for reads and writes through NVME_IOCTL_SUBMIT_IO
+        return false;
+    }
+    ring = get_NVMe_Uring(nvmeIoCtx->device);
+    if (!ring || ring->inFlight > 0)
+    {
+        //completions on the ring belong to commands from submit_NVMe_IO_Uring_Command until they are reaped
+        return false;
+    }
+    start_Timer(commandTimer);
+    result = send_NVMe_Uring_Cmd(ring, nvmeIoCtx, &commandSpecific);
+    stop_Timer(commandTimer);
+    *ret = set_NVMe_Uring_Completion(nvmeIoCtx, result, commandSpecific);
+    return true;
+}
+#endif //SG_HELPER_NVME_URING
+
+void close_NVMe_IO_Uring(tDevice *device)
+{
+#if defined (SG_HELPER_NVME_URING)
+    if (device && device->os_info.nvmeUring)
+    {
+        release_NVMe_Uring(device->os_info.nvmeUring);
+        safe_Free(device->os_info.nvmeUring)
+    }
+#else
+    M_USE_UNUSED(device);
+#endif
+}
+
 #if !defined(DISABLE_NVME_PASSTHROUGH)
+int register_NVMe_IO_Uring_Buffers(tDevice *device, uint8_t **buffers, uint32_t *bufferSizes, uint32_t count)
+{
+#if defined (SG_HELPER_NVME_URING)
+    nvmeUringContext *ring = NULL;
+    uint32_t bufferIter = 0;
+    if (!device || count > NVME_URING_MAX_FIXED_BUFFERS || (count > 0 && (!buffers || !bufferSizes)))
+    {
+        return BAD_PARAMETER;
+    }
+    if (device->drive_info.drive_type != NVME_DRIVE)
+    {
+        return NOT_SUPPORTED;
+    }
+    ring = get_NVMe_Uring(device);
+    if (!ring)
+    {
+        return NOT_SUPPORTED;
+    }
+    if (ring->inFlight > 0)
+    {
+        //queued commands may be using the current buffers
+        return BAD_PARAMETER;
+    }
+    if (ring->numberOfFixedBuffers > 0)
+    {
+        syscall(__NR_io_uring_register, ring->ringFd, IORING_UNREGISTER_BUFFERS, NULL, 0);
+        ring->numberOfFixedBuffers = 0;
+    }
+    if (count == 0)
+    {
+        return SUCCESS;
+    }
+    #if defined (IORING_URING_CMD_FIXED)
+    for (bufferIter = 0; bufferIter < count; ++bufferIter)
+    {
+        if (!buffers[bufferIter] || bufferSizes[bufferIter] == 0)
+        {
+            return BAD_PARAMETER;
+        }
+        ring->fixedBuffers[bufferIter].iov_base = buffers[bufferIter];
+        ring->fixedBuffers[bufferIter].iov_len = bufferSizes[bufferIter];
+    }
+    //the kernel pins the pages, which counts against RLIMIT_MEMLOCK
+    if (syscall(__NR_io_uring_register, ring->ringFd, IORING_REGISTER_BUFFERS, ring->fixedBuffers, count) < 0)
+    {
+        return errno == ENOMEM ? MEMORY_FAILURE : FAILURE;
+    }
+    ring->numberOfFixedBuffers = count;
+    //Kernels before 6.1 take the buffers, then reject every passthrough command that uses them. A one block read of LBA 0 into the first
+    //buffer finds this out now rather than failing the caller's commands later.
+    if (device->drive_info.deviceBlockSize > 0 && bufferSizes[0] >= device->drive_info.deviceBlockSize)
+    {
+        nvmeCmdCtx probe;
+        uint64_t commandSpecific = 0;
+        memset(&probe, 0, sizeof(nvmeCmdCtx));
+        probe.commandType = NVM_CMD;
+        probe.cmd.nvmCmd.opcode = NVME_CMD_READ;
+        probe.commandDirection = XFER_DATA_IN;
+        probe.ptrData = buffers[0];
+        probe.dataSize = device->drive_info.deviceBlockSize;
+        probe.device = device;
+        probe.timeout = 15;
+        if (send_NVMe_Uring_Cmd(ring, &probe, &commandSpecific) < 0)
+        {
+            syscall(__NR_io_uring_register, ring->ringFd, IORING_UNREGISTER_BUFFERS, NULL, 0);
+            ring->numberOfFixedBuffers = 0;
+            return NOT_SUPPORTED;
+        }
+    }
+    return SUCCESS;
+    #else
+    //the kernel headers are older than registered buffers in passthrough commands
+    M_USE_UNUSED(bufferIter);
+    return NOT_SUPPORTED;
+    #endif
+#else
+    M_USE_UNUSED(device);
+    M_USE_UNUSED(buffers);
+    M_USE_UNUSED(bufferSizes);
+    M_USE_UNUSED(count);
+    return NOT_SUPPORTED;
+#endif
+}
+
+int submit_NVMe_IO_Uring_Command(nvmeCmdCtx *nvmeIoCtx)
+{
+#if defined (SG_HELPER_NVME_URING)
+    nvmeUringContext *ring = NULL;
+    int32_t error = 0;
+    if (!nvmeIoCtx || !nvmeIoCtx->device || nvmeIoCtx->commandType != NVM_CMD || nvmeIoCtx->cmd.nvmCmd.metadata)
+    {
+        return BAD_PARAMETER;
+    }
+    if (nvmeIoCtx->device->drive_info.drive_type != NVME_DRIVE)
+    {
+        return NOT_SUPPORTED;
+    }
+    ring = get_NVMe_Uring(nvmeIoCtx->device);
+    if (!ring)
+    {
+        return NOT_SUPPORTED;
+    }
+    if (ring->inFlight >= NVME_URING_MAX_QUEUED)
+    {
+        return BAD_PARAMETER;
+    }
+    memset(&nvmeIoCtx->commandCompletionData, 0, sizeof(nvmeIoCtx->commandCompletionData));
+    queue_NVMe_Uring_Cmd(ring, nvmeIoCtx, C_CAST(uint64_t, C_CAST(uintptr_t, nvmeIoCtx)));
+    if ((error = enter_NVMe_Uring_Cmd(ring)) < 0)
+    {
+        nvmeIoCtx->device->os_info.last_error = -error;
+        return OS_PASSTHROUGH_FAILURE;
+    }
+    ++ring->inFlight;
+    return SUCCESS;
+#else
+    M_USE_UNUSED(nvmeIoCtx);
+    return NOT_SUPPORTED;
+#endif
+}
+
+int reap_NVMe_IO_Uring_Commands(tDevice *device, uint32_t minimumToComplete, nvmeCmdCtx **completed, int *results, uint32_t maxCompleted, uint32_t *numberCompleted)
+{
+#if defined (SG_HELPER_NVME_URING)
+    nvmeUringContext *ring = NULL;
+    if (!device || !completed || !results || !numberCompleted || maxCompleted == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    *numberCompleted = 0;
+    ring = device->os_info.nvmeUring;
+    if (!ring || !ring->available)
+    {
+        return NOT_SUPPORTED;
+    }
+    minimumToComplete = M_Min(M_Min(minimumToComplete, ring->inFlight), maxCompleted);
+    while (*numberCompleted < maxCompleted && ring->inFlight > 0)
+    {
+        uint64_t userData = 0;
+        uint64_t commandSpecific = 0;
+        int32_t result = 0;
+        int32_t error = get_NVMe_Uring_Completion(ring, *numberCompleted < minimumToComplete, &userData, &result, &commandSpecific);
+        nvmeCmdCtx *nvmeIoCtx = NULL;
+        if (error == -EAGAIN)
+        {
+            //enough have completed and the rest are still running
+            break;
+        }
+        else if (error < 0)
+        {
+            device->os_info.last_error = -error;
+            return OS_PASSTHROUGH_FAILURE;
+        }
+        if (userData == 0)
+        {
+            //a command from send_NVMe_Uring_Cmd that was not waited for. It is not one of the caller's commands.
+            continue;
+        }
+        --ring->inFlight;
+        nvmeIoCtx = C_CAST(nvmeCmdCtx*, C_CAST(uintptr_t, userData));
+        results[*numberCompleted] = set_NVMe_Uring_Completion(nvmeIoCtx, result, commandSpecific);
+        if (results[*numberCompleted] == SUCCESS)
+        {
+            results[*numberCompleted] = check_NVMe_Status(nvmeIoCtx->commandCompletionData.statusAndCID);
+        }
+        completed[*numberCompleted] = nvmeIoCtx;
+        ++(*numberCompleted);
+    }
+    return SUCCESS;
+#else
+    M_USE_UNUSED(device);
+    M_USE_UNUSED(minimumToComplete);
+    M_USE_UNUSED(completed);
+    M_USE_UNUSED(results);
+    M_USE_UNUSED(maxCompleted);
+    M_USE_UNUSED(numberCompleted);
+    return NOT_SUPPORTED;
+#endif
+}
+
 int send_NVMe_IO(nvmeCmdCtx *nvmeIoCtx )
 {
     int ret = SUCCESS;//NVME_SC_SUCCESS;//This defined value used to exist in some version of nvme.h but is missing in nvme_ioctl.h...it was a value of zero, so this should be ok.
@@ -1860,6 +2566,12 @@ int send_NVMe_IO(nvmeCmdCtx *nvmeIoCtx )
         }
         break;
     case NVM_CMD:
+        #if defined (SG_HELPER_NVME_URING)
+        if (send_NVMe_IO_Through_Uring(nvmeIoCtx, &commandTimer, &ret))
+        {
+            break;
+        }
+        #endif
         //check opcode to perform the correct IOCTL
         switch (nvmeIoCtx->cmd.nvmCmd.opcode)
         {
@@ -1956,6 +2668,67 @@ int send_NVMe_IO(nvmeCmdCtx *nvmeIoCtx )
     return ret;
 }
 
+//"nvme" and "n" plus two 32bit numbers, which is the only form of name that is looked at
+#define NVME_BLOCK_NAME_LENGTH 32
+
+int get_NVMe_Namespace_Handle(tDevice *device, uint32_t namespaceID, char *handle, size_t handleLength)
+{
+    int ret = NOT_SUPPORTED;
+    unsigned int handlePrefix = 0;
+    struct dirent **blockList = NULL;
+    int numberOfBlockDevices = 0;
+    int blockIter = 0;
+    if (!device || !handle || handleLength == 0 || namespaceID == 0)
+    {
+        return BAD_PARAMETER;
+    }
+    //Namespaces of the same controller (or the same subsystem when native multipath is on) share the number after "nvme": /dev/nvme0, /dev/nvme0n1, /dev/nvme0n2.
+    //The number after "n" is an instance number and does not have to match the namespace ID, so the ID is read from sysfs.
+    if (sscanf(device->os_info.name, "/dev/nvme%u", &handlePrefix) != 1)
+    {
+        return NOT_SUPPORTED;
+    }
+    numberOfBlockDevices = scandir("/sys/block", &blockList, NULL, alphasort);
+    for (blockIter = 0; blockIter < numberOfBlockDevices; ++blockIter)
+    {
+        unsigned int entryPrefix = 0, entryInstance = 0;
+        char expectedName[NVME_BLOCK_NAME_LENGTH] = { 0 };
+        if (ret != SUCCESS
+            && sscanf(blockList[blockIter]->d_name, "nvme%un%u", &entryPrefix, &entryInstance) == 2 && entryPrefix == handlePrefix)
+        {
+            //skip multipath path devices (nvme0c1n1). They have no /dev node.
+            //expectedName is used from here on since it is the same string and its length is known to fit the paths below
+            snprintf(expectedName, NVME_BLOCK_NAME_LENGTH, "nvme%un%u", entryPrefix, entryInstance);
+            if (strcmp(expectedName, blockList[blockIter]->d_name) == 0)
+            {
+                char nsidPath[OS_HANDLE_NAME_MAX_LENGTH] = { 0 };
+                FILE *nsidFile = NULL;
+                snprintf(nsidPath, OS_HANDLE_NAME_MAX_LENGTH, "/sys/block/%s/nsid", expectedName);
+                if ((nsidFile = fopen(nsidPath, "r")))
+                {
+                    unsigned int entryNamespaceID = 0;
+                    if (fscanf(nsidFile, "%u", &entryNamespaceID) == 1 && entryNamespaceID == namespaceID)
+                    {
+                        if (handleLength > strlen("/dev/") + strlen(expectedName))
+                        {
+                            snprintf(handle, handleLength, "/dev/%s", expectedName);
+                            ret = SUCCESS;
+                        }
+                        else
+                        {
+                            ret = BAD_PARAMETER;//handle is too small for the name
+                        }
+                    }
+                    fclose(nsidFile);
+                }
+            }
+        }
+        safe_Free(blockList[blockIter])
+    }
+    safe_Free(blockList)
+    return ret;
+}
+
 int linux_NVMe_Reset(tDevice *device, bool subsystemReset)
 {
     //Can only do a reset on a controller handle. Need to get the controller handle if this is a namespace handle!!!
@@ -164,6 +164,7 @@ void close_NVMe_Passthru_Protocol_Ptr(EFI_NVM_EXPRESS_PASS_THRU_PROTOCOL **pPass
 int get_Device(const char *filename, tDevice *device)
 {
     char interface[10] = { 0 };
+    device->bufferPool = NULL;//only enable_Device_Buffer_Pool creates one
     snprintf(device->os_info.name, OS_HANDLE_NAME_MAX_LENGTH, "%s", filename);
     snprintf(device->os_info.friendlyName, OS_HANDLE_FRIENDLY_NAME_MAX_LENGTH, "%s", filename);
     device->os_info.osType = OS_UEFI;
@@ -1784,6 +1785,7 @@ int os_nvme_Subsystem_Reset(tDevice *device)
 
 int close_Device(tDevice *device)
 {
+    disable_Device_Buffer_Pool(device);
     return NOT_SUPPORTED;
 }
 
@@ -52,6 +52,7 @@ static void set_Device_Name(const char* filename, char * name, int sizeOfName)
 int get_Device(const char *filename, tDevice *device)
 {
     int ret = SUCCESS;
+    device->bufferPool = NULL;//only enable_Device_Buffer_Pool creates one
 
     if((device->os_info.fd = open(filename, O_RDWR | O_NONBLOCK)) < 0)
     {
@@ -305,6 +306,7 @@ int close_Device(tDevice *device)
     int retValue = 0;
     if(device)
     {
+        disable_Device_Buffer_Pool(device);
         retValue = close(device->os_info.fd);
         device->os_info.last_error = errno;
         if(retValue == 0)
@@ -851,6 +851,7 @@ int get_Device(const char *filename, tDevice *device)
     struct nvme_adapter_list nvmeAdptList;
     bool isScsi = false;
     char *nvmeDevName;
+    device->bufferPool = NULL;//only enable_Device_Buffer_Pool creates one
 
     /**
      * In VMWare NVMe device the drivename (for NDDK) 
@@ -1845,6 +1846,7 @@ int close_Device(tDevice *dev)
 
     if (dev)
     {
+        disable_Device_Buffer_Pool(dev);
         if (isNVMe) 
         {
             Nvme_Close(dev->os_info.nvmeFd);
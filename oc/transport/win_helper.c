@@ -2186,6 +2186,7 @@ int close_Device(tDevice *dev)
     int retValue = 0;
     if (dev)
     {
+        disable_Device_Buffer_Pool(dev);
 #if defined (ENABLE_CSMI)
         if (is_CSMI_Handle(dev->os_info.name))
         {
@@ -3320,6 +3321,7 @@ static int get_Win_Device(const char *filename, tDevice *device )
 }
 int get_Device(const char *filename, tDevice *device)
 {
+    device->bufferPool = NULL;//only enable_Device_Buffer_Pool creates one
 #if defined (ENABLE_CSMI)
     //check is the handle is in the format of a CSMI device handle so we can open the csmi device properly.
     if (is_CSMI_Handle(filename))